@@ -0,0 +1,186 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file CanBusAnalyzer.cpp
+ * @brief Implementation of the CanBusAnalyzer class.
+ */
+
+#include "CanBusAnalyzer.h"
+
+#include <QVariantMap>
+
+#include <algorithm>
+#include <cmath>
+
+CanBusAnalyzer::CanBusAnalyzer(QObject *parent) : QObject(parent)
+{
+    m_table.resize(TABLE_CAPACITY);
+    m_clock.start();
+    connect(&m_publishTimer, &QTimer::timeout, this, &CanBusAnalyzer::publish);
+    m_publishTimer.start(PUBLISH_INTERVAL_MS);
+}
+
+void CanBusAnalyzer::setTableVisible(bool visible)
+{
+    if (m_tableVisible == visible)
+        return;
+
+    m_tableVisible = visible;
+    if (m_tableVisible)
+        rebuildRows();
+    emit tableVisibleChanged();
+}
+
+void CanBusAnalyzer::setBitrate(int bitrate)
+{
+    if (bitrate <= 0 || m_bitrate == bitrate)
+        return;
+
+    m_bitrate = bitrate;
+    emit statsChanged();
+}
+
+void CanBusAnalyzer::reset()
+{
+    m_table.fill(IdStats());
+    m_uniqueIds = 0;
+    m_untrackedFrames = 0;
+    m_bitsInWindow = 0;
+    m_framesInWindow = 0;
+    m_busLoadPercent = 0.0;
+    m_totalFrameRate = 0;
+    m_windowStartMs = m_clock.elapsed();
+    m_idStats.clear();
+    emit statsChanged();
+    emit idStatsChanged();
+}
+
+CanBusAnalyzer::IdStats *CanBusAnalyzer::slotFor(quint32 key)
+{
+    // Fibonacci hashing into a power-of-two table with linear probing.
+    quint32 index = (key * 2654435769u) >> 23;
+    for (int probe = 0; probe < TABLE_CAPACITY; ++probe) {
+        IdStats &slot = m_table[static_cast<int>(index)];
+        if (slot.used && slot.key == key)
+            return &slot;
+        if (!slot.used) {
+            if (m_uniqueIds >= MAX_TRACKED_IDS)
+                return nullptr;
+            slot.used = true;
+            slot.key = key;
+            ++m_uniqueIds;
+            return &slot;
+        }
+        index = (index + 1) & (TABLE_CAPACITY - 1);
+    }
+    return nullptr;
+}
+
+int CanBusAnalyzer::frameBits(bool extended, int payloadBytes)
+{
+    // Classic CAN: 47 (standard) / 67 (extended) overhead bits plus payload,
+    // with worst-case stuffing over the stuffable region.
+    const int dataBits = 8 * payloadBytes;
+    if (extended)
+        return 67 + dataBits + (54 + dataBits - 1) / 4;
+    return 47 + dataBits + (34 + dataBits - 1) / 4;
+}
+
+void CanBusAnalyzer::recordFrame(const QCanBusFrame &frame)
+{
+    const bool extended = frame.hasExtendedFrameFormat();
+    const int payloadBytes = static_cast<int>(frame.payload().size());
+    m_bitsInWindow += static_cast<quint64>(frameBits(extended, payloadBytes));
+    ++m_framesInWindow;
+
+    const quint32 key = frame.frameId() | (extended ? 0x80000000u : 0u);
+    IdStats *stats = slotFor(key);
+    if (!stats) {
+        ++m_untrackedFrames;
+        return;
+    }
+
+    // Prefer the kernel receive timestamp; fall back to our own clock when the
+    // backend does not provide one.
+    const QCanBusFrame::TimeStamp ts = frame.timeStamp();
+    const qint64 nowMs = m_clock.elapsed();
+    qint64 timestampUs = ts.seconds() * 1000000 + ts.microSeconds();
+    if (timestampUs == 0)
+        timestampUs = m_clock.nsecsElapsed() / 1000;
+
+    if (stats->frames > 0 && timestampUs > stats->lastTimestampUs) {
+        // Welford running mean/variance of the inter-arrival time.
+        const double interval = static_cast<double>(timestampUs - stats->lastTimestampUs);
+        const double n = static_cast<double>(stats->frames);
+        const double delta = interval - stats->meanIntervalUs;
+        stats->meanIntervalUs += delta / n;
+        stats->intervalM2 += delta * (interval - stats->meanIntervalUs);
+        if (interval > stats->maxIntervalUs)
+            stats->maxIntervalUs = interval;
+    }
+
+    stats->extended = extended;
+    stats->dlc = static_cast<quint8>(payloadBytes);
+    stats->lastTimestampUs = timestampUs;
+    stats->lastSeenMs = nowMs;
+    ++stats->frames;
+    ++stats->framesInWindow;
+}
+
+void CanBusAnalyzer::publish()
+{
+    const qint64 nowMs = m_clock.elapsed();
+    const qint64 elapsedMs = qMax<qint64>(1, nowMs - m_windowStartMs);
+    m_windowStartMs = nowMs;
+
+    m_totalFrameRate = static_cast<int>(m_framesInWindow * 1000 / elapsedMs);
+    const double bitsPerSecond = static_cast<double>(m_bitsInWindow) * 1000.0 / elapsedMs;
+    m_busLoadPercent = m_bitrate > 0 ? qMin(100.0, bitsPerSecond * 100.0 / m_bitrate) : 0.0;
+    m_bitsInWindow = 0;
+    m_framesInWindow = 0;
+
+    for (IdStats &stats : m_table) {
+        if (!stats.used)
+            continue;
+        stats.rate = stats.framesInWindow * 1000.0 / elapsedMs;
+        stats.framesInWindow = 0;
+    }
+
+    emit statsChanged();
+    if (m_tableVisible)
+        rebuildRows();
+}
+
+void CanBusAnalyzer::rebuildRows()
+{
+    QVector<const IdStats *> used;
+    used.reserve(m_uniqueIds);
+    for (const IdStats &stats : std::as_const(m_table)) {
+        if (stats.used)
+            used.append(&stats);
+    }
+    std::sort(used.begin(), used.end(), [](const IdStats *a, const IdStats *b) { return a->key < b->key; });
+
+    const qint64 nowMs = m_clock.elapsed();
+    QVariantList rows;
+    rows.reserve(used.size());
+    for (const IdStats *stats : std::as_const(used)) {
+        const quint32 id = stats->key & 0x1FFFFFFFu;
+        const double intervals = stats->frames > 1 ? static_cast<double>(stats->frames - 1) : 0.0;
+        const QString hexId = QStringLiteral("%1").arg(id, stats->extended ? 8 : 3, 16, QLatin1Char('0')).toUpper();
+
+        QVariantMap row;
+        row[QStringLiteral("id")] = QStringLiteral("0x") + hexId;
+        row[QStringLiteral("dlc")] = static_cast<int>(stats->dlc);
+        row[QStringLiteral("rate")] = stats->rate;
+        row[QStringLiteral("meanMs")] = stats->meanIntervalUs / 1000.0;
+        row[QStringLiteral("maxMs")] = stats->maxIntervalUs / 1000.0;
+        row[QStringLiteral("jitterMs")] = intervals > 0.0 ? std::sqrt(stats->intervalM2 / intervals) / 1000.0 : 0.0;
+        row[QStringLiteral("ageMs")] = nowMs - stats->lastSeenMs;
+        row[QStringLiteral("frames")] = static_cast<double>(stats->frames);
+        rows.append(row);
+    }
+
+    m_idStats = rows;
+    emit idStatsChanged();
+}
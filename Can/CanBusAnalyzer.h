@@ -0,0 +1,130 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file CanBusAnalyzer.h
+ * @brief Per-CAN-ID rate, inter-arrival jitter and bus-load statistics.
+ *
+ * Every frame from CanTransport updates one slot of a fixed-capacity
+ * open-addressing table keyed by CAN ID (O(1), no allocation). Once per
+ * second the per-window counters are folded into frame rates and an estimated
+ * bus load for the configured bitrate; the QML table rows are only rebuilt
+ * while the analyzer section is open.
+ */
+
+#ifndef CANBUSANALYZER_H
+#define CANBUSANALYZER_H
+
+#include <QCanBusFrame>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <QVariantList>
+#include <QVector>
+
+class CanBusAnalyzer : public QObject
+{
+    Q_OBJECT
+
+    /// Estimated bus load in percent of the configured bitrate (last second)
+    Q_PROPERTY(double busLoadPercent READ busLoadPercent NOTIFY statsChanged)
+
+    /// Frames per second across all IDs (last second)
+    Q_PROPERTY(int totalFrameRate READ totalFrameRate NOTIFY statsChanged)
+
+    /// Number of distinct CAN IDs seen since the last reset
+    Q_PROPERTY(int uniqueIdCount READ uniqueIdCount NOTIFY statsChanged)
+
+    /// Frames not tracked because the ID table was full
+    Q_PROPERTY(int untrackedFrames READ untrackedFrames NOTIFY statsChanged)
+
+    /// Nominal bus bitrate used for the load estimate
+    Q_PROPERTY(int bitrate READ bitrate NOTIFY statsChanged)
+
+    /// Per-ID rows {id, dlc, rate, meanMs, maxMs, jitterMs, ageMs, frames}, sorted by ID
+    Q_PROPERTY(QVariantList idStats READ idStats NOTIFY idStatsChanged)
+
+    /// Whether idStats is rebuilt each publish interval (set while the table is on screen)
+    Q_PROPERTY(bool tableVisible READ tableVisible WRITE setTableVisible NOTIFY tableVisibleChanged)
+
+public:
+    explicit CanBusAnalyzer(QObject *parent = nullptr);
+
+    double busLoadPercent() const { return m_busLoadPercent; }
+    int totalFrameRate() const { return m_totalFrameRate; }
+    int uniqueIdCount() const { return m_uniqueIds; }
+    int untrackedFrames() const { return m_untrackedFrames; }
+    int bitrate() const { return m_bitrate; }
+    QVariantList idStats() const { return m_idStats; }
+    bool tableVisible() const { return m_tableVisible; }
+    void setTableVisible(bool visible);
+
+    /**
+     * @brief Set the nominal bus bitrate used for the bus-load estimate.
+     * @param bitrate Bits per second (e.g. 500000)
+     */
+    void setBitrate(int bitrate);
+
+    /// Clear all per-ID statistics
+    Q_INVOKABLE void reset();
+
+public slots:
+    /**
+     * @brief Account one received frame.
+     *
+     * Connected to CanTransport::frameReceived; constant time per frame.
+     */
+    void recordFrame(const QCanBusFrame &frame);
+
+signals:
+    void statsChanged();
+    void idStatsChanged();
+    void tableVisibleChanged();
+
+private slots:
+    void publish();
+
+private:
+    struct IdStats
+    {
+        quint32 key = 0;
+        bool used = false;
+        bool extended = false;
+        quint8 dlc = 0;
+        quint64 frames = 0;
+        quint32 framesInWindow = 0;
+        double rate = 0.0;
+        qint64 lastTimestampUs = 0;
+        qint64 lastSeenMs = 0;
+        double meanIntervalUs = 0.0;
+        double intervalM2 = 0.0;
+        double maxIntervalUs = 0.0;
+    };
+
+    IdStats *slotFor(quint32 key);
+    void rebuildRows();
+
+    /// Frame length on the wire including worst-case stuff bits
+    static int frameBits(bool extended, int payloadBytes);
+
+    static constexpr int TABLE_CAPACITY = 512;      // power of two
+    static constexpr int MAX_TRACKED_IDS = 384;     // keep probe chains short (75% load)
+    static constexpr int PUBLISH_INTERVAL_MS = 1000;
+
+    QVector<IdStats> m_table;
+    int m_uniqueIds = 0;
+    int m_untrackedFrames = 0;
+    int m_bitrate = 250000;
+    quint64 m_bitsInWindow = 0;
+    quint32 m_framesInWindow = 0;
+
+    double m_busLoadPercent = 0.0;
+    int m_totalFrameRate = 0;
+    QVariantList m_idStats;
+    bool m_tableVisible = false;
+
+    QElapsedTimer m_clock;
+    qint64 m_windowStartMs = 0;
+    QTimer m_publishTimer;
+};
+
+#endif  // CANBUSANALYZER_H
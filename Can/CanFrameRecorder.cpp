@@ -0,0 +1,212 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file CanFrameRecorder.cpp
+ * @brief Implementation of the CanFrameRecorder class.
+ */
+
+#include "CanFrameRecorder.h"
+
+#include "CanTransport.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+#include <QThread>
+
+#include <chrono>
+
+namespace {
+constexpr quint64 RING_MASK = CanFrameRecorder::RING_CAPACITY - 1;
+constexpr qsizetype WRITE_BLOCK_SIZE = 64 * 1024;
+constexpr int IDLE_SLEEP_MS = 10;
+constexpr int STATS_INTERVAL_MS = 1000;
+constexpr qint64 PARTIAL_FLUSH_INTERVAL_MS = 1000;
+
+static_assert((CanFrameRecorder::RING_CAPACITY & RING_MASK) == 0, "ring capacity must be a power of two");
+
+qint64 wallClockUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
+CanFrameRecorder::CanFrameRecorder(QObject *parent) : QObject(parent)
+{
+    m_ring.resize(RING_CAPACITY);
+    connect(&m_statsTimer, &QTimer::timeout, this, &CanFrameRecorder::statsChanged);
+}
+
+CanFrameRecorder::~CanFrameRecorder()
+{
+    stop();
+}
+
+void CanFrameRecorder::attachTransport(CanTransport *transport)
+{
+    if (m_transport)
+        disconnect(m_transport, nullptr, this, nullptr);
+
+    m_transport = transport;
+    if (!m_transport)
+        return;
+
+    connect(m_transport, &CanTransport::frameReceived, this, &CanFrameRecorder::recordFrame);
+    connect(m_transport, &CanTransport::interfaceNameChanged, this,
+            [this]() { m_interfaceName = m_transport->interfaceName().toLatin1(); });
+    m_interfaceName = m_transport->interfaceName().toLatin1();
+}
+
+void CanFrameRecorder::setRecording(bool recording)
+{
+    if (recording)
+        start();
+    else
+        stop();
+}
+
+void CanFrameRecorder::setBinaryFormat(bool binary)
+{
+    if (m_binaryFormat == binary)
+        return;
+
+    m_binaryFormat = binary;
+    emit binaryFormatChanged();
+}
+
+bool CanFrameRecorder::start(const QString &path)
+{
+    if (m_thread)
+        return true;
+
+    m_path = path;
+    if (m_path.isEmpty()) {
+        const QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+        dir.mkpath(QStringLiteral("canlogs"));
+        m_path = dir.filePath(QStringLiteral("canlogs/candump-%1%2")
+                                  .arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-hhmmss")),
+                                       m_binaryFormat ? QStringLiteral(".ptcan") : QStringLiteral(".log")));
+    }
+
+    m_file.setFileName(m_path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+        emit errorOccurred(QStringLiteral("CAN recorder: cannot open %1: %2").arg(m_path, m_file.errorString()));
+        return false;
+    }
+
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    m_framesWritten.store(0, std::memory_order_relaxed);
+    m_framesDropped.store(0, std::memory_order_relaxed);
+    m_bytesWritten.store(0, std::memory_order_relaxed);
+    m_stopRequested.store(false);
+
+    // Format and interface name are fixed for the whole recording.
+    m_thread = QThread::create([this, binary = m_binaryFormat, interfaceName = m_interfaceName]() {
+        run(binary, interfaceName);
+    });
+    m_thread->setObjectName(QStringLiteral("CanRecorder"));
+    m_thread->start(QThread::LowPriority);
+    m_accepting.store(true, std::memory_order_release);
+
+    m_statsTimer.start(STATS_INTERVAL_MS);
+    emit recordingChanged(true);
+    emit statsChanged();
+    return true;
+}
+
+void CanFrameRecorder::stop()
+{
+    if (!m_thread)
+        return;
+
+    m_accepting.store(false, std::memory_order_release);
+    m_stopRequested.store(true, std::memory_order_release);
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+    m_file.close();
+    m_statsTimer.stop();
+
+    emit statsChanged();
+    emit recordingChanged(false);
+    emit recordingFinished(m_path, framesRecorded(), framesDropped());
+}
+
+void CanFrameRecorder::recordFrame(const QCanBusFrame &frame)
+{
+    if (!m_accepting.load(std::memory_order_relaxed))
+        return;
+
+    const quint64 head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+        m_framesDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    CanLogRecord &slot = m_ring[head & RING_MASK];
+    slot = CanLogRecord::fromFrame(frame, 0);
+    if (slot.timestampUs == 0)
+        slot.timestampUs = wallClockUs();
+    m_head.store(head + 1, std::memory_order_release);
+}
+
+// ---------------------------------------------------------------------------
+// Writer thread
+// ---------------------------------------------------------------------------
+
+bool CanFrameRecorder::drain(QByteArray &block, bool binary, const QByteArray &interfaceName)
+{
+    const quint64 tail = m_tail.load(std::memory_order_relaxed);
+    const quint64 head = m_head.load(std::memory_order_acquire);
+    if (head == tail)
+        return false;
+
+    for (quint64 i = tail; i != head; ++i) {
+        const CanLogRecord &record = m_ring[i & RING_MASK];
+        if (binary)
+            CanLog::appendBinaryRecord(block, record);
+        else
+            CanLog::appendCandumpLine(block, record, interfaceName);
+    }
+    m_tail.store(head, std::memory_order_release);
+    m_framesWritten.fetch_add(head - tail, std::memory_order_relaxed);
+    return true;
+}
+
+void CanFrameRecorder::run(bool binary, const QByteArray &interfaceName)
+{
+    QByteArray block;
+    block.reserve(WRITE_BLOCK_SIZE * 2);
+    if (binary)
+        block.append(CanLog::binaryFileHeader());
+
+    bool failed = false;
+    qint64 lastWriteMs = QDateTime::currentMSecsSinceEpoch();
+    const auto writeBlock = [&]() {
+        if (block.isEmpty())
+            return;
+        if (!failed && m_file.write(block) != block.size()) {
+            failed = true;
+            emit errorOccurred(
+                QStringLiteral("CAN recorder: write to %1 failed: %2").arg(m_path, m_file.errorString()));
+        }
+        if (!failed)
+            m_bytesWritten.fetch_add(static_cast<quint64>(block.size()), std::memory_order_relaxed);
+        block.clear();
+        lastWriteMs = QDateTime::currentMSecsSinceEpoch();
+    };
+
+    for (;;) {
+        const bool stop = m_stopRequested.load(std::memory_order_acquire);
+        const bool drained = drain(block, binary, interfaceName);
+        if (block.size() >= WRITE_BLOCK_SIZE || stop
+            || (!block.isEmpty() && QDateTime::currentMSecsSinceEpoch() - lastWriteMs >= PARTIAL_FLUSH_INTERVAL_MS))
+            writeBlock();
+        if (stop)
+            break;
+        if (!drained)
+            QThread::msleep(IDLE_SLEEP_MS);
+    }
+}
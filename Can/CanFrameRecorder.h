@@ -0,0 +1,120 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file CanFrameRecorder.h
+ * @brief Raw CAN bus recorder writing candump (or compact .ptcan) logs from a background thread.
+ *
+ * Frames are taken straight from CanTransport::frameReceived, before any
+ * protocol decoding. The GUI thread copies each frame into a preallocated
+ * single-producer/single-consumer ring (no allocation, no lock); a writer
+ * thread drains the ring, formats the records and writes them in large
+ * blocks. When the writer falls behind the ring fills up and new frames are
+ * counted as dropped instead of growing memory.
+ */
+
+#ifndef CANFRAMERECORDER_H
+#define CANFRAMERECORDER_H
+
+#include "CanLogFormat.h"
+
+#include <QByteArray>
+#include <QCanBusFrame>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include <atomic>
+#include <vector>
+
+class CanTransport;
+class QThread;
+
+class CanFrameRecorder : public QObject
+{
+    Q_OBJECT
+
+    /// Whether frames are currently being recorded
+    Q_PROPERTY(bool recording READ recording WRITE setRecording NOTIFY recordingChanged)
+
+    /// Write .ptcan binary instead of candump text; applied on the next start
+    Q_PROPERTY(bool binaryFormat READ binaryFormat WRITE setBinaryFormat NOTIFY binaryFormatChanged)
+
+    /// Current (or last) recording file
+    Q_PROPERTY(QString filePath READ filePath NOTIFY recordingChanged)
+
+    /// Frames written in the current recording
+    Q_PROPERTY(double framesRecorded READ framesRecorded NOTIFY statsChanged)
+
+    /// Frames dropped because the ring was full
+    Q_PROPERTY(double framesDropped READ framesDropped NOTIFY statsChanged)
+
+    /// Bytes written in the current recording
+    Q_PROPERTY(double bytesWritten READ bytesWritten NOTIFY statsChanged)
+
+public:
+    /// Ring slots (power of two); bounds recorder memory to RING_CAPACITY * sizeof(CanLogRecord)
+    static constexpr int RING_CAPACITY = 8192;
+
+    explicit CanFrameRecorder(QObject *parent = nullptr);
+    ~CanFrameRecorder() override;
+
+    /// Record frames received by @p transport and take the candump interface name from it
+    void attachTransport(CanTransport *transport);
+
+    bool recording() const { return m_thread != nullptr; }
+    void setRecording(bool recording);
+    bool binaryFormat() const { return m_binaryFormat; }
+    void setBinaryFormat(bool binary);
+    QString filePath() const { return m_path; }
+    double framesRecorded() const { return static_cast<double>(m_framesWritten.load(std::memory_order_relaxed)); }
+    double framesDropped() const { return static_cast<double>(m_framesDropped.load(std::memory_order_relaxed)); }
+    double bytesWritten() const { return static_cast<double>(m_bytesWritten.load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief Open the output file and start the writer thread.
+     * @param path Output file; defaults to a timestamped file under the app data directory
+     * @return false if the file could not be opened
+     */
+    Q_INVOKABLE bool start(const QString &path = QString());
+
+    /// Stop accepting frames, drain the ring and close the file
+    Q_INVOKABLE void stop();
+
+public slots:
+    /// Copy one frame into the ring (GUI thread, constant time, no allocation)
+    void recordFrame(const QCanBusFrame &frame);
+
+signals:
+    void recordingChanged(bool recording);
+    void binaryFormatChanged();
+    void statsChanged();
+    void recordingFinished(const QString &path, double frames, double dropped);
+    /// May be emitted from the writer thread
+    void errorOccurred(const QString &message);
+
+private:
+    void run(bool binary, const QByteArray &interfaceName);
+    bool drain(QByteArray &block, bool binary, const QByteArray &interfaceName);
+
+    CanTransport *m_transport = nullptr;
+    QByteArray m_interfaceName = QByteArrayLiteral("can0");
+    bool m_binaryFormat = false;
+    QString m_path;
+    QFile m_file;
+    QThread *m_thread = nullptr;
+    QTimer m_statsTimer;
+
+    // * SPSC ring: m_head is advanced by the GUI thread, m_tail by the writer thread
+    std::vector<CanLogRecord> m_ring;
+    std::atomic<quint64> m_head{0};
+    std::atomic<quint64> m_tail{0};
+    std::atomic<bool> m_accepting{false};
+    std::atomic<bool> m_stopRequested{false};
+
+    std::atomic<quint64> m_framesWritten{0};
+    std::atomic<quint64> m_framesDropped{0};
+    std::atomic<quint64> m_bytesWritten{0};
+};
+
+#endif  // CANFRAMERECORDER_H
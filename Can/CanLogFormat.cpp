@@ -0,0 +1,323 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file CanLogFormat.cpp
+ * @brief candump and .ptcan encodings of raw CAN frames.
+ */
+
+#include "CanLogFormat.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
+constexpr char BINARY_MAGIC[8] = {'P', 'T', 'C', 'A', 'N', 'L', 'G', '\1'};
+constexpr quint32 BINARY_VERSION = 1;
+constexpr quint32 CAN_ERR_FLAG = 0x20000000u;
+
+constexpr quint32 ID_EXTENDED = 1u << 31;
+constexpr quint32 ID_REMOTE = 1u << 30;
+constexpr quint32 ID_ERROR = 1u << 29;
+constexpr quint32 ID_FD = 1u << 28;
+constexpr quint32 ID_BRS = 1u << 27;
+constexpr quint32 ID_ESI = 1u << 26;
+constexpr quint32 ID_MASK = 0x1FFFFFFFu;
+
+void appendHex(char *&out, quint32 value, int digits)
+{
+    for (int shift = (digits - 1) * 4; shift >= 0; shift -= 4)
+        *out++ = HEX_DIGITS[(value >> shift) & 0xF];
+}
+
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+void appendDecimal(char *&out, qint64 value, int minDigits)
+{
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (count < minDigits)
+        digits[count++] = '0';
+    while (count > 0)
+        *out++ = digits[--count];
+}
+}  // namespace
+
+CanLogRecord CanLogRecord::fromFrame(const QCanBusFrame &frame, qint64 fallbackUs)
+{
+    CanLogRecord record;
+    const QCanBusFrame::TimeStamp ts = frame.timeStamp();
+    record.timestampUs = ts.seconds() * 1000000 + ts.microSeconds();
+    if (record.timestampUs == 0)
+        record.timestampUs = fallbackUs;
+
+    record.frameId = frame.frameId();
+    if (frame.hasExtendedFrameFormat())
+        record.flags |= Extended;
+    if (frame.frameType() == QCanBusFrame::RemoteRequestFrame)
+        record.flags |= Remote;
+    if (frame.frameType() == QCanBusFrame::ErrorFrame) {
+        record.flags |= Error;
+        record.frameId = static_cast<quint32>(frame.error().toInt());
+    }
+    if (frame.hasFlexibleDataRateFormat())
+        record.flags |= FlexibleData;
+    if (frame.hasBitrateSwitch())
+        record.flags |= BitrateSwitch;
+    if (frame.hasErrorStateIndicator())
+        record.flags |= ErrorStateIndicator;
+
+    // payload() shares the frame's buffer; only the bytes are copied here.
+    const QByteArray payload = frame.payload();
+    record.length = static_cast<quint8>(qMin<qsizetype>(payload.size(), sizeof(record.data)));
+    std::memcpy(record.data, payload.constData(), record.length);
+    return record;
+}
+
+QCanBusFrame CanLogRecord::toFrame() const
+{
+    QCanBusFrame frame;
+    if (flags & Error) {
+        frame.setFrameType(QCanBusFrame::ErrorFrame);
+        frame.setError(QCanBusFrame::FrameErrors::fromInt(static_cast<int>(frameId)));
+    } else {
+        frame.setFrameId(frameId);
+        frame.setExtendedFrameFormat((flags & Extended) != 0);
+        frame.setFrameType((flags & Remote) ? QCanBusFrame::RemoteRequestFrame : QCanBusFrame::DataFrame);
+    }
+    frame.setFlexibleDataRateFormat((flags & FlexibleData) != 0);
+    frame.setBitrateSwitch((flags & BitrateSwitch) != 0);
+    frame.setErrorStateIndicator((flags & ErrorStateIndicator) != 0);
+    frame.setPayload(QByteArray(reinterpret_cast<const char *>(data), length));
+    frame.setTimeStamp(QCanBusFrame::TimeStamp(timestampUs / 1000000, timestampUs % 1000000));
+    return frame;
+}
+
+namespace CanLog {
+
+void appendCandumpLine(QByteArray &out, const CanLogRecord &record, const QByteArray &interfaceName)
+{
+    // Upper bound: 20 for the timestamp, interface, 15 for id, separators and newline, hex payload.
+    const qsizetype start = out.size();
+    out.resize(start + 48 + interfaceName.size() + 2 * record.length);
+    char *p = out.data() + start;
+
+    *p++ = '(';
+    appendDecimal(p, record.timestampUs / 1000000, 10);
+    *p++ = '.';
+    appendDecimal(p, record.timestampUs % 1000000, 6);
+    *p++ = ')';
+    *p++ = ' ';
+    std::memcpy(p, interfaceName.constData(), interfaceName.size());
+    p += interfaceName.size();
+    *p++ = ' ';
+
+    if (record.flags & CanLogRecord::Error)
+        appendHex(p, record.frameId | CAN_ERR_FLAG, 8);
+    else if (record.flags & CanLogRecord::Extended)
+        appendHex(p, record.frameId, 8);
+    else
+        appendHex(p, record.frameId, 3);
+    *p++ = '#';
+
+    if (record.flags & CanLogRecord::Remote) {
+        *p++ = 'R';
+    } else {
+        if (record.flags & CanLogRecord::FlexibleData) {
+            int fdFlags = 0;
+            if (record.flags & CanLogRecord::BitrateSwitch)
+                fdFlags |= 0x1;
+            if (record.flags & CanLogRecord::ErrorStateIndicator)
+                fdFlags |= 0x2;
+            *p++ = '#';
+            *p++ = HEX_DIGITS[fdFlags];
+        }
+        for (int i = 0; i < record.length; ++i)
+            appendHex(p, record.data[i], 2);
+    }
+    *p++ = '\n';
+    out.resize(p - out.constData());
+}
+
+QByteArray binaryFileHeader()
+{
+    QByteArray header(BINARY_HEADER_SIZE, '\0');
+    std::memcpy(header.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    qToLittleEndian<quint32>(BINARY_VERSION, header.data() + 8);
+    return header;
+}
+
+void appendBinaryRecord(QByteArray &out, const CanLogRecord &record)
+{
+    quint32 id = record.frameId & ID_MASK;
+    if (record.flags & CanLogRecord::Extended)
+        id |= ID_EXTENDED;
+    if (record.flags & CanLogRecord::Remote)
+        id |= ID_REMOTE;
+    if (record.flags & CanLogRecord::Error)
+        id |= ID_ERROR;
+    if (record.flags & CanLogRecord::FlexibleData)
+        id |= ID_FD;
+    if (record.flags & CanLogRecord::BitrateSwitch)
+        id |= ID_BRS;
+    if (record.flags & CanLogRecord::ErrorStateIndicator)
+        id |= ID_ESI;
+
+    const int paddedLength = (record.length + 7) & ~7;
+    const qsizetype start = out.size();
+    out.append(16 + paddedLength, '\0');
+    char *p = out.data() + start;
+    qToLittleEndian<qint64>(record.timestampUs, p);
+    qToLittleEndian<quint32>(id, p + 8);
+    p[12] = static_cast<char>(record.length);
+    std::memcpy(p + 16, record.data, record.length);
+}
+
+bool parseCandumpLine(const char *line, qsizetype length, CanLogRecord &record)
+{
+    const char *p = line;
+    const char *end = line + length;
+    while (end > p && (end[-1] == '\r' || end[-1] == ' '))
+        --end;
+    while (p < end && *p == ' ')
+        ++p;
+    if (p == end || *p++ != '(')
+        return false;
+
+    // * Timestamp "(seconds.fraction)"; the fraction is normally 6 digits but is scaled either way
+    qint64 seconds = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+        seconds = seconds * 10 + (*p++ - '0');
+    qint64 micros = 0;
+    int fractionDigits = 0;
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (fractionDigits < 6) {
+                micros = micros * 10 + (*p - '0');
+                ++fractionDigits;
+            }
+            ++p;
+        }
+    }
+    for (; fractionDigits < 6; ++fractionDigits)
+        micros *= 10;
+    if (p == end || *p++ != ')')
+        return false;
+
+    // * Interface name
+    while (p < end && *p == ' ')
+        ++p;
+    while (p < end && *p != ' ')
+        ++p;
+    while (p < end && *p == ' ')
+        ++p;
+
+    // * Identifier: 3 hex digits for standard frames, 8 for extended and error frames
+    const char *idStart = p;
+    quint32 id = 0;
+    int digit = 0;
+    while (p < end && (digit = hexValue(*p)) >= 0) {
+        id = (id << 4) | static_cast<quint32>(digit);
+        ++p;
+    }
+    const qsizetype idDigits = p - idStart;
+    if (idDigits == 0 || idDigits > 8 || p == end || *p++ != '#')
+        return false;
+
+    record = CanLogRecord();
+    record.timestampUs = seconds * 1000000 + micros;
+    if (idDigits > 3) {
+        if (id & CAN_ERR_FLAG)
+            record.flags |= CanLogRecord::Error;
+        else
+            record.flags |= CanLogRecord::Extended;
+        id &= ID_MASK;
+    }
+    record.frameId = id;
+
+    if (p < end && *p == 'R') {
+        record.flags |= CanLogRecord::Remote;
+        return true;
+    }
+    if (p < end && *p == '#') {
+        ++p;
+        const int fdFlags = p < end ? hexValue(*p++) : -1;
+        if (fdFlags < 0)
+            return false;
+        record.flags |= CanLogRecord::FlexibleData;
+        if (fdFlags & 0x1)
+            record.flags |= CanLogRecord::BitrateSwitch;
+        if (fdFlags & 0x2)
+            record.flags |= CanLogRecord::ErrorStateIndicator;
+    }
+
+    // * Payload: hex pairs, optionally separated by '.'; anything after it (e.g. "_<dlc>") is ignored
+    const int maxLength = (record.flags & CanLogRecord::FlexibleData) ? 64 : 8;
+    while (p + 1 < end && record.length < maxLength) {
+        if (*p == '.') {
+            ++p;
+            continue;
+        }
+        const int high = hexValue(p[0]);
+        const int low = hexValue(p[1]);
+        if (high < 0 || low < 0)
+            break;
+        record.data[record.length++] = static_cast<quint8>((high << 4) | low);
+        p += 2;
+    }
+    return true;
+}
+
+bool isBinaryLog(const uchar *data, qsizetype size)
+{
+    return size >= BINARY_HEADER_SIZE && std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0
+           && qFromLittleEndian<quint32>(data + 8) == BINARY_VERSION;
+}
+
+qsizetype readBinaryRecord(const uchar *data, qsizetype available, CanLogRecord &record)
+{
+    if (available < 16)
+        return 0;
+
+    const quint32 id = qFromLittleEndian<quint32>(data + 8);
+    const int length = qMin<int>(data[12], sizeof(record.data));
+    const qsizetype size = 16 + ((length + 7) & ~7);
+    if (available < size)
+        return 0;
+
+    record = CanLogRecord();
+    record.timestampUs = qFromLittleEndian<qint64>(data);
+    record.frameId = id & ID_MASK;
+    if (id & ID_EXTENDED)
+        record.flags |= CanLogRecord::Extended;
+    if (id & ID_REMOTE)
+        record.flags |= CanLogRecord::Remote;
+    if (id & ID_ERROR)
+        record.flags |= CanLogRecord::Error;
+    if (id & ID_FD)
+        record.flags |= CanLogRecord::FlexibleData;
+    if (id & ID_BRS)
+        record.flags |= CanLogRecord::BitrateSwitch;
+    if (id & ID_ESI)
+        record.flags |= CanLogRecord::ErrorStateIndicator;
+    record.length = static_cast<quint8>(length);
+    std::memcpy(record.data, data + 16, length);
+    return size;
+}
+
+}  // namespace CanLog
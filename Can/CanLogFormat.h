@@ -0,0 +1,92 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file CanLogFormat.h
+ * @brief Raw CAN frame records and their on-disk encodings.
+ *
+ * Two encodings are supported:
+ *
+ * - candump log format, as written by `candump -L` and read by can-utils
+ *   (`canplayer`, `log2asc`, ...):
+ *       (1712345678.123456) can0 123#DEADBEEF
+ *       (1712345678.123789) can0 18FF50E5#0102030405060708
+ *       (1712345678.124000) can0 123#R
+ *       (1712345678.124100) can0 123##1DEADBEEF        (CAN FD, flags nibble)
+ *
+ * - .ptcan compact binary: a 16-byte file header ("PTCANLG\1", quint32
+ *   version, quint32 reserved) followed by little-endian records of
+ *       qint64  timestampUs
+ *       quint32 id          bit 31 extended, 30 remote, 29 error, 28 FD, 27 BRS, 26 ESI
+ *       quint8  length
+ *       quint8  reserved[3]
+ *       payload padded to a multiple of 8 bytes
+ *   A classic 8-byte frame takes 24 bytes instead of ~45 as text.
+ *
+ * Both encodings can be parsed back for replay (see CanReplaySource).
+ */
+
+#ifndef CANLOGFORMAT_H
+#define CANLOGFORMAT_H
+
+#include <QByteArray>
+#include <QCanBusFrame>
+
+/// One raw frame, fixed size so it can live in a preallocated ring.
+struct CanLogRecord
+{
+    enum Flag : quint8 {
+        Extended = 0x01,
+        Remote = 0x02,
+        Error = 0x04,
+        FlexibleData = 0x08,
+        BitrateSwitch = 0x10,
+        ErrorStateIndicator = 0x20,
+    };
+
+    qint64 timestampUs = 0;  ///< Receive time in microseconds since the Unix epoch
+    quint32 frameId = 0;
+    quint8 flags = 0;
+    quint8 length = 0;
+    quint8 data[64] = {};
+
+    /**
+     * @brief Copy @p frame into a record without allocating.
+     * @param fallbackUs Timestamp used when the backend did not provide one
+     */
+    static CanLogRecord fromFrame(const QCanBusFrame &frame, qint64 fallbackUs);
+
+    /// Rebuild a QCanBusFrame (including its timestamp)
+    QCanBusFrame toFrame() const;
+};
+
+namespace CanLog {
+constexpr int BINARY_HEADER_SIZE = 16;
+
+/// Append one candump -L line (with trailing newline) for @p record
+void appendCandumpLine(QByteArray &out, const CanLogRecord &record, const QByteArray &interfaceName);
+
+/// File header for the .ptcan binary encoding
+QByteArray binaryFileHeader();
+
+/// Append one .ptcan record for @p record
+void appendBinaryRecord(QByteArray &out, const CanLogRecord &record);
+
+/**
+ * @brief Parse one candump -L line (without the trailing newline).
+ *
+ * Trailing carriage returns and fields after the payload are ignored.
+ * @return false for blank, comment or malformed lines
+ */
+bool parseCandumpLine(const char *line, qsizetype length, CanLogRecord &record);
+
+/// True if @p data starts with a .ptcan file header of a supported version
+bool isBinaryLog(const uchar *data, qsizetype size);
+
+/**
+ * @brief Decode the .ptcan record at @p data.
+ * @return Bytes consumed, or 0 if fewer than a whole record remain (truncated file)
+ */
+qsizetype readBinaryRecord(const uchar *data, qsizetype available, CanLogRecord &record);
+}  // namespace CanLog
+
+#endif  // CANLOGFORMAT_H
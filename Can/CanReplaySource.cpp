@@ -0,0 +1,170 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file CanReplaySource.cpp
+ * @brief Implementation of the CanReplaySource class.
+ */
+
+#include "CanReplaySource.h"
+
+#include "../Core/TraceRecorder.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace {
+/// Frames emitted per event-loop pass; keeps the GUI responsive in as-fast-as-possible mode
+constexpr int MAX_FRAMES_PER_PASS = 512;
+
+qint64 wallClockUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
+CanReplaySource::CanReplaySource(QObject *parent) : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &CanReplaySource::replayDue);
+}
+
+CanReplaySource::~CanReplaySource()
+{
+    close();
+}
+
+bool CanReplaySource::open(const QString &path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = QStringLiteral("Cannot open CAN log %1: %2").arg(path, m_file.errorString());
+        return false;
+    }
+    m_size = m_file.size();
+    m_data = m_size > 0 ? m_file.map(0, m_size) : nullptr;
+    if (!m_data) {
+        m_error = QStringLiteral("Cannot map CAN log %1").arg(path);
+        m_file.close();
+        return false;
+    }
+
+    m_binary = CanLog::isBinaryLog(m_data, m_size);
+    m_error.clear();
+    return true;
+}
+
+void CanReplaySource::close()
+{
+    stop();
+    if (m_data)
+        m_file.unmap(const_cast<uchar *>(m_data));
+    m_data = nullptr;
+    m_size = 0;
+    m_offset = 0;
+    m_file.close();
+}
+
+void CanReplaySource::setSpeed(double speed)
+{
+    m_speed = speed > 0.0 ? speed : AS_FAST_AS_POSSIBLE;
+}
+
+void CanReplaySource::start()
+{
+    if (!m_data)
+        return;
+
+    m_offset = m_binary ? CanLog::BINARY_HEADER_SIZE : 0;
+    m_framesReplayed = 0;
+    m_recordsSkipped = 0;
+    m_elapsedUs = 0;
+    m_hasPending = readNext(m_pending);
+    m_firstTimestampUs = m_pending.timestampUs;
+    m_startWallUs = wallClockUs();
+    m_clock.start();
+    m_running = true;
+    m_timer.start(0);
+}
+
+void CanReplaySource::stop()
+{
+    m_timer.stop();
+    m_running = false;
+    m_hasPending = false;
+}
+
+bool CanReplaySource::readNext(CanLogRecord &record)
+{
+    while (m_offset < m_size) {
+        const uchar *p = m_data + m_offset;
+        const qint64 available = m_size - m_offset;
+
+        if (m_binary) {
+            const qsizetype used = CanLog::readBinaryRecord(p, available, record);
+            if (used == 0) {
+                // Truncated trailing record, e.g. after power loss while recording.
+                ++m_recordsSkipped;
+                m_offset = m_size;
+                return false;
+            }
+            m_offset += used;
+            return true;
+        }
+
+        const void *newline = std::memchr(p, '\n', static_cast<size_t>(available));
+        const qint64 length = newline ? static_cast<const uchar *>(newline) - p : available;
+        m_offset += length + 1;
+        if (CanLog::parseCandumpLine(reinterpret_cast<const char *>(p), length, record))
+            return true;
+        if (length > 0 && p[0] != '#')
+            ++m_recordsSkipped;
+    }
+    return false;
+}
+
+void CanReplaySource::replayDue()
+{
+    PT_TRACE_SCOPE("can.replayBatch");
+
+    const bool paced = m_speed > 0.0;
+    const qint64 nowUs = m_clock.nsecsElapsed() / 1000;
+    const qint64 batchWallUs = paced ? 0 : wallClockUs();
+    qint64 dueUs = 0;
+
+    for (int emitted = 0; m_running && m_hasPending && emitted < MAX_FRAMES_PER_PASS; ++emitted) {
+        // * Paced frames keep their recorded spacing (scaled), anchored at the wall time replay started
+        qint64 stampUs = batchWallUs;
+        if (paced) {
+            dueUs = static_cast<qint64>((m_pending.timestampUs - m_firstTimestampUs) / m_speed);
+            if (dueUs > nowUs)
+                break;
+            stampUs = m_startWallUs + dueUs;
+        }
+
+        QCanBusFrame frame = m_pending.toFrame();
+        frame.setTimeStamp(QCanBusFrame::TimeStamp(stampUs / 1000000, stampUs % 1000000));
+        emit frameReceived(frame);
+        ++m_framesReplayed;
+        m_hasPending = readNext(m_pending);
+    }
+
+    // A receiver may have stopped or closed the source while frames were emitted.
+    if (!m_running)
+        return;
+
+    m_elapsedUs = m_clock.nsecsElapsed() / 1000;
+    if (!m_hasPending) {
+        m_running = false;
+        emit finished();
+        return;
+    }
+
+    if (paced && dueUs > nowUs)
+        m_timer.start(static_cast<int>(qMax<qint64>(0, (dueUs - m_elapsedUs) / 1000)));
+    else
+        m_timer.start(0);
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file CanReplaySource.h
+ * @brief Plays recorded candump or .ptcan logs back as a stream of CAN frames.
+ *
+ * The log is memory-mapped and decoded one record at a time, so replaying a
+ * long session does not load it into memory. Frames are emitted on the
+ * thread that owns the source, either paced by their recorded timestamps
+ * (optionally scaled by a speed factor) or as fast as the receivers accept
+ * them. In both cases each frame carries the wall-clock time at which it was
+ * "received", as socketcan would stamp it.
+ */
+
+#ifndef CANREPLAYSOURCE_H
+#define CANREPLAYSOURCE_H
+
+#include "CanLogFormat.h"
+
+#include <QCanBusFrame>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+class CanReplaySource : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Speed value that replays without pacing (throughput benchmark)
+    static constexpr double AS_FAST_AS_POSSIBLE = 0.0;
+
+    explicit CanReplaySource(QObject *parent = nullptr);
+    ~CanReplaySource() override;
+
+    /// Map @p path and detect its encoding; any previous log is closed
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    QString errorString() const { return m_error; }
+
+    /// Playback speed relative to the recording; AS_FAST_AS_POSSIBLE (0) disables pacing
+    double speed() const { return m_speed; }
+    void setSpeed(double speed);
+
+    /// Start (or restart) playback from the beginning of the log; frames are emitted from the event loop
+    void start();
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    qint64 framesReplayed() const { return m_framesReplayed; }
+    /// Lines (or trailing bytes) that could not be decoded
+    qint64 recordsSkipped() const { return m_recordsSkipped; }
+    /// Wall time from start() until the last frame was emitted
+    qint64 elapsedUs() const { return m_elapsedUs; }
+
+signals:
+    void frameReceived(const QCanBusFrame &frame);
+    /// Emitted once the end of the log has been replayed
+    void finished();
+
+private slots:
+    void replayDue();
+
+private:
+    bool readNext(CanLogRecord &record);
+
+    QFile m_file;
+    const uchar *m_data = nullptr;
+    qint64 m_size = 0;
+    qint64 m_offset = 0;
+    bool m_binary = false;
+    QString m_error;
+
+    double m_speed = 1.0;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_startWallUs = 0;
+    qint64 m_firstTimestampUs = 0;
+    CanLogRecord m_pending;
+    bool m_hasPending = false;
+    bool m_running = false;
+
+    qint64 m_framesReplayed = 0;
+    qint64 m_recordsSkipped = 0;
+    qint64 m_elapsedUs = 0;
+};
+
+#endif  // CANREPLAYSOURCE_H
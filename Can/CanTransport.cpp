@@ -1,5 +1,8 @@
 #include "CanTransport.h"
 
+#include "../Core/TraceRecorder.h"
+#include "CanReplaySource.h"
+
 #include <QCanBus>
 
 CanTransport::CanTransport(QObject *parent) : QObject(parent) {}
@@ -35,13 +38,24 @@ QString CanTransport::lastError() const
 
 bool CanTransport::isConnected() const
 {
+    if (m_replay)
+        return true;
     return m_device && m_device->state() == QCanBusDevice::ConnectedState;
 }
 
+void CanTransport::setReplayFile(const QString &path, double speed)
+{
+    m_replayPath = path;
+    m_replaySpeed = speed;
+}
+
 bool CanTransport::open()
 {
     close();
 
+    if (isReplay())
+        return openReplay();
+
     if (!socketCanAvailable()) {
         setLastError(QStringLiteral("Qt socketcan plugin is not available"));
         return false;
@@ -69,8 +83,39 @@ bool CanTransport::open()
     return true;
 }
 
+bool CanTransport::openReplay()
+{
+    m_replay = new CanReplaySource(this);
+    if (!m_replay->open(m_replayPath)) {
+        setLastError(m_replay->errorString());
+        delete m_replay;
+        m_replay = nullptr;
+        return false;
+    }
+
+    connect(m_replay, &CanReplaySource::frameReceived, this, &CanTransport::frameReceived);
+    connect(m_replay, &CanReplaySource::finished, this,
+            [this]() { emit replayFinished(m_replay->framesReplayed(), m_replay->elapsedUs()); });
+
+    // Playback begins from the event loop, after the protocol module has attached.
+    m_replay->setSpeed(m_replaySpeed);
+    m_replay->start();
+
+    m_lastError.clear();
+    emit connectionChanged(true);
+    return true;
+}
+
 void CanTransport::close()
 {
+    if (m_replay) {
+        m_replay->close();
+        m_replay->deleteLater();
+        m_replay = nullptr;
+        emit connectionChanged(false);
+        return;
+    }
+
     if (!m_device)
         return;
 
@@ -88,6 +133,8 @@ bool CanTransport::writeFrame(const QCanBusFrame &frame)
         setLastError(QStringLiteral("Cannot write CAN frame while disconnected"));
         return false;
     }
+    if (m_replay)
+        return true;
 
     if (!m_device->writeFrame(frame)) {
         setLastError(m_device->errorString().isEmpty() ? QStringLiteral("Failed to write CAN frame")
@@ -100,6 +147,7 @@ bool CanTransport::writeFrame(const QCanBusFrame &frame)
 
 void CanTransport::onFramesReceived()
 {
+    PT_TRACE_SCOPE("can.rxBatch");
     if (!m_device)
         return;
 
@@ -6,6 +6,8 @@
 #include <QObject>
 #include <QString>
 
+class CanReplaySource;
+
 class CanTransport : public QObject
 {
     Q_OBJECT
@@ -23,6 +25,17 @@ public:
     QString lastError() const;
     bool isConnected() const;
 
+    /**
+     * @brief Replay a candump or .ptcan log instead of opening the socketcan interface.
+     *
+     * Takes effect on the next open(). While replaying, received frames come
+     * from the log, writes are accepted and discarded, and the transport
+     * reports itself connected until closed. An empty @p path restores live mode.
+     * @param speed Playback speed relative to the recording; 0 replays as fast as possible
+     */
+    void setReplayFile(const QString &path, double speed = 1.0);
+    bool isReplay() const { return !m_replayPath.isEmpty(); }
+
     bool open();
     void close();
     bool writeFrame(const QCanBusFrame &frame);
@@ -32,6 +45,8 @@ signals:
     void connectionChanged(bool connected);
     void interfaceNameChanged();
     void errorOccurred(const QString &message);
+    /// The replay log has been played to the end
+    void replayFinished(qint64 frames, qint64 elapsedUs);
 
 private slots:
     void onFramesReceived();
@@ -39,8 +54,12 @@ private slots:
 
 private:
     void setLastError(const QString &message);
+    bool openReplay();
 
     QCanBusDevice *m_device = nullptr;
+    CanReplaySource *m_replay = nullptr;
+    QString m_replayPath;
+    double m_replaySpeed = 1.0;
     QString m_interfaceName = QStringLiteral("can0");
     QString m_lastError;
 };
@@ -9,11 +9,13 @@
 #include "../../Core/Models/SettingsData.h"
 #include "../../Core/Models/VehicleData.h"
 #include "../../Core/SensorRegistry.h"
+#include "../../Core/TraceRecorder.h"
 #include "../../Utils/SteinhartCalculator.h"
 
 #include <QtEndian>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 
 static constexpr int STATUS_MASK = 128;
@@ -21,12 +23,20 @@ static constexpr int FREQUENCY_MASK = 127;
 static constexpr int HZ_AVERAGE_WINDOW = 10;
 static constexpr double DI1_FREQUENCY_SCALE = 16.6666667;
 
+static qint64 wallClockUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
 ExBoardCan::ExBoardCan(QObject *parent)
     : CanInterface(parent),
       m_hzAverage(HZ_AVERAGE_WINDOW, 0),
       m_speedHzAverage(HZ_AVERAGE_WINDOW, 0),
       m_speedFreqAverage(HZ_AVERAGE_WINDOW, 0.0)
-{}
+{
+    initGearConfirmation();
+}
 
 ExBoardCan::ExBoardCan(DigitalInputs *digitalInputs, ExpanderBoardData *expanderBoardData, EngineData *engineData,
                        SettingsData *settingsData, VehicleData *vehicleData, ConnectionData *connectionData,
@@ -41,13 +51,22 @@ ExBoardCan::ExBoardCan(DigitalInputs *digitalInputs, ExpanderBoardData *expander
       m_hzAverage(HZ_AVERAGE_WINDOW, 0),
       m_speedHzAverage(HZ_AVERAGE_WINDOW, 0),
       m_speedFreqAverage(HZ_AVERAGE_WINDOW, 0.0)
-{}
+{
+    initGearConfirmation();
+}
 
 ExBoardCan::~ExBoardCan()
 {
     detachTransport();
 }
 
+void ExBoardCan::initGearConfirmation()
+{
+    m_gearClock.start();
+    m_gearConfirmTimer.setSingleShot(true);
+    connect(&m_gearConfirmTimer, &QTimer::timeout, this, &ExBoardCan::onGearPortVoltageChanged);
+}
+
 QString ExBoardCan::moduleName() const
 {
     return QStringLiteral("ExBoardCan");
@@ -144,6 +163,7 @@ void ExBoardCan::setChannelCalibration(int channel, qreal val0v, qreal val5v, bo
 
 void ExBoardCan::applyCalibration(int channel, qreal voltage)
 {
+    PT_TRACE_SCOPE("exboard.calibration");
     if (!m_expanderBoardData || channel < 0 || channel >= EX_ANALOG_CHANNELS)
         return;
 
@@ -207,6 +227,17 @@ void ExBoardCan::setGearVoltageConfig(const QVariantMap &config)
     m_gearConfig.voltage5 = config.value(QStringLiteral("voltage5"), 3.0).toDouble();
     m_gearConfig.voltage6 = config.value(QStringLiteral("voltage6"), 3.5).toDouble();
 
+    // Nearest configured voltage within the tolerance; -2 = no gear recognised.
+    GearClassifier::Config classifier;
+    classifier.targets = {
+        {0, m_gearConfig.voltageN}, {-1, m_gearConfig.voltageR}, {1, m_gearConfig.voltage1}, {2, m_gearConfig.voltage2},
+        {3, m_gearConfig.voltage3}, {4, m_gearConfig.voltage4},  {5, m_gearConfig.voltage5}, {6, m_gearConfig.voltage6},
+    };
+    classifier.tolerance = m_gearConfig.tolerance;
+    classifier.unknownGear = -2;
+    m_gearClassifier.configure(classifier);
+    m_gearConfirmTimer.stop();
+
     if (m_gearConnection)
         disconnect(m_gearConnection);
 
@@ -248,34 +279,6 @@ void ExBoardCan::setGearVoltageConfig(const QVariantMap &config)
     m_gearConnection = connectGearSignal();
 }
 
-int ExBoardCan::voltageToGear(double voltage) const
-{
-    if (!m_gearConfig.enabled)
-        return -2;
-
-    struct GearEntry
-    {
-        int gear;
-        double targetV;
-    };
-
-    const GearEntry entries[] = {
-        {0, m_gearConfig.voltageN}, {-1, m_gearConfig.voltageR}, {1, m_gearConfig.voltage1}, {2, m_gearConfig.voltage2},
-        {3, m_gearConfig.voltage3}, {4, m_gearConfig.voltage4},  {5, m_gearConfig.voltage5}, {6, m_gearConfig.voltage6},
-    };
-
-    double bestDelta = m_gearConfig.tolerance + 1.0;
-    int bestGear = -2;
-    for (const auto &entry : entries) {
-        const double delta = std::abs(voltage - entry.targetV);
-        if (delta <= m_gearConfig.tolerance && delta < bestDelta) {
-            bestDelta = delta;
-            bestGear = entry.gear;
-        }
-    }
-    return bestGear;
-}
-
 void ExBoardCan::onGearPortVoltageChanged()
 {
     if (!m_gearConfig.enabled || !m_expanderBoardData)
@@ -311,7 +314,16 @@ void ExBoardCan::onGearPortVoltageChanged()
         return;
     }
 
-    const int gear = voltageToGear(voltage);
+    const qint64 nowMs = m_gearClock.elapsed();
+    const bool changed = m_gearClassifier.update(voltage, nowMs);
+    const qint64 pendingMs = m_gearClassifier.pendingMs(nowMs);
+    if (pendingMs >= 0)
+        m_gearConfirmTimer.start(static_cast<int>(pendingMs));
+    else
+        m_gearConfirmTimer.stop();
+    if (!changed)
+        return;
+    const int gear = m_gearClassifier.gear();
     m_expanderBoardData->setEXGear(gear);
     if (m_vehicleData && gear >= -1)
         m_vehicleData->setGear(gear);
@@ -325,11 +337,12 @@ void ExBoardCan::setSpeedSensorConfig(const QVariantMap &config)
         sourceType = QStringLiteral("digital");
     if (sourceType == QLatin1String("analogsquare") || sourceType == QLatin1String("analogfrequency"))
         sourceType = QStringLiteral("analogsquare");
-    if (sourceType != QLatin1String("analog") && sourceType != QLatin1String("digital")
-        && sourceType != QLatin1String("analogsquare")) {
-        sourceType = QStringLiteral("analog");
-    }
-    m_speedConfig.sourceType = sourceType;
+    if (sourceType == QLatin1String("digital"))
+        m_speedConfig.source = SpeedSensorConfig::Source::Digital;
+    else if (sourceType == QLatin1String("analogsquare"))
+        m_speedConfig.source = SpeedSensorConfig::Source::AnalogSquare;
+    else
+        m_speedConfig.source = SpeedSensorConfig::Source::Analog;
     m_speedConfig.analogPort = config.value(QStringLiteral("analogPort"), 0).toInt();
     m_speedConfig.digitalPort = config.value(QStringLiteral("digitalPort"), 0).toInt();
     m_speedConfig.pulsesPerRev = config.value(QStringLiteral("pulsesPerRev"), 4.0).toDouble();
@@ -338,7 +351,10 @@ void ExBoardCan::setSpeedSensorConfig(const QVariantMap &config)
     m_speedConfig.frequencyHysteresis = config.value(QStringLiteral("frequencyHysteresis"), 0.2).toDouble();
     m_speedConfig.tireCircumference = config.value(QStringLiteral("tireCircumference"), 2.06).toDouble();
     m_speedConfig.finalDriveRatio = config.value(QStringLiteral("finalDriveRatio"), 1.0).toDouble();
-    m_speedConfig.unit = config.value(QStringLiteral("unit"), QStringLiteral("MPH")).toString();
+    const Unit unit = parseUnit(config.value(QStringLiteral("unit"), QStringLiteral("MPH")).toString());
+    m_speedConfig.unit = unit == Unit::MilesPerHour ? Unit::MilesPerHour : Unit::KilometersPerHour;
+    m_speedConfig.fromMetersPerSecond = UnitConversion::between(Unit::MetersPerSecond, m_speedConfig.unit);
+    m_speedConfig.toKilometersPerHour = UnitConversion::between(m_speedConfig.unit, Unit::KilometersPerHour);
 
     if (m_speedConnection)
         disconnect(m_speedConnection);
@@ -346,8 +362,7 @@ void ExBoardCan::setSpeedSensorConfig(const QVariantMap &config)
     if (!m_speedConfig.enabled || !m_expanderBoardData)
         return;
 
-    if (m_speedConfig.sourceType == QLatin1String("analog")
-        || m_speedConfig.sourceType == QLatin1String("analogsquare")) {
+    if (m_speedConfig.source != SpeedSensorConfig::Source::Digital) {
         const int port = m_speedConfig.analogPort;
         auto connectSpeedSignal = [this, port]() {
             switch (port) {
@@ -405,8 +420,7 @@ double ExBoardCan::calculateSpeedFromFrequencyHz(double frequencyHz) const
     const double wheelSpeedMps = wheelRps * m_speedConfig.tireCircumference;
     const double corrected =
         (m_speedConfig.finalDriveRatio > 0.0) ? wheelSpeedMps / m_speedConfig.finalDriveRatio : wheelSpeedMps;
-    return (m_speedConfig.unit.compare(QStringLiteral("MPH"), Qt::CaseInsensitive) == 0) ? corrected * 2.23694
-                                                                                           : corrected * 3.6;
+    return m_speedConfig.fromMetersPerSecond.apply(corrected);
 }
 
 double ExBoardCan::speedAnalogVoltage() const
@@ -475,7 +489,7 @@ void ExBoardCan::updateAnalogSquareWaveSpeed(double voltage)
                 for (int i = 0; i < HZ_AVERAGE_WINDOW; ++i)
                     avgHz += m_speedFreqAverage[i];
                 avgHz /= HZ_AVERAGE_WINDOW;
-                m_expanderBoardData->setEXSpeed(calculateSpeedFromFrequencyHz(avgHz));
+                publishSpeed(calculateSpeedFromFrequencyHz(avgHz));
             }
         }
         m_lastSpeedRisingEdgeNs = nowNs;
@@ -483,7 +497,7 @@ void ExBoardCan::updateAnalogSquareWaveSpeed(double voltage)
         const qint64 ageNs = m_speedEdgeTimer.nsecsElapsed() - m_lastSpeedRisingEdgeNs;
         if (ageNs > 800000000) {
             m_speedFreqAverage.fill(0.0);
-            m_expanderBoardData->setEXSpeed(0.0);
+            publishSpeed(0.0);
         }
     }
 
@@ -495,14 +509,21 @@ void ExBoardCan::onSpeedSourceChanged()
     if (!m_speedConfig.enabled || !m_expanderBoardData)
         return;
 
-    if (m_speedConfig.sourceType == QLatin1String("analog")) {
+    if (m_speedConfig.source == SpeedSensorConfig::Source::Analog) {
         const double voltage = speedAnalogVoltage();
-        m_expanderBoardData->setEXSpeed(voltage * m_speedConfig.voltageMultiplier);
-    } else if (m_speedConfig.sourceType == QLatin1String("analogsquare")) {
+        publishSpeed(voltage * m_speedConfig.voltageMultiplier);
+    } else if (m_speedConfig.source == SpeedSensorConfig::Source::AnalogSquare) {
         updateAnalogSquareWaveSpeed(speedAnalogVoltage());
     }
 }
 
+void ExBoardCan::publishSpeed(double speed)
+{
+    m_expanderBoardData->setEXSpeed(speed);
+    emit speedSampled(m_speedConfig.toKilometersPerHour.apply(speed),
+                      m_frameTimestampUs > 0 ? m_frameTimestampUs : wallClockUs());
+}
+
 QString ExBoardCan::byteArrayToHex(const QByteArray &byteArray) const
 {
     QString hexString;
@@ -513,6 +534,12 @@ QString ExBoardCan::byteArrayToHex(const QByteArray &byteArray) const
 
 void ExBoardCan::onFrameReceived(const QCanBusFrame &frame)
 {
+    PT_TRACE_SCOPE("exboard.decode");
+    // Prefer the kernel receive timestamp; fall back to our own clock when the backend does not provide one.
+    const QCanBusFrame::TimeStamp ts = frame.timeStamp();
+    m_frameTimestampUs = ts.seconds() * 1000000 + ts.microSeconds();
+    if (m_frameTimestampUs == 0)
+        m_frameTimestampUs = wallClockUs();
     QString canid = QStringLiteral("0x") + QString::number(static_cast<quint32>(frame.frameId()), 16).toUpper();
     const QString payloadHex = byteArrayToHex(frame.payload());
     emit NewCanFrameReceived(static_cast<int>(frame.frameId()), payloadHex);
@@ -567,7 +594,8 @@ void ExBoardCan::onFrameReceived(const QCanBusFrame &frame)
             }
         }
 
-        if (m_speedConfig.enabled && m_speedConfig.sourceType == QLatin1String("digital") && m_expanderBoardData) {
+        if (m_speedConfig.enabled && m_speedConfig.source == SpeedSensorConfig::Source::Digital
+            && m_expanderBoardData) {
             const int selectedPort = qBound(0, m_speedConfig.digitalPort, 7);
             const int digitalBytes[8] = {byte0, byte1, byte2, byte3, byte4, byte5, byte6, byte7};
             const int rawFrequency = digitalBytes[selectedPort] & FREQUENCY_MASK;
@@ -581,7 +609,7 @@ void ExBoardCan::onFrameReceived(const QCanBusFrame &frame)
 
             const double frequencyHz = avgRaw * DI1_FREQUENCY_SCALE;
             const double speed = calculateSpeedFromFrequencyHz(frequencyHz);
-            m_expanderBoardData->setEXSpeed(speed);
+            publishSpeed(speed);
         }
 
         if (m_sensorRegistry) {
@@ -609,8 +637,7 @@ void ExBoardCan::onFrameReceived(const QCanBusFrame &frame)
                 m_sensorRegistry->markCanSensorActive(QStringLiteral("EXAnalogCalc%1").arg(i));
             }
         }
-        if (m_speedConfig.enabled && (m_speedConfig.sourceType == QLatin1String("analog")
-                                      || m_speedConfig.sourceType == QLatin1String("analogsquare"))
+        if (m_speedConfig.enabled && m_speedConfig.source != SpeedSensorConfig::Source::Digital
             && m_speedConfig.analogPort >= 0 && m_speedConfig.analogPort <= 3) {
             onSpeedSourceChanged();
         }
@@ -629,8 +656,7 @@ void ExBoardCan::onFrameReceived(const QCanBusFrame &frame)
                 m_sensorRegistry->markCanSensorActive(QStringLiteral("EXAnalogCalc%1").arg(i));
             }
         }
-        if (m_speedConfig.enabled && (m_speedConfig.sourceType == QLatin1String("analog")
-                                      || m_speedConfig.sourceType == QLatin1String("analogsquare"))
+        if (m_speedConfig.enabled && m_speedConfig.source != SpeedSensorConfig::Source::Digital
             && m_speedConfig.analogPort >= 4 && m_speedConfig.analogPort <= 7) {
             onSpeedSourceChanged();
         }
@@ -642,6 +668,9 @@ void ExBoardCan::onFrameReceived(const QCanBusFrame &frame)
             m_engineData->setrpm(qRound((pkgpayload[0] * 8.0) / cylinders));
         }
     }
+
+    // Speed published outside a frame (settings changes, playback) is stamped with the current time.
+    m_frameTimestampUs = 0;
 }
 
 void ExBoardCan::setRpmSource(int source)
@@ -2,12 +2,15 @@
 #define EXBOARDCAN_H
 
 #include "../../Can/CanInterface.h"
+#include "../../Utils/GearClassifier.h"
+#include "../../Utils/UnitConversion.h"
 
 #include <QByteArray>
 #include <QCanBusFrame>
 #include <QElapsedTimer>
 #include <QMetaObject>
 #include <QString>
+#include <QTimer>
 #include <QVariantMap>
 #include <QVector>
 
@@ -51,8 +54,14 @@ struct GearVoltageConfig
 
 struct SpeedSensorConfig
 {
+    enum class Source {
+        Analog,        ///< Voltage proportional to speed
+        AnalogSquare,  ///< Square wave on an analog input
+        Digital,       ///< Frequency counted by the EX board on a digital input
+    };
+
     bool enabled = false;
-    QString sourceType = QStringLiteral("analog");
+    Source source = Source::Analog;
     int analogPort = 0;
     int digitalPort = 0;
     double pulsesPerRev = 4.0;
@@ -61,7 +70,10 @@ struct SpeedSensorConfig
     double frequencyHysteresis = 0.2;
     double tireCircumference = 2.06;
     double finalDriveRatio = 1.0;
-    QString unit = QStringLiteral("MPH");
+    Unit unit = Unit::MilesPerHour;  ///< Unit EXSpeed is published in
+    /// Precompiled from unit when the config is set
+    UnitConversion fromMetersPerSecond = UnitConversion::between(Unit::MetersPerSecond, Unit::MilesPerHour);
+    UnitConversion toKilometersPerHour = UnitConversion::between(Unit::MilesPerHour, Unit::KilometersPerHour);
 };
 
 class ExBoardCan : public CanInterface
@@ -109,6 +121,12 @@ signals:
     void baseIdsChanged();
     void NewCanFrameReceived(int canId, QString payload);
     void Newtestsignal();
+    /**
+     * @brief Every speed computation, including unchanged values (EXSpeedChanged only fires on change).
+     * @param speedKph Speed in km/h, whatever unit EXSpeed is configured for
+     * @param timestampUs Receive time of the CAN frame it came from (epoch microseconds)
+     */
+    void speedSampled(qreal speedKph, qint64 timestampUs);
 
 private slots:
     void onFrameReceived(const QCanBusFrame &frame);
@@ -116,11 +134,12 @@ private slots:
 private:
     void applyCalibration(int channel, qreal voltage);
     QString byteArrayToHex(const QByteArray &byteArray) const;
-    int voltageToGear(double voltage) const;
     double calculateSpeedFromFrequencyHz(double frequencyHz) const;
     double speedAnalogVoltage() const;
     void updateAnalogSquareWaveSpeed(double voltage);
+    void publishSpeed(double speed);
     void onGearPortVoltageChanged();
+    void initGearConfirmation();
     void onSpeedSourceChanged();
 
     CanTransport *m_transport = nullptr;
@@ -158,9 +177,13 @@ private:
     qint64 m_lastSpeedRisingEdgeNs = -1;
     bool m_analogSpeedStateInitialized = false;
     bool m_analogSpeedHigh = false;
+    qint64 m_frameTimestampUs = 0;  ///< Receive time of the frame being decoded; 0 between frames
 
     ChannelCalibration m_calibration[EX_ANALOG_CHANNELS];
     GearVoltageConfig m_gearConfig;
+    GearClassifier m_gearClassifier;  ///< Built from m_gearConfig
+    QElapsedTimer m_gearClock;
+    QTimer m_gearConfirmTimer;  ///< Re-reads the port once a pending gear is due (the port only signals changes)
     SpeedSensorConfig m_speedConfig;
     int m_rpmSource = 0;
     QMetaObject::Connection m_gearConnection;
@@ -0,0 +1,292 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file FrameTimingMonitor.cpp
+ * @brief Implementation of the FrameTimingMonitor class.
+ */
+
+#include "FrameTimingMonitor.h"
+
+#include "DiagnosticsProvider.h"
+#include "TraceRecorder.h"
+
+#include <QMutexLocker>
+#include <QQuickWindow>
+#include <QScreen>
+
+#include <algorithm>
+
+namespace {
+// Gaps longer than this are the scene graph idling (nothing to redraw), not jank.
+constexpr qint64 kIdleGapNs = 250 * 1000 * 1000;
+
+double nsToMs(qint64 ns)
+{
+    return static_cast<double>(ns) / 1.0e6;
+}
+
+qint64 percentile(QVector<qint64> &values, double fraction)
+{
+    if (values.isEmpty())
+        return 0;
+    const int index = qBound(0, static_cast<int>(fraction * (values.size() - 1) + 0.5), values.size() - 1);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values.at(index);
+}
+}  // namespace
+
+FrameTimingMonitor::FrameTimingMonitor(QObject *parent) : QObject(parent)
+{
+    m_ring.resize(SAMPLE_WINDOW);
+    connect(&m_publishTimer, &QTimer::timeout, this, &FrameTimingMonitor::publishStats);
+}
+
+FrameTimingMonitor::~FrameTimingMonitor()
+{
+    disconnectWindow();
+}
+
+void FrameTimingMonitor::attachWindow(QQuickWindow *window)
+{
+    if (m_window == window)
+        return;
+
+    disconnectWindow();
+    m_window = window;
+    updateVsyncInterval();
+    updateHooks();
+}
+
+void FrameTimingMonitor::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled)
+        return;
+
+    m_enabled = enabled;
+    if (m_enabled) {
+        reset();
+        // The scratch state belongs to the render thread, which may be mid-frame: let it clear it.
+        m_scratchResetPending.store(true, std::memory_order_release);
+        m_publishClock.start();
+        m_publishTimer.start(PUBLISH_INTERVAL_MS);
+    } else {
+        m_publishTimer.stop();
+    }
+    updateHooks();
+    emit enabledChanged();
+}
+
+void FrameTimingMonitor::setTraceHooksEnabled(bool enabled)
+{
+    if (m_traceHooksEnabled == enabled)
+        return;
+
+    m_traceHooksEnabled = enabled;
+    updateHooks();
+}
+
+void FrameTimingMonitor::setLogEnabled(bool enabled)
+{
+    if (m_logEnabled == enabled)
+        return;
+
+    m_logEnabled = enabled;
+    emit logEnabledChanged();
+}
+
+QString FrameTimingMonitor::summaryText() const
+{
+    return QStringLiteral("Frames: %1 fps, p50 %2 ms, p95 %3 ms, p99 %4 ms, max %5 ms, "
+                          "sync %6 ms, render %7 ms, swap %8 ms, dropped %9")
+        .arg(m_frameRate, 0, 'f', 1)
+        .arg(m_frameP50Ms, 0, 'f', 2)
+        .arg(m_frameP95Ms, 0, 'f', 2)
+        .arg(m_frameP99Ms, 0, 'f', 2)
+        .arg(m_frameMaxMs, 0, 'f', 2)
+        .arg(m_syncMs, 0, 'f', 2)
+        .arg(m_renderMs, 0, 'f', 2)
+        .arg(m_swapMs, 0, 'f', 2)
+        .arg(m_droppedFrames);
+}
+
+void FrameTimingMonitor::logSummary()
+{
+    if (m_diagnosticsProvider)
+        m_diagnosticsProvider->addLogMessage(QStringLiteral("INFO"), summaryText());
+}
+
+void FrameTimingMonitor::reset()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_ringWritePos = 0;
+        m_ringCount = 0;
+        m_framesSincePublish = 0;
+        m_droppedSincePublish = 0;
+    }
+    m_droppedFrames = 0;
+    m_frameRate = 0.0;
+    m_frameP50Ms = m_frameP95Ms = m_frameP99Ms = m_frameMaxMs = 0.0;
+    m_syncMs = m_renderMs = m_swapMs = 0.0;
+    emit statsChanged();
+}
+
+// ---------------------------------------------------------------------------
+// Window hooks
+// ---------------------------------------------------------------------------
+
+void FrameTimingMonitor::updateHooks()
+{
+    if (m_enabled || m_traceHooksEnabled)
+        connectWindow();
+    else
+        disconnectWindow();
+}
+
+void FrameTimingMonitor::connectWindow()
+{
+    if (!m_window || !m_connections.isEmpty())
+        return;
+
+    // The scene graph emits these from the render thread; DirectConnection keeps
+    // the callbacks on that thread so no event is queued per frame.
+    m_connections.append(connect(m_window, &QQuickWindow::beforeSynchronizing, this,
+                                 &FrameTimingMonitor::onBeforeSynchronizing, Qt::DirectConnection));
+    m_connections.append(connect(m_window, &QQuickWindow::afterSynchronizing, this,
+                                 &FrameTimingMonitor::onAfterSynchronizing, Qt::DirectConnection));
+    m_connections.append(connect(m_window, &QQuickWindow::beforeRendering, this,
+                                 &FrameTimingMonitor::onBeforeRendering, Qt::DirectConnection));
+    m_connections.append(connect(m_window, &QQuickWindow::afterRendering, this,
+                                 &FrameTimingMonitor::onAfterRendering, Qt::DirectConnection));
+    m_connections.append(connect(m_window, &QQuickWindow::frameSwapped, this, &FrameTimingMonitor::onFrameSwapped,
+                                 Qt::DirectConnection));
+    m_connections.append(
+        connect(m_window, &QWindow::screenChanged, this, &FrameTimingMonitor::updateVsyncInterval));
+}
+
+void FrameTimingMonitor::disconnectWindow()
+{
+    for (const QMetaObject::Connection &c : std::as_const(m_connections))
+        disconnect(c);
+    m_connections.clear();
+}
+
+void FrameTimingMonitor::updateVsyncInterval()
+{
+    double refreshRate = 60.0;
+    if (m_window && m_window->screen() && m_window->screen()->refreshRate() > 1.0)
+        refreshRate = m_window->screen()->refreshRate();
+
+    QMutexLocker locker(&m_mutex);
+    m_vsyncIntervalNs = static_cast<qint64>(1.0e9 / refreshRate);
+    m_vsyncIntervalMs = nsToMs(m_vsyncIntervalNs);
+}
+
+void FrameTimingMonitor::onBeforeSynchronizing()
+{
+    m_syncStartNs = TraceRecorder::nowNs();
+}
+
+void FrameTimingMonitor::onAfterSynchronizing()
+{
+    m_syncEndNs = TraceRecorder::nowNs();
+    m_pending.syncNs = m_syncEndNs - m_syncStartNs;
+    PT_TRACE_COMPLETE("qml.sync", m_syncStartNs, m_syncEndNs);
+}
+
+void FrameTimingMonitor::onBeforeRendering()
+{
+    if (m_scratchResetPending.exchange(false, std::memory_order_acquire)) {
+        // No interval or swap phase is measured across the time the monitor was off
+        m_lastSwapNs = 0;
+        m_renderEndNs = 0;
+        m_pending = FrameSample();
+    }
+    m_renderStartNs = TraceRecorder::nowNs();
+}
+
+void FrameTimingMonitor::onAfterRendering()
+{
+    m_renderEndNs = TraceRecorder::nowNs();
+    m_pending.renderNs = m_renderEndNs - m_renderStartNs;
+    PT_TRACE_COMPLETE("qml.render", m_renderStartNs, m_renderEndNs);
+}
+
+void FrameTimingMonitor::onFrameSwapped()
+{
+    const qint64 now = TraceRecorder::nowNs();
+    const qint64 previous = m_lastSwapNs;
+    m_lastSwapNs = now;
+
+    m_pending.swapNs = m_renderEndNs > 0 ? now - m_renderEndNs : 0;
+    if (m_renderEndNs > 0)
+        PT_TRACE_COMPLETE("qml.swap", m_renderEndNs, now);
+    m_pending.intervalNs = previous > 0 ? now - previous : 0;
+    const FrameSample sample = m_pending;
+    m_pending = FrameSample();
+
+    if (sample.intervalNs <= 0 || sample.intervalNs > kIdleGapNs)
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    m_ring[m_ringWritePos] = sample;
+    m_ringWritePos = (m_ringWritePos + 1) % SAMPLE_WINDOW;
+    if (m_ringCount < SAMPLE_WINDOW)
+        ++m_ringCount;
+    ++m_framesSincePublish;
+    if (sample.intervalNs > static_cast<qint64>(m_vsyncIntervalNs * DROP_THRESHOLD)) {
+        // An interval of N vsync periods means N - 1 presentations were missed.
+        const qint64 periods = (sample.intervalNs + m_vsyncIntervalNs / 2) / m_vsyncIntervalNs;
+        m_droppedSincePublish += static_cast<int>(qMax<qint64>(1, periods - 1));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Statistics
+// ---------------------------------------------------------------------------
+
+void FrameTimingMonitor::publishStats()
+{
+    QVector<qint64> intervals;
+    qint64 syncSum = 0;
+    qint64 renderSum = 0;
+    qint64 swapSum = 0;
+    int frames = 0;
+    int dropped = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        intervals.reserve(m_ringCount);
+        for (int i = 0; i < m_ringCount; ++i) {
+            const FrameSample &s = m_ring.at(i);
+            intervals.append(s.intervalNs);
+            syncSum += s.syncNs;
+            renderSum += s.renderNs;
+            swapSum += s.swapNs;
+        }
+        frames = m_framesSincePublish;
+        dropped = m_droppedSincePublish;
+        m_framesSincePublish = 0;
+        m_droppedSincePublish = 0;
+    }
+
+    const qint64 elapsedMs = m_publishClock.restart();
+    m_frameRate = elapsedMs > 0 ? frames * 1000.0 / elapsedMs : 0.0;
+    m_droppedFrames += dropped;
+
+    if (!intervals.isEmpty()) {
+        const double count = intervals.size();
+        m_syncMs = nsToMs(syncSum) / count;
+        m_renderMs = nsToMs(renderSum) / count;
+        m_swapMs = nsToMs(swapSum) / count;
+        m_frameMaxMs = nsToMs(*std::max_element(intervals.cbegin(), intervals.cend()));
+        m_frameP50Ms = nsToMs(percentile(intervals, 0.50));
+        m_frameP95Ms = nsToMs(percentile(intervals, 0.95));
+        m_frameP99Ms = nsToMs(percentile(intervals, 0.99));
+    }
+
+    emit statsChanged();
+
+    if (m_logEnabled && m_diagnosticsProvider && frames > 0)
+        m_diagnosticsProvider->addLogMessage(dropped > 0 ? QStringLiteral("WARN") : QStringLiteral("DEBUG"),
+                                             summaryText());
+}
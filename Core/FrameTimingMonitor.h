@@ -0,0 +1,184 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file FrameTimingMonitor.h
+ * @brief Render-loop frame timing and jank statistics for the Diagnostics page.
+ *
+ * Hooks the scene graph signals of the main QQuickWindow and measures:
+ * - Frame-to-frame interval (frameSwapped to frameSwapped)
+ * - Sync, render, and swap phase durations
+ * - Dropped frames (intervals longer than 1.5 vsync periods)
+ *
+ * The scene graph signals are emitted on the render thread, so samples are
+ * pushed into a small mutex-guarded ring once per frame and reduced to
+ * rolling percentiles on the GUI thread once per second. When disabled, all
+ * window connections are dropped so the render loop carries no overhead.
+ *
+ * The same hooks feed the sync/render/swap phases into TraceRecorder while a
+ * trace is being recorded, so they stay connected during tracing as well.
+ */
+
+#ifndef FRAMETIMINGMONITOR_H
+#define FRAMETIMINGMONITOR_H
+
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QVector>
+
+#include <atomic>
+
+class QQuickWindow;
+class DiagnosticsProvider;
+
+class FrameTimingMonitor : public QObject
+{
+    Q_OBJECT
+
+    /// Whether frame statistics are being collected
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+
+    /// Whether a summary line is written to the Diagnostics log every publish interval
+    Q_PROPERTY(bool logEnabled READ logEnabled WRITE setLogEnabled NOTIFY logEnabledChanged)
+
+    // -- Rolling statistics (last SAMPLE_WINDOW frames) --
+
+    /// Presented frames per second over the last publish interval
+    Q_PROPERTY(double frameRate READ frameRate NOTIFY statsChanged)
+
+    /// Frame interval percentiles in milliseconds
+    Q_PROPERTY(double frameP50Ms READ frameP50Ms NOTIFY statsChanged)
+    Q_PROPERTY(double frameP95Ms READ frameP95Ms NOTIFY statsChanged)
+    Q_PROPERTY(double frameP99Ms READ frameP99Ms NOTIFY statsChanged)
+    Q_PROPERTY(double frameMaxMs READ frameMaxMs NOTIFY statsChanged)
+
+    /// Mean phase durations in milliseconds
+    Q_PROPERTY(double syncMs READ syncMs NOTIFY statsChanged)
+    Q_PROPERTY(double renderMs READ renderMs NOTIFY statsChanged)
+    Q_PROPERTY(double swapMs READ swapMs NOTIFY statsChanged)
+
+    /// Dropped vsync intervals since the monitor was enabled or reset
+    Q_PROPERTY(int droppedFrames READ droppedFrames NOTIFY statsChanged)
+
+    /// Expected frame interval derived from the screen refresh rate
+    Q_PROPERTY(double vsyncIntervalMs READ vsyncIntervalMs NOTIFY statsChanged)
+
+public:
+    explicit FrameTimingMonitor(QObject *parent = nullptr);
+    ~FrameTimingMonitor() override;
+
+    void setDiagnosticsProvider(DiagnosticsProvider *diag) { m_diagnosticsProvider = diag; }
+
+    /**
+     * @brief Attach to the window whose render loop should be measured.
+     * @param window Main application window (hooks are installed only while enabled)
+     */
+    void attachWindow(QQuickWindow *window);
+
+    bool enabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+    bool logEnabled() const { return m_logEnabled; }
+    void setLogEnabled(bool enabled);
+
+    double frameRate() const { return m_frameRate; }
+    double frameP50Ms() const { return m_frameP50Ms; }
+    double frameP95Ms() const { return m_frameP95Ms; }
+    double frameP99Ms() const { return m_frameP99Ms; }
+    double frameMaxMs() const { return m_frameMaxMs; }
+    double syncMs() const { return m_syncMs; }
+    double renderMs() const { return m_renderMs; }
+    double swapMs() const { return m_swapMs; }
+    int droppedFrames() const { return m_droppedFrames; }
+    double vsyncIntervalMs() const { return m_vsyncIntervalMs; }
+
+    /// One-line summary of the current statistics (used for logging)
+    Q_INVOKABLE QString summaryText() const;
+
+    /// Write the current summary to the Diagnostics log
+    Q_INVOKABLE void logSummary();
+
+    /// Clear the sample ring and dropped-frame counter
+    Q_INVOKABLE void reset();
+
+public slots:
+    /// Keep the window hooks installed while a trace is recording (feeds the QML frame phase spans)
+    void setTraceHooksEnabled(bool enabled);
+
+signals:
+    void enabledChanged();
+    void logEnabledChanged();
+    void statsChanged();
+
+private slots:
+    void publishStats();
+
+private:
+    struct FrameSample
+    {
+        qint64 intervalNs = 0;
+        qint64 syncNs = 0;
+        qint64 renderNs = 0;
+        qint64 swapNs = 0;
+    };
+
+    void updateHooks();
+    void connectWindow();
+    void disconnectWindow();
+    void updateVsyncInterval();
+
+    // * Render-thread callbacks
+    void onBeforeSynchronizing();
+    void onAfterSynchronizing();
+    void onBeforeRendering();
+    void onAfterRendering();
+    void onFrameSwapped();
+
+    static constexpr int SAMPLE_WINDOW = 600;
+    static constexpr int PUBLISH_INTERVAL_MS = 1000;
+    static constexpr double DROP_THRESHOLD = 1.5;
+
+    QPointer<QQuickWindow> m_window;
+    DiagnosticsProvider *m_diagnosticsProvider = nullptr;
+    QVector<QMetaObject::Connection> m_connections;
+    QTimer m_publishTimer;
+    bool m_enabled = false;
+    bool m_traceHooksEnabled = false;
+    bool m_logEnabled = false;
+
+    // * Render-thread scratch state (only touched from the render thread)
+    qint64 m_syncStartNs = 0;
+    qint64 m_syncEndNs = 0;
+    qint64 m_renderStartNs = 0;
+    qint64 m_renderEndNs = 0;
+    qint64 m_lastSwapNs = 0;
+    FrameSample m_pending;
+    /// Set by setEnabled(); the render thread clears its scratch state in the next onBeforeRendering()
+    std::atomic<bool> m_scratchResetPending{false};
+
+    // * Shared ring (guarded by m_mutex)
+    mutable QMutex m_mutex;
+    QVector<FrameSample> m_ring;
+    int m_ringWritePos = 0;
+    int m_ringCount = 0;
+    int m_framesSincePublish = 0;
+    int m_droppedSincePublish = 0;
+    qint64 m_vsyncIntervalNs = 16666667;
+
+    // * Published statistics (GUI thread)
+    double m_frameRate = 0.0;
+    double m_frameP50Ms = 0.0;
+    double m_frameP95Ms = 0.0;
+    double m_frameP99Ms = 0.0;
+    double m_frameMaxMs = 0.0;
+    double m_syncMs = 0.0;
+    double m_renderMs = 0.0;
+    double m_swapMs = 0.0;
+    int m_droppedFrames = 0;
+    double m_vsyncIntervalMs = 16.667;
+    QElapsedTimer m_publishClock;
+};
+
+#endif  // FRAMETIMINGMONITOR_H
@@ -8,3 +8,83 @@
 #include "GPSData.h"
 
 GPSData::GPSData(QObject *parent) : QObject(parent) {}
+
+void GPSData::setgpsLatitude(double gpsLatitude)
+{
+    if (m_gpsLatitude != gpsLatitude) {
+        m_gpsLatitude = gpsLatitude;
+        emit gpsLatitudeChanged(gpsLatitude);
+    }
+}
+
+void GPSData::setgpsLongitude(double gpsLongitude)
+{
+    if (m_gpsLongitude != gpsLongitude) {
+        m_gpsLongitude = gpsLongitude;
+        emit gpsLongitudeChanged(gpsLongitude);
+    }
+}
+
+void GPSData::setgpsAltitude(qreal gpsAltitude)
+{
+    if (m_gpsAltitude != gpsAltitude) {
+        m_gpsAltitude = gpsAltitude;
+        emit gpsAltitudeChanged(gpsAltitude);
+    }
+}
+
+void GPSData::setgpsSpeed(qreal gpsSpeed)
+{
+    if (m_gpsSpeed != gpsSpeed) {
+        m_gpsSpeed = gpsSpeed;
+        emit gpsSpeedChanged(gpsSpeed);
+    }
+}
+
+void GPSData::setgpsbearing(qreal gpsbearing)
+{
+    if (m_gpsbearing != gpsbearing) {
+        m_gpsbearing = gpsbearing;
+        emit gpsbearingChanged(gpsbearing);
+    }
+}
+
+void GPSData::setgpsVisibleSatelites(int gpsVisibleSatelites)
+{
+    if (m_gpsVisibleSatelites != gpsVisibleSatelites) {
+        m_gpsVisibleSatelites = gpsVisibleSatelites;
+        emit gpsVisibleSatelitesChanged(gpsVisibleSatelites);
+    }
+}
+
+void GPSData::setgpsHDOP(qreal gpsHDOP)
+{
+    if (m_gpsHDOP != gpsHDOP) {
+        m_gpsHDOP = gpsHDOP;
+        emit gpsHDOPChanged(gpsHDOP);
+    }
+}
+
+void GPSData::setgpsFixQuality(int gpsFixQuality)
+{
+    if (m_gpsFixQuality != gpsFixQuality) {
+        m_gpsFixQuality = gpsFixQuality;
+        emit gpsFixQualityChanged(gpsFixQuality);
+    }
+}
+
+void GPSData::setgpsUtcTime(int gpsUtcTime)
+{
+    if (m_gpsUtcTime != gpsUtcTime) {
+        m_gpsUtcTime = gpsUtcTime;
+        emit gpsUtcTimeChanged(gpsUtcTime);
+    }
+}
+
+void GPSData::setgpsTimestamp(qint64 gpsTimestamp)
+{
+    if (m_gpsTimestamp != gpsTimestamp) {
+        m_gpsTimestamp = gpsTimestamp;
+        emit gpsTimestampChanged(gpsTimestamp);
+    }
+}
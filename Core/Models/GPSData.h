@@ -2,7 +2,10 @@
  * @file GPSData.h
  * @brief GPS/Location data model for PowerTune
  *
- * Reserved for future GPS hardware integration.
+ * Fed by GpsReceiver from an NMEA serial receiver. Property names match the
+ * GPS keys registered in SensorRegistry. gpsTimestamp is the receive time
+ * of the latest fix on the same epoch-microsecond clock as CAN frames, so
+ * GPS and CAN samples can be lined up.
  *
  * Part of the DashBoard God Object refactoring (TODO-001)
  */
@@ -16,8 +19,67 @@ class GPSData : public QObject
 {
     Q_OBJECT
 
+    Q_PROPERTY(double gpsLatitude READ gpsLatitude WRITE setgpsLatitude NOTIFY gpsLatitudeChanged)
+    Q_PROPERTY(double gpsLongitude READ gpsLongitude WRITE setgpsLongitude NOTIFY gpsLongitudeChanged)
+    Q_PROPERTY(qreal gpsAltitude READ gpsAltitude WRITE setgpsAltitude NOTIFY gpsAltitudeChanged)
+    Q_PROPERTY(qreal gpsSpeed READ gpsSpeed WRITE setgpsSpeed NOTIFY gpsSpeedChanged)
+    Q_PROPERTY(qreal gpsbearing READ gpsbearing WRITE setgpsbearing NOTIFY gpsbearingChanged)
+    Q_PROPERTY(int gpsVisibleSatelites READ gpsVisibleSatelites WRITE setgpsVisibleSatelites NOTIFY
+                   gpsVisibleSatelitesChanged)
+    Q_PROPERTY(qreal gpsHDOP READ gpsHDOP WRITE setgpsHDOP NOTIFY gpsHDOPChanged)
+    Q_PROPERTY(int gpsFixQuality READ gpsFixQuality WRITE setgpsFixQuality NOTIFY gpsFixQualityChanged)
+    Q_PROPERTY(int gpsUtcTime READ gpsUtcTime WRITE setgpsUtcTime NOTIFY gpsUtcTimeChanged)
+    Q_PROPERTY(qint64 gpsTimestamp READ gpsTimestamp WRITE setgpsTimestamp NOTIFY gpsTimestampChanged)
+
 public:
     explicit GPSData(QObject *parent = nullptr);
+
+    double gpsLatitude() const { return m_gpsLatitude; }
+    double gpsLongitude() const { return m_gpsLongitude; }
+    qreal gpsAltitude() const { return m_gpsAltitude; }
+    qreal gpsSpeed() const { return m_gpsSpeed; }
+    qreal gpsbearing() const { return m_gpsbearing; }
+    int gpsVisibleSatelites() const { return m_gpsVisibleSatelites; }
+    qreal gpsHDOP() const { return m_gpsHDOP; }
+    int gpsFixQuality() const { return m_gpsFixQuality; }
+    int gpsUtcTime() const { return m_gpsUtcTime; }
+    qint64 gpsTimestamp() const { return m_gpsTimestamp; }
+
+public slots:
+    void setgpsLatitude(double gpsLatitude);
+    void setgpsLongitude(double gpsLongitude);
+    void setgpsAltitude(qreal gpsAltitude);
+    void setgpsSpeed(qreal gpsSpeed);
+    void setgpsbearing(qreal gpsbearing);
+    void setgpsVisibleSatelites(int gpsVisibleSatelites);
+    void setgpsHDOP(qreal gpsHDOP);
+    void setgpsFixQuality(int gpsFixQuality);
+    void setgpsUtcTime(int gpsUtcTime);
+    void setgpsTimestamp(qint64 gpsTimestamp);
+
+signals:
+    void gpsLatitudeChanged(double gpsLatitude);
+    void gpsLongitudeChanged(double gpsLongitude);
+    void gpsAltitudeChanged(qreal gpsAltitude);
+    void gpsSpeedChanged(qreal gpsSpeed);
+    void gpsbearingChanged(qreal gpsbearing);
+    void gpsVisibleSatelitesChanged(int gpsVisibleSatelites);
+    void gpsHDOPChanged(qreal gpsHDOP);
+    void gpsFixQualityChanged(int gpsFixQuality);
+    void gpsUtcTimeChanged(int gpsUtcTime);
+    void gpsTimestampChanged(qint64 gpsTimestamp);
+
+private:
+    double m_gpsLatitude = 0;
+    double m_gpsLongitude = 0;
+    qreal m_gpsAltitude = 0;
+    qreal m_gpsSpeed = 0;    ///< km/h
+    qreal m_gpsbearing = 0;  ///< Degrees true
+    int m_gpsVisibleSatelites = 0;
+    qreal m_gpsHDOP = 0;
+    int m_gpsFixQuality = 0;    ///< NMEA GGA fix quality, 0 = no fix
+    int m_gpsUtcTime = -1;      ///< ms since 00:00 UTC of the latest fix, -1 = none
+    qint64 m_gpsTimestamp = 0;  ///< Receive time, epoch microseconds
 };
 
 #endif  // GPSDATA_H
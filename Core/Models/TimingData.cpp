@@ -115,26 +115,84 @@ void TimingData::setreactiontime(qreal reactiontime)
     }
 }
 
+// * Lap Timer formatting
+QString TimingData::formatLapTime(int ms)
+{
+    if (ms <= 0)
+        return QString();
+    return QStringLiteral("%1:%2.%3")
+        .arg(ms / 60000, 2, 10, QLatin1Char('0'))
+        .arg((ms / 1000) % 60, 2, 10, QLatin1Char('0'))
+        .arg(ms % 1000, 3, 10, QLatin1Char('0'));
+}
+int TimingData::parseLapTime(const QString &text)
+{
+    const qsizetype colon = text.indexOf(QLatin1Char(':'));
+    bool minutesOk = colon > 0;
+    bool secondsOk = false;
+    const int minutes = minutesOk ? text.left(colon).toInt(&minutesOk) : 0;
+    const double seconds = text.mid(colon + 1).toDouble(&secondsOk);
+    if (!secondsOk || (colon > 0 && !minutesOk) || seconds < 0.0)
+        return 0;
+    return minutes * 60000 + qRound(seconds * 1000.0);
+}
+
 // * Setters - Lap Timer
 void TimingData::setlaptime(const QString &laptime)
 {
-    if (m_laptime != laptime) {
-        m_laptime = laptime;
-        emit laptimeChanged(laptime);
-    }
+    setlaptimeMs(parseLapTime(laptime));
 }
 void TimingData::setLastlaptime(const QString &Lastlaptime)
 {
-    if (m_Lastlaptime != Lastlaptime) {
-        m_Lastlaptime = Lastlaptime;
-        emit LastlaptimeChanged(Lastlaptime);
-    }
+    setLastlaptimeMs(parseLapTime(Lastlaptime));
 }
 void TimingData::setbestlaptime(const QString &bestlaptime)
 {
-    if (m_bestlaptime != bestlaptime) {
-        m_bestlaptime = bestlaptime;
-        emit bestlaptimeChanged(bestlaptime);
+    setbestlaptimeMs(parseLapTime(bestlaptime));
+}
+void TimingData::setlaptimeMs(int laptimeMs)
+{
+    if (m_laptimeMs != laptimeMs) {
+        m_laptimeMs = laptimeMs;
+        emit laptimeMsChanged(laptimeMs);
+        emit laptimeChanged();
+    }
+}
+void TimingData::setLastlaptimeMs(int LastlaptimeMs)
+{
+    if (m_LastlaptimeMs != LastlaptimeMs) {
+        m_LastlaptimeMs = LastlaptimeMs;
+        emit LastlaptimeMsChanged(LastlaptimeMs);
+        emit LastlaptimeChanged();
+    }
+}
+void TimingData::setbestlaptimeMs(int bestlaptimeMs)
+{
+    if (m_bestlaptimeMs != bestlaptimeMs) {
+        m_bestlaptimeMs = bestlaptimeMs;
+        emit bestlaptimeMsChanged(bestlaptimeMs);
+        emit bestlaptimeChanged();
+    }
+}
+void TimingData::setlastSectorMs(int lastSectorMs)
+{
+    if (m_lastSectorMs != lastSectorMs) {
+        m_lastSectorMs = lastSectorMs;
+        emit lastSectorMsChanged(lastSectorMs);
+    }
+}
+void TimingData::setcurrentSector(int currentSector)
+{
+    if (m_currentSector != currentSector) {
+        m_currentSector = currentSector;
+        emit currentSectorChanged(currentSector);
+    }
+}
+void TimingData::setlapDelta(qreal lapDelta)
+{
+    if (m_lapDelta != lapDelta) {
+        m_lapDelta = lapDelta;
+        emit lapDeltaChanged(lapDelta);
     }
 }
 void TimingData::setcurrentLap(int currentLap)
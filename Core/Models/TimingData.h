@@ -8,6 +8,11 @@
  * - Reaction time
  * - Lap timing data
  *
+ * Lap and sector times are stored as integer milliseconds (0 = none). The
+ * laptime / Lastlaptime / bestlaptime strings are formatted from them only
+ * when read, so a running lap clock updated per GPS fix costs no string work
+ * unless something displays it.
+ *
  * Part of the DashBoard God Object refactoring (TODO-001)
  */
 
@@ -48,11 +53,18 @@ class TimingData : public QObject
     // * Reaction
     Q_PROPERTY(qreal reactiontime READ reactiontime WRITE setreactiontime NOTIFY reactiontimeChanged)
 
-    // * Lap Timer
+    // * Lap Timer (laptime runs during the lap, Lastlaptime is the last completed lap)
     Q_PROPERTY(QString laptime READ laptime WRITE setlaptime NOTIFY laptimeChanged)
     Q_PROPERTY(QString Lastlaptime READ Lastlaptime WRITE setLastlaptime NOTIFY LastlaptimeChanged)
     Q_PROPERTY(QString bestlaptime READ bestlaptime WRITE setbestlaptime NOTIFY bestlaptimeChanged)
     Q_PROPERTY(int currentLap READ currentLap WRITE setcurrentLap NOTIFY currentLapChanged)
+    Q_PROPERTY(int laptimeMs READ laptimeMs WRITE setlaptimeMs NOTIFY laptimeMsChanged)
+    Q_PROPERTY(int LastlaptimeMs READ LastlaptimeMs WRITE setLastlaptimeMs NOTIFY LastlaptimeMsChanged)
+    Q_PROPERTY(int bestlaptimeMs READ bestlaptimeMs WRITE setbestlaptimeMs NOTIFY bestlaptimeMsChanged)
+    Q_PROPERTY(int lastSectorMs READ lastSectorMs WRITE setlastSectorMs NOTIFY lastSectorMsChanged)
+    Q_PROPERTY(int currentSector READ currentSector WRITE setcurrentSector NOTIFY currentSectorChanged)
+    /// Seconds behind (+) or ahead (-) of the best lap at the same distance into the lap
+    Q_PROPERTY(qreal lapDelta READ lapDelta WRITE setlapDelta NOTIFY lapDeltaChanged)
 
 public:
     explicit TimingData(QObject *parent = nullptr);
@@ -80,10 +92,21 @@ public:
     qreal reactiontime() const { return m_reactiontime; }
 
     // * Getters - Lap Timer
-    QString laptime() const { return m_laptime; }
-    QString Lastlaptime() const { return m_Lastlaptime; }
-    QString bestlaptime() const { return m_bestlaptime; }
+    QString laptime() const { return formatLapTime(m_laptimeMs); }
+    QString Lastlaptime() const { return formatLapTime(m_LastlaptimeMs); }
+    QString bestlaptime() const { return formatLapTime(m_bestlaptimeMs); }
     int currentLap() const { return m_currentLap; }
+    int laptimeMs() const { return m_laptimeMs; }
+    int LastlaptimeMs() const { return m_LastlaptimeMs; }
+    int bestlaptimeMs() const { return m_bestlaptimeMs; }
+    int lastSectorMs() const { return m_lastSectorMs; }
+    int currentSector() const { return m_currentSector; }
+    qreal lapDelta() const { return m_lapDelta; }
+
+    /// "mm:ss.zzz", or an empty string for 0
+    Q_INVOKABLE static QString formatLapTime(int ms);
+    /// Inverse of formatLapTime(); 0 for an empty or malformed string
+    static int parseLapTime(const QString &text);
 
 public slots:
     // * Setters - Drag Strip Times
@@ -108,11 +131,17 @@ public slots:
     // * Setters - Reaction
     void setreactiontime(qreal reactiontime);
 
-    // * Setters - Lap Timer
+    // * Setters - Lap Timer (the string setters parse, e.g. for log playback)
     void setlaptime(const QString &laptime);
     void setLastlaptime(const QString &Lastlaptime);
     void setbestlaptime(const QString &bestlaptime);
     void setcurrentLap(int currentLap);
+    void setlaptimeMs(int laptimeMs);
+    void setLastlaptimeMs(int LastlaptimeMs);
+    void setbestlaptimeMs(int bestlaptimeMs);
+    void setlastSectorMs(int lastSectorMs);
+    void setcurrentSector(int currentSector);
+    void setlapDelta(qreal lapDelta);
 
 signals:
     // * Signals - Drag Strip Times
@@ -138,10 +167,16 @@ signals:
     void reactiontimeChanged(qreal reactiontime);
 
     // * Signals - Lap Timer
-    void laptimeChanged(const QString &laptime);
-    void LastlaptimeChanged(const QString &Lastlaptime);
-    void bestlaptimeChanged(const QString &bestlaptime);
+    void laptimeChanged();
+    void LastlaptimeChanged();
+    void bestlaptimeChanged();
     void currentLapChanged(int currentLap);
+    void laptimeMsChanged(int laptimeMs);
+    void LastlaptimeMsChanged(int LastlaptimeMs);
+    void bestlaptimeMsChanged(int bestlaptimeMs);
+    void lastSectorMsChanged(int lastSectorMs);
+    void currentSectorChanged(int currentSector);
+    void lapDeltaChanged(qreal lapDelta);
 
 private:
     // * Drag Strip Times
@@ -167,10 +202,13 @@ private:
     qreal m_reactiontime = 0;
 
     // * Lap Timer
-    QString m_laptime;
-    QString m_Lastlaptime;
-    QString m_bestlaptime;
+    int m_laptimeMs = 0;
+    int m_LastlaptimeMs = 0;
+    int m_bestlaptimeMs = 0;
     int m_currentLap = 0;
+    int m_lastSectorMs = 0;
+    int m_currentSector = 0;
+    qreal m_lapDelta = 0;
 };
 
 #endif  // TIMINGDATA_H
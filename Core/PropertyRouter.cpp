@@ -22,6 +22,7 @@
 #include "Models/UIState.h"
 #include "Models/VehicleData.h"
 #include "SensorRegistry.h"
+#include "TraceRecorder.h"
 
 #include <QDebug>
 #include <QMetaMethod>
@@ -107,7 +108,8 @@ void PropertyRouter::connectModelSignals(QObject *model)
         int signalIndex = notifySignal.methodIndex();
 
         // * Record the mapping: (model, signalIndex) -> (propertyName, propertyIndex)
-        m_signalToPropertyMap[model][signalIndex] = SignalPropertyInfo{propName, i};
+        m_signalToPropertyMap[model][signalIndex] =
+            SignalPropertyInfo{propName, i, m_displayConversions.value(propName)};
 
         // * Connect the model's NOTIFY signal to our relay slot
         QObject::connect(model, notifySignal, this, relaySlot);
@@ -140,6 +142,7 @@ void PropertyRouter::disconnectModel(QObject *model)
 
 void PropertyRouter::onModelPropertyChanged()
 {
+    PT_TRACE_SCOPE("router.emit");
     QObject *model = sender();
     if (!model)
         return;
@@ -161,6 +164,8 @@ void PropertyRouter::onModelPropertyChanged()
         return;
 
     QVariant val = model->metaObject()->property(info.propertyIndex).read(model);
+    if (!info.displayConversion.isIdentity())
+        val = info.displayConversion.apply(val.toDouble());
     emit valueChanged(info.propertyName, val);
 
     const QStringList aliases = m_reverseAliases.value(info.propertyName);
@@ -189,6 +194,9 @@ QVariant PropertyRouter::getValue(const QString &propertyName) const
     QVariant val = model->property(resolvedProperty.toLatin1().constData());
     if (!val.isValid())
         return QVariant(0);
+    const auto conversion = m_displayConversions.constFind(resolvedProperty);
+    if (conversion != m_displayConversions.constEnd())
+        return conversion->apply(val.toDouble());
     return val;
 }
 
@@ -293,7 +301,50 @@ QString PropertyRouter::resolveAlias(const QString &key) const
 
 void PropertyRouter::setSensorRegistry(SensorRegistry *sensorRegistry)
 {
+    if (m_sensorRegistry)
+        disconnect(m_sensorRegistry, nullptr, this, nullptr);
     m_sensorRegistry = sensorRegistry;
+    if (m_sensorRegistry)
+        connect(m_sensorRegistry, &SensorRegistry::sensorsChanged, this, &PropertyRouter::refreshDisplayConversions);
+    refreshDisplayConversions();
+}
+
+void PropertyRouter::refreshDisplayConversions()
+{
+    m_displayConversions.clear();
+    if (m_sensorRegistry) {
+        const QStringList keys = m_sensorRegistry->sensorKeys();
+        for (const QString &key : keys) {
+            const UnitConversion conversion = m_sensorRegistry->displayConversion(key);
+            if (!conversion.isIdentity())
+                m_displayConversions.insert(key, conversion);
+        }
+    }
+
+    for (auto modelIt = m_signalToPropertyMap.begin(); modelIt != m_signalToPropertyMap.end(); ++modelIt) {
+        for (auto it = modelIt->begin(); it != modelIt->end(); ++it)
+            it->displayConversion = m_displayConversions.value(it->propertyName);
+    }
+}
+
+bool PropertyRouter::resolveProperty(const QString &propertyName, QObject **model, int *propertyIndex) const
+{
+    const QString resolvedProperty = resolveAlias(propertyName);
+    auto it = m_propertyModelMap.constFind(resolvedProperty);
+    if (it == m_propertyModelMap.constEnd())
+        return false;
+
+    QObject *owner = modelForType(it.value());
+    if (!owner)
+        return false;
+
+    const int index = owner->metaObject()->indexOfProperty(resolvedProperty.toLatin1().constData());
+    if (index < 0)
+        return false;
+
+    *model = owner;
+    *propertyIndex = index;
+    return true;
 }
 
 QObject *PropertyRouter::modelForType(ModelType type) const
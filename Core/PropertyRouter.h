@@ -9,11 +9,17 @@
  * Reactive binding: The valueChanged() signal fires whenever any model
  * property with a NOTIFY signal changes. QML overlays use a Connections
  * block to filter by property name and update their local value cache.
+ *
+ * Values of registered sensors are published in their display unit: the
+ * SensorRegistry's precompiled conversion is stored with each relayed
+ * property and applied as one multiply-add per change.
  */
 
 #ifndef PROPERTYROUTER_H
 #define PROPERTYROUTER_H
 
+#include "../Utils/UnitConversion.h"
+
 #include <QHash>
 #include <QMetaProperty>
 #include <QObject>
@@ -67,7 +73,7 @@ public:
     /**
      * @brief Get a property value by name from the appropriate model
      * @param propertyName The name of the property to retrieve
-     * @return The property value as QVariant, or 0 if not found
+     * @return The property value as QVariant (in its display unit), or 0 if not found
      *
      * Usage in QML:
      *   PropertyRouter.getValue("rpm")      // Returns Engine.rpm
@@ -103,6 +109,20 @@ public:
     Q_INVOKABLE bool isAlias(const QString &key) const;
     Q_INVOKABLE QString resolveAlias(const QString &key) const;
     void setSensorRegistry(SensorRegistry *sensorRegistry);
+
+    /**
+     * @brief Resolve a property key (or alias) to its owning model and meta-property
+     * @param propertyName Property or alias key
+     * @param model Receives the owning model
+     * @param propertyIndex Receives the index into model->metaObject()
+     * @return false if the key is unknown or its model is not set
+     *
+     * Lets C++ consumers read or watch a property directly without going
+     * through the string-keyed valueChanged() relay. Values read this way
+     * are in the sensor's canonical unit.
+     */
+    bool resolveProperty(const QString &propertyName, QObject **model, int *propertyIndex) const;
+
     void connectModel(QObject *model);
     void disconnectModel(QObject *model);
 
@@ -127,6 +147,9 @@ private slots:
      */
     void onModelPropertyChanged();
 
+    /// Pick up the registry's display conversions after a unit or sensor change
+    void refreshDisplayConversions();
+
 private:
     // * Initialize the property to model mappings
     void initializePropertyMappings();
@@ -177,6 +200,7 @@ private:
     QHash<QString, QStringList> m_reverseAliases;  // sourceKey -> alias keys
     mutable QSet<QString> m_activeProperties;
     QSet<QObject *> m_connectedModels;
+    QHash<QString, UnitConversion> m_displayConversions;  ///< Non-identity conversions only
 
     /**
      * @struct SignalPropertyInfo
@@ -186,6 +210,7 @@ private:
     {
         QString propertyName;
         int propertyIndex;
+        UnitConversion displayConversion;
     };
 
     /**
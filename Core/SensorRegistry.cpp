@@ -7,6 +7,7 @@
 
 #include "SensorRegistry.h"
 
+#include "TraceRecorder.h"
 #include "appsettings.h"
 
 #include <QDateTime>
@@ -14,6 +15,8 @@
 #include <QMetaEnum>
 #include <QSettings>
 
+#include <cmath>
+
 /// CAN sensor timeout threshold in milliseconds (10 seconds)
 static constexpr qint64 kCanTimeoutMs = 10000;
 
@@ -38,6 +41,50 @@ void SensorRegistry::setAppSettings(AppSettings *settings)
     m_appSettings = settings;
 }
 
+void SensorRegistry::setUnitPreferences(const UnitPreferences &preferences)
+{
+    m_unitPreferences = preferences;
+    for (auto it = m_sensors.begin(); it != m_sensors.end(); ++it)
+        compileUnit(*it);
+    scheduleSensorsChanged();
+}
+
+UnitConversion SensorRegistry::displayConversion(const QString &key) const
+{
+    const auto it = m_sensors.constFind(key);
+    return it != m_sensors.constEnd() ? it->displayConversion : UnitConversion();
+}
+
+QString SensorRegistry::canonicalUnit(const QString &key) const
+{
+    const auto it = m_sensors.constFind(key);
+    return it != m_sensors.constEnd() ? it->unit : QString();
+}
+
+void SensorRegistry::compileUnit(SensorEntry &entry) const
+{
+    const Unit canonical = parseUnit(entry.unit);
+    const Unit display = entry.fixedUnit ? canonical : displayUnit(canonical, m_unitPreferences);
+    entry.displayUnit = display == canonical ? Unit::None : display;
+    entry.displayConversion = UnitConversion::between(canonical, display);
+}
+
+QString SensorRegistry::displayUnitOf(const SensorEntry &entry) const
+{
+    return entry.displayUnit == Unit::None ? entry.unit : unitSymbol(entry.displayUnit);
+}
+
+double SensorRegistry::displayMaxValue(const SensorEntry &entry) const
+{
+    return entry.displayConversion.apply(entry.maxValue);
+}
+
+double SensorRegistry::displayStepSize(const SensorEntry &entry) const
+{
+    // A step is a difference: the conversion's offset does not apply
+    return entry.stepSize * std::abs(entry.displayConversion.scale);
+}
+
 /**
  * @brief Register a sensor as available in the registry.
  *
@@ -46,7 +93,7 @@ void SensorRegistry::setAppSettings(AppSettings *settings)
  * @param key Unique property key (e.g., "rpm", "boost", "Analog0")
  * @param displayName Human-readable name (e.g., "RPM", "Boost Pressure")
  * @param category Category for grouping (e.g., "Engine", "Analog Inputs")
- * @param unit Unit string (e.g., "rpm", "psi", "V")
+ * @param unit Canonical unit of the property value (e.g., "rpm", "psi", "V")
  * @param source Where this sensor data comes from
  */
 void SensorRegistry::registerSensor(const QString &key, const QString &displayName, const QString &category,
@@ -66,6 +113,7 @@ void SensorRegistry::registerSensor(const QString &key, const QString &displayNa
     entry.decimals = decimals;
     entry.maxValue = maxValue;
     entry.stepSize = stepSize;
+    compileUnit(entry);
 
     m_sensors.insert(key, entry);
 
@@ -208,7 +256,7 @@ QString SensorRegistry::getDisplayName(const QString &key) const
 }
 
 /**
- * @brief Get unit for a sensor key.
+ * @brief Get the display unit for a sensor key.
  * @param key Sensor property key
  * @return Unit string or empty string if not found
  */
@@ -216,7 +264,7 @@ QString SensorRegistry::getUnit(const QString &key) const
 {
     auto it = m_sensors.constFind(key);
     if (it != m_sensors.constEnd()) {
-        return it->unit;
+        return displayUnitOf(it.value());
     }
     return QString();
 }
@@ -230,13 +278,13 @@ int SensorRegistry::getDecimals(const QString &key) const
 double SensorRegistry::getMaxValue(const QString &key) const
 {
     auto it = m_sensors.constFind(key);
-    return it != m_sensors.constEnd() ? it->maxValue : 100.0;
+    return it != m_sensors.constEnd() ? displayMaxValue(it.value()) : 100.0;
 }
 
 double SensorRegistry::getStepSize(const QString &key) const
 {
     auto it = m_sensors.constFind(key);
-    return it != m_sensors.constEnd() ? it->stepSize : 1.0;
+    return it != m_sensors.constEnd() ? displayStepSize(it.value()) : 1.0;
 }
 
 void SensorRegistry::updateSensorMetadata(const QString &key, const QString &unit, int decimals, double maxValue,
@@ -250,6 +298,7 @@ void SensorRegistry::updateSensorMetadata(const QString &key, const QString &uni
 
     if (it->unit != unit) {
         it->unit = unit;
+        compileUnit(*it);
         changed = true;
     }
     if (it->decimals != decimals) {
@@ -280,6 +329,7 @@ void SensorRegistry::updateSensorMetadata(const QString &key, const QString &uni
  */
 void SensorRegistry::refreshExtenderAnalogInputs()
 {
+    PT_TRACE_SCOPE("registry.refreshExtenderAnalogInputs");
     QStringList toRemove;
     for (auto it = m_sensors.constBegin(); it != m_sensors.constEnd(); ++it) {
         if (it->source == SensorSource::ExtenderAnalog)
@@ -313,6 +363,7 @@ void SensorRegistry::refreshExtenderAnalogInputs()
         rawEntry.decimals = 3;
         rawEntry.maxValue = 5.0;
         rawEntry.stepSize = 0.1;
+        compileUnit(rawEntry);
         m_sensors.insert(rawKey, rawEntry);
 
         const QString calcKey = QStringLiteral("EXAnalogCalc%1").arg(i);
@@ -320,13 +371,17 @@ void SensorRegistry::refreshExtenderAnalogInputs()
         calcEntry.key = calcKey;
         calcEntry.displayName = QStringLiteral("EX AN Calc %1: %2").arg(i).arg(customName);
         calcEntry.category = QStringLiteral("Extender Board");
+        // The unit comes from the channel's preset or NTC setup (ExBoardConfigManager), and QML binds
+        // Expander.EXAnalogCalcN directly in it: keep it out of the display unit conversion, like EXSpeed.
         calcEntry.unit = QString();
+        calcEntry.fixedUnit = true;
         calcEntry.source = SensorSource::ExtenderAnalog;
         calcEntry.active = false;
         calcEntry.lastActiveTimestamp = 0;
         calcEntry.decimals = 2;
         calcEntry.maxValue = 100.0;
         calcEntry.stepSize = 1.0;
+        compileUnit(calcEntry);
         m_sensors.insert(calcKey, calcEntry);
     }
 
@@ -336,12 +391,17 @@ void SensorRegistry::refreshExtenderAnalogInputs()
         speedEntry.key = QStringLiteral("EXSpeed");
         speedEntry.displayName = QStringLiteral("EX Speed");
         speedEntry.category = QStringLiteral("Extender Board");
-        speedEntry.unit = QStringLiteral("km/h");
+        // EXSpeed is published and shown in the unit chosen in the speed sensor settings, like the
+        // sensor page and gauge labels that read Expander.EXSpeed directly.
+        speedEntry.unit = unitSymbol(
+            parseUnit(readValue(QStringLiteral("ui/exboard/speedSensor/unit"), QStringLiteral("MPH")).toString()));
+        speedEntry.fixedUnit = true;
         speedEntry.source = SensorSource::ExtenderAnalog;
         speedEntry.active = false;
         speedEntry.decimals = 1;
         speedEntry.maxValue = 300.0;
         speedEntry.stepSize = 1.0;
+        compileUnit(speedEntry);
         m_sensors.insert(speedEntry.key, speedEntry);
     }
     const bool gearEnabled = readValue(QStringLiteral("ui/exboard/gearSensor/enabled"), false).toBool();
@@ -356,6 +416,7 @@ void SensorRegistry::refreshExtenderAnalogInputs()
         gearEntry.decimals = 0;
         gearEntry.maxValue = 7.0;
         gearEntry.stepSize = 1.0;
+        compileUnit(gearEntry);
         m_sensors.insert(gearEntry.key, gearEntry);
     }
 
@@ -371,6 +432,7 @@ void SensorRegistry::refreshExtenderAnalogInputs()
         diffEntry.decimals = 2;
         diffEntry.maxValue = 100.0;
         diffEntry.stepSize = 1.0;
+        compileUnit(diffEntry);
         m_sensors.insert(diffEntry.key, diffEntry);
     }
 
@@ -385,6 +447,7 @@ void SensorRegistry::refreshExtenderAnalogInputs()
  */
 void SensorRegistry::refreshExtenderDigitalInputs()
 {
+    PT_TRACE_SCOPE("registry.refreshExtenderDigitalInputs");
     QStringList toRemove;
     for (auto it = m_sensors.constBegin(); it != m_sensors.constEnd(); ++it) {
         if (it->source == SensorSource::ExtenderDigital)
@@ -427,6 +490,7 @@ void SensorRegistry::refreshExtenderDigitalInputs()
         entry.decimals = 0;
         entry.maxValue = 1.0;
         entry.stepSize = 1.0;
+        compileUnit(entry);
         m_sensors.insert(key, entry);
     }
 
@@ -441,6 +505,7 @@ void SensorRegistry::refreshExtenderDigitalInputs()
         freqEntry.decimals = 0;
         freqEntry.maxValue = 10000.0;
         freqEntry.stepSize = 100.0;
+        compileUnit(freqEntry);
         m_sensors.insert(freqEntry.key, freqEntry);
     }
 
@@ -449,6 +514,7 @@ void SensorRegistry::refreshExtenderDigitalInputs()
 
 void SensorRegistry::refreshAll()
 {
+    PT_TRACE_SCOPE("registry.refreshAll");
     const bool priorSuppress = m_suppressEmit;
     m_suppressEmit = true;
     refreshExtenderAnalogInputs();
@@ -473,6 +539,7 @@ int SensorRegistry::availableCount() const
  */
 QVariantList SensorRegistry::availableSensors() const
 {
+    PT_TRACE_SCOPE("registry.availableSensors");
     return getSensorsByCategory(QString());
 }
 
@@ -494,7 +561,7 @@ QStringList SensorRegistry::availableCategories() const
 /**
  * @brief Register built-in sensors that are always available.
  *
- * Registers GPS position/speed/heading/altitude/satellites sensors,
+ * Registers GPS position/speed/heading/altitude/satellites sensors, the lap delta,
  * SenseHat accelerometer axes (X, Y, Z), gyroscope axes (X, Y, Z),
  * compass heading, ambient temperature, and ambient pressure.
  */
@@ -514,6 +581,10 @@ void SensorRegistry::registerBuiltinSensors()
     registerSensor(QStringLiteral("gpsVisibleSatelites"), QStringLiteral("Satellites"), QStringLiteral("GPS"),
                    QString(), SensorSource::GPS, 0, 32.0, 1.0);
 
+    // Lap timer: delta to the best lap, computed from GPS fixes and speed samples
+    registerSensor(QStringLiteral("lapDelta"), QStringLiteral("Lap Delta"), QStringLiteral("Lap Timer"),
+                   QStringLiteral("s"), SensorSource::Computed, 2, 10.0, 0.1);
+
     // SenseHat accelerometer sensors
     registerSensor(QStringLiteral("accelx"), QStringLiteral("Accelerometer X"), QStringLiteral("Accelerometer"),
                    QStringLiteral("g"), SensorSource::SenseHat, 2, 16.0, 0.1);
@@ -546,7 +617,8 @@ void SensorRegistry::registerBuiltinSensors()
 /**
  * @brief Convert a SensorEntry to a QVariantMap for QML consumption.
  * @param entry The sensor entry to convert
- * @return QVariantMap with keys: key, displayName, category, unit, source, active
+ * @return QVariantMap with keys: key, displayName, category, unit, decimals, maxValue, stepSize, source, active;
+ *         unit, maxValue and stepSize are in the display unit
  */
 QVariantMap SensorRegistry::entryToVariantMap(const SensorEntry &entry) const
 {
@@ -554,10 +626,10 @@ QVariantMap SensorRegistry::entryToVariantMap(const SensorEntry &entry) const
     map[QStringLiteral("key")] = entry.key;
     map[QStringLiteral("displayName")] = entry.displayName;
     map[QStringLiteral("category")] = entry.category;
-    map[QStringLiteral("unit")] = entry.unit;
+    map[QStringLiteral("unit")] = displayUnitOf(entry);
     map[QStringLiteral("decimals")] = entry.decimals;
-    map[QStringLiteral("maxValue")] = entry.maxValue;
-    map[QStringLiteral("stepSize")] = entry.stepSize;
+    map[QStringLiteral("maxValue")] = displayMaxValue(entry);
+    map[QStringLiteral("stepSize")] = displayStepSize(entry);
 
     // Convert enum to string for QML
     const QMetaEnum metaEnum = QMetaEnum::fromType<SensorSource>();
@@ -575,6 +647,7 @@ QVariantMap SensorRegistry::entryToVariantMap(const SensorEntry &entry) const
  */
 void SensorRegistry::checkCanTimeouts()
 {
+    PT_TRACE_SCOPE("registry.checkCanTimeouts");
     const qint64 now = QDateTime::currentMSecsSinceEpoch();
     bool changed = false;
 
@@ -12,11 +12,21 @@
  *
  * The registry provides a filtered list to the dashboard creator
  * so only available sensors are shown.
+ *
+ * Each sensor's registered unit is its canonical unit, the unit its model
+ * property holds. The display unit follows the speed / temperature /
+ * pressure settings; the conversion between the two is compiled whenever
+ * those settings or the sensor change (see UnitConversion.h) and applied
+ * by PropertyRouter when it publishes a value. Sensors whose unit is chosen
+ * in their own settings (EXSpeed) keep it: QML bound straight to the model
+ * shows the same number as the routed value.
  */
 
 #ifndef SENSORREGISTRY_H
 #define SENSORREGISTRY_H
 
+#include "../Utils/UnitConversion.h"
+
 #include <QMap>
 #include <QObject>
 #include <QString>
@@ -44,6 +54,18 @@ public:
     explicit SensorRegistry(QObject *parent = nullptr);
     void setAppSettings(AppSettings *settings);
 
+    /// Recompile every sensor's display conversion for new unit settings
+    void setUnitPreferences(const UnitPreferences &preferences);
+    UnitPreferences unitPreferences() const { return m_unitPreferences; }
+
+    /**
+     * @brief Conversion from a sensor's canonical unit to its display unit.
+     * @return Identity for unknown keys and sensors without a convertible unit
+     */
+    UnitConversion displayConversion(const QString &key) const;
+    /// Unit the model property holds (as registered), or empty for unknown keys
+    QString canonicalUnit(const QString &key) const;
+
     // -- Sensor source enum --
 
     /**
@@ -66,7 +88,7 @@ public:
      * @param key Unique property key (e.g., "rpm", "boost", "Analog0")
      * @param displayName Human-readable name (e.g., "RPM", "Boost Pressure")
      * @param category Category for grouping (e.g., "Engine", "Analog Inputs")
-     * @param unit Unit string (e.g., "rpm", "psi", "V")
+     * @param unit Canonical unit of the property value (e.g., "rpm", "psi", "V")
      * @param source Where this sensor data comes from
      */
     void registerSensor(const QString &key, const QString &displayName, const QString &category, const QString &unit,
@@ -120,7 +142,7 @@ public:
     Q_INVOKABLE QString getDisplayName(const QString &key) const;
 
     /**
-     * @brief Get unit for a sensor key.
+     * @brief Get the display unit for a sensor key.
      * @param key Sensor property key
      * @return Unit string or empty string if not found
      */
@@ -200,19 +222,23 @@ private:
         QString key;
         QString displayName;
         QString category;
-        QString unit;
+        QString unit;  ///< Canonical unit as registered
         SensorSource source;
         bool active = true;
         qint64 lastActiveTimestamp = 0;  ///< msecsSinceEpoch of last markCanSensorActive call
         int decimals = 2;
         double maxValue = 100.0;
         double stepSize = 1.0;
+        bool fixedUnit = false;  ///< Unit chosen per sensor: never converted to the unit settings
+        Unit displayUnit = Unit::None;  ///< None: shown in the canonical unit
+        UnitConversion displayConversion;
     };
 
     QMap<QString, SensorEntry> m_sensors;
     QTimer m_canTimeoutTimer;  ///< Periodically check for stale sensors
     QTimer m_sensorsChangedTimer;
     AppSettings *m_appSettings = nullptr;
+    UnitPreferences m_unitPreferences;
     bool m_sensorsChangedPending = false;
     bool m_suppressEmit = false;
 
@@ -221,6 +247,13 @@ private:
      */
     void registerBuiltinSensors();
 
+    /// Derive @p entry's display unit and conversion from its unit and the current preferences
+    void compileUnit(SensorEntry &entry) const;
+    QString displayUnitOf(const SensorEntry &entry) const;
+    /// maxValue and stepSize in displayUnitOf(), the unit QML receives the value in
+    double displayMaxValue(const SensorEntry &entry) const;
+    double displayStepSize(const SensorEntry &entry) const;
+
     void scheduleSensorsChanged();
     void emitScheduledSensorsChanged();
 
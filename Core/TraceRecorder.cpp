@@ -0,0 +1,313 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file TraceRecorder.cpp
+ * @brief Implementation of the TraceRecorder class.
+ */
+
+#include "TraceRecorder.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSocketNotifier>
+#include <QStandardPaths>
+#include <QThread>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+    #include <csignal>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+TraceRecorder *TraceRecorder::s_instance = nullptr;
+
+namespace {
+constexpr int kEventsPerThread = 8192;
+
+struct TraceEvent
+{
+    const char *name;
+    qint64 startNs;
+    qint64 durationNs;
+};
+
+// Single-producer ring owned by one thread. The owning thread is the only
+// writer; dumps and clears touch it only after recording has been paused and
+// the writer has left record() (see pauseWriters()).
+struct ThreadBuffer
+{
+    int tid = 0;
+    QString threadName;
+    std::atomic<bool> writing{false};
+    std::atomic<quint64> written{0};
+    TraceEvent events[kEventsPerThread];
+};
+
+QMutex &registryMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+std::vector<std::unique_ptr<ThreadBuffer>> &registry()
+{
+    static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    return buffers;
+}
+
+thread_local ThreadBuffer *t_buffer = nullptr;
+
+ThreadBuffer *currentThreadBuffer()
+{
+    if (t_buffer)
+        return t_buffer;
+
+    // First span on this thread: register a buffer. Buffers live until exit so
+    // spans from threads that have already finished still show up in dumps.
+    auto buffer = std::make_unique<ThreadBuffer>();
+    QThread *thread = QThread::currentThread();
+    if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread())
+        buffer->threadName = QStringLiteral("GUI");
+    else if (thread && !thread->objectName().isEmpty())
+        buffer->threadName = thread->objectName();
+
+    QMutexLocker locker(&registryMutex());
+    buffer->tid = static_cast<int>(registry().size()) + 1;
+    if (buffer->threadName.isEmpty())
+        buffer->threadName = QStringLiteral("Thread %1").arg(buffer->tid);
+    t_buffer = buffer.get();
+    registry().push_back(std::move(buffer));
+    return t_buffer;
+}
+
+/**
+ * Stop recording and wait until no thread is inside record().
+ *
+ * record() raises its buffer's writing flag before it checks s_recording, and
+ * this clears s_recording before it checks the flags (both sequentially
+ * consistent), so a writer either sees recording off or is waited for.
+ * Call with the registry mutex held.
+ */
+void pauseWriters(std::atomic<bool> &recording)
+{
+    recording.store(false, std::memory_order_seq_cst);
+    for (const auto &buffer : registry()) {
+        while (buffer->writing.load(std::memory_order_seq_cst))
+            QThread::yieldCurrentThread();
+    }
+}
+
+QByteArray jsonEscaped(const QString &text)
+{
+    QByteArray out;
+    const QByteArray utf8 = text.toUtf8();
+    out.reserve(utf8.size());
+    for (const char c : utf8) {
+        if (c == '"' || c == '\\')
+            out.append('\\');
+        if (static_cast<unsigned char>(c) >= 0x20)
+            out.append(c);
+    }
+    return out;
+}
+
+#ifdef Q_OS_LINUX
+int s_signalFds[2] = {-1, -1};
+
+void sigusr1Handler(int)
+{
+    const char byte = 1;
+    [[maybe_unused]] const ssize_t written = ::write(s_signalFds[0], &byte, sizeof(byte));
+}
+#endif
+}  // namespace
+
+TraceRecorder::TraceRecorder(QObject *parent) : QObject(parent)
+{
+    s_instance = this;
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    s_recording.store(false, std::memory_order_relaxed);
+    if (s_instance == this)
+        s_instance = nullptr;
+}
+
+TraceRecorder *TraceRecorder::instance()
+{
+    return s_instance;
+}
+
+qint64 TraceRecorder::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void TraceRecorder::record(const char *name, qint64 startNs, qint64 endNs)
+{
+    ThreadBuffer *buffer = currentThreadBuffer();
+    // Spans that began before a dump or clear paused recording end here; drop them.
+    buffer->writing.store(true, std::memory_order_seq_cst);
+    if (!s_recording.load(std::memory_order_seq_cst)) {
+        buffer->writing.store(false, std::memory_order_release);
+        return;
+    }
+    const quint64 index = buffer->written.load(std::memory_order_relaxed);
+    buffer->events[index % kEventsPerThread] = TraceEvent{name, startNs, endNs - startNs};
+    buffer->written.store(index + 1, std::memory_order_release);
+    buffer->writing.store(false, std::memory_order_release);
+}
+
+bool TraceRecorder::compiledIn() const
+{
+#ifdef POWERTUNE_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void TraceRecorder::setRecording(bool recording)
+{
+    if (!compiledIn())
+        recording = false;
+    if (isRecording() == recording)
+        return;
+
+    s_recording.store(recording, std::memory_order_relaxed);
+    emit recordingChanged(recording);
+}
+
+void TraceRecorder::installSignalHandler()
+{
+#ifdef Q_OS_LINUX
+    // Nothing to dump without tracing; leave SIGUSR1 at its default.
+    if (!compiledIn() || m_signalNotifier)
+        return;
+
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, s_signalFds) != 0) {
+        emit errorOccurred(QStringLiteral("Trace: failed to create SIGUSR1 socket pair"));
+        return;
+    }
+
+    struct sigaction action = {};
+    action.sa_handler = sigusr1Handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    if (::sigaction(SIGUSR1, &action, nullptr) != 0) {
+        emit errorOccurred(QStringLiteral("Trace: failed to install SIGUSR1 handler"));
+        return;
+    }
+
+    m_signalNotifier = new QSocketNotifier(s_signalFds[1], QSocketNotifier::Read, this);
+    connect(m_signalNotifier, &QSocketNotifier::activated, this, &TraceRecorder::onSignalNotifier);
+#endif
+}
+
+void TraceRecorder::onSignalNotifier()
+{
+#ifdef Q_OS_LINUX
+    char byte = 0;
+    [[maybe_unused]] const ssize_t bytesRead = ::read(s_signalFds[1], &byte, sizeof(byte));
+    dumpChromeTrace();
+#endif
+}
+
+void TraceRecorder::clear()
+{
+    const bool wasRecording = isRecording();
+    {
+        QMutexLocker locker(&registryMutex());
+        pauseWriters(s_recording);
+        for (const auto &buffer : registry())
+            buffer->written.store(0, std::memory_order_relaxed);
+    }
+    s_recording.store(wasRecording);
+}
+
+QString TraceRecorder::dumpChromeTrace(const QString &path)
+{
+    QString outputPath = path;
+    if (outputPath.isEmpty()) {
+        const QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+        dir.mkpath(QStringLiteral("traces"));
+        outputPath = dir.filePath(QStringLiteral("traces/trace-%1.json")
+                                      .arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-hhmmss"))));
+    }
+
+    // Pause producers so the rings are stable while they are read.
+    const bool wasRecording = isRecording();
+
+    QByteArray json;
+    json.reserve(1 << 20);
+    json.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    int eventCount = 0;
+    {
+        QMutexLocker locker(&registryMutex());
+        pauseWriters(s_recording);
+
+        qint64 originNs = 0;
+        for (const auto &buffer : registry()) {
+            const quint64 written = buffer->written.load(std::memory_order_acquire);
+            const quint64 count = qMin<quint64>(written, kEventsPerThread);
+            for (quint64 i = written - count; i < written; ++i) {
+                const qint64 start = buffer->events[i % kEventsPerThread].startNs;
+                if (originNs == 0 || start < originNs)
+                    originNs = start;
+            }
+        }
+
+        for (const auto &buffer : registry()) {
+            if (!first)
+                json.append(',');
+            first = false;
+            json.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+            json.append(QByteArray::number(buffer->tid));
+            json.append(",\"args\":{\"name\":\"");
+            json.append(jsonEscaped(buffer->threadName));
+            json.append("\"}}");
+
+            const quint64 written = buffer->written.load(std::memory_order_acquire);
+            const quint64 count = qMin<quint64>(written, kEventsPerThread);
+            for (quint64 i = written - count; i < written; ++i) {
+                const TraceEvent &event = buffer->events[i % kEventsPerThread];
+                json.append(",{\"name\":\"");
+                json.append(event.name);
+                json.append("\",\"cat\":\"powertune\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+                json.append(QByteArray::number(buffer->tid));
+                json.append(",\"ts\":");
+                json.append(QByteArray::number((event.startNs - originNs) / 1000.0, 'f', 3));
+                json.append(",\"dur\":");
+                json.append(QByteArray::number(event.durationNs / 1000.0, 'f', 3));
+                json.append('}');
+                ++eventCount;
+            }
+        }
+    }
+    json.append("]}\n");
+
+    s_recording.store(wasRecording);
+
+    QFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+        emit errorOccurred(QStringLiteral("Trace: failed to write %1").arg(outputPath));
+        return QString();
+    }
+    file.close();
+
+    m_lastDumpPath = outputPath;
+    emit traceDumped(outputPath, eventCount);
+    return outputPath;
+}
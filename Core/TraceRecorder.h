@@ -0,0 +1,139 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file TraceRecorder.h
+ * @brief Lightweight span tracing for backend hot paths with Chrome trace export.
+ *
+ * Spans are recorded with PT_TRACE_SCOPE("name") into fixed-size per-thread
+ * ring buffers (no locks, no allocation on the hot path) and dumped as Chrome
+ * trace JSON (chrome://tracing, ui.perfetto.dev) on demand from the
+ * Diagnostics page, from any Qt signal connected to dumpChromeTrace(), or by
+ * sending SIGUSR1 to the process on Linux.
+ *
+ * Tracing is compiled in only when POWERTUNE_TRACING is defined (CMake option
+ * POWERTUNE_ENABLE_TRACING). Without it the macros expand to nothing. When
+ * compiled in but not recording, a span costs one relaxed atomic load.
+ */
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+
+class QSocketNotifier;
+
+class TraceRecorder : public QObject
+{
+    Q_OBJECT
+
+    /// Whether tracing support was compiled into this build
+    Q_PROPERTY(bool compiledIn READ compiledIn CONSTANT)
+
+    /// Whether spans are currently being recorded
+    Q_PROPERTY(bool recording READ recording WRITE setRecording NOTIFY recordingChanged)
+
+    /// Path of the most recent trace dump (empty until the first dump)
+    Q_PROPERTY(QString lastDumpPath READ lastDumpPath NOTIFY traceDumped)
+
+public:
+    explicit TraceRecorder(QObject *parent = nullptr);
+    ~TraceRecorder() override;
+
+    static TraceRecorder *instance();
+
+    /// Monotonic timestamp in nanoseconds shared by all trace producers
+    static qint64 nowNs();
+
+    /// Hot-path check used by TraceScope
+    static bool isRecording() { return s_recording.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Append a completed span to the calling thread's ring buffer.
+     * @param name Static string literal naming the span (pointer is stored, not copied)
+     * @param startNs Start timestamp from nowNs()
+     * @param endNs End timestamp from nowNs()
+     */
+    static void record(const char *name, qint64 startNs, qint64 endNs);
+
+    bool compiledIn() const;
+    bool recording() const { return isRecording(); }
+    void setRecording(bool recording);
+    QString lastDumpPath() const { return m_lastDumpPath; }
+
+    /**
+     * @brief Install a SIGUSR1 handler that triggers dumpChromeTrace() on the GUI thread.
+     *
+     * Linux only; a no-op elsewhere and in builds without POWERTUNE_TRACING.
+     */
+    void installSignalHandler();
+
+public slots:
+    /**
+     * @brief Write all buffered spans as Chrome trace JSON.
+     * @param path Output file; defaults to a timestamped file in the app data directory
+     * @return Path written, or an empty string on failure
+     *
+     * Recording is paused, and spans still being written are waited for, while
+     * the buffers are read; it is restored afterwards.
+     */
+    QString dumpChromeTrace(const QString &path = QString());
+
+    /// Discard all buffered spans
+    void clear();
+
+signals:
+    void recordingChanged(bool recording);
+    void traceDumped(const QString &path, int spanCount);
+    void errorOccurred(const QString &message);
+
+private:
+    void onSignalNotifier();
+
+    static inline std::atomic<bool> s_recording{false};
+    static TraceRecorder *s_instance;
+
+    QString m_lastDumpPath;
+    QSocketNotifier *m_signalNotifier = nullptr;
+};
+
+/// RAII span; records [construction, destruction) when tracing is active.
+class TraceScope
+{
+public:
+    explicit TraceScope(const char *name)
+        : m_name(TraceRecorder::isRecording() ? name : nullptr), m_startNs(m_name ? TraceRecorder::nowNs() : 0)
+    {}
+    ~TraceScope()
+    {
+        if (m_name)
+            TraceRecorder::record(m_name, m_startNs, TraceRecorder::nowNs());
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    const char *m_name;
+    qint64 m_startNs;
+};
+
+#ifdef POWERTUNE_TRACING
+    #define PT_TRACE_CONCAT_INNER(a, b) a##b
+    #define PT_TRACE_CONCAT(a, b) PT_TRACE_CONCAT_INNER(a, b)
+    #define PT_TRACE_SCOPE(name) TraceScope PT_TRACE_CONCAT(ptTraceScope_, __LINE__)(name)
+    #define PT_TRACE_COMPLETE(name, startNs, endNs)                                                                    \
+        do {                                                                                                           \
+            if (TraceRecorder::isRecording())                                                                          \
+                TraceRecorder::record(name, startNs, endNs);                                                           \
+        } while (0)
+#else
+    #define PT_TRACE_SCOPE(name)
+    #define PT_TRACE_COMPLETE(name, startNs, endNs)                                                                    \
+        do {                                                                                                           \
+        } while (0)
+#endif
+
+#endif  // TRACERECORDER_H
@@ -21,22 +21,31 @@
 
 #include "connect.h"
 
+#include "../Can/CanBusAnalyzer.h"
+#include "../Can/CanFrameRecorder.h"
 #include "../Can/CanManager.h"
 #include "../Can/CanStartupManager.h"
 #include "../Can/CanTransport.h"
 #include "../Hardware/Extender.h"
+#include "../Hardware/GpsReceiver.h"
+#include "../Hardware/SharedMemoryPublisher.h"
+#include "../Hardware/TelemetryBroadcaster.h"
+#include "../Hardware/UdpReceiver.h"
 #include "../Utils/Calculations.h"
 #include "../Utils/CalibrationHelper.h"
 #include "../Utils/DataLogger.h"
+#include "../Utils/LogPlayer.h"
 #include "../Utils/OverlayPositionManager.h"
 #include "../Utils/ShiftIndicatorHelper.h"
 #include "../Utils/SteinhartCalculator.h"
+#include "../Utils/UnitConversion.h"
 #include "../Utils/wifiscanner.h"
 #include "DiagnosticsProvider.h"
 #include "DashboardLockService.h"
 #include "DemoModeService.h"
 #include "DifferentialSensorCalc.h"
 #include "ExBoardConfigManager.h"
+#include "FrameTimingMonitor.h"
 #include "Models/CanFrameModel.h"
 #include "Models/DataModels.h"
 #include "Models/UIState.h"
@@ -44,6 +53,7 @@
 #include "PropertyRouter.h"
 #include "ScreenControlService.h"
 #include "SensorRegistry.h"
+#include "TraceRecorder.h"
 #include "UpdateManagerService.h"
 #include "appsettings.h"
 
@@ -56,6 +66,7 @@
 #include <QProcess>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
 #include <QRegularExpression>
 #include <QStandardPaths>
 #include <QTextStream>
@@ -92,6 +103,7 @@ bool Connect::hasBrightnessControl() const
 Connect::Connect(QObject *parent)
     : QObject(parent),
       m_datalogger(nullptr),
+      m_logPlayer(nullptr),
       m_calculations(nullptr),
       m_wifiscanner(nullptr),
       m_extender(nullptr),
@@ -99,6 +111,10 @@ Connect::Connect(QObject *parent)
       m_engineData(nullptr),
       m_vehicleData(nullptr),
       m_gpsData(nullptr),
+      m_gpsReceiver(nullptr),
+      m_udpReceiver(nullptr),
+      m_telemetryBroadcaster(nullptr),
+      m_sharedMemoryPublisher(nullptr),
       m_analogInputs(nullptr),
       m_digitalInputs(nullptr),
       m_expanderBoardData(nullptr),
@@ -110,13 +126,17 @@ Connect::Connect(QObject *parent)
       m_calibrationHelper(nullptr),
       m_sensorRegistry(nullptr),
       m_diagnosticsProvider(nullptr),
+      m_frameTimingMonitor(nullptr),
+      m_traceRecorder(nullptr),
       m_screenControlService(nullptr),
       m_dashboardLockService(nullptr),
       m_demoModeService(nullptr),
       m_updateManagerService(nullptr),
       m_canStartupManager(nullptr),
       m_canTransport(nullptr),
-      m_canManager(nullptr)
+      m_canManager(nullptr),
+      m_canBusAnalyzer(nullptr),
+      m_canFrameRecorder(nullptr)
 
 {
     // * Phase 2: Create domain data models
@@ -143,24 +163,132 @@ Connect::Connect(QObject *parent)
     m_wifiscanner = new WifiScanner(m_connectionData, this);
     m_extender = new Extender(m_digitalInputs, m_expanderBoardData, m_engineData, m_settingsData, m_vehicleData,
                               m_connectionData, this);
+    // * Speed samples carry their CAN receive time; drag timing, gear and odometer run per sample
+    connect(m_extender, &ExBoardCan::speedSampled, m_calculations, &calculations::onSpeedSample);
     m_canStartupManager = new CanStartupManager(this);
     m_canTransport = new CanTransport(this);
     m_canManager = new CanManager(this);
     m_canManager->setTransport(m_canTransport);
     m_canManager->registerModule(m_extender);
+    m_canBusAnalyzer = new CanBusAnalyzer(this);
+    connect(m_canTransport, &CanTransport::frameReceived, m_canBusAnalyzer, &CanBusAnalyzer::recordFrame);
+    m_canFrameRecorder = new CanFrameRecorder(this);
+    m_canFrameRecorder->attachTransport(m_canTransport);
     m_steinhartCalc = new SteinhartCalculator(this);
     m_extender->setSteinhartCalculator(m_steinhartCalc);
     m_extender->connectCalibrationSignals();
     m_calibrationHelper = new CalibrationHelper(m_steinhartCalc, this);
     m_sensorRegistry = new SensorRegistry(this);
     m_sensorRegistry->setAppSettings(m_appSettings);
+    // * Unit settings are compiled into conversions here, never compared per sample
+    const auto applyUnitPreferences = [this]() {
+        UnitPreferences preferences;
+        preferences.speed = parseUnitSystem(m_settingsData->speedunits());
+        preferences.temperature = parseUnitSystem(m_settingsData->units());
+        preferences.pressure = parseUnitSystem(m_settingsData->pressureunits());
+        m_sensorRegistry->setUnitPreferences(preferences);
+        m_calculations->setUnitPreferences(preferences);
+    };
+    applyUnitPreferences();
+    for (auto changed :
+         {&SettingsData::unitsChanged, &SettingsData::speedunitsChanged, &SettingsData::pressureunitsChanged})
+        connect(m_settingsData, changed, this, applyUnitPreferences);
     m_propertyRouter->setSensorRegistry(m_sensorRegistry);
+    m_datalogger->setSensorRegistry(m_sensorRegistry);
+    m_datalogger->setPropertyRouter(m_propertyRouter);
+    m_datalogger->setAppSettings(m_appSettings);
     m_extender->setSensorRegistry(m_sensorRegistry);
     m_diagnosticsProvider = new DiagnosticsProvider(this);
     m_diagnosticsProvider->setSensorRegistry(m_sensorRegistry);
     m_diagnosticsProvider->setPropertyRouter(m_propertyRouter);
     m_diagnosticsProvider->setAppSettings(m_appSettings);
     m_extender->setDiagnosticsProvider(m_diagnosticsProvider);
+    m_frameTimingMonitor = new FrameTimingMonitor(this);
+    m_frameTimingMonitor->setDiagnosticsProvider(m_diagnosticsProvider);
+    m_traceRecorder = new TraceRecorder(this);
+    m_traceRecorder->installSignalHandler();
+    connect(m_traceRecorder, &TraceRecorder::recordingChanged, m_frameTimingMonitor,
+            &FrameTimingMonitor::setTraceHooksEnabled);
+    connect(m_traceRecorder, &TraceRecorder::traceDumped, this, [this](const QString &path, int spanCount) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(
+                QStringLiteral("INFO"), QStringLiteral("Trace written: %1 (%2 spans)").arg(path).arg(spanCount));
+    });
+    connect(m_traceRecorder, &TraceRecorder::errorOccurred, this, [this](const QString &message) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(QStringLiteral("ERROR"), message);
+    });
+    connect(m_datalogger, &datalogger::errorOccurred, this, [this](const QString &message) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(QStringLiteral("ERROR"), message);
+    });
+    connect(m_datalogger, &datalogger::csvExported, this, [this](const QString &path) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(QStringLiteral("INFO"), QStringLiteral("Log exported: %1").arg(path));
+    });
+    connect(m_datalogger, &datalogger::logRecovered, this, [this](const QString &description) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(QStringLiteral("WARN"),
+                                                 QStringLiteral("Recovered interrupted log: %1").arg(description));
+    });
+    connect(m_datalogger, &datalogger::triggered, this, [this](const QString &reason, const QString &path) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(QStringLiteral("INFO"),
+                                                 QStringLiteral("Log triggered (%1): %2").arg(reason, path));
+    });
+    m_datalogger->recoverLogs();
+    m_logPlayer = new LogPlayer(this);
+    m_logPlayer->setPropertyRouter(m_propertyRouter);
+    connect(m_logPlayer, &LogPlayer::errorOccurred, this, [this](const QString &message) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(QStringLiteral("ERROR"), message);
+    });
+    m_gpsReceiver = new GpsReceiver(m_gpsData, this);
+    m_gpsReceiver->setSensorRegistry(m_sensorRegistry);
+    connect(m_gpsReceiver, &GpsReceiver::fixReceived, m_calculations, [this](const GpsFix &fix) {
+        m_calculations->onPositionSample(fix.latitude, fix.longitude, fix.receivedUs);
+    });
+    // * Restores Odo/Trip from the odometer journal and the track last given to Calculations.setLapTrack()
+    m_calculations->setAppSettings(m_appSettings);
+    connect(m_gpsReceiver, &GpsReceiver::errorOccurred, this, [this](const QString &message) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(QStringLiteral("WARN"), message);
+    });
+    m_udpReceiver = new UdpReceiver(this);
+    m_udpReceiver->setPropertyRouter(m_propertyRouter);
+    m_udpReceiver->setSensorRegistry(m_sensorRegistry);
+    connect(m_udpReceiver, &UdpReceiver::errorOccurred, this, [this](const QString &message) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(QStringLiteral("WARN"), message);
+    });
+    m_telemetryBroadcaster = new TelemetryBroadcaster(this);
+    m_telemetryBroadcaster->setPropertyRouter(m_propertyRouter);
+    m_telemetryBroadcaster->setSensorRegistry(m_sensorRegistry);
+    connect(m_telemetryBroadcaster, &TelemetryBroadcaster::errorOccurred, this, [this](const QString &message) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(QStringLiteral("WARN"), message);
+    });
+    m_sharedMemoryPublisher = new SharedMemoryPublisher(this);
+    m_sharedMemoryPublisher->setPropertyRouter(m_propertyRouter);
+    m_sharedMemoryPublisher->setSensorRegistry(m_sensorRegistry);
+    connect(m_sharedMemoryPublisher, &SharedMemoryPublisher::errorOccurred, this, [this](const QString &message) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(QStringLiteral("WARN"), message);
+    });
+    connect(m_canFrameRecorder, &CanFrameRecorder::recordingFinished, this,
+            [this](const QString &path, double frames, double dropped) {
+                if (m_diagnosticsProvider)
+                    m_diagnosticsProvider->addLogMessage(
+                        dropped > 0 ? QStringLiteral("WARN") : QStringLiteral("INFO"),
+                        QStringLiteral("CAN recording saved: %1 (%2 frames, %3 dropped)")
+                            .arg(path)
+                            .arg(frames, 0, 'f', 0)
+                            .arg(dropped, 0, 'f', 0));
+            });
+    connect(m_canFrameRecorder, &CanFrameRecorder::errorOccurred, this, [this](const QString &message) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(QStringLiteral("ERROR"), message);
+    });
     connect(m_canStartupManager, &CanStartupManager::startupFailed, this, [this](const QString &reason) {
         if (m_diagnosticsProvider) {
             m_diagnosticsProvider->addLogMessage(QStringLiteral("ERROR"), reason);
@@ -179,6 +307,15 @@ Connect::Connect(QObject *parent)
         emit connectionStateChanged(connected, connected ? QStringLiteral("Native CAN active")
                                                          : QStringLiteral("Native CAN disconnected"));
     });
+    connect(m_canTransport, &CanTransport::replayFinished, this, [this](qint64 frames, qint64 elapsedUs) {
+        if (m_diagnosticsProvider)
+            m_diagnosticsProvider->addLogMessage(
+                QStringLiteral("INFO"), QStringLiteral("CAN replay finished: %1 frames in %2 s (%3 frames/s)")
+                                            .arg(frames)
+                                            .arg(elapsedUs / 1e6, 0, 'f', 2)
+                                            .arg(elapsedUs > 0 ? frames * 1e6 / elapsedUs : 0.0, 0, 'f', 0));
+        emit canReplayFinished(frames, elapsedUs);
+    });
     connect(m_canManager, &CanManager::activationFailed, this, [this](const QString &reason) {
         if (m_diagnosticsProvider)
             m_diagnosticsProvider->addLogMessage(QStringLiteral("ERROR"), reason);
@@ -229,6 +366,10 @@ Connect::Connect(QObject *parent)
     engine->rootContext()->setContextProperty("Engine", m_engineData);
     engine->rootContext()->setContextProperty("Vehicle", m_vehicleData);
     engine->rootContext()->setContextProperty("GPS", m_gpsData);
+    engine->rootContext()->setContextProperty("GpsReceiver", m_gpsReceiver);
+    engine->rootContext()->setContextProperty("UdpReceiver", m_udpReceiver);
+    engine->rootContext()->setContextProperty("TelemetryBroadcaster", m_telemetryBroadcaster);
+    engine->rootContext()->setContextProperty("SharedMemoryPublisher", m_sharedMemoryPublisher);
     engine->rootContext()->setContextProperty("Analog", m_analogInputs);
     engine->rootContext()->setContextProperty("Digital", m_digitalInputs);
     engine->rootContext()->setContextProperty("Expander", m_expanderBoardData);
@@ -241,6 +382,7 @@ Connect::Connect(QObject *parent)
     engine->rootContext()->setContextProperty("Extender2", m_extender);
     engine->rootContext()->setContextProperty("AppSettings", m_appSettings);
     engine->rootContext()->setContextProperty("Logger", m_datalogger);
+    engine->rootContext()->setContextProperty("LogPlayer", m_logPlayer);
     engine->rootContext()->setContextProperty("Calculations", m_calculations);
     engine->rootContext()->setContextProperty("Dirmodel", dirModel);
     engine->rootContext()->setContextProperty("Filemodel", fileModel);
@@ -251,6 +393,15 @@ Connect::Connect(QObject *parent)
     engine->rootContext()->setContextProperty("SensorRegistry", m_sensorRegistry);
     // * Phase 8: Expose DiagnosticsProvider to QML
     engine->rootContext()->setContextProperty("Diagnostics", m_diagnosticsProvider);
+    engine->rootContext()->setContextProperty("FrameTiming", m_frameTimingMonitor);
+    engine->rootContext()->setContextProperty("Tracer", m_traceRecorder);
+    engine->rootContext()->setContextProperty("CanAnalyzer", m_canBusAnalyzer);
+    engine->rootContext()->setContextProperty("CanRecorder", m_canFrameRecorder);
+    // * Render-loop timing hooks attach to the main window once QML has created it
+    connect(engine, &QQmlApplicationEngine::objectCreated, this, [this](QObject *object, const QUrl &) {
+        if (auto *window = qobject_cast<QQuickWindow *>(object))
+            m_frameTimingMonitor->attachWindow(window);
+    });
     engine->rootContext()->setContextProperty("OverlayConfig", m_overlayConfigManager);
     engine->rootContext()->setContextProperty("ShiftHelper", m_shiftIndicatorHelper);
     engine->rootContext()->setContextProperty("ExBoardConfig", m_exBoardConfigManager);
@@ -282,6 +433,7 @@ Connect::Connect(QObject *parent)
     applyDifferentialConfig();
     connect(m_exBoardConfigManager, &ExBoardConfigManager::configChanged, this, applyDifferentialConfig);
     connect(qApp, &QCoreApplication::aboutToQuit, m_appSettings, &AppSettings::sync);
+    connect(qApp, &QCoreApplication::aboutToQuit, m_calculations, &calculations::saveodoandtriptofile);
     // * Phase 7: Populate SensorRegistry with configured extender channels
     m_sensorRegistry->refreshAll();
 
@@ -477,6 +629,7 @@ void Connect::setWeight(const int &weight)
 void Connect::setOdometer(const qreal &Odometer)
 {
     m_vehicleData->setOdo(Odometer);
+    m_calculations->saveodoandtriptofile();
 }
 void Connect::qmlTreeviewclicked(const QModelIndex &index)
 {
@@ -618,8 +771,11 @@ bool Connect::startActiveCanModule()
         return false;
     }
 
-    if (!m_canStartupManager->prepareInterface(QStringLiteral("can0"), bitrate))
+    // A replayed log does not touch the real interface.
+    if (!m_canTransport->isReplay() && !m_canStartupManager->prepareInterface(QStringLiteral("can0"), bitrate))
         return false;
+    if (m_canBusAnalyzer)
+        m_canBusAnalyzer->setBitrate(bitrate);
 
     m_canTransport->setInterfaceName(QStringLiteral("can0"));
     if (!m_canTransport->open())
@@ -636,6 +792,89 @@ bool Connect::startActiveCanModule()
     return true;
 }
 
+void Connect::setCanReplay(const QString &path, double speed)
+{
+    if (m_canTransport)
+        m_canTransport->setReplayFile(path, speed);
+    if (m_diagnosticsProvider && !path.isEmpty()) {
+        m_diagnosticsProvider->addLogMessage(
+            QStringLiteral("INFO"),
+            QStringLiteral("CAN input replays %1 (%2)")
+                .arg(path, speed > 0.0 ? QStringLiteral("%1x").arg(speed) : QStringLiteral("as fast as possible")));
+    }
+}
+
+void Connect::setLogPlayback(const QString &path, double speed)
+{
+    if (!m_logPlayer || !m_logPlayer->load(path))
+        return;
+    m_logPlayer->setSpeed(speed);
+    m_logPlayer->setLoop(true);
+    m_logPlayer->play();
+    if (m_diagnosticsProvider) {
+        m_diagnosticsProvider->addLogMessage(
+            QStringLiteral("INFO"),
+            QStringLiteral("Playing %1 into the dashboard (%2x, looped)").arg(path).arg(m_logPlayer->speed()));
+    }
+}
+
+void Connect::setGpsDevice(const QString &path, int baudRate, int rateHz)
+{
+    if (!m_gpsReceiver || path.isEmpty())
+        return;
+    m_gpsReceiver->open(path, baudRate, rateHz);
+    if (m_diagnosticsProvider) {
+        m_diagnosticsProvider->addLogMessage(QStringLiteral("INFO"),
+                                             QStringLiteral("GPS input from %1 at %2 baud").arg(path).arg(baudRate));
+    }
+}
+
+void Connect::setUdpInput(int port, const QString &identMapPath)
+{
+    if (!m_udpReceiver)
+        return;
+    if (!identMapPath.isEmpty() && !m_udpReceiver->loadIdentMap(identMapPath))
+        return;
+    if (m_udpReceiver->start(port) && m_diagnosticsProvider) {
+        m_diagnosticsProvider->addLogMessage(QStringLiteral("INFO"),
+                                             QStringLiteral("UDP sensor input on port %1").arg(port));
+    }
+}
+
+void Connect::setTelemetryBroadcast(const QString &host, int port, int rateHz)
+{
+    if (!m_telemetryBroadcaster)
+        return;
+    if (m_telemetryBroadcaster->start(host, port, rateHz) && m_diagnosticsProvider) {
+        const QString message = QStringLiteral("Telemetry broadcast to %1:%2 at %3 Hz")
+                                    .arg(host)
+                                    .arg(port)
+                                    .arg(m_telemetryBroadcaster->rateHz());
+        m_diagnosticsProvider->addLogMessage(QStringLiteral("INFO"), message);
+    }
+}
+
+void Connect::setSharedMemoryExport(const QString &name, int rateHz)
+{
+    if (!m_sharedMemoryPublisher)
+        return;
+    if (m_sharedMemoryPublisher->start(name, rateHz) && m_diagnosticsProvider) {
+        m_diagnosticsProvider->addLogMessage(QStringLiteral("INFO"),
+                                             QStringLiteral("Sensor snapshot in shared memory %1 (%2 slots)")
+                                                 .arg(name)
+                                                 .arg(m_sharedMemoryPublisher->slotCount()));
+    }
+}
+
+void Connect::openSavedCanConnection()
+{
+    // * EX Board is the only native CAN backend (see MainSettings.qml ecuBackendMap)
+    constexpr int EXBOARD_BACKEND = 5;
+    const int canBase = m_appSettings ? m_appSettings->getValue(QStringLiteral("ui/extenderCanBase"), 0).toInt() : 0;
+    const int rpmBase = m_appSettings ? m_appSettings->getValue(QStringLiteral("ui/shiftLightCanBase"), 0).toInt() : 0;
+    openConnection(QString(), EXBOARD_BACKEND, canBase, rpmBase);
+}
+
 void Connect::update()
 {
     if (m_updateManagerService)
@@ -31,6 +31,7 @@
 
 
 class datalogger;
+class LogPlayer;
 class calculations;
 class AppSettings;
 class WifiScanner;
@@ -39,6 +40,10 @@ class UIState;
 class EngineData;
 class VehicleData;
 class GPSData;
+class GpsReceiver;
+class UdpReceiver;
+class TelemetryBroadcaster;
+class SharedMemoryPublisher;
 class AnalogInputs;
 class DigitalInputs;
 class ExpanderBoardData;
@@ -50,6 +55,8 @@ class SteinhartCalculator;
 class CalibrationHelper;
 class SensorRegistry;
 class DiagnosticsProvider;
+class FrameTimingMonitor;
+class TraceRecorder;
 class OverlayPositionManager;
 class ShiftIndicatorHelper;
 class CanFrameModel;
@@ -63,6 +70,8 @@ class UpdateManagerService;
 class CanStartupManager;
 class CanTransport;
 class CanManager;
+class CanBusAnalyzer;
+class CanFrameRecorder;
 
 class Connect : public QObject
 {
@@ -116,6 +125,26 @@ public:
     Q_INVOKABLE void reboot();
     Q_INVOKABLE void turnscreen();
 
+    /**
+     * @brief Feed the CAN pipeline from a recorded candump or .ptcan log instead of can0.
+     * @param speed Playback speed relative to the recording; 0 replays as fast as possible
+     */
+    void setCanReplay(const QString &path, double speed);
+    /// Load a data log into the models and play it in a loop (dashboard profiling workload)
+    void setLogPlayback(const QString &path, double speed);
+    /**
+     * @brief Read NMEA from a serial GPS receiver (or a ptgpssim pty).
+     * @param rateHz If > 0, configure a u-blox receiver for this fix rate
+     */
+    void setGpsDevice(const QString &path, int baudRate, int rateHz);
+    /// Receive binary or legacy text sensor datagrams on @p port, idents mapped by @p identMapPath
+    void setUdpInput(int port, const QString &identMapPath);
+    /// Broadcast changed sensor values to pit-side viewers (Tools/pttelemetry) at @p host:@p port
+    void setTelemetryBroadcast(const QString &host, int port, int rateHz);
+    /// Publish every registered sensor into the POSIX shared-memory segment @p name (layout in ptshm.h)
+    void setSharedMemoryExport(const QString &name, int rateHz);
+    /// Open the EX Board module with the CAN base addresses saved in the settings
+    void openSavedCanConnection();
 
 public:
     QStringList portsNames() const { return m_portsNames; }
@@ -126,6 +155,7 @@ private:
 
     AppSettings *m_appSettings;
     datalogger *m_datalogger;
+    LogPlayer *m_logPlayer;
     calculations *m_calculations;
     QStringList m_portsNames;
     QStringList *m_ecuList;
@@ -138,6 +168,10 @@ private:
     EngineData *m_engineData;
     VehicleData *m_vehicleData;
     GPSData *m_gpsData;
+    GpsReceiver *m_gpsReceiver;
+    UdpReceiver *m_udpReceiver;
+    TelemetryBroadcaster *m_telemetryBroadcaster;
+    SharedMemoryPublisher *m_sharedMemoryPublisher;
     AnalogInputs *m_analogInputs;
     DigitalInputs *m_digitalInputs;
     ExpanderBoardData *m_expanderBoardData;
@@ -149,6 +183,8 @@ private:
     CalibrationHelper *m_calibrationHelper;
     SensorRegistry *m_sensorRegistry;
     DiagnosticsProvider *m_diagnosticsProvider;
+    FrameTimingMonitor *m_frameTimingMonitor;
+    TraceRecorder *m_traceRecorder;
     OverlayPositionManager *m_overlayConfigManager;
     ShiftIndicatorHelper *m_shiftIndicatorHelper;
     CanFrameModel *m_canFrameModel;
@@ -162,6 +198,8 @@ private:
     CanStartupManager *m_canStartupManager;
     CanTransport *m_canTransport;
     CanManager *m_canManager;
+    CanBusAnalyzer *m_canBusAnalyzer;
+    CanFrameRecorder *m_canFrameRecorder;
     BrightnessMethod m_brightnessMethod = BrightnessMethod::None;
 
     int m_ecu = 0;
@@ -179,6 +217,7 @@ signals:
     void sig_portsNamesChanged(QStringList portsNames);
     void connectionOpenResult(bool success, const QString &message);
     void connectionStateChanged(bool connected, const QString &statusMessage);
+    void canReplayFinished(qint64 frames, qint64 elapsedUs);
 
 public slots:
     void setPortsNames(QStringList portsNames)
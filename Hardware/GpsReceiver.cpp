@@ -0,0 +1,279 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file GpsReceiver.cpp
+ * @brief Implementation of the GpsReceiver class.
+ */
+
+#include "GpsReceiver.h"
+
+#include "../Core/Models/GPSData.h"
+#include "../Core/SensorRegistry.h"
+#include "../Core/TraceRecorder.h"
+
+#include <QFile>
+#include <QSocketNotifier>
+
+#include <chrono>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <termios.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+/// Same clock as the CAN frame timestamps
+qint64 wallClockUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+#ifdef Q_OS_UNIX
+speed_t baudConstant(int baudRate)
+{
+    switch (baudRate) {
+    case 9600:
+        return B9600;
+    case 19200:
+        return B19200;
+    case 38400:
+        return B38400;
+    case 57600:
+        return B57600;
+    case 230400:
+        return B230400;
+    #ifdef B460800
+    case 460800:
+        return B460800;
+    #endif
+    default:
+        return B115200;
+    }
+}
+#endif
+}  // namespace
+
+GpsReceiver::GpsReceiver(GPSData *gpsData, QObject *parent)
+    : QObject(parent),
+      m_gpsData(gpsData),
+      m_registryKeys({QStringLiteral("gpsLatitude"), QStringLiteral("gpsLongitude"), QStringLiteral("gpsAltitude"),
+                      QStringLiteral("gpsSpeed"), QStringLiteral("gpsbearing"),
+                      QStringLiteral("gpsVisibleSatelites")})
+{
+    m_silenceTimer.setSingleShot(true);
+    m_silenceTimer.setInterval(SILENCE_TIMEOUT_MS);
+    connect(&m_silenceTimer, &QTimer::timeout, this, &GpsReceiver::onSilence);
+    m_reopenTimer.setInterval(REOPEN_INTERVAL_MS);
+    connect(&m_reopenTimer, &QTimer::timeout, this, &GpsReceiver::reopen);
+}
+
+GpsReceiver::~GpsReceiver()
+{
+    closeDevice();
+}
+
+void GpsReceiver::setSensorRegistry(SensorRegistry *sensorRegistry)
+{
+    m_sensorRegistry = sensorRegistry;
+}
+
+bool GpsReceiver::open(const QString &device, int baudRate, int updateRateHz)
+{
+    close();
+    m_device = device;
+    m_baudRate = baudRate;
+    m_updateRateHz = updateRateHz;
+    if (openDevice())
+        return true;
+    emit errorOccurred(m_error);
+    m_reopenTimer.start();
+    return false;
+}
+
+void GpsReceiver::close()
+{
+    m_reopenTimer.stop();
+    m_silenceTimer.stop();
+    closeDevice();
+    clearFix();
+}
+
+bool GpsReceiver::openDevice()
+{
+#ifdef Q_OS_UNIX
+    const int fd = ::open(QFile::encodeName(m_device).constData(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        m_error = QStringLiteral("GPS: cannot open %1: %2").arg(m_device, QString::fromLocal8Bit(std::strerror(errno)));
+        return false;
+    }
+
+    // Raw 8N1, reads return whatever is buffered; ptys accept this too.
+    termios tio{};
+    if (::tcgetattr(fd, &tio) == 0) {
+        ::cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD;
+        ::cfsetispeed(&tio, baudConstant(m_baudRate));
+        ::cfsetospeed(&tio, baudConstant(m_baudRate));
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+        ::tcsetattr(fd, TCSANOW, &tio);
+        ::tcflush(fd, TCIFLUSH);
+    }
+
+    m_fd = fd;
+    m_fill = 0;
+    m_notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &GpsReceiver::onReadable);
+    m_reopenTimer.stop();
+    m_silenceTimer.start();
+    if (m_updateRateHz > 0)
+        writeUbxRate(m_updateRateHz);
+    emit connectedChanged();
+    return true;
+#else
+    m_error = QStringLiteral("GPS: serial input needs a POSIX system");
+    return false;
+#endif
+}
+
+void GpsReceiver::closeDevice()
+{
+    if (m_fd < 0)
+        return;
+    delete m_notifier;
+    m_notifier = nullptr;
+#ifdef Q_OS_UNIX
+    ::close(m_fd);
+#endif
+    m_fd = -1;
+    m_fill = 0;
+    emit connectedChanged();
+}
+
+void GpsReceiver::reopen()
+{
+    if (openDevice())
+        m_reopenTimer.stop();
+}
+
+void GpsReceiver::onReadable()
+{
+    PT_TRACE_SCOPE("gps.read");
+#ifdef Q_OS_UNIX
+    bool lost = false;
+    while (m_fill < READ_BUFFER_SIZE) {
+        const ssize_t n = ::read(m_fd, m_buffer + m_fill, READ_BUFFER_SIZE - m_fill);
+        if (n > 0) {
+            m_fill += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+            continue;
+        // EOF or EIO: the adapter was unplugged or the pty's writer went away.
+        lost = n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+        break;
+    }
+    const qint64 receivedUs = wallClockUs();
+
+    const quint64 sentencesBefore = m_parser.sentenceCount();
+    unsigned updates = 0;
+    const qsizetype consumed = m_parser.parse(m_buffer, m_fill, receivedUs, &updates);
+    if (consumed > 0) {
+        std::memmove(m_buffer, m_buffer + consumed, m_fill - consumed);
+        m_fill -= consumed;
+    }
+    if (m_parser.sentenceCount() != sentencesBefore) {
+        m_silenceTimer.start();
+        m_silenceReported = false;
+    }
+    if (updates != 0)
+        publish(updates);
+
+    if (lost) {
+        m_error = QStringLiteral("GPS: lost %1, reopening").arg(m_device);
+        emit errorOccurred(m_error);
+        m_silenceTimer.stop();
+        closeDevice();
+        clearFix();
+        m_reopenTimer.start();
+    }
+#endif
+}
+
+void GpsReceiver::onSilence()
+{
+    clearFix();
+    if (!m_silenceReported) {
+        m_silenceReported = true;
+        m_error = QStringLiteral("GPS: no valid NMEA from %1").arg(m_device);
+        emit errorOccurred(m_error);
+    }
+}
+
+void GpsReceiver::publish(unsigned updates)
+{
+    if (!m_gpsData)
+        return;
+    const GpsFix &fix = m_parser.fix();
+
+    if (updates & NmeaParser::QualityUpdated) {
+        m_gpsData->setgpsFixQuality(fix.valid ? qMax(1, fix.quality) : 0);
+        m_gpsData->setgpsVisibleSatelites(fix.satellites);
+        m_gpsData->setgpsHDOP(fix.hdop);
+        m_gpsData->setgpsAltitude(fix.altitude);
+    }
+    if (updates & NmeaParser::MotionUpdated) {
+        m_gpsData->setgpsSpeed(fix.speedKph);
+        m_gpsData->setgpsbearing(fix.course);
+    }
+    // GGA and RMC both carry the position; publish each epoch once.
+    if ((updates & NmeaParser::PositionUpdated) && fix.valid && (fix.utcMs < 0 || fix.utcMs != m_lastEpochMs)) {
+        m_lastEpochMs = fix.utcMs;
+        m_gpsData->setgpsLatitude(fix.latitude);
+        m_gpsData->setgpsLongitude(fix.longitude);
+        m_gpsData->setgpsUtcTime(fix.utcMs);
+        m_gpsData->setgpsTimestamp(fix.receivedUs);
+        if (m_sensorRegistry) {
+            for (const QString &key : m_registryKeys)
+                m_sensorRegistry->markCanSensorActive(key);
+        }
+        emit fixReceived(fix);
+    }
+}
+
+void GpsReceiver::clearFix()
+{
+    m_parser.reset();
+    m_lastEpochMs = -1;
+    if (!m_gpsData)
+        return;
+    m_gpsData->setgpsFixQuality(0);
+    m_gpsData->setgpsVisibleSatelites(0);
+    m_gpsData->setgpsSpeed(0);
+}
+
+bool GpsReceiver::writeUbxRate(int hz)
+{
+#ifdef Q_OS_UNIX
+    // UBX CFG-RATE: measurement period in ms, one fix per measurement, aligned to GPS time
+    const quint16 periodMs = static_cast<quint16>(1000 / qBound(1, hz, 25));
+    quint8 frame[14] = {0xB5, 0x62, 0x06, 0x08, 0x06, 0x00, static_cast<quint8>(periodMs & 0xFF),
+                        static_cast<quint8>(periodMs >> 8), 0x01, 0x00, 0x01, 0x00, 0x00, 0x00};
+    quint8 ckA = 0;
+    quint8 ckB = 0;
+    for (int i = 2; i < 12; ++i) {
+        ckA += frame[i];
+        ckB += ckA;
+    }
+    frame[12] = ckA;
+    frame[13] = ckB;
+    return ::write(m_fd, frame, sizeof(frame)) == static_cast<ssize_t>(sizeof(frame));
+#else
+    Q_UNUSED(hz);
+    return false;
+#endif
+}
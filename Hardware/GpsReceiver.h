@@ -0,0 +1,101 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file GpsReceiver.h
+ * @brief Serial NMEA GPS ingest: non-blocking reads, in-place parsing, timestamped fixes into GPSData.
+ *
+ * The device (a USB/UART receiver, or a pty from Tools/ptgpssim.cpp for
+ * bench testing) is opened non-blocking in raw mode and watched with a
+ * QSocketNotifier, so the GUI thread only runs when bytes arrive. Each read
+ * is parsed in place by NmeaParser and stamped with the same epoch
+ * microsecond clock as CAN frames.
+ *
+ * One fix is published per receiver epoch (GGA and RMC of the same second
+ * fraction count once), which keeps 10-25 Hz receivers at one model update
+ * per fix. If the receiver goes quiet the fix is dropped; if the device
+ * disappears it is reopened until it comes back.
+ */
+
+#ifndef GPSRECEIVER_H
+#define GPSRECEIVER_H
+
+#include "NmeaParser.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+class GPSData;
+class SensorRegistry;
+class QSocketNotifier;
+
+class GpsReceiver : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool connected READ isConnected NOTIFY connectedChanged)
+    Q_PROPERTY(QString device READ device NOTIFY connectedChanged)
+
+public:
+    static constexpr int READ_BUFFER_SIZE = 4096;
+    /// No valid sentence for this long drops the fix
+    static constexpr int SILENCE_TIMEOUT_MS = 3000;
+    static constexpr int REOPEN_INTERVAL_MS = 2000;
+
+    explicit GpsReceiver(GPSData *gpsData, QObject *parent = nullptr);
+    ~GpsReceiver() override;
+
+    void setSensorRegistry(SensorRegistry *sensorRegistry);
+
+    /**
+     * @brief Start reading NMEA from @p device.
+     * @param baudRate Line speed for serial devices (ignored for ptys)
+     * @param updateRateHz If > 0, ask a u-blox receiver for this navigation rate (1-25 Hz)
+     * @return false if the device cannot be opened now; it is retried in the background either way
+     */
+    Q_INVOKABLE bool open(const QString &device, int baudRate = 115200, int updateRateHz = 0);
+    Q_INVOKABLE void close();
+
+    bool isConnected() const { return m_fd >= 0; }
+    QString device() const { return m_device; }
+    const GpsFix &fix() const { return m_parser.fix(); }
+    QString errorString() const { return m_error; }
+
+signals:
+    void connectedChanged();
+    /// A new position epoch; fix.receivedUs is its receive time
+    void fixReceived(const GpsFix &fix);
+    void errorOccurred(const QString &message);
+
+private slots:
+    void onReadable();
+    void onSilence();
+    void reopen();
+
+private:
+    bool openDevice();
+    void closeDevice();
+    void publish(unsigned updates);
+    void clearFix();
+    bool writeUbxRate(int hz);
+
+    GPSData *m_gpsData = nullptr;
+    SensorRegistry *m_sensorRegistry = nullptr;
+    QString m_device;
+    QString m_error;
+    int m_baudRate = 115200;
+    int m_updateRateHz = 0;
+    int m_fd = -1;
+    QSocketNotifier *m_notifier = nullptr;
+    QTimer m_silenceTimer;
+    QTimer m_reopenTimer;
+
+    NmeaParser m_parser;
+    char m_buffer[READ_BUFFER_SIZE];
+    qsizetype m_fill = 0;
+    int m_lastEpochMs = -1;  ///< utcMs of the last published fix
+    bool m_silenceReported = false;
+    const QStringList m_registryKeys;
+};
+
+#endif  // GPSRECEIVER_H
@@ -0,0 +1,290 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file NmeaParser.cpp
+ * @brief Implementation of the NmeaParser class.
+ */
+
+#include "NmeaParser.h"
+
+#include <cstring>
+
+namespace {
+constexpr double KNOTS_TO_KPH = 1.852;
+constexpr double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12};
+
+/// One comma-separated field of a sentence, [begin, end)
+struct Field
+{
+    const char *begin = nullptr;
+    const char *end = nullptr;
+
+    bool isEmpty() const { return begin == end; }
+    char first() const { return isEmpty() ? '\0' : *begin; }
+};
+
+/// Splits the body of a sentence (after "$ttSSS," up to '*') without copying
+class FieldReader
+{
+public:
+    FieldReader(const char *begin, const char *end) : m_pos(begin), m_end(end) {}
+
+    Field next()
+    {
+        Field field;
+        field.begin = m_pos;
+        while (m_pos < m_end && *m_pos != ',')
+            ++m_pos;
+        field.end = m_pos;
+        if (m_pos < m_end)
+            ++m_pos;
+        return field;
+    }
+
+    void skip(int count)
+    {
+        for (int i = 0; i < count; ++i)
+            next();
+    }
+
+private:
+    const char *m_pos;
+    const char *m_end;
+};
+
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+/// Plain decimal ("-12.345"); false for an empty or malformed field
+bool toDouble(const Field &field, double &value)
+{
+    const char *p = field.begin;
+    bool negative = false;
+    if (p < field.end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+
+    qint64 mantissa = 0;
+    int fractionDigits = 0;
+    int digits = 0;
+    bool inFraction = false;
+    for (; p < field.end; ++p) {
+        if (*p == '.' && !inFraction) {
+            inFraction = true;
+            continue;
+        }
+        if (*p < '0' || *p > '9')
+            return false;
+        // Digits past the 12th fractional place are below any receiver's resolution.
+        if (inFraction && fractionDigits == 12)
+            continue;
+        if (++digits > 18)
+            return false;
+        mantissa = mantissa * 10 + (*p - '0');
+        if (inFraction)
+            ++fractionDigits;
+    }
+    if (digits == 0)
+        return false;
+    value = mantissa / POW10[fractionDigits];
+    if (negative)
+        value = -value;
+    return true;
+}
+
+bool toInt(const Field &field, int &value)
+{
+    double parsed = 0.0;
+    if (!toDouble(field, parsed))
+        return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+/// "ddmm.mmmm" / "dddmm.mmmm" plus hemisphere to signed degrees
+bool toDegrees(const Field &coordinate, const Field &hemisphere, double &degrees)
+{
+    double raw = 0.0;
+    if (!toDouble(coordinate, raw) || raw < 0.0)
+        return false;
+    const double whole = static_cast<double>(static_cast<qint64>(raw / 100.0));
+    degrees = whole + (raw - whole * 100.0) / 60.0;
+    const char h = hemisphere.first();
+    if (h == 'S' || h == 'W')
+        degrees = -degrees;
+    return h == 'N' || h == 'S' || h == 'E' || h == 'W';
+}
+
+/// "hhmmss.sss" to ms since midnight
+bool toTimeOfDay(const Field &field, int &utcMs)
+{
+    double raw = 0.0;
+    if (field.end - field.begin < 6 || !toDouble(field, raw))
+        return false;
+    const int whole = static_cast<int>(raw);
+    const int hours = whole / 10000;
+    const int minutes = (whole / 100) % 100;
+    const double seconds = raw - (whole - whole % 100);
+    if (hours > 23 || minutes > 59 || seconds >= 61.0)
+        return false;
+    utcMs = (hours * 3600 + minutes * 60) * 1000 + static_cast<int>(seconds * 1000.0 + 0.5);
+    return true;
+}
+
+bool isType(const char *sentence, const char *type)
+{
+    // "$" + two-character talker ID, then the sentence type
+    return std::memcmp(sentence + 3, type, 3) == 0;
+}
+}  // namespace
+
+bool NmeaParser::checksumValid(const char *begin, const char *end)
+{
+    if (end - begin < 4 || *begin != '$')
+        return false;
+    const char *star = end - 3;
+    if (*star != '*')
+        return false;
+    quint8 sum = 0;
+    for (const char *p = begin + 1; p < star; ++p)
+        sum ^= static_cast<quint8>(*p);
+    const int high = hexValue(star[1]);
+    const int low = hexValue(star[2]);
+    return high >= 0 && low >= 0 && sum == ((high << 4) | low);
+}
+
+qsizetype NmeaParser::parse(const char *data, qsizetype size, qint64 receivedUs, unsigned *updates)
+{
+    unsigned changed = 0;
+    qsizetype consumed = 0;
+    while (consumed < size) {
+        const char *start = static_cast<const char *>(std::memchr(data + consumed, '$', size - consumed));
+        if (!start) {
+            consumed = size;  // Nothing but noise
+            break;
+        }
+        const qsizetype startOffset = start - data;
+        const char *newline = static_cast<const char *>(std::memchr(start, '\n', size - startOffset));
+        if (!newline) {
+            // Incomplete: keep it for the next read unless it can no longer become a sentence.
+            consumed = size - startOffset > MAX_SENTENCE ? size : startOffset;
+            break;
+        }
+        consumed = newline + 1 - data;
+
+        const char *end = newline;
+        if (end > start && end[-1] == '\r')
+            --end;
+        if (end - start > MAX_SENTENCE)
+            continue;
+        // A '$' inside the line means the previous sentence was cut off; restart at the later one.
+        const char *restart = static_cast<const char *>(std::memchr(start + 1, '$', end - start - 1));
+        if (restart) {
+            consumed = restart - data;
+            continue;
+        }
+        if (!checksumValid(start, end)) {
+            ++m_checksumErrors;
+            continue;
+        }
+        ++m_sentences;
+        changed |= parseSentence(start, end - 3, receivedUs);
+    }
+    if (updates)
+        *updates = changed;
+    return consumed;
+}
+
+unsigned NmeaParser::parseSentence(const char *begin, const char *end, qint64 receivedUs)
+{
+    if (end - begin < 7 || begin[6] != ',')
+        return 0;
+    FieldReader fields(begin + 7, end);
+    unsigned changed = 0;
+
+    if (isType(begin, "GGA")) {
+        // time, lat, N/S, lon, E/W, quality, satellites, hdop, altitude, M, ...
+        const Field time = fields.next();
+        const Field latitude = fields.next();
+        const Field ns = fields.next();
+        const Field longitude = fields.next();
+        const Field ew = fields.next();
+        int quality = 0;
+        toInt(fields.next(), quality);
+        int satellites = 0;
+        toInt(fields.next(), satellites);
+        double hdop = 0.0;
+        toDouble(fields.next(), hdop);
+        double altitude = m_fix.altitude;
+        toDouble(fields.next(), altitude);
+
+        m_fix.quality = quality;
+        m_fix.satellites = satellites;
+        m_fix.hdop = hdop;
+        m_fix.altitude = altitude;
+        changed |= QualityUpdated;
+
+        double lat = 0.0;
+        double lon = 0.0;
+        if (quality > 0 && toDegrees(latitude, ns, lat) && toDegrees(longitude, ew, lon)) {
+            toTimeOfDay(time, m_fix.utcMs);
+            m_fix.latitude = lat;
+            m_fix.longitude = lon;
+            m_fix.valid = true;
+            m_fix.receivedUs = receivedUs;
+            changed |= PositionUpdated;
+        } else if (quality == 0) {
+            m_fix.valid = false;
+        }
+    } else if (isType(begin, "RMC")) {
+        // time, status, lat, N/S, lon, E/W, speed (knots), course, date, ...
+        const Field time = fields.next();
+        const Field status = fields.next();
+        const Field latitude = fields.next();
+        const Field ns = fields.next();
+        const Field longitude = fields.next();
+        const Field ew = fields.next();
+        const Field speed = fields.next();
+        const Field course = fields.next();
+        if (status.first() != 'A') {
+            m_fix.valid = false;
+            return QualityUpdated;
+        }
+
+        double lat = 0.0;
+        double lon = 0.0;
+        if (toDegrees(latitude, ns, lat) && toDegrees(longitude, ew, lon)) {
+            toTimeOfDay(time, m_fix.utcMs);
+            m_fix.latitude = lat;
+            m_fix.longitude = lon;
+            m_fix.valid = true;
+            m_fix.receivedUs = receivedUs;
+            changed |= PositionUpdated;
+        }
+        double knots = 0.0;
+        if (toDouble(speed, knots)) {
+            m_fix.speedKph = knots * KNOTS_TO_KPH;
+            changed |= MotionUpdated;
+        }
+        // Course is empty while stationary; keep the last one.
+        if (toDouble(course, m_fix.course))
+            changed |= MotionUpdated;
+    } else if (isType(begin, "VTG")) {
+        // course true, T, course magnetic, M, speed knots, N, speed km/h, K, mode
+        const Field course = fields.next();
+        fields.skip(5);
+        const Field speedKph = fields.next();
+        if (toDouble(speedKph, m_fix.speedKph))
+            changed |= MotionUpdated;
+        if (toDouble(course, m_fix.course))
+            changed |= MotionUpdated;
+    }
+    return changed;
+}
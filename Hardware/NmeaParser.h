@@ -0,0 +1,75 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file NmeaParser.h
+ * @brief In-place NMEA 0183 parser for GGA, RMC and VTG sentences.
+ *
+ * parse() works directly on the caller's receive buffer: it finds complete
+ * sentences, checks their XOR checksum and reads the fields by pointer,
+ * with no per-sentence allocation, string copies or locale-dependent
+ * number parsing. Any talker is accepted ($GP, $GN, $GL, ...). Bytes that
+ * are not part of a sentence (u-blox UBX replies, line noise) are skipped.
+ *
+ * A sentence needs at most 82 characters, so at 115200 baud even a 25 Hz
+ * receiver sending GGA + RMC per epoch uses well under half the line.
+ */
+
+#ifndef NMEAPARSER_H
+#define NMEAPARSER_H
+
+#include <QtGlobal>
+
+struct GpsFix
+{
+    qint64 receivedUs = 0;   ///< Receive time of the sentence that completed the fix (epoch microseconds)
+    int utcMs = -1;          ///< Time of day of the fix, ms since 00:00 UTC
+    double latitude = 0.0;   ///< Degrees, south negative
+    double longitude = 0.0;  ///< Degrees, west negative
+    double altitude = 0.0;   ///< Metres above mean sea level
+    double speedKph = 0.0;
+    double course = 0.0;  ///< Degrees true
+    double hdop = 0.0;
+    int satellites = 0;
+    int quality = 0;  ///< GGA fix quality, 0 = no fix
+    bool valid = false;
+};
+
+class NmeaParser
+{
+public:
+    /// Longest sentence accepted, with some slack over the 82 the standard allows
+    static constexpr int MAX_SENTENCE = 128;
+
+    enum Update : unsigned {
+        PositionUpdated = 1u << 0,  ///< New latitude / longitude from a valid GGA or RMC
+        MotionUpdated = 1u << 1,    ///< Speed or course
+        QualityUpdated = 1u << 2,   ///< Fix quality, satellites, HDOP or altitude
+    };
+
+    /**
+     * @brief Parse every complete sentence at the start of @p data.
+     * @param receivedUs Receive time stamped on the fixes these sentences produce
+     * @param updates Receives the Update bits of everything that changed
+     * @return Bytes consumed; the caller keeps the rest (an incomplete sentence) for the next read
+     */
+    qsizetype parse(const char *data, qsizetype size, qint64 receivedUs, unsigned *updates);
+
+    const GpsFix &fix() const { return m_fix; }
+    /// Forget the fix, e.g. after the receiver went quiet
+    void reset() { m_fix = GpsFix(); }
+
+    quint64 sentenceCount() const { return m_sentences; }
+    quint64 checksumErrors() const { return m_checksumErrors; }
+
+    /// True if [@p begin, @p end) is "$...*hh" with a matching checksum
+    static bool checksumValid(const char *begin, const char *end);
+
+private:
+    unsigned parseSentence(const char *begin, const char *end, qint64 receivedUs);
+
+    GpsFix m_fix;
+    quint64 m_sentences = 0;
+    quint64 m_checksumErrors = 0;
+};
+
+#endif  // NMEAPARSER_H
@@ -0,0 +1,322 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file SharedMemoryPublisher.cpp
+ * @brief Implementation of the SharedMemoryPublisher class.
+ */
+
+#include "SharedMemoryPublisher.h"
+
+#include "../Core/PropertyRouter.h"
+#include "../Core/SensorRegistry.h"
+#include "../Core/TraceRecorder.h"
+
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+
+#ifdef Q_OS_UNIX
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+static_assert(sizeof(pt_shm_header) == PT_SHM_HEADER_SIZE, "ptshm.h header layout changed");
+static_assert(offsetof(pt_shm_header, sequence) == 64, "seqlock must start its own cache line");
+
+namespace {
+constexpr size_t CACHE_LINE = 64;
+
+size_t alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/// Property read straight through the meta-call, without a QVariant
+template <typename T>
+T readDirect(QObject *model, int propertyIndex)
+{
+    T value = T();
+    int status = -1;
+    void *argv[] = {&value, nullptr, &status};
+    QMetaObject::metacall(model, QMetaObject::ReadProperty, propertyIndex, argv);
+    return value;
+}
+
+/// Copy @p text into a fixed-size, NUL-terminated schema field
+void writeField(char *field, int size, const QByteArray &text)
+{
+    const int length = qMin(static_cast<int>(text.size()), size - 1);
+    std::memcpy(field, text.constData(), static_cast<size_t>(length));
+    field[length] = '\0';
+}
+
+QString systemError()
+{
+    return QString::fromLocal8Bit(std::strerror(errno));
+}
+}  // namespace
+
+SharedMemoryPublisher::SharedMemoryPublisher(QObject *parent) : QObject(parent)
+{
+    m_publishTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_publishTimer, &QTimer::timeout, this, &SharedMemoryPublisher::publish);
+    m_statsTimer.setInterval(STATS_INTERVAL_MS);
+    connect(&m_statsTimer, &QTimer::timeout, this, &SharedMemoryPublisher::statsChanged);
+}
+
+SharedMemoryPublisher::~SharedMemoryPublisher()
+{
+    stop();
+}
+
+void SharedMemoryPublisher::setPropertyRouter(PropertyRouter *propertyRouter)
+{
+    m_propertyRouter = propertyRouter;
+}
+
+void SharedMemoryPublisher::setSensorRegistry(SensorRegistry *sensorRegistry)
+{
+    if (m_sensorRegistry)
+        disconnect(m_sensorRegistry, nullptr, this, nullptr);
+    m_sensorRegistry = sensorRegistry;
+    if (m_sensorRegistry)
+        connect(m_sensorRegistry, &SensorRegistry::sensorsChanged, this, &SharedMemoryPublisher::onSensorsChanged);
+}
+
+bool SharedMemoryPublisher::start(const QString &name, int rateHz)
+{
+    stop();
+
+    // POSIX names are "/name" with no further slashes
+    if (name.size() < 2 || !name.startsWith(QLatin1Char('/')) || name.indexOf(QLatin1Char('/'), 1) >= 0) {
+        emit errorOccurred(QStringLiteral("Shared memory: invalid segment name %1").arg(name));
+        return false;
+    }
+    if (!m_sensorRegistry || !m_propertyRouter) {
+        emit errorOccurred(QStringLiteral("Shared memory: no sensor registry"));
+        return false;
+    }
+
+    m_name = name;
+    m_rateHz = qBound(1, rateHz, MAX_RATE_HZ);
+    bindSlots();
+    if (!createSegment())
+        return false;
+
+    m_publishCount = 0;
+    publish();
+    m_publishTimer.start(1000 / m_rateHz);
+    m_statsTimer.start();
+    emit runningChanged();
+    return true;
+}
+
+void SharedMemoryPublisher::stop()
+{
+    if (!m_header)
+        return;
+
+    m_publishTimer.stop();
+    m_statsTimer.stop();
+    releaseSegment();
+    emit statsChanged();
+    emit runningChanged();
+}
+
+void SharedMemoryPublisher::onSensorsChanged()
+{
+    // Also emitted for active-state changes, which leave the schema as it is.
+    if (!m_header || !schemaChanged())
+        return;
+
+    releaseSegment();
+    bindSlots();
+    if (!createSegment()) {
+        m_publishTimer.stop();
+        m_statsTimer.stop();
+    } else {
+        publish();
+    }
+    emit runningChanged();
+}
+
+bool SharedMemoryPublisher::schemaChanged() const
+{
+    if (m_sensorRegistry->sensorKeys() != m_keys)
+        return true;
+    // Units and decimals are written only when the segment is created (EXSpeed's unit is a setting).
+    for (const Slot &slot : m_slots) {
+        const QString key = QString::fromUtf8(slot.key);
+        if (m_sensorRegistry->canonicalUnit(key).toUtf8() != slot.unit
+            || m_sensorRegistry->getDecimals(key) != slot.decimals)
+            return true;
+    }
+    return false;
+}
+
+void SharedMemoryPublisher::bindSlots()
+{
+    m_slots.clear();
+    m_keys = m_sensorRegistry->sensorKeys();
+    for (const QString &key : std::as_const(m_keys)) {
+        Slot slot;
+        if (!m_propertyRouter->resolveProperty(key, &slot.model, &slot.propertyIndex))
+            continue;
+        slot.property = slot.model->metaObject()->property(slot.propertyIndex);
+        switch (slot.property.metaType().id()) {
+        case QMetaType::Double:
+            slot.kind = Slot::Kind::Double;
+            break;
+        case QMetaType::Int:
+            slot.kind = Slot::Kind::Int;
+            break;
+        case QMetaType::Float:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Bool:
+            break;
+        default:
+            continue;
+        }
+        slot.key = key.toUtf8();
+        slot.unit = m_sensorRegistry->canonicalUnit(key).toUtf8();
+        slot.decimals = m_sensorRegistry->getDecimals(key);
+        m_slots.append(slot);
+    }
+    m_values.fill(0.0, m_slots.size());
+}
+
+bool SharedMemoryPublisher::createSegment()
+{
+#ifdef Q_OS_UNIX
+    const QByteArray name = m_name.toLocal8Bit();
+
+    // A segment left by an earlier run (or another dash instance) may still be mapped by readers:
+    // tell them to reopen before it is unlinked.
+    const int oldFd = ::shm_open(name.constData(), O_RDWR, 0);
+    if (oldFd >= 0) {
+        struct stat info = {};
+        if (::fstat(oldFd, &info) == 0 && info.st_size >= PT_SHM_HEADER_SIZE) {
+            void *old = ::mmap(nullptr, PT_SHM_HEADER_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, oldFd, 0);
+            if (old != MAP_FAILED) {
+                auto *oldHeader = static_cast<pt_shm_header *>(old);
+                if (oldHeader->magic == PT_SHM_MAGIC)
+                    __atomic_store_n(&oldHeader->state, PT_SHM_STATE_STALE, __ATOMIC_RELEASE);
+                ::munmap(old, PT_SHM_HEADER_SIZE);
+            }
+        }
+        ::close(oldFd);
+        ::shm_unlink(name.constData());
+    }
+
+    const auto count = static_cast<size_t>(m_slots.size());
+    const size_t keysOffset = PT_SHM_HEADER_SIZE;
+    const size_t unitsOffset = keysOffset + count * PT_SHM_KEY_SIZE;
+    const size_t decimalsOffset = unitsOffset + count * PT_SHM_UNIT_SIZE;
+    const size_t valuesOffset = alignUp(decimalsOffset + count, CACHE_LINE);
+    const size_t totalSize = alignUp(valuesOffset + count * sizeof(double), CACHE_LINE);
+
+    const int fd = ::shm_open(name.constData(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        emit errorOccurred(QStringLiteral("Shared memory: cannot create %1: %2").arg(m_name, systemError()));
+        return false;
+    }
+    void *mapping = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(totalSize)) == 0)
+        mapping = ::mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        emit errorOccurred(QStringLiteral("Shared memory: cannot map %1: %2").arg(m_name, systemError()));
+        ::close(fd);
+        ::shm_unlink(name.constData());
+        return false;
+    }
+    ::close(fd);
+
+    // The new object is zero-filled; the schema is written once here.
+    char *base = static_cast<char *>(mapping);
+    for (size_t i = 0; i < count; ++i) {
+        const Slot &slot = m_slots.at(static_cast<int>(i));
+        writeField(base + keysOffset + i * PT_SHM_KEY_SIZE, PT_SHM_KEY_SIZE, slot.key);
+        writeField(base + unitsOffset + i * PT_SHM_UNIT_SIZE, PT_SHM_UNIT_SIZE, slot.unit);
+        base[decimalsOffset + i] = static_cast<char>(qBound(0, slot.decimals, 255));
+    }
+
+    auto *header = static_cast<pt_shm_header *>(mapping);
+    header->version = PT_SHM_VERSION;
+    header->header_size = PT_SHM_HEADER_SIZE;
+    header->slot_count = static_cast<uint32_t>(count);
+    header->total_size = totalSize;
+    header->keys_offset = static_cast<uint32_t>(keysOffset);
+    header->units_offset = static_cast<uint32_t>(unitsOffset);
+    header->decimals_offset = static_cast<uint32_t>(decimalsOffset);
+    header->values_offset = static_cast<uint32_t>(valuesOffset);
+    header->publish_hz = static_cast<uint32_t>(m_rateHz);
+    header->publisher_pid = static_cast<uint32_t>(::getpid());
+    header->state = PT_SHM_STATE_LIVE;
+    // Magic last: a reader that maps the segment mid-setup sees pt_shm_check() fail and retries.
+    __atomic_store_n(&header->magic, PT_SHM_MAGIC, __ATOMIC_RELEASE);
+
+    m_header = header;
+    m_mappedSize = totalSize;
+    m_sharedValues = reinterpret_cast<double *>(base + valuesOffset);
+    return true;
+#else
+    emit errorOccurred(QStringLiteral("Shared memory: %1 is not supported on this platform").arg(m_name));
+    return false;
+#endif
+}
+
+void SharedMemoryPublisher::releaseSegment()
+{
+#ifdef Q_OS_UNIX
+    if (m_header) {
+        __atomic_store_n(&m_header->state, PT_SHM_STATE_STALE, __ATOMIC_RELEASE);
+        ::munmap(m_header, m_mappedSize);
+        ::shm_unlink(m_name.toLocal8Bit().constData());
+    }
+#endif
+    m_header = nullptr;
+    m_mappedSize = 0;
+    m_sharedValues = nullptr;
+}
+
+void SharedMemoryPublisher::publish()
+{
+    if (!m_header)
+        return;
+
+    PT_TRACE_SCOPE("shm.publish");
+    double *values = m_values.data();
+    for (int i = 0; i < m_slots.size(); ++i) {
+        const Slot &slot = m_slots.at(i);
+        switch (slot.kind) {
+        case Slot::Kind::Double:
+            values[i] = readDirect<double>(slot.model, slot.propertyIndex);
+            break;
+        case Slot::Kind::Int:
+            values[i] = readDirect<int>(slot.model, slot.propertyIndex);
+            break;
+        case Slot::Kind::Other:
+            values[i] = slot.property.read(slot.model).toDouble();
+            break;
+        }
+    }
+
+    timespec now{};
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    ++m_publishCount;
+
+    // Seqlock write (this is the only writer): odd, copy, even. The release fence keeps the copy
+    // from becoming visible before the odd sequence does.
+    const uint64_t sequence = m_header->sequence;
+    __atomic_store_n(&m_header->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    std::memcpy(m_sharedValues, values, static_cast<size_t>(m_values.size()) * sizeof(double));
+    m_header->timestamp_ns = static_cast<uint64_t>(now.tv_sec) * 1000000000u + static_cast<uint64_t>(now.tv_nsec);
+    m_header->publish_count = m_publishCount;
+    __atomic_store_n(&m_header->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file SharedMemoryPublisher.h
+ * @brief Live sensor snapshot in POSIX shared memory for co-processes on the same device.
+ *
+ * Video overlays and loggers running beside the dash read every registered
+ * sensor straight from a shared-memory segment (layout in ptshm.h) instead
+ * of a socket. On each publish tick the GUI thread reads the model
+ * properties into a local array, then copies it into the segment under a
+ * seqlock; readers retry instead of locking, so no reader can stall the
+ * dash. QSharedMemory is not used: its segments are keyed and locked for
+ * Qt peers, not plain shm_open() readers.
+ *
+ * The slot list follows SensorRegistry: when its keys, or a sensor's unit
+ * or decimals, change the segment is marked stale, unlinked and recreated
+ * with the new schema.
+ */
+
+#ifndef SHAREDMEMORYPUBLISHER_H
+#define SHAREDMEMORYPUBLISHER_H
+
+#include "ptshm.h"
+
+#include <QByteArray>
+#include <QMetaProperty>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+class PropertyRouter;
+class SensorRegistry;
+
+class SharedMemoryPublisher : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(QString segmentName READ segmentName NOTIFY runningChanged)
+    Q_PROPERTY(int rateHz READ rateHz NOTIFY runningChanged)
+    Q_PROPERTY(int slotCount READ slotCount NOTIFY runningChanged)
+    Q_PROPERTY(double publishCount READ publishCount NOTIFY statsChanged)
+
+public:
+    static constexpr int DEFAULT_RATE_HZ = 50;
+    static constexpr int MAX_RATE_HZ = 200;
+    static constexpr int STATS_INTERVAL_MS = 1000;
+
+    explicit SharedMemoryPublisher(QObject *parent = nullptr);
+    ~SharedMemoryPublisher() override;
+
+    void setPropertyRouter(PropertyRouter *propertyRouter);
+    void setSensorRegistry(SensorRegistry *sensorRegistry);
+
+    /**
+     * @brief Create the segment @p name ("/name") and publish @p rateHz snapshots per second.
+     *
+     * A segment of the same name left by an earlier run is marked stale and
+     * replaced. A running export is restarted.
+     * @return false if the segment cannot be created
+     */
+    Q_INVOKABLE bool start(const QString &name = QStringLiteral(PT_SHM_DEFAULT_NAME), int rateHz = DEFAULT_RATE_HZ);
+    /// Mark the segment stale and unlink it; readers that still map it keep the last snapshot
+    Q_INVOKABLE void stop();
+
+    bool isRunning() const { return m_header != nullptr; }
+    QString segmentName() const { return m_name; }
+    int rateHz() const { return m_rateHz; }
+    int slotCount() const { return m_slots.size(); }
+    double publishCount() const { return static_cast<double>(m_publishCount); }
+
+signals:
+    void runningChanged();
+    void statsChanged();
+    void errorOccurred(const QString &message);
+
+private slots:
+    void publish();
+    void onSensorsChanged();
+
+private:
+    struct Slot
+    {
+        enum class Kind { Double, Int, Other };
+
+        QObject *model = nullptr;
+        QMetaProperty property;
+        int propertyIndex = -1;
+        Kind kind = Kind::Other;
+        QByteArray key;
+        QByteArray unit;
+        int decimals = 0;
+    };
+
+    void bindSlots();
+    /// @return true if the registry's keys, units or decimals no longer match the bound slots
+    bool schemaChanged() const;
+    bool createSegment();
+    void releaseSegment();
+
+    PropertyRouter *m_propertyRouter = nullptr;
+    SensorRegistry *m_sensorRegistry = nullptr;
+    QString m_name;
+    int m_rateHz = DEFAULT_RATE_HZ;
+    QStringList m_keys;  ///< SensorRegistry keys the slots were bound from
+    QVector<Slot> m_slots;
+    QVector<double> m_values;
+
+    pt_shm_header *m_header = nullptr;
+    size_t m_mappedSize = 0;
+    double *m_sharedValues = nullptr;
+    quint64 m_publishCount = 0;
+
+    QTimer m_publishTimer;
+    QTimer m_statsTimer;
+};
+
+#endif  // SHAREDMEMORYPUBLISHER_H
@@ -0,0 +1,389 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file TelemetryBroadcaster.cpp
+ * @brief Implementation of the TelemetryBroadcaster class.
+ */
+
+#include "TelemetryBroadcaster.h"
+
+#include "../Core/PropertyRouter.h"
+#include "../Core/SensorRegistry.h"
+#include "../Core/TraceRecorder.h"
+
+#include <QThread>
+
+#include <cmath>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+    #include <arpa/inet.h>
+    #include <cerrno>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+/// Worst-case data record: two 10-byte varints
+constexpr int MAX_DATA_RECORD = 20;
+/// Quantized values are kept well inside qint64
+constexpr double MAX_QUANTIZED = 9.0e15;
+
+bool isNumericProperty(const QMetaProperty &property)
+{
+    switch (property.metaType().id()) {
+    case QMetaType::Double:
+    case QMetaType::Float:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Bool:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// CPU time consumed by the calling thread, or 0 where it cannot be measured
+qint64 threadCpuUs()
+{
+#ifdef Q_OS_UNIX
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return static_cast<qint64>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#endif
+    return 0;
+}
+
+/// Property read straight through the meta-call, without a QVariant
+template <typename T>
+T readDirect(QObject *model, int propertyIndex)
+{
+    T value = T();
+    int status = -1;
+    void *argv[] = {&value, nullptr, &status};
+    QMetaObject::metacall(model, QMetaObject::ReadProperty, propertyIndex, argv);
+    return value;
+}
+}  // namespace
+
+TelemetryBroadcaster::TelemetryBroadcaster(QObject *parent) : QObject(parent)
+{
+    m_snapshotTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_snapshotTimer, &QTimer::timeout, this, &TelemetryBroadcaster::takeSnapshot);
+    m_statsTimer.setInterval(STATS_INTERVAL_MS);
+    connect(&m_statsTimer, &QTimer::timeout, this, &TelemetryBroadcaster::updateStats);
+}
+
+TelemetryBroadcaster::~TelemetryBroadcaster()
+{
+    stop();
+}
+
+void TelemetryBroadcaster::setPropertyRouter(PropertyRouter *propertyRouter)
+{
+    m_propertyRouter = propertyRouter;
+}
+
+void TelemetryBroadcaster::setSensorRegistry(SensorRegistry *sensorRegistry)
+{
+    m_sensorRegistry = sensorRegistry;
+}
+
+bool TelemetryBroadcaster::start(const QString &host, int port, int rateHz)
+{
+    stop();
+
+    if (!bindChannels())
+        return false;
+    if (!openSocket(host, port))
+        return false;
+
+    m_rateHz = qBound(1, rateHz, MAX_RATE_HZ);
+    m_destination = QStringLiteral("%1:%2").arg(host).arg(port);
+    const int channels = m_channels.size();
+    m_front.fill(0.0, channels);
+    m_back.fill(0.0, channels);
+    m_work.fill(0.0, channels);
+    m_sent.fill(0, channels);
+    m_datagram.resize(Telemetry::MAX_DATAGRAM_SIZE);
+    m_backPending = false;
+    m_stopRequested = false;
+    m_sequence = 0;
+    m_lastKeyframeMs = -1;
+    m_lastSchemaMs = -1;
+    m_sendFailing = false;
+    m_packetsSent.store(0);
+    m_bytesSent.store(0);
+    m_snapshotsDropped.store(0);
+    m_cpuUs.store(0);
+    m_statsCpuUs = 0;
+    m_statsTimeMs = 0;
+    m_cpuPercent = 0.0;
+
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName(QStringLiteral("Telemetry"));
+    m_thread->start(QThread::LowPriority);
+    m_clock.start();
+    m_snapshotTimer.start(1000 / m_rateHz);
+    m_statsTimer.start();
+    emit runningChanged();
+    return true;
+}
+
+void TelemetryBroadcaster::stop()
+{
+    if (!m_thread)
+        return;
+
+    m_snapshotTimer.stop();
+    m_statsTimer.stop();
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopRequested = true;
+        m_wake.wakeOne();
+    }
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+    closeSocket();
+    emit statsChanged();
+    emit runningChanged();
+}
+
+bool TelemetryBroadcaster::bindChannels()
+{
+    m_channels.clear();
+    if (!m_sensorRegistry || !m_propertyRouter) {
+        emit errorOccurred(QStringLiteral("Telemetry: no sensor registry"));
+        return false;
+    }
+
+    const QStringList keys = m_sensorRegistry->sensorKeys();
+    for (const QString &key : keys) {
+        Channel channel;
+        if (!m_propertyRouter->resolveProperty(key, &channel.model, &channel.propertyIndex))
+            continue;
+        channel.property = channel.model->metaObject()->property(channel.propertyIndex);
+        if (!isNumericProperty(channel.property))
+            continue;
+        if (channel.property.metaType().id() == QMetaType::Double)
+            channel.kind = Channel::Kind::Double;
+        else if (channel.property.metaType().id() == QMetaType::Int)
+            channel.kind = Channel::Kind::Int;
+        channel.key = key.toUtf8().left(255);
+        channel.unit = m_sensorRegistry->canonicalUnit(key).toUtf8().left(255);
+        channel.decimals = qBound(0, m_sensorRegistry->getDecimals(key), Telemetry::MAX_DECIMALS);
+        channel.scale = Telemetry::scaleForDecimals(channel.decimals);
+        m_channels.append(channel);
+        if (m_channels.size() == Telemetry::MAX_CHANNELS)
+            break;
+    }
+    if (m_channels.isEmpty()) {
+        emit errorOccurred(QStringLiteral("Telemetry: no channels to broadcast"));
+        return false;
+    }
+    return true;
+}
+
+bool TelemetryBroadcaster::openSocket(const QString &host, int port)
+{
+#ifdef Q_OS_UNIX
+    in_addr address = {};
+    if (port <= 0 || port > 0xFFFF || ::inet_pton(AF_INET, host.toLatin1().constData(), &address) != 1) {
+        emit errorOccurred(QStringLiteral("Telemetry: invalid destination %1:%2").arg(host).arg(port));
+        return false;
+    }
+    // Non-blocking: a full send buffer drops the datagram rather than stalling the packer.
+    m_fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (m_fd < 0) {
+        emit errorOccurred(
+            QStringLiteral("Telemetry: socket failed: %1").arg(QString::fromLocal8Bit(std::strerror(errno))));
+        return false;
+    }
+    m_address = ntohl(address.s_addr);
+    m_port = static_cast<quint16>(port);
+    if (IN_MULTICAST(m_address)) {
+        const int ttl = MULTICAST_TTL;
+        ::setsockopt(m_fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    }
+    return true;
+#else
+    emit errorOccurred(QStringLiteral("Telemetry: UDP broadcast to %1:%2 is not supported here").arg(host).arg(port));
+    return false;
+#endif
+}
+
+void TelemetryBroadcaster::closeSocket()
+{
+#ifdef Q_OS_UNIX
+    if (m_fd >= 0)
+        ::close(m_fd);
+#endif
+    m_fd = -1;
+}
+
+// ---------------------------------------------------------------------------
+// GUI thread
+// ---------------------------------------------------------------------------
+
+void TelemetryBroadcaster::takeSnapshot()
+{
+    PT_TRACE_SCOPE("telemetry.snapshot");
+    const qint64 cpuStartUs = threadCpuUs();
+    double *values = m_front.data();
+    for (int i = 0; i < m_channels.size(); ++i) {
+        const Channel &channel = m_channels.at(i);
+        switch (channel.kind) {
+        case Channel::Kind::Double:
+            values[i] = readDirect<double>(channel.model, channel.propertyIndex);
+            break;
+        case Channel::Kind::Int:
+            values[i] = readDirect<int>(channel.model, channel.propertyIndex);
+            break;
+        case Channel::Kind::Other:
+            values[i] = channel.property.read(channel.model).toDouble();
+            break;
+        }
+    }
+    m_cpuUs.fetch_add(threadCpuUs() - cpuStartUs, std::memory_order_relaxed);
+
+    QMutexLocker locker(&m_mutex);
+    if (m_backPending)
+        m_snapshotsDropped.fetch_add(1, std::memory_order_relaxed);
+    m_front.swap(m_back);
+    m_backTimeMs = m_clock.elapsed();
+    m_backPending = true;
+    m_wake.wakeOne();
+}
+
+void TelemetryBroadcaster::updateStats()
+{
+    const qint64 nowMs = m_clock.elapsed();
+    const qint64 cpuUs = m_cpuUs.load(std::memory_order_relaxed);
+    if (nowMs > m_statsTimeMs)
+        m_cpuPercent = static_cast<double>(cpuUs - m_statsCpuUs) / static_cast<double>(nowMs - m_statsTimeMs) / 10.0;
+    m_statsCpuUs = cpuUs;
+    m_statsTimeMs = nowMs;
+    emit statsChanged();
+}
+
+// ---------------------------------------------------------------------------
+// Packer thread
+// ---------------------------------------------------------------------------
+
+void TelemetryBroadcaster::run()
+{
+    for (;;) {
+        qint64 timeMs = 0;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (!m_backPending && !m_stopRequested)
+                m_wake.wait(&m_mutex);
+            if (m_stopRequested)
+                break;
+            m_work.swap(m_back);
+            m_backPending = false;
+            timeMs = m_backTimeMs;
+        }
+        const qint64 cpuStartUs = threadCpuUs();
+        pack(timeMs);
+        m_cpuUs.fetch_add(threadCpuUs() - cpuStartUs, std::memory_order_relaxed);
+    }
+}
+
+void TelemetryBroadcaster::pack(qint64 timeMs)
+{
+    PT_TRACE_SCOPE("telemetry.pack");
+    const char *end = m_datagram.constData() + Telemetry::MAX_DATAGRAM_SIZE;
+
+    if (m_lastSchemaMs < 0 || timeMs - m_lastSchemaMs >= SCHEMA_INTERVAL_MS) {
+        beginDatagram(Telemetry::Type::Schema);
+        for (int id = 0; id < m_channels.size(); ++id) {
+            const Channel &channel = m_channels.at(id);
+            if (end - m_cursor < 13 + channel.key.size() + channel.unit.size()) {
+                sendDatagram(timeMs);
+                beginDatagram(Telemetry::Type::Schema);
+            }
+            m_cursor = Telemetry::writeVarint(m_cursor, static_cast<quint64>(id - m_previousId - 1));
+            *m_cursor++ = static_cast<char>(channel.decimals);
+            *m_cursor++ = static_cast<char>(channel.key.size());
+            std::memcpy(m_cursor, channel.key.constData(), channel.key.size());
+            m_cursor += channel.key.size();
+            *m_cursor++ = static_cast<char>(channel.unit.size());
+            std::memcpy(m_cursor, channel.unit.constData(), channel.unit.size());
+            m_cursor += channel.unit.size();
+            m_previousId = id;
+            ++m_header.recordCount;
+        }
+        sendDatagram(timeMs);
+        m_lastSchemaMs = timeMs;
+    }
+
+    const bool keyframe = m_lastKeyframeMs < 0 || timeMs - m_lastKeyframeMs >= KEYFRAME_INTERVAL_MS;
+    const Telemetry::Type type = keyframe ? Telemetry::Type::Keyframe : Telemetry::Type::Delta;
+    beginDatagram(type);
+    for (int id = 0; id < m_channels.size(); ++id) {
+        const double value = m_work.at(id) * m_channels.at(id).scale;
+        if (!std::isfinite(value))
+            continue;
+        const qint64 quantized = std::llround(qBound(-MAX_QUANTIZED, value, MAX_QUANTIZED));
+        if (!keyframe && quantized == m_sent.at(id))
+            continue;
+
+        if (end - m_cursor < MAX_DATA_RECORD) {
+            sendDatagram(timeMs);
+            beginDatagram(type);
+        }
+        m_cursor = Telemetry::writeVarint(m_cursor, static_cast<quint64>(id - m_previousId - 1));
+        const qint64 encoded = keyframe ? quantized : quantized - m_sent.at(id);
+        m_cursor = Telemetry::writeVarint(m_cursor, Telemetry::zigzag(encoded));
+        m_sent[id] = quantized;
+        m_previousId = id;
+        ++m_header.recordCount;
+    }
+    // Nothing changed: send nothing; the next keyframe doubles as a heartbeat.
+    if (m_header.recordCount > 0)
+        sendDatagram(timeMs);
+    if (keyframe)
+        m_lastKeyframeMs = timeMs;
+}
+
+void TelemetryBroadcaster::beginDatagram(Telemetry::Type type)
+{
+    m_header = Telemetry::Header();
+    m_header.type = type;
+    m_cursor = m_datagram.data() + Telemetry::HEADER_SIZE;
+    m_previousId = -1;
+}
+
+void TelemetryBroadcaster::sendDatagram(qint64 timeMs)
+{
+    m_header.sequence = m_sequence++;
+    m_header.timeMs = static_cast<quint32>(timeMs);
+    char *data = m_datagram.data();
+    Telemetry::writeHeader(data, m_header);
+    const auto size = static_cast<size_t>(m_cursor - data);
+
+#ifdef Q_OS_UNIX
+    sockaddr_in target = {};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(m_port);
+    target.sin_addr.s_addr = htonl(m_address);
+    if (::sendto(m_fd, data, size, 0, reinterpret_cast<const sockaddr *>(&target), sizeof(target)) < 0) {
+        // Report once per run of failures (no route, unplugged link); receivers resync on the next keyframe.
+        if (!m_sendFailing && errno != EAGAIN && errno != EWOULDBLOCK) {
+            m_sendFailing = true;
+            emit errorOccurred(QStringLiteral("Telemetry: send to %1 failed: %2")
+                                   .arg(m_destination, QString::fromLocal8Bit(std::strerror(errno))));
+        }
+        return;
+    }
+#endif
+    m_sendFailing = false;
+    m_packetsSent.fetch_add(1, std::memory_order_relaxed);
+    m_bytesSent.fetch_add(size, std::memory_order_relaxed);
+}
@@ -0,0 +1,168 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file TelemetryBroadcaster.h
+ * @brief Live sensor broadcast over UDP (unicast or multicast) for pit-side viewers.
+ *
+ * At the broadcast rate the GUI thread copies every numeric SensorRegistry
+ * channel into a snapshot (direct property reads, no QVariant for double and
+ * int properties) and hands it to a packer thread by swapping buffers, as
+ * LogWriter does. If the packer is still busy the newer snapshot replaces
+ * the pending one. The packer quantizes the values, sends only channels
+ * whose quantized value changed since the previous snapshot (see
+ * TelemetryFormat.h), a full keyframe every KEYFRAME_INTERVAL_MS and the
+ * channel names and units every SCHEMA_INTERVAL_MS. cpuPercent reports what
+ * the snapshots and packing cost, so the budget can be checked on the device.
+ *
+ * Tools/pttelemetry.cpp is a reference receiver.
+ */
+
+#ifndef TELEMETRYBROADCASTER_H
+#define TELEMETRYBROADCASTER_H
+
+#include "TelemetryFormat.h"
+
+#include <QElapsedTimer>
+#include <QMetaProperty>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <atomic>
+
+class PropertyRouter;
+class SensorRegistry;
+class QThread;
+
+class TelemetryBroadcaster : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(QString destination READ destination NOTIFY runningChanged)
+    Q_PROPERTY(int rateHz READ rateHz NOTIFY runningChanged)
+    Q_PROPERTY(int channelCount READ channelCount NOTIFY runningChanged)
+    Q_PROPERTY(double packetsSent READ packetsSent NOTIFY statsChanged)
+    Q_PROPERTY(double bytesSent READ bytesSent NOTIFY statsChanged)
+    /// Snapshots replaced before the packer got to them
+    Q_PROPERTY(double snapshotsDropped READ snapshotsDropped NOTIFY statsChanged)
+    /// Thread CPU time of snapshots and packing over the last stats interval, in percent of one core
+    Q_PROPERTY(double cpuPercent READ cpuPercent NOTIFY statsChanged)
+
+public:
+    static constexpr int DEFAULT_RATE_HZ = 50;
+    static constexpr int MAX_RATE_HZ = 100;
+    static constexpr int KEYFRAME_INTERVAL_MS = 1000;
+    static constexpr int SCHEMA_INTERVAL_MS = 5000;
+    /// Router hops for multicast destinations
+    static constexpr int MULTICAST_TTL = 4;
+    static constexpr int STATS_INTERVAL_MS = 1000;
+
+    explicit TelemetryBroadcaster(QObject *parent = nullptr);
+    ~TelemetryBroadcaster() override;
+
+    void setPropertyRouter(PropertyRouter *propertyRouter);
+    void setSensorRegistry(SensorRegistry *sensorRegistry);
+
+    /**
+     * @brief Start broadcasting to @p host (IPv4 unicast or multicast group) on @p port.
+     *
+     * The channel list is taken from the SensorRegistry now; a running
+     * broadcast is restarted.
+     * @return false if the address is invalid or the socket cannot be created
+     */
+    Q_INVOKABLE bool start(const QString &host, int port = Telemetry::DEFAULT_PORT, int rateHz = DEFAULT_RATE_HZ);
+    Q_INVOKABLE void stop();
+
+    bool isRunning() const { return m_thread != nullptr; }
+    QString destination() const { return m_destination; }
+    int rateHz() const { return m_rateHz; }
+    int channelCount() const { return m_channels.size(); }
+    double packetsSent() const { return static_cast<double>(m_packetsSent.load(std::memory_order_relaxed)); }
+    double bytesSent() const { return static_cast<double>(m_bytesSent.load(std::memory_order_relaxed)); }
+    double snapshotsDropped() const { return static_cast<double>(m_snapshotsDropped.load(std::memory_order_relaxed)); }
+    double cpuPercent() const { return m_cpuPercent; }
+
+signals:
+    void runningChanged();
+    void statsChanged();
+    /// May be emitted from the packer thread
+    void errorOccurred(const QString &message);
+
+private slots:
+    void takeSnapshot();
+    void updateStats();
+
+private:
+    struct Channel
+    {
+        enum class Kind { Double, Int, Other };
+
+        QObject *model = nullptr;
+        QMetaProperty property;
+        int propertyIndex = -1;
+        Kind kind = Kind::Other;
+        QByteArray key;
+        QByteArray unit;  ///< Canonical unit; values are sent as the model holds them
+        int decimals = 0;
+        double scale = 1.0;
+    };
+
+    bool bindChannels();
+    bool openSocket(const QString &host, int port);
+    void closeSocket();
+    void run();
+    void pack(qint64 timeMs);
+    void beginDatagram(Telemetry::Type type);
+    void sendDatagram(qint64 timeMs);
+
+    PropertyRouter *m_propertyRouter = nullptr;
+    SensorRegistry *m_sensorRegistry = nullptr;
+    QString m_destination;
+    int m_rateHz = DEFAULT_RATE_HZ;
+
+    // * Fixed while the thread runs
+    QVector<Channel> m_channels;
+    int m_fd = -1;
+    quint32 m_address = 0;  ///< Host byte order
+    quint16 m_port = 0;
+
+    // * GUI thread
+    QThread *m_thread = nullptr;
+    QTimer m_snapshotTimer;
+    QTimer m_statsTimer;
+    QElapsedTimer m_clock;
+    QVector<double> m_front;
+    qint64 m_statsCpuUs = 0;  ///< m_cpuUs at the last stats update
+    qint64 m_statsTimeMs = 0;
+    double m_cpuPercent = 0.0;
+
+    // * Shared hand-off (guarded by m_mutex)
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    QVector<double> m_back;
+    qint64 m_backTimeMs = 0;
+    bool m_backPending = false;
+    bool m_stopRequested = false;
+
+    // * Packer thread only
+    QVector<double> m_work;
+    QVector<qint64> m_sent;  ///< Quantized values as of the last datagram
+    QByteArray m_datagram;
+    char *m_cursor = nullptr;
+    Telemetry::Header m_header;
+    int m_previousId = -1;
+    quint32 m_sequence = 0;
+    qint64 m_lastKeyframeMs = -1;
+    qint64 m_lastSchemaMs = -1;
+    bool m_sendFailing = false;
+
+    std::atomic<quint64> m_packetsSent{0};
+    std::atomic<quint64> m_bytesSent{0};
+    std::atomic<quint64> m_snapshotsDropped{0};
+    std::atomic<qint64> m_cpuUs{0};  ///< Both threads' CPU time spent on the broadcast
+};
+
+#endif  // TELEMETRYBROADCASTER_H
@@ -0,0 +1,166 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file TelemetryFormat.cpp
+ * @brief Telemetry datagram header, varint coding and the TelemetryDecoder class.
+ */
+
+#include "TelemetryFormat.h"
+
+#include <QtEndian>
+
+#include <algorithm>
+
+namespace {
+constexpr char MAGIC[2] = {'P', 'T'};
+constexpr quint8 VERSION = 2;
+}  // namespace
+
+namespace Telemetry {
+
+void writeHeader(char *out, const Header &header)
+{
+    out[0] = MAGIC[0];
+    out[1] = MAGIC[1];
+    out[2] = static_cast<char>(VERSION);
+    out[3] = static_cast<char>(header.type);
+    qToLittleEndian<quint32>(header.sequence, out + 4);
+    qToLittleEndian<quint32>(header.timeMs, out + 8);
+    qToLittleEndian<quint16>(header.recordCount, out + 12);
+    qToLittleEndian<quint16>(0, out + 14);
+}
+
+bool readHeader(const char *data, int size, Header &header)
+{
+    if (size < HEADER_SIZE || data[0] != MAGIC[0] || data[1] != MAGIC[1] || static_cast<quint8>(data[2]) != VERSION)
+        return false;
+    const auto type = static_cast<quint8>(data[3]);
+    if (type > static_cast<quint8>(Type::Schema))
+        return false;
+    header.type = static_cast<Type>(type);
+    header.sequence = qFromLittleEndian<quint32>(data + 4);
+    header.timeMs = qFromLittleEndian<quint32>(data + 8);
+    header.recordCount = qFromLittleEndian<quint16>(data + 12);
+    return true;
+}
+
+char *writeVarint(char *out, quint64 value)
+{
+    while (value >= 0x80) {
+        *out++ = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<char>(value);
+    return out;
+}
+
+const char *readVarint(const char *in, const char *end, quint64 &value)
+{
+    value = 0;
+    for (int shift = 0; in < end && shift < 64; shift += 7) {
+        const auto byte = static_cast<quint8>(*in++);
+        value |= static_cast<quint64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return in;
+    }
+    return nullptr;
+}
+
+double scaleForDecimals(int decimals)
+{
+    static constexpr double SCALES[MAX_DECIMALS + 1] = {1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6};
+    return SCALES[qBound(0, decimals, MAX_DECIMALS)];
+}
+
+}  // namespace Telemetry
+
+void TelemetryDecoder::reset()
+{
+    m_quantized.clear();
+    m_valid.clear();
+    m_keys.clear();
+    m_units.clear();
+    m_scales.clear();
+    m_changed.clear();
+    m_haveSequence = false;
+    m_lost = 0;
+}
+
+void TelemetryDecoder::ensureChannel(int id)
+{
+    if (id < m_quantized.size())
+        return;
+    m_quantized.resize(id + 1);
+    m_valid.resize(id + 1);
+    m_keys.resize(id + 1);
+    m_units.resize(id + 1);
+    m_scales.resize(id + 1, 0.0);
+}
+
+double TelemetryDecoder::value(int id) const
+{
+    if (id >= m_quantized.size())
+        return 0.0;
+    const double scale = m_scales.at(id);
+    return scale > 0.0 ? m_quantized.at(id) / scale : static_cast<double>(m_quantized.at(id));
+}
+
+TelemetryDecoder::Result TelemetryDecoder::feed(const char *data, int size)
+{
+    Telemetry::Header header;
+    if (!Telemetry::readHeader(data, size, header))
+        return Result::Invalid;
+
+    // A lost delta leaves every channel unknown until a keyframe repeats it.
+    const quint32 gap = header.sequence - m_expectedSequence;
+    if (m_haveSequence && gap != 0 && gap < 0x80000000u) {
+        m_lost += gap;
+        std::fill(m_valid.begin(), m_valid.end(), 0);
+    }
+    m_haveSequence = true;
+    m_expectedSequence = header.sequence + 1;
+    m_header = header;
+    m_changed.clear();
+
+    const char *in = data + Telemetry::HEADER_SIZE;
+    const char *end = data + size;
+    int id = -1;
+    for (int record = 0; record < header.recordCount; ++record) {
+        quint64 gapValue = 0;
+        in = Telemetry::readVarint(in, end, gapValue);
+        if (!in || gapValue >= static_cast<quint64>(Telemetry::MAX_CHANNELS - id))
+            return Result::Invalid;
+        id += static_cast<int>(gapValue) + 1;
+        ensureChannel(id);
+
+        if (header.type == Telemetry::Type::Schema) {
+            if (end - in < 3 || end - in - 3 < static_cast<quint8>(in[1]))
+                return Result::Invalid;
+            const int keyLength = static_cast<quint8>(in[1]);
+            const char *unit = in + 2 + keyLength;
+            if (end - unit - 1 < static_cast<quint8>(unit[0]))
+                return Result::Invalid;
+            m_scales[id] = Telemetry::scaleForDecimals(static_cast<quint8>(in[0]));
+            m_keys[id] = QByteArray(in + 2, keyLength);
+            m_units[id] = QByteArray(unit + 1, static_cast<quint8>(unit[0]));
+            in = unit + 1 + static_cast<quint8>(unit[0]);
+            continue;
+        }
+
+        quint64 encoded = 0;
+        in = Telemetry::readVarint(in, end, encoded);
+        if (!in)
+            return Result::Invalid;
+        const qint64 value = Telemetry::unzigzag(encoded);
+        if (header.type == Telemetry::Type::Keyframe) {
+            m_quantized[id] = value;
+            m_valid[id] = 1;
+        } else if (m_valid.at(id)) {
+            m_quantized[id] += value;
+        } else {
+            continue;
+        }
+        m_changed.append(id);
+    }
+    return header.type == Telemetry::Type::Schema ? Result::Schema : Result::Data;
+}
@@ -0,0 +1,121 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file TelemetryFormat.h
+ * @brief Wire format of the live telemetry broadcast, and a stateful decoder for viewers.
+ *
+ * Every datagram starts with a 16-byte little-endian header:
+ *     quint8  magic[2]     'P', 'T'
+ *     quint8  version      2
+ *     quint8  type         Delta, Keyframe or Schema
+ *     quint32 sequence     +1 per datagram
+ *     quint32 timeMs       snapshot time since the broadcast started
+ *     quint16 recordCount
+ *     quint16 reserved
+ *
+ * Values are the raw model values, in the channel's canonical unit as named
+ * by the schema (not the dash's display unit setting). They are quantized
+ * per channel to integers (value * 10^decimals, the channel's display
+ * decimals). Records are sorted by channel id and encoded as varints:
+ *     varint  idGap        id - previous id - 1 (previous id starts at -1 in each datagram)
+ *     Keyframe: zigzag varint  quantized value
+ *     Delta:    zigzag varint  quantized value - value in the previous datagram
+ *     Schema:   quint8 decimals, quint8 keyLength, key bytes (SensorRegistry key),
+ *               quint8 unitLength, unit bytes (canonical unit, empty if unitless)
+ *
+ * Delta datagrams only hold channels that changed since the previous
+ * snapshot, typically 2-3 bytes each. Keyframes (every channel) let late
+ * joiners and receivers that lost a datagram resynchronise; schema datagrams
+ * name the channel ids. Both may be split over several datagrams.
+ */
+
+#ifndef TELEMETRYFORMAT_H
+#define TELEMETRYFORMAT_H
+
+#include <QByteArray>
+#include <QVector>
+#include <QtGlobal>
+
+namespace Telemetry {
+constexpr quint16 DEFAULT_PORT = 45460;
+constexpr int HEADER_SIZE = 16;
+/// Datagrams are closed before they grow past this, below the Ethernet MTU
+constexpr int MAX_DATAGRAM_SIZE = 1400;
+constexpr int MAX_CHANNELS = 0xFFFF;
+constexpr int MAX_DECIMALS = 6;
+
+enum class Type : quint8 { Delta = 0, Keyframe = 1, Schema = 2 };
+
+struct Header
+{
+    Type type = Type::Delta;
+    quint32 sequence = 0;
+    quint32 timeMs = 0;
+    quint16 recordCount = 0;
+};
+
+void writeHeader(char *out, const Header &header);
+/// @return false if @p data is not a telemetry datagram of a supported version
+bool readHeader(const char *data, int size, Header &header);
+
+/// Append an unsigned LEB128 varint; @p out must have 10 bytes free
+char *writeVarint(char *out, quint64 value);
+/// @return Position after the varint, or nullptr if it runs past @p end
+const char *readVarint(const char *in, const char *end, quint64 &value);
+
+inline quint64 zigzag(qint64 value)
+{
+    return (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63);
+}
+
+inline qint64 unzigzag(quint64 value)
+{
+    return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+}
+
+/// 10^decimals for quantizing
+double scaleForDecimals(int decimals);
+}  // namespace Telemetry
+
+/**
+ * Receiver-side state: applies keyframes and deltas in order. A sequence gap
+ * invalidates every channel until the next keyframe carries it again.
+ */
+class TelemetryDecoder
+{
+public:
+    enum class Result { Invalid, Data, Schema };
+
+    Result feed(const char *data, int size);
+    void reset();
+
+    int channelCount() const { return m_quantized.size(); }
+    bool isValid(int id) const { return id < m_valid.size() && m_valid.at(id); }
+    /// Value in unit(); raw quantized value until the schema for @p id has been seen
+    double value(int id) const;
+    /// SensorRegistry key, or empty until the schema for @p id has been seen
+    QByteArray key(int id) const { return m_keys.value(id); }
+    /// Canonical unit of value(), or empty until the schema for @p id has been seen (or if unitless)
+    QByteArray unit(int id) const { return m_units.value(id); }
+
+    /// Channels set by the last feed()
+    const QVector<int> &changed() const { return m_changed; }
+    const Telemetry::Header &lastHeader() const { return m_header; }
+    quint64 lostDatagrams() const { return m_lost; }
+
+private:
+    void ensureChannel(int id);
+
+    QVector<qint64> m_quantized;
+    QVector<char> m_valid;
+    QVector<QByteArray> m_keys;
+    QVector<QByteArray> m_units;
+    QVector<double> m_scales;
+    QVector<int> m_changed;
+    Telemetry::Header m_header;
+    bool m_haveSequence = false;
+    quint32 m_expectedSequence = 0;
+    quint64 m_lost = 0;
+};
+
+#endif  // TELEMETRYFORMAT_H
@@ -0,0 +1,143 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file UdpBatchSocket.cpp
+ * @brief Implementation of the UdpBatchSocket class.
+ */
+
+#include "UdpBatchSocket.h"
+
+#include "UdpSensorFormat.h"
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+/// One byte more than the largest valid datagram, so oversized ones show up as MSG_TRUNC
+constexpr int SLOT_SIZE = UdpSensor::MAX_DATAGRAM_SIZE + 1;
+}  // namespace
+
+struct UdpBatchSocket::Batch
+{
+    std::vector<char> buffers = std::vector<char>(static_cast<size_t>(BATCH_SIZE) * SLOT_SIZE);
+#ifdef Q_OS_LINUX
+    iovec vectors[BATCH_SIZE] = {};
+    mmsghdr messages[BATCH_SIZE] = {};
+#endif
+    int sizes[BATCH_SIZE] = {};
+};
+
+UdpBatchSocket::UdpBatchSocket() : m_batch(new Batch)
+{
+#ifdef Q_OS_LINUX
+    for (int i = 0; i < BATCH_SIZE; ++i) {
+        m_batch->vectors[i].iov_base = m_batch->buffers.data() + static_cast<size_t>(i) * SLOT_SIZE;
+        m_batch->vectors[i].iov_len = SLOT_SIZE;
+        m_batch->messages[i].msg_hdr.msg_iov = &m_batch->vectors[i];
+        m_batch->messages[i].msg_hdr.msg_iovlen = 1;
+    }
+#endif
+}
+
+UdpBatchSocket::~UdpBatchSocket()
+{
+    close();
+}
+
+bool UdpBatchSocket::bind(quint16 port, bool loopbackOnly, QString *error)
+{
+    close();
+    m_truncated = 0;
+
+#ifdef Q_OS_LINUX
+    m_fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (m_fd < 0) {
+        if (error)
+            *error = QStringLiteral("UDP: socket failed: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+        return false;
+    }
+
+    const int reuse = 1;
+    ::setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    // Best effort: capped by net.core.rmem_max.
+    const int receiveBuffer = RECEIVE_BUFFER_BYTES;
+    ::setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(loopbackOnly ? INADDR_LOOPBACK : INADDR_ANY);
+    if (::bind(m_fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) < 0) {
+        if (error) {
+            *error = QStringLiteral("UDP: cannot bind port %1: %2")
+                         .arg(port)
+                         .arg(QString::fromLocal8Bit(std::strerror(errno)));
+        }
+        close();
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(port);
+    Q_UNUSED(loopbackOnly);
+    if (error)
+        *error = QStringLiteral("UDP: batched receive is only available on Linux");
+    return false;
+#endif
+}
+
+void UdpBatchSocket::close()
+{
+#ifdef Q_OS_LINUX
+    if (m_fd >= 0)
+        ::close(m_fd);
+#endif
+    m_fd = -1;
+}
+
+int UdpBatchSocket::receive(int timeoutMs)
+{
+    if (m_fd < 0)
+        return -1;
+
+#ifdef Q_OS_LINUX
+    pollfd descriptor = {m_fd, POLLIN, 0};
+    const int ready = ::poll(&descriptor, 1, timeoutMs);
+    if (ready < 0)
+        return errno == EINTR ? 0 : -1;
+    if (ready == 0)
+        return 0;
+
+    const int count = ::recvmmsg(m_fd, m_batch->messages, BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    if (count < 0)
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    for (int i = 0; i < count; ++i) {
+        if (m_batch->messages[i].msg_hdr.msg_flags & MSG_TRUNC)
+            ++m_truncated;
+        m_batch->sizes[i] = qMin(static_cast<int>(m_batch->messages[i].msg_len), SLOT_SIZE);
+    }
+    return count;
+#else
+    Q_UNUSED(timeoutMs);
+    return -1;
+#endif
+}
+
+const char *UdpBatchSocket::datagram(int index) const
+{
+    return m_batch->buffers.data() + static_cast<size_t>(index) * SLOT_SIZE;
+}
+
+int UdpBatchSocket::datagramSize(int index) const
+{
+    return m_batch->sizes[index];
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file UdpBatchSocket.h
+ * @brief Bound UDP socket that reads up to BATCH_SIZE datagrams per system call (recvmmsg).
+ *
+ * At tens of thousands of small datagrams per second the per-call cost of
+ * recvfrom dominates; recvmmsg drains everything queued (up to BATCH_SIZE)
+ * in one call into preallocated buffers. Meant to be driven from a single
+ * background thread; the datagrams returned by receive() stay valid until
+ * the next call.
+ */
+
+#ifndef UDPBATCHSOCKET_H
+#define UDPBATCHSOCKET_H
+
+#include <QString>
+#include <QtGlobal>
+
+#include <memory>
+
+class UdpBatchSocket
+{
+public:
+    static constexpr int BATCH_SIZE = 64;
+    /// Kernel receive buffer requested with SO_RCVBUF; absorbs bursts while the reader is descheduled
+    static constexpr int RECEIVE_BUFFER_BYTES = 4 * 1024 * 1024;
+
+    UdpBatchSocket();
+    ~UdpBatchSocket();
+    UdpBatchSocket(const UdpBatchSocket &) = delete;
+    UdpBatchSocket &operator=(const UdpBatchSocket &) = delete;
+
+    /**
+     * @brief Bind to @p port on all interfaces (or loopback only).
+     * @return false with @p error set if the socket cannot be bound
+     */
+    bool bind(quint16 port, bool loopbackOnly, QString *error);
+    void close();
+    bool isOpen() const { return m_fd >= 0; }
+
+    /**
+     * @brief Wait up to @p timeoutMs for data and read what is queued.
+     * @return Datagrams read (0 on timeout or interrupt), or -1 if the socket failed
+     */
+    int receive(int timeoutMs);
+
+    const char *datagram(int index) const;
+    int datagramSize(int index) const;
+    /// Datagrams cut off because they exceeded the buffer size, since bind()
+    quint64 truncated() const { return m_truncated; }
+
+private:
+    struct Batch;  ///< Buffers and recvmmsg headers
+
+    int m_fd = -1;
+    std::unique_ptr<Batch> m_batch;
+    quint64 m_truncated = 0;
+};
+
+#endif  // UDPBATCHSOCKET_H
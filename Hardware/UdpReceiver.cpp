@@ -0,0 +1,282 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file UdpReceiver.cpp
+ * @brief Implementation of the UdpReceiver class.
+ */
+
+#include "UdpReceiver.h"
+
+#include "../Core/PropertyRouter.h"
+#include "../Core/SensorRegistry.h"
+#include "../Core/TraceRecorder.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QThread>
+
+#include <vector>
+
+UdpReceiver::UdpReceiver(QObject *parent) : QObject(parent)
+{
+    m_publishTimer.setInterval(PUBLISH_INTERVAL_MS);
+    m_publishTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_publishTimer, &QTimer::timeout, this, &UdpReceiver::publish);
+    m_statsTimer.setInterval(STATS_INTERVAL_MS);
+    connect(&m_statsTimer, &QTimer::timeout, this, &UdpReceiver::statsChanged);
+}
+
+UdpReceiver::~UdpReceiver()
+{
+    stop();
+}
+
+void UdpReceiver::setPropertyRouter(PropertyRouter *propertyRouter)
+{
+    m_propertyRouter = propertyRouter;
+}
+
+void UdpReceiver::setSensorRegistry(SensorRegistry *sensorRegistry)
+{
+    m_sensorRegistry = sensorRegistry;
+}
+
+bool UdpReceiver::loadIdentMap(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        emit errorOccurred(QStringLiteral("UDP: cannot open ident map %1: %2").arg(path, file.errorString()));
+        return false;
+    }
+
+    QHash<int, QString> identKeys;
+    int lineNumber = 0;
+    while (!file.atEnd()) {
+        ++lineNumber;
+        QByteArray line = file.readLine();
+        const qsizetype comment = line.indexOf('#');
+        if (comment >= 0)
+            line.truncate(comment);
+        const QList<QByteArray> fields = line.simplified().split(' ');
+        if (fields.size() == 1 && fields.first().isEmpty())
+            continue;
+
+        bool ok = false;
+        const int ident = fields.first().toInt(&ok);
+        if (fields.size() != 2 || !ok || ident < 0 || ident > 0xFFFF) {
+            emit errorOccurred(QStringLiteral("UDP: %1:%2: expected \"ident key\"").arg(path).arg(lineNumber));
+            continue;
+        }
+        identKeys.insert(ident, QString::fromUtf8(fields.at(1)));
+    }
+    setIdentMap(identKeys);
+    return true;
+}
+
+void UdpReceiver::setIdentMap(const QHash<int, QString> &identKeys)
+{
+    m_identKeys = identKeys;
+}
+
+bool UdpReceiver::start(int port)
+{
+    stop();
+
+    QString error;
+    if (port <= 0 || port > 0xFFFF || !m_socket.bind(static_cast<quint16>(port), false, &error)) {
+        emit errorOccurred(error.isEmpty() ? QStringLiteral("UDP: invalid port %1").arg(port) : error);
+        return false;
+    }
+    m_port = port;
+
+    bindTargets();
+    const int slotCount = m_targets.size();
+    m_latest.fill(0.0, slotCount);
+    m_latestDirty.fill(0, slotCount);
+    m_latestSlots.clear();
+    m_latestSlots.reserve(slotCount);
+    m_values.fill(0.0, slotCount);
+    m_dirty.fill(0, slotCount);
+    m_dirtySlots.clear();
+    m_dirtySlots.reserve(slotCount);
+    m_publishSlots.reserve(slotCount);
+    m_publishValues.reserve(slotCount);
+
+    m_samples.store(0);
+    m_datagrams.store(0);
+    m_lost.store(0);
+    m_rejected.store(0);
+    m_unmapped.store(0);
+    m_stopRequested.store(false);
+
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName(QStringLiteral("UdpReceiver"));
+    m_thread->start(QThread::HighPriority);
+    m_publishTimer.start();
+    m_statsTimer.start();
+    emit runningChanged();
+    return true;
+}
+
+void UdpReceiver::stop()
+{
+    if (!m_thread)
+        return;
+
+    m_stopRequested.store(true, std::memory_order_release);
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+    m_socket.close();
+    m_publishTimer.stop();
+    m_statsTimer.stop();
+    publish();
+    emit statsChanged();
+    emit runningChanged();
+}
+
+void UdpReceiver::bindTargets()
+{
+    // Idents are looked up by index on the reader thread, so the table spans the largest mapped ident.
+    int maxIdent = -1;
+    for (auto it = m_identKeys.constBegin(); it != m_identKeys.constEnd(); ++it)
+        maxIdent = qMax(maxIdent, it.key());
+    m_slotForIdent.fill(-1, maxIdent + 1);
+    m_targets.clear();
+
+    QHash<QString, int> slotForKey;
+    for (auto it = m_identKeys.constBegin(); it != m_identKeys.constEnd(); ++it) {
+        // Several idents may feed the same key; they share its slot.
+        const auto existing = slotForKey.constFind(it.value());
+        if (existing != slotForKey.constEnd()) {
+            m_slotForIdent[it.key()] = existing.value();
+            continue;
+        }
+
+        QObject *model = nullptr;
+        int propertyIndex = -1;
+        if (!m_propertyRouter || !m_propertyRouter->resolveProperty(it.value(), &model, &propertyIndex)) {
+            emit errorOccurred(QStringLiteral("UDP: ident %1 maps to unknown sensor %2").arg(it.key()).arg(it.value()));
+            continue;
+        }
+        Target target;
+        target.key = it.value();
+        target.model = model;
+        target.property = model->metaObject()->property(propertyIndex);
+        slotForKey.insert(target.key, m_targets.size());
+        m_slotForIdent[it.key()] = m_targets.size();
+        m_targets.append(target);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Reader thread
+// ---------------------------------------------------------------------------
+
+void UdpReceiver::run()
+{
+    std::vector<UdpSensor::Sample> samples(UdpSensor::MAX_SAMPLES);
+    bool haveSequence = false;
+    quint32 expectedSequence = 0;
+    const int identCount = m_slotForIdent.size();
+
+    while (!m_stopRequested.load(std::memory_order_acquire)) {
+        const int count = m_socket.receive(POLL_TIMEOUT_MS);
+        if (count < 0) {
+            emit errorOccurred(QStringLiteral("UDP: receive on port %1 failed").arg(m_port));
+            break;
+        }
+        if (count == 0)
+            continue;
+
+        PT_TRACE_SCOPE("udp.batch");
+        quint64 decoded = 0;
+        quint64 unmapped = 0;
+        quint64 rejected = 0;
+        for (int i = 0; i < count; ++i) {
+            quint32 sequence = 0;
+            const char *data = m_socket.datagram(i);
+            const int size = m_socket.datagramSize(i);
+            const int n = UdpSensor::decode(data, size, samples.data(), UdpSensor::MAX_SAMPLES, &sequence);
+            if (n < 0 || size > UdpSensor::MAX_DATAGRAM_SIZE) {
+                ++rejected;
+                continue;
+            }
+            if (UdpSensor::isBinary(data, size)) {
+                // Forward gaps are losses; a jump backwards is a restarted sender.
+                const quint32 gap = sequence - expectedSequence;
+                if (haveSequence && gap != 0 && gap < 0x80000000u)
+                    m_lost.fetch_add(gap, std::memory_order_relaxed);
+                haveSequence = true;
+                expectedSequence = sequence + 1;
+            }
+
+            for (int s = 0; s < n; ++s) {
+                const int ident = samples[s].ident;
+                const int slot = ident < identCount ? m_slotForIdent.at(ident) : -1;
+                if (slot < 0) {
+                    ++unmapped;
+                    continue;
+                }
+                m_latest[slot] = samples[s].value;
+                if (!m_latestDirty.at(slot)) {
+                    m_latestDirty[slot] = 1;
+                    m_latestSlots.append(slot);
+                }
+            }
+            decoded += static_cast<quint64>(n);
+        }
+
+        // One lock per batch; only the latest value per slot is handed over.
+        if (!m_latestSlots.isEmpty()) {
+            QMutexLocker locker(&m_mutex);
+            for (const int slot : std::as_const(m_latestSlots)) {
+                m_values[slot] = m_latest.at(slot);
+                m_latestDirty[slot] = 0;
+                if (!m_dirty.at(slot)) {
+                    m_dirty[slot] = 1;
+                    m_dirtySlots.append(slot);
+                }
+            }
+        }
+        m_latestSlots.clear();
+
+        m_datagrams.fetch_add(static_cast<quint64>(count), std::memory_order_relaxed);
+        m_samples.fetch_add(decoded, std::memory_order_relaxed);
+        m_unmapped.fetch_add(unmapped, std::memory_order_relaxed);
+        m_rejected.fetch_add(rejected, std::memory_order_relaxed);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// GUI thread
+// ---------------------------------------------------------------------------
+
+void UdpReceiver::publish()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_dirtySlots.isEmpty())
+            return;
+        m_publishSlots.swap(m_dirtySlots);
+        m_publishValues.resize(m_publishSlots.size());
+        for (int i = 0; i < m_publishSlots.size(); ++i) {
+            const int slot = m_publishSlots.at(i);
+            m_publishValues[i] = m_values.at(slot);
+            m_dirty[slot] = 0;
+        }
+    }
+
+    PT_TRACE_SCOPE("udp.publish");
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    for (int i = 0; i < m_publishSlots.size(); ++i) {
+        Target &target = m_targets[m_publishSlots.at(i)];
+        target.property.write(target.model, QVariant(m_publishValues.at(i)));
+        // The registry times a sensor out 10 s after it was last marked, so keep marking it while data arrives
+        if (m_sensorRegistry && nowMs - target.markedActiveMs >= ACTIVE_REFRESH_MS) {
+            m_sensorRegistry->markCanSensorActive(target.key);
+            target.markedActiveMs = nowMs;
+        }
+    }
+    m_publishSlots.clear();
+}
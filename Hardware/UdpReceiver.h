@@ -0,0 +1,143 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file UdpReceiver.h
+ * @brief UDP sensor ingest: batched datagram reads on a background thread, coalesced model writes.
+ *
+ * A reader thread pulls datagrams in batches (UdpBatchSocket, recvmmsg),
+ * decodes binary or legacy text samples (UdpSensorFormat.h) and keeps only
+ * the latest value per mapped ident. Once per display frame the GUI thread
+ * takes the idents that changed and writes them into the models through
+ * their properties, so a 50k samples/s feed costs at most one property
+ * write per channel per frame on the GUI thread.
+ *
+ * Idents are mapped to sensor keys (PropertyRouter names) by an ident map
+ * file with one "ident key" pair per line, e.g. "108 gpsLatitude"; '#'
+ * starts a comment. Idents without a mapping are counted and dropped.
+ */
+
+#ifndef UDPRECEIVER_H
+#define UDPRECEIVER_H
+
+#include "UdpBatchSocket.h"
+#include "UdpSensorFormat.h"
+
+#include <QHash>
+#include <QMetaProperty>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+#include <atomic>
+
+class PropertyRouter;
+class SensorRegistry;
+class QThread;
+
+class UdpReceiver : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(int port READ port NOTIFY runningChanged)
+    Q_PROPERTY(double samplesReceived READ samplesReceived NOTIFY statsChanged)
+    Q_PROPERTY(double datagramsReceived READ datagramsReceived NOTIFY statsChanged)
+    /// Binary datagrams missing from the sequence
+    Q_PROPERTY(double datagramsLost READ datagramsLost NOTIFY statsChanged)
+    /// Datagrams in neither encoding, or cut off
+    Q_PROPERTY(double datagramsRejected READ datagramsRejected NOTIFY statsChanged)
+    Q_PROPERTY(double unmappedSamples READ unmappedSamples NOTIFY statsChanged)
+
+public:
+    static constexpr int PUBLISH_INTERVAL_MS = 16;
+    /// Longest the reader thread waits before checking for stop
+    static constexpr int POLL_TIMEOUT_MS = 100;
+    static constexpr int STATS_INTERVAL_MS = 1000;
+    /// A receiving sensor is re-marked active this often, well inside the registry's 10 s timeout
+    static constexpr qint64 ACTIVE_REFRESH_MS = 1000;
+
+    explicit UdpReceiver(QObject *parent = nullptr);
+    ~UdpReceiver() override;
+
+    void setPropertyRouter(PropertyRouter *propertyRouter);
+    void setSensorRegistry(SensorRegistry *sensorRegistry);
+
+    /// Replace the ident map with the "ident key" lines of @p path; applied on the next start()
+    bool loadIdentMap(const QString &path);
+    void setIdentMap(const QHash<int, QString> &identKeys);
+
+    /**
+     * @brief Bind @p port and start the reader thread; a running receiver is restarted.
+     * @return false if the port cannot be bound
+     */
+    Q_INVOKABLE bool start(int port = UdpSensor::DEFAULT_PORT);
+    Q_INVOKABLE void stop();
+
+    bool isRunning() const { return m_thread != nullptr; }
+    int port() const { return m_port; }
+    double samplesReceived() const { return static_cast<double>(m_samples.load(std::memory_order_relaxed)); }
+    double datagramsReceived() const { return static_cast<double>(m_datagrams.load(std::memory_order_relaxed)); }
+    double datagramsLost() const { return static_cast<double>(m_lost.load(std::memory_order_relaxed)); }
+    double datagramsRejected() const { return static_cast<double>(m_rejected.load(std::memory_order_relaxed)); }
+    double unmappedSamples() const { return static_cast<double>(m_unmapped.load(std::memory_order_relaxed)); }
+
+signals:
+    void runningChanged();
+    void statsChanged();
+    /// May be emitted from the reader thread
+    void errorOccurred(const QString &message);
+
+private slots:
+    void publish();
+
+private:
+    struct Target
+    {
+        QString key;
+        QObject *model = nullptr;
+        QMetaProperty property;
+        qint64 markedActiveMs = 0;  ///< When it was last marked active in the SensorRegistry
+    };
+
+    void bindTargets();
+    void run();
+
+    PropertyRouter *m_propertyRouter = nullptr;
+    SensorRegistry *m_sensorRegistry = nullptr;
+    QHash<int, QString> m_identKeys;
+    int m_port = 0;
+
+    UdpBatchSocket m_socket;
+    QThread *m_thread = nullptr;
+    QTimer m_publishTimer;
+    QTimer m_statsTimer;
+    std::atomic<bool> m_stopRequested{false};
+
+    // * Fixed while the thread runs
+    QVector<int> m_slotForIdent;  ///< Target index per ident, -1 if unmapped
+    QVector<Target> m_targets;
+
+    // * Reader thread only
+    QVector<double> m_latest;
+    QVector<char> m_latestDirty;
+    QVector<int> m_latestSlots;
+
+    // * Shared hand-off (guarded by m_mutex)
+    QMutex m_mutex;
+    QVector<double> m_values;
+    QVector<char> m_dirty;
+    QVector<int> m_dirtySlots;
+
+    // * GUI thread only
+    QVector<int> m_publishSlots;
+    QVector<double> m_publishValues;
+
+    std::atomic<quint64> m_samples{0};
+    std::atomic<quint64> m_datagrams{0};
+    std::atomic<quint64> m_lost{0};
+    std::atomic<quint64> m_rejected{0};
+    std::atomic<quint64> m_unmapped{0};
+};
+
+#endif  // UDPRECEIVER_H
@@ -0,0 +1,109 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file UdpSensorFormat.cpp
+ * @brief Binary and legacy text encodings of the UDP sensor feed.
+ */
+
+#include "UdpSensorFormat.h"
+
+#include <QtEndian>
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+constexpr char MAGIC[2] = {'P', 'U'};
+constexpr quint8 VERSION = 1;
+
+int decodeBinary(const char *data, int size, UdpSensor::Sample *out, int capacity, quint32 *sequence)
+{
+    const auto *bytes = reinterpret_cast<const uchar *>(data);
+    if (sequence)
+        *sequence = qFromLittleEndian<quint32>(bytes + 4);
+
+    const int records = qMin((size - UdpSensor::HEADER_SIZE) / UdpSensor::RECORD_SIZE, capacity);
+    const uchar *record = bytes + UdpSensor::HEADER_SIZE;
+    for (int i = 0; i < records; ++i, record += UdpSensor::RECORD_SIZE) {
+        out[i].ident = qFromLittleEndian<quint16>(record);
+        out[i].value = qFromLittleEndian<float>(record + 2);
+    }
+    return records;
+}
+
+int decodeText(const char *data, int size, UdpSensor::Sample *out, int capacity)
+{
+    int count = 0;
+    const char *end = data + size;
+    for (const char *line = data; line < end && count < capacity;) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        if (!lineEnd)
+            lineEnd = end;
+        const char *fieldEnd = lineEnd;
+        while (fieldEnd > line && (fieldEnd[-1] == '\r' || fieldEnd[-1] == ' '))
+            --fieldEnd;
+
+        unsigned ident = 0;
+        const auto [identEnd, identError] = std::from_chars(line, fieldEnd, ident);
+        if (identError == std::errc() && identEnd < fieldEnd && *identEnd == ',' && ident <= 0xFFFF) {
+            double value = 0.0;
+            const auto [valueEnd, valueError] = std::from_chars(identEnd + 1, fieldEnd, value);
+            if (valueError == std::errc() && valueEnd == fieldEnd) {
+                out[count].ident = static_cast<quint16>(ident);
+                out[count].value = value;
+                ++count;
+            }
+        }
+        line = lineEnd + 1;
+    }
+    return count;
+}
+}  // namespace
+
+namespace UdpSensor {
+
+bool isBinary(const char *data, int size)
+{
+    return size >= HEADER_SIZE && data[0] == MAGIC[0] && data[1] == MAGIC[1]
+           && static_cast<quint8>(data[2]) == VERSION;
+}
+
+int decode(const char *data, int size, Sample *out, int capacity, quint32 *sequence)
+{
+    if (size <= 0)
+        return -1;
+    if (isBinary(data, size))
+        return decodeBinary(data, size, out, capacity, sequence);
+    // Text always starts with an ident
+    if (data[0] < '0' || data[0] > '9')
+        return -1;
+    return decodeText(data, size, out, capacity);
+}
+
+void beginDatagram(QByteArray &out, quint32 sequence)
+{
+    out.resize(HEADER_SIZE);
+    out[0] = MAGIC[0];
+    out[1] = MAGIC[1];
+    out[2] = static_cast<char>(VERSION);
+    out[3] = 0;
+    qToLittleEndian<quint32>(sequence, out.data() + 4);
+}
+
+void appendRecord(QByteArray &out, quint16 ident, float value)
+{
+    char record[RECORD_SIZE];
+    qToLittleEndian<quint16>(ident, record);
+    qToLittleEndian<float>(value, record + 2);
+    out.append(record, RECORD_SIZE);
+}
+
+void appendTextRecord(QByteArray &out, quint16 ident, double value)
+{
+    char line[48];
+    const int length = std::snprintf(line, sizeof(line), "%u,%.6g\n", static_cast<unsigned>(ident), value);
+    out.append(line, length);
+}
+
+}  // namespace UdpSensor
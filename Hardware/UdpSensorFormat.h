@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file UdpSensorFormat.h
+ * @brief Datagram encodings of the UDP sensor feed (ident/value samples).
+ *
+ * Two encodings are accepted on the same port:
+ *
+ * - binary: an 8-byte header followed by packed little-endian records
+ *       quint8  magic[2]   'P', 'U'
+ *       quint8  version    1
+ *       quint8  reserved
+ *       quint32 sequence   +1 per datagram, used to count lost datagrams
+ *   then per sample
+ *       quint16 ident
+ *       float   value
+ *   A full 1472-byte datagram carries 244 samples.
+ *
+ * - legacy text, as sent by the old daemon: one "ident,value" per line
+ *   ("108,-37.8136\n109,144.9631\n"); a single line without newline is fine.
+ *
+ * Idents are mapped to sensor keys by the receiver (see UdpReceiver).
+ */
+
+#ifndef UDPSENSORFORMAT_H
+#define UDPSENSORFORMAT_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+namespace UdpSensor {
+constexpr quint16 DEFAULT_PORT = 45454;
+/// Largest datagram that avoids IP fragmentation on Ethernet
+constexpr int MAX_DATAGRAM_SIZE = 1472;
+constexpr int HEADER_SIZE = 8;
+constexpr int RECORD_SIZE = 6;
+constexpr int MAX_RECORDS = (MAX_DATAGRAM_SIZE - HEADER_SIZE) / RECORD_SIZE;
+/// Upper bound of samples in one datagram of either encoding ("1,2\n" is the shortest text sample)
+constexpr int MAX_SAMPLES = MAX_DATAGRAM_SIZE / 4;
+
+struct Sample
+{
+    quint16 ident = 0;
+    double value = 0.0;
+};
+
+/// True if @p data starts with a binary header of a supported version
+bool isBinary(const char *data, int size);
+
+/**
+ * @brief Decode one datagram of either encoding.
+ * @param out Receives up to @p capacity samples; text lines that do not parse are skipped
+ * @param sequence Receives the datagram sequence number (binary only, untouched for text)
+ * @return Samples decoded, or -1 if the datagram is neither encoding
+ */
+int decode(const char *data, int size, Sample *out, int capacity, quint32 *sequence);
+
+/// Start a binary datagram in @p out (cleared first)
+void beginDatagram(QByteArray &out, quint32 sequence);
+
+/// Append one binary record to a datagram started with beginDatagram()
+void appendRecord(QByteArray &out, quint16 ident, float value);
+
+/// Append one legacy "ident,value\n" line
+void appendTextRecord(QByteArray &out, quint16 ident, double value);
+}  // namespace UdpSensor
+
+#endif  // UDPSENSORFORMAT_H
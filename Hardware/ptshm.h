@@ -0,0 +1,137 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file ptshm.h
+ * @brief Layout of the dashboard's shared-memory sensor snapshot, for co-process readers (C99 or C++).
+ *
+ * The dash (SharedMemoryPublisher) publishes every registered sensor into
+ * the POSIX shared-memory object PT_SHM_DEFAULT_NAME (or the name given
+ * with --shm-name). Map it read-only:
+ *
+ *     int fd = shm_open(PT_SHM_DEFAULT_NAME, O_RDONLY, 0);
+ *     // fstat(fd): require st_size >= PT_SHM_HEADER_SIZE, map the header, check pt_shm_check(),
+ *     // then require header->total_size <= st_size and map header->total_size
+ *
+ * The dash creates the object empty and only then sizes it, and touching a
+ * mapping beyond the object's size raises SIGBUS. So check the size with
+ * fstat() before each mmap(); an object that is too small is still being
+ * set up, so try again shortly.
+ *
+ * Segment layout, native byte order, all offsets from the segment start:
+ *     pt_shm_header                          (PT_SHM_HEADER_SIZE bytes)
+ *     char    keys[slot_count][PT_SHM_KEY_SIZE]    SensorRegistry key, NUL-terminated
+ *     char    units[slot_count][PT_SHM_UNIT_SIZE]  unit of the value as the model holds it
+ *     uint8_t decimals[slot_count]                 display decimals
+ *     double  values[slot_count]                   seqlock protected
+ *
+ * The schema (keys, units, decimals) never changes in a live segment. When
+ * the dash's sensor list or a sensor's unit or decimals change, or the dash
+ * exits, the segment is marked PT_SHM_STATE_STALE and unlinked; readers
+ * should then unmap it and open the name again.
+ *
+ * values[], timestamp_ns and publish_count are written under a seqlock:
+ * sequence is odd while the dash copies a snapshot in. Readers never block
+ * the dash and never take a lock; they copy and retry if the sequence
+ * moved:
+ *
+ *     uint64_t start;
+ *     do {
+ *         start = pt_shm_read_begin(header);
+ *         memcpy(local, pt_shm_values(header), header->slot_count * sizeof(double));
+ *     } while (pt_shm_read_retry(header, start));
+ *
+ * Tools/ptshmread.c is a complete reader.
+ */
+
+#ifndef PTSHM_H
+#define PTSHM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PT_SHM_DEFAULT_NAME "/powertune-sensors"
+#define PT_SHM_MAGIC 0x48535450u  // "PTSH"
+#define PT_SHM_VERSION 1u
+#define PT_SHM_HEADER_SIZE 128
+#define PT_SHM_KEY_SIZE 48
+#define PT_SHM_UNIT_SIZE 16
+
+#define PT_SHM_STATE_LIVE 0u
+#define PT_SHM_STATE_STALE 1u  ///< Replaced or removed by the dash: reopen the name
+
+typedef struct pt_shm_header
+{
+    // * Fixed for the life of the segment
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t slot_count;
+    uint64_t total_size;
+    uint32_t keys_offset;
+    uint32_t units_offset;
+    uint32_t decimals_offset;
+    uint32_t values_offset;  ///< 64-byte aligned
+    uint32_t publish_hz;
+    uint32_t publisher_pid;
+    uint32_t state;  ///< PT_SHM_STATE_*
+    uint32_t reserved0[3];
+
+    // * Seqlock protected, on their own cache line
+    uint64_t sequence;      ///< Odd while a snapshot is being written
+    uint64_t timestamp_ns;  ///< CLOCK_MONOTONIC time of the snapshot
+    uint64_t publish_count;
+    uint8_t reserved1[40];
+} pt_shm_header;
+
+/// @return Non-zero if @p header is a segment this header describes and has been fully set up
+static inline int pt_shm_check(const pt_shm_header *header)
+{
+    return __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) == PT_SHM_MAGIC && header->version == PT_SHM_VERSION
+           && header->header_size == PT_SHM_HEADER_SIZE;
+}
+
+static inline int pt_shm_is_stale(const pt_shm_header *header)
+{
+    return __atomic_load_n(&header->state, __ATOMIC_ACQUIRE) != PT_SHM_STATE_LIVE;
+}
+
+static inline const char *pt_shm_key(const pt_shm_header *header, uint32_t slot)
+{
+    return (const char *)header + header->keys_offset + (uint64_t)slot * PT_SHM_KEY_SIZE;
+}
+
+static inline const char *pt_shm_unit(const pt_shm_header *header, uint32_t slot)
+{
+    return (const char *)header + header->units_offset + (uint64_t)slot * PT_SHM_UNIT_SIZE;
+}
+
+static inline const uint8_t *pt_shm_decimals(const pt_shm_header *header)
+{
+    return (const uint8_t *)header + header->decimals_offset;
+}
+
+static inline const double *pt_shm_values(const pt_shm_header *header)
+{
+    return (const double *)((const char *)header + header->values_offset);
+}
+
+static inline uint64_t pt_shm_read_begin(const pt_shm_header *header)
+{
+    return __atomic_load_n(&header->sequence, __ATOMIC_ACQUIRE);
+}
+
+/// @return Non-zero if the data copied since pt_shm_read_begin() may be torn and must be read again
+static inline int pt_shm_read_retry(const pt_shm_header *header, uint64_t start)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return (start & 1u) != 0 || __atomic_load_n(&header->sequence, __ATOMIC_RELAXED) != start;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // PTSHM_H
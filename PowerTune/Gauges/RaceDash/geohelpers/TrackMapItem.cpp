@@ -0,0 +1,383 @@
+#include "TrackMapItem.h"
+
+#include <QHash>
+#include <QMatrix4x4>
+#include <QPair>
+#include <QSGFlatColorMaterial>
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QSGTransformNode>
+#include <QtMath>
+
+#include <climits>
+#include <cmath>
+
+namespace {
+
+constexpr double METRES_PER_DEGREE = 6371000.0 * M_PI / 180.0;
+/// Smallest area the view is fitted to, so the first few fixes are not blown up to full size
+constexpr double MIN_VIEW_M = 50.0;
+constexpr qreal MARGIN_PX = 8.0;
+constexpr int MARKER_SEGMENTS = 24;
+
+int levelForScale(double pixelsPerMetre)
+{
+    return static_cast<int>(std::floor(2.0 * std::log2(pixelsPerMetre)));
+}
+
+double scaleForLevel(int level)
+{
+    return std::exp2(level / 2.0);
+}
+
+/// Douglas-Peucker over points[0, count), iterative; returns the indices kept, in order
+QVector<int> decimate(const QPointF *points, int count, double epsilon)
+{
+    QVector<int> kept;
+    if (count <= 2) {
+        for (int i = 0; i < count; ++i)
+            kept.append(i);
+        return kept;
+    }
+
+    QVector<char> keep(count, 0);
+    keep[0] = 1;
+    keep[count - 1] = 1;
+    const double epsilon2 = epsilon * epsilon;
+    QVector<QPair<int, int>> spans;
+    spans.append({0, count - 1});
+    while (!spans.isEmpty()) {
+        const QPair<int, int> span = spans.takeLast();
+        const QPointF a = points[span.first];
+        const QPointF d = points[span.second] - a;
+        const double length2 = d.x() * d.x() + d.y() * d.y();
+
+        double farthest2 = 0.0;
+        int farthest = -1;
+        for (int i = span.first + 1; i < span.second; ++i) {
+            const QPointF p = points[i] - a;
+            double distance2 = 0.0;
+            if (length2 <= 0.0) {
+                distance2 = p.x() * p.x() + p.y() * p.y();
+            } else {
+                const double cross = d.x() * p.y() - d.y() * p.x();
+                distance2 = cross * cross / length2;
+            }
+            if (distance2 > farthest2) {
+                farthest2 = distance2;
+                farthest = i;
+            }
+        }
+        if (farthest >= 0 && farthest2 > epsilon2) {
+            keep[farthest] = 1;
+            spans.append({span.first, farthest});
+            spans.append({farthest, span.second});
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (keep.at(i))
+            kept.append(i);
+    }
+    return kept;
+}
+
+/// Decimated polyline as a triangle strip of the given half width, all in metres
+void fillStrip(QSGGeometry *geometry, const QPointF *points, int count, double epsilon, double halfWidth)
+{
+    const QVector<int> kept = decimate(points, count, epsilon);
+    const int n = kept.size();
+    if (n < 2) {
+        geometry->allocate(0);
+        return;
+    }
+
+    geometry->allocate(n * 2);
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+    for (int i = 0; i < n; ++i) {
+        const QPointF &p = points[kept.at(i)];
+        const QPointF direction = points[kept.at(qMin(i + 1, n - 1))] - points[kept.at(qMax(i - 1, 0))];
+        const double length = std::hypot(direction.x(), direction.y());
+        const QPointF normal = length > 0.0 ? QPointF(-direction.y(), direction.x()) * (halfWidth / length)
+                                            : QPointF(0.0, halfWidth);
+        vertices[i * 2].set(static_cast<float>(p.x() + normal.x()), static_cast<float>(p.y() + normal.y()));
+        vertices[i * 2 + 1].set(static_cast<float>(p.x() - normal.x()), static_cast<float>(p.y() - normal.y()));
+    }
+}
+
+QSGGeometryNode *createNode(QSGGeometry::DrawingMode mode, const QColor &color)
+{
+    auto *node = new QSGGeometryNode();
+    auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(mode);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry, true);
+
+    auto *material = new QSGFlatColorMaterial();
+    material->setColor(color);
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial, true);
+    return node;
+}
+
+/// Filled circle around the origin, in pixels
+QSGGeometryNode *createMarker(qreal size, const QColor &color)
+{
+    QSGGeometryNode *node = createNode(QSGGeometry::DrawTriangles, color);
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate(MARKER_SEGMENTS * 3);
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+    const float radius = static_cast<float>(size / 2.0);
+    for (int i = 0; i < MARKER_SEGMENTS; ++i) {
+        const double a0 = 2.0 * M_PI * i / MARKER_SEGMENTS;
+        const double a1 = 2.0 * M_PI * (i + 1) / MARKER_SEGMENTS;
+        vertices[i * 3].set(0.0f, 0.0f);
+        vertices[i * 3 + 1].set(radius * static_cast<float>(std::cos(a0)), radius * static_cast<float>(std::sin(a0)));
+        vertices[i * 3 + 2].set(radius * static_cast<float>(std::cos(a1)), radius * static_cast<float>(std::sin(a1)));
+    }
+    return node;
+}
+
+/*
+ * Scene graph side of TrackMapItem. Chunk nodes of every zoom level built
+ * so far are kept; only those of the active level are in the tree.
+ */
+class TrackMapNode : public QSGNode
+{
+public:
+    TrackMapNode()
+    {
+        track = new QSGTransformNode();
+        appendChildNode(track);
+        marker = new QSGTransformNode();
+        appendChildNode(marker);
+    }
+
+    ~TrackMapNode() override
+    {
+        // Nodes in the tree are deleted with it; cached levels that are not shown are not.
+        for (auto it = levels.begin(); it != levels.end(); ++it) {
+            if (it.key() != activeLevel)
+                qDeleteAll(it.value());
+        }
+    }
+
+    QSGTransformNode *track = nullptr;
+    QSGTransformNode *marker = nullptr;
+    QSGGeometryNode *dot = nullptr;
+    QSGGeometryNode *tail = nullptr;  ///< Open chunk of the active level
+    QHash<int, QVector<QSGGeometryNode *>> levels;
+    int activeLevel = INT_MIN;
+    int generation = -1;
+    int tailVersion = -1;
+};
+
+}  // namespace
+
+TrackMapItem::TrackMapItem(QQuickItem *parent) : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void TrackMapItem::scheduleUpdate()
+{
+    update();
+    emit appearanceChanged();
+}
+
+void TrackMapItem::setRecording(bool value)
+{
+    if (m_recording == value)
+        return;
+
+    m_recording = value;
+    emit appearanceChanged();
+}
+
+void TrackMapItem::setZoom(qreal value)
+{
+    const qreal clamped = qBound(0.1, value, 64.0);
+    if (qFuzzyCompare(m_zoom, clamped))
+        return;
+
+    // Only the transform changes; the level's decimation is built once and cached.
+    m_zoom = clamped;
+    scheduleUpdate();
+}
+
+void TrackMapItem::setLineWidth(qreal value)
+{
+    const qreal clamped = qBound(0.5, value, 32.0);
+    if (qFuzzyCompare(m_lineWidth, clamped))
+        return;
+
+    m_lineWidth = clamped;
+    ++m_generation;
+    scheduleUpdate();
+}
+
+void TrackMapItem::setMarkerSize(qreal value)
+{
+    const qreal clamped = qBound(1.0, value, 128.0);
+    if (qFuzzyCompare(m_markerSize, clamped))
+        return;
+
+    m_markerSize = clamped;
+    ++m_generation;
+    scheduleUpdate();
+}
+
+void TrackMapItem::setTrackColor(const QColor &value)
+{
+    if (m_trackColor == value)
+        return;
+
+    m_trackColor = value;
+    ++m_generation;
+    scheduleUpdate();
+}
+
+void TrackMapItem::setMarkerColor(const QColor &value)
+{
+    if (m_markerColor == value)
+        return;
+
+    m_markerColor = value;
+    ++m_generation;
+    scheduleUpdate();
+}
+
+void TrackMapItem::addPosition(double latitude, double longitude)
+{
+    if (!m_hasOrigin) {
+        m_hasOrigin = true;
+        m_originLatitude = latitude;
+        m_originLongitude = longitude;
+        m_metresPerDegreeLongitude = METRES_PER_DEGREE * std::cos(qDegreesToRadians(latitude));
+    }
+    m_position = QPointF((longitude - m_originLongitude) * m_metresPerDegreeLongitude,
+                         (latitude - m_originLatitude) * METRES_PER_DEGREE);
+
+    if (m_recording) {
+        const bool moved = m_trace.isEmpty()
+                           || std::hypot(m_position.x() - m_trace.constLast().x(),
+                                         m_position.y() - m_trace.constLast().y())
+                                  >= MIN_SPACING_M;
+        if (moved) {
+            if (m_trace.isEmpty()) {
+                m_bounds = QRectF(m_position, m_position);
+            } else {
+                m_bounds.setLeft(qMin(m_bounds.left(), m_position.x()));
+                m_bounds.setRight(qMax(m_bounds.right(), m_position.x()));
+                m_bounds.setTop(qMin(m_bounds.top(), m_position.y()));
+                m_bounds.setBottom(qMax(m_bounds.bottom(), m_position.y()));
+            }
+            m_trace.append(m_position);
+            // The open chunk is redrawn at a bounded rate, and always when it fills up.
+            if (!m_tailTimer.isValid() || m_tailTimer.elapsed() >= TAIL_REBUILD_MS
+                || (m_trace.size() - 1) % CHUNK_POINTS == 0) {
+                ++m_tailVersion;
+                m_tailTimer.start();
+            }
+            emit pointCountChanged();
+        }
+    }
+    update();
+}
+
+void TrackMapItem::clear()
+{
+    m_trace.clear();
+    m_trace.squeeze();
+    m_bounds = QRectF();
+    m_hasOrigin = false;
+    m_tailTimer.invalidate();
+    ++m_generation;
+    emit pointCountChanged();
+    update();
+}
+
+QSGNode *TrackMapItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    auto *node = static_cast<TrackMapNode *>(oldNode);
+    if (node && node->generation != m_generation) {
+        delete node;
+        node = nullptr;
+    }
+    if (!node) {
+        node = new TrackMapNode();
+        node->generation = m_generation;
+    }
+
+    const QRectF bounds = boundingRect();
+    if (m_trace.isEmpty() || bounds.width() <= 2 * MARGIN_PX || bounds.height() <= 2 * MARGIN_PX)
+        return node;
+
+    // Fit the driven area into the item; zoomed in, follow the car.
+    QRectF view = m_bounds;
+    if (view.width() < MIN_VIEW_M)
+        view.adjust(-(MIN_VIEW_M - view.width()) / 2.0, 0.0, (MIN_VIEW_M - view.width()) / 2.0, 0.0);
+    if (view.height() < MIN_VIEW_M)
+        view.adjust(0.0, -(MIN_VIEW_M - view.height()) / 2.0, 0.0, (MIN_VIEW_M - view.height()) / 2.0);
+    const double fit =
+        qMin((bounds.width() - 2 * MARGIN_PX) / view.width(), (bounds.height() - 2 * MARGIN_PX) / view.height());
+    const double scale = fit * m_zoom;
+    const QPointF centre = m_zoom > 1.0 ? m_position : view.center();
+
+    QMatrix4x4 matrix;
+    matrix.translate(bounds.center().x(), bounds.center().y());
+    matrix.scale(scale, -scale);  // North up
+    matrix.translate(-centre.x(), -centre.y());
+    node->track->setMatrix(matrix);
+
+    const int level = levelForScale(scale);
+    if (level != node->activeLevel) {
+        node->track->removeAllChildNodes();
+        delete node->tail;
+        node->tail = nullptr;
+        node->activeLevel = level;
+        for (QSGGeometryNode *chunk : node->levels.value(level))
+            node->track->appendChildNode(chunk);
+        node->tailVersion = -1;
+    }
+
+    const double levelScale = scaleForLevel(level);
+    const double epsilon = TOLERANCE_PX / levelScale;
+    const double halfWidth = m_lineWidth / 2.0 / levelScale;
+
+    // Chunk k covers points [k * CHUNK_POINTS, (k + 1) * CHUNK_POINTS], sharing its end with the next one.
+    QVector<QSGGeometryNode *> &chunks = node->levels[level];
+    const int complete = (m_trace.size() - 1) / CHUNK_POINTS;
+    while (chunks.size() < complete) {
+        QSGGeometryNode *chunk = createNode(QSGGeometry::DrawTriangleStrip, m_trackColor);
+        fillStrip(chunk->geometry(), m_trace.constData() + chunks.size() * CHUNK_POINTS, CHUNK_POINTS + 1, epsilon,
+                  halfWidth);
+        if (node->tail)
+            node->track->insertChildNodeBefore(chunk, node->tail);
+        else
+            node->track->appendChildNode(chunk);
+        chunks.append(chunk);
+        node->tailVersion = -1;
+    }
+    if (node->tailVersion != m_tailVersion) {
+        if (!node->tail) {
+            node->tail = createNode(QSGGeometry::DrawTriangleStrip, m_trackColor);
+            node->track->appendChildNode(node->tail);
+        }
+        const int first = complete * CHUNK_POINTS;
+        fillStrip(node->tail->geometry(), m_trace.constData() + first, m_trace.size() - first, epsilon, halfWidth);
+        node->tail->markDirty(QSGNode::DirtyGeometry);
+        node->tailVersion = m_tailVersion;
+    }
+
+    // Per frame only the marker moves.
+    if (!node->dot) {
+        node->dot = createMarker(m_markerSize, m_markerColor);
+        node->marker->appendChildNode(node->dot);
+    }
+    const QPointF markerPosition = matrix.map(m_position);
+    QMatrix4x4 markerMatrix;
+    markerMatrix.translate(markerPosition.x(), markerPosition.y());
+    node->marker->setMatrix(markerMatrix);
+    return node;
+}
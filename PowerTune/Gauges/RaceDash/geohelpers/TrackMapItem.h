@@ -0,0 +1,104 @@
+#ifndef RACEDASH_TRACKMAPITEM_H
+#define RACEDASH_TRACKMAPITEM_H
+
+#include <QColor>
+#include <QElapsedTimer>
+#include <QPointF>
+#include <QQuickItem>
+#include <QRectF>
+#include <QVector>
+#include <qqmlintegration.h>
+
+class QSGNode;
+
+/*
+ * Driven GPS trace with a live position marker.
+ *
+ * Positions are projected once into metres around the first fix and kept at
+ * full resolution. The outline is drawn from Douglas-Peucker decimations of
+ * that trace, one per zoom level (half-octave steps of pixels per metre),
+ * built per CHUNK_POINTS-point chunk and cached as scene graph geometry in
+ * metres. Pan, zoom and resizes only change a transform; the marker is a
+ * separate node that is moved, never rebuilt. Only the open tail chunk is
+ * re-decimated, at most every TAIL_REBUILD_MS.
+ *
+ * Feed it per fix, e.g. GPS.onGpsTimestampChanged: map.addPosition(GPS.gpsLatitude, GPS.gpsLongitude)
+ */
+class TrackMapItem : public QQuickItem
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(TrackMapItem)
+
+    Q_PROPERTY(bool recording READ recording WRITE setRecording NOTIFY appearanceChanged)
+    Q_PROPERTY(qreal zoom READ zoom WRITE setZoom NOTIFY appearanceChanged)
+    Q_PROPERTY(qreal lineWidth READ lineWidth WRITE setLineWidth NOTIFY appearanceChanged)
+    Q_PROPERTY(qreal markerSize READ markerSize WRITE setMarkerSize NOTIFY appearanceChanged)
+    Q_PROPERTY(QColor trackColor READ trackColor WRITE setTrackColor NOTIFY appearanceChanged)
+    Q_PROPERTY(QColor markerColor READ markerColor WRITE setMarkerColor NOTIFY appearanceChanged)
+    Q_PROPERTY(int pointCount READ pointCount NOTIFY pointCountChanged)
+
+public:
+    /// Raw points per cached chunk
+    static constexpr int CHUNK_POINTS = 1024;
+    /// Fixes closer than this to the last stored point are not stored (standing still)
+    static constexpr double MIN_SPACING_M = 1.0;
+    /// Decimation tolerance on screen
+    static constexpr double TOLERANCE_PX = 0.5;
+    static constexpr int TAIL_REBUILD_MS = 500;
+
+    explicit TrackMapItem(QQuickItem *parent = nullptr);
+
+    bool recording() const { return m_recording; }
+    void setRecording(bool value);
+
+    qreal zoom() const { return m_zoom; }
+    void setZoom(qreal value);
+
+    qreal lineWidth() const { return m_lineWidth; }
+    void setLineWidth(qreal value);
+
+    qreal markerSize() const { return m_markerSize; }
+    void setMarkerSize(qreal value);
+
+    QColor trackColor() const { return m_trackColor; }
+    void setTrackColor(const QColor &value);
+
+    QColor markerColor() const { return m_markerColor; }
+    void setMarkerColor(const QColor &value);
+
+    int pointCount() const { return m_trace.size(); }
+
+    Q_INVOKABLE void addPosition(double latitude, double longitude);
+    Q_INVOKABLE void clear();
+
+signals:
+    void appearanceChanged();
+    void pointCountChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+
+private:
+    void scheduleUpdate();
+
+    QVector<QPointF> m_trace;  ///< Metres east / north of the first fix
+    QRectF m_bounds;
+    QPointF m_position;
+    bool m_hasOrigin = false;
+    double m_originLatitude = 0.0;
+    double m_originLongitude = 0.0;
+    double m_metresPerDegreeLongitude = 0.0;
+
+    int m_generation = 0;   ///< Bumped by clear() and appearance changes that invalidate cached geometry
+    int m_tailVersion = 0;  ///< Bumped when the open chunk should be redrawn
+    QElapsedTimer m_tailTimer;
+
+    bool m_recording = true;
+    qreal m_zoom = 1.0;
+    qreal m_lineWidth = 4.0;
+    qreal m_markerSize = 12.0;
+    QColor m_trackColor = QColor(QStringLiteral("#B0B0B0"));
+    QColor m_markerColor = QColor(QStringLiteral("#FF8A00"));
+};
+
+#endif
@@ -1230,4 +1230,953 @@ SettingsPage {
         }
     }
 
+    // * CAN BUS ANALYZER
+    SettingsSection {
+        id: canAnalyzerSection
+
+        Layout.fillWidth: true
+        collapsed: true
+        collapsible: true
+        title: "CAN Bus Analyzer"
+
+        onCollapsedChanged: CanAnalyzer.tableVisible = !collapsed
+        Component.onDestruction: CanAnalyzer.tableVisible = false
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            Text {
+                color: CanAnalyzer.busLoadPercent > 70 ? SettingsTheme.warning : SettingsTheme.textPrimary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: "Bus load " + CanAnalyzer.busLoadPercent.toFixed(1) + "% @ " + (CanAnalyzer.bitrate / 1000) + " kbit/s"
+            }
+
+            Text {
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: CanAnalyzer.totalFrameRate + " frames/s, " + CanAnalyzer.uniqueIdCount + " IDs"
+                      + (CanAnalyzer.untrackedFrames > 0 ? ", " + CanAnalyzer.untrackedFrames + " untracked" : "")
+            }
+
+            Item {
+                Layout.fillWidth: true
+            }
+
+            StyledButton {
+                primary: false
+                text: "Reset"
+
+                onClicked: CanAnalyzer.reset()
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            Text {
+                Layout.preferredWidth: 80
+                color: SettingsTheme.accent
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                font.weight: Font.DemiBold
+                text: "ID"
+            }
+
+            Text {
+                Layout.preferredWidth: 30
+                color: SettingsTheme.accent
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                font.weight: Font.DemiBold
+                text: "DLC"
+            }
+
+            Text {
+                Layout.preferredWidth: 60
+                color: SettingsTheme.accent
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                font.weight: Font.DemiBold
+                text: "Rate /s"
+            }
+
+            Text {
+                Layout.preferredWidth: 60
+                color: SettingsTheme.accent
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                font.weight: Font.DemiBold
+                text: "Mean ms"
+            }
+
+            Text {
+                Layout.preferredWidth: 60
+                color: SettingsTheme.accent
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                font.weight: Font.DemiBold
+                text: "Max ms"
+            }
+
+            Text {
+                Layout.preferredWidth: 60
+                color: SettingsTheme.accent
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                font.weight: Font.DemiBold
+                text: "Jitter ms"
+            }
+
+            Text {
+                Layout.fillWidth: true
+                color: SettingsTheme.accent
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                font.weight: Font.DemiBold
+                text: "Age ms"
+            }
+        }
+
+        Rectangle {
+            Layout.fillWidth: true
+            color: SettingsTheme.border
+            height: SettingsTheme.borderWidth
+        }
+
+        ListView {
+            id: canAnalyzerList
+
+            Layout.fillWidth: true
+            Layout.preferredHeight: 300
+            clip: true
+            model: CanAnalyzer.idStats
+            spacing: 1
+
+            ScrollBar.vertical: ScrollBar {
+                policy: canAnalyzerList.contentHeight > canAnalyzerList.height ? ScrollBar.AsNeeded : ScrollBar.AlwaysOff
+            }
+            delegate: Rectangle {
+                required property int index
+                required property var modelData
+
+                color: index % 2 === 0 ? SettingsTheme.surface : SettingsTheme.background
+                height: 28
+                width: canAnalyzerList.width
+
+                RowLayout {
+                    anchors.fill: parent
+                    anchors.leftMargin: 4
+                    anchors.rightMargin: 4
+                    spacing: SettingsTheme.contentSpacing
+
+                    Text {
+                        Layout.preferredWidth: 80
+                        color: SettingsTheme.accent
+                        font.family: SettingsTheme.fontFamilyMono
+                        font.pixelSize: SettingsTheme.fontCaption
+                        text: modelData.id
+                    }
+
+                    Text {
+                        Layout.preferredWidth: 30
+                        color: SettingsTheme.textSecondary
+                        font.family: SettingsTheme.fontFamilyMono
+                        font.pixelSize: SettingsTheme.fontCaption
+                        text: modelData.dlc
+                    }
+
+                    Text {
+                        Layout.preferredWidth: 60
+                        color: SettingsTheme.textPrimary
+                        font.family: SettingsTheme.fontFamilyMono
+                        font.pixelSize: SettingsTheme.fontCaption
+                        text: modelData.rate.toFixed(1)
+                    }
+
+                    Text {
+                        Layout.preferredWidth: 60
+                        color: SettingsTheme.textPrimary
+                        font.family: SettingsTheme.fontFamilyMono
+                        font.pixelSize: SettingsTheme.fontCaption
+                        text: modelData.meanMs.toFixed(2)
+                    }
+
+                    Text {
+                        Layout.preferredWidth: 60
+                        color: SettingsTheme.textPrimary
+                        font.family: SettingsTheme.fontFamilyMono
+                        font.pixelSize: SettingsTheme.fontCaption
+                        text: modelData.maxMs.toFixed(2)
+                    }
+
+                    Text {
+                        Layout.preferredWidth: 60
+                        color: SettingsTheme.textPrimary
+                        font.family: SettingsTheme.fontFamilyMono
+                        font.pixelSize: SettingsTheme.fontCaption
+                        text: modelData.jitterMs.toFixed(2)
+                    }
+
+                    Text {
+                        Layout.fillWidth: true
+                        color: modelData.ageMs > 1000 ? SettingsTheme.warning : SettingsTheme.textSecondary
+                        font.family: SettingsTheme.fontFamilyMono
+                        font.pixelSize: SettingsTheme.fontCaption
+                        text: modelData.ageMs
+                    }
+                }
+            }
+        }
+    }
+
+    // * CAN RECORDER
+    SettingsSection {
+        id: canRecorderSection
+
+        Layout.fillWidth: true
+        collapsed: true
+        collapsible: true
+        title: "CAN Recorder"
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            StyledSwitch {
+                id: canRecorderToggle
+
+                checked: CanRecorder.recording
+
+                onCheckedChanged: CanRecorder.recording = checked
+            }
+
+            Text {
+                color: CanRecorder.recording ? SettingsTheme.success : SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: CanRecorder.recording ? "Recording" : "Stopped"
+            }
+
+            Item {
+                Layout.fillWidth: true
+            }
+
+            StyledSwitch {
+                id: canRecorderBinaryToggle
+
+                checked: CanRecorder.binaryFormat
+                enabled: !CanRecorder.recording
+
+                onCheckedChanged: CanRecorder.binaryFormat = checked
+            }
+
+            Text {
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: canRecorderBinaryToggle.checked ? "Binary (.ptcan)" : "candump (.log)"
+            }
+        }
+
+        Text {
+            Layout.fillWidth: true
+            color: CanRecorder.framesDropped > 0 ? SettingsTheme.warning : SettingsTheme.textSecondary
+            font.family: SettingsTheme.fontFamilyMono
+            font.pixelSize: SettingsTheme.fontCaption
+            text: CanRecorder.framesRecorded.toFixed(0) + " frames, " + (CanRecorder.bytesWritten / 1024).toFixed(0)
+                  + " KiB, " + CanRecorder.framesDropped.toFixed(0) + " dropped"
+            visible: CanRecorder.filePath !== ""
+        }
+
+        Text {
+            Layout.fillWidth: true
+            color: SettingsTheme.textSecondary
+            elide: Text.ElideMiddle
+            font.family: SettingsTheme.fontFamilyMono
+            font.pixelSize: SettingsTheme.fontCaption
+            text: CanRecorder.filePath
+            visible: CanRecorder.filePath !== ""
+        }
+    }
+
+    // * DATA LOGGER
+    SettingsSection {
+        id: dataLoggerSection
+
+        Layout.fillWidth: true
+        collapsed: true
+        collapsible: true
+        title: "Data Logger"
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            Text {
+                Layout.preferredWidth: root._statusLabelWidth
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontStatus
+                text: "Sample Rate"
+            }
+
+            StyledComboBox {
+                id: loggerRateSelect
+
+                readonly property var rates: [10, 20, 50, 100]
+
+                currentIndex: Math.max(0, rates.indexOf(Logger.sampleRateHz))
+                model: ["10 Hz", "20 Hz", "50 Hz", "100 Hz"]
+
+                onActivated: index => Logger.sampleRateHz = rates[index]
+            }
+
+            Text {
+                Layout.preferredWidth: root._statusLabelWidth
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontStatus
+                text: "Sync To Disk"
+            }
+
+            StyledComboBox {
+                currentIndex: Logger.fsyncMode
+                model: ["Never", "Every 5 s", "Every Block"]
+
+                onActivated: index => Logger.fsyncMode = index
+            }
+
+            Text {
+                Layout.preferredWidth: root._statusLabelWidth
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontStatus
+                text: "Compression"
+            }
+
+            StyledComboBox {
+                currentIndex: Logger.compression
+                model: Logger.zstdAvailable ? ["Off", "zlib", "zstd"] : ["Off", "zlib"]
+
+                onActivated: index => Logger.compression = index
+            }
+
+            Item {
+                Layout.fillWidth: true
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            Text {
+                Layout.preferredWidth: root._statusLabelWidth
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontStatus
+                text: "Segment Size"
+            }
+
+            StyledComboBox {
+                readonly property var sizes: [0, 16, 64, 256]
+
+                currentIndex: Math.max(0, sizes.indexOf(Logger.segmentSizeMiB))
+                model: ["Off", "16 MiB", "64 MiB", "256 MiB"]
+
+                onActivated: index => Logger.segmentSizeMiB = sizes[index]
+            }
+
+            Text {
+                Layout.preferredWidth: root._statusLabelWidth
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontStatus
+                text: "Segment Age"
+            }
+
+            StyledComboBox {
+                readonly property var minutes: [0, 10, 30, 60]
+
+                currentIndex: Math.max(0, minutes.indexOf(Logger.segmentMinutes))
+                model: ["Off", "10 min", "30 min", "60 min"]
+
+                onActivated: index => Logger.segmentMinutes = minutes[index]
+            }
+
+            Text {
+                Layout.preferredWidth: root._statusLabelWidth
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontStatus
+                text: "Disk Budget"
+            }
+
+            StyledComboBox {
+                readonly property var budgets: [0, 1024, 4096, 16384]
+
+                currentIndex: Math.max(0, budgets.indexOf(Logger.diskBudgetMiB))
+                model: ["Off", "1 GiB", "4 GiB", "16 GiB"]
+
+                onActivated: index => Logger.diskBudgetMiB = budgets[index]
+            }
+
+            Item {
+                Layout.fillWidth: true
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            StyledSwitch {
+                id: loggerBinaryToggle
+
+                checked: Logger.binaryFormat
+
+                onCheckedChanged: Logger.binaryFormat = checked
+            }
+
+            Text {
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: loggerBinaryToggle.checked ? "Binary (.ptlog)" : "CSV"
+            }
+
+            Item {
+                Layout.fillWidth: true
+            }
+
+            StyledButton {
+                enabled: !Logger.logging && (Logger.lastLogPath.endsWith(".ptlog") || Logger.lastLogPath.endsWith(".ptz"))
+                primary: false
+                text: "Export CSV"
+
+                onClicked: Logger.exportCsv()
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            StyledSwitch {
+                id: loggerChannelToggle
+
+                checked: Logger.channelLogging
+
+                onCheckedChanged: Logger.channelLogging = checked
+            }
+
+            Text {
+                Layout.fillWidth: true
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: {
+                    if (!loggerChannelToggle.checked)
+                        return "Fixed column set";
+                    if (Logger.logging)
+                        return Logger.channelCount + " registry channels (.ptlog)";
+                    return "Registry channels, per-channel rate or on change (.ptlog)";
+                }
+            }
+        }
+
+        ListView {
+            id: loggerChannelList
+
+            readonly property var rates: [0, 1, 10, 50, 100, 200]
+
+            Layout.fillWidth: true
+            Layout.preferredHeight: 200
+            clip: true
+            model: loggerChannelToggle.checked && !dataLoggerSection.collapsed ? SensorRegistry.sensorKeys() : []
+            spacing: 1
+            visible: loggerChannelToggle.checked
+
+            ScrollBar.vertical: ScrollBar {
+                policy: ScrollBar.AsNeeded
+            }
+            delegate: Rectangle {
+                required property int index
+                required property string modelData
+
+                color: index % 2 === 0 ? SettingsTheme.surface : SettingsTheme.background
+                height: SettingsTheme.controlHeight + 4
+                width: loggerChannelList.width
+
+                RowLayout {
+                    anchors.fill: parent
+                    anchors.leftMargin: SettingsTheme.contentSpacing / 2
+                    anchors.rightMargin: SettingsTheme.contentSpacing / 2
+                    spacing: SettingsTheme.contentSpacing
+
+                    Text {
+                        Layout.fillWidth: true
+                        color: SettingsTheme.textPrimary
+                        elide: Text.ElideRight
+                        font.family: SettingsTheme.fontFamily
+                        font.pixelSize: SettingsTheme.fontStatus
+                        text: SensorRegistry.getDisplayName(modelData) + "  (" + modelData + ")"
+                    }
+
+                    StyledComboBox {
+                        currentIndex: Math.max(0, loggerChannelList.rates.indexOf(Logger.channelRate(modelData)))
+                        model: ["On change", "1 Hz", "10 Hz", "50 Hz", "100 Hz", "200 Hz"]
+
+                        onActivated: index => Logger.setChannelRate(modelData, loggerChannelList.rates[index])
+                    }
+                }
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            Text {
+                Layout.preferredWidth: root._statusLabelWidth
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontStatus
+                text: "Pre-Trigger"
+            }
+
+            StyledComboBox {
+                readonly property var seconds: [0, 5, 10, 30, 60]
+
+                currentIndex: Math.max(0, seconds.indexOf(Logger.preTriggerSeconds))
+                model: ["Off", "5 s", "10 s", "30 s", "60 s"]
+
+                onActivated: index => Logger.preTriggerSeconds = seconds[index]
+            }
+
+            Text {
+                Layout.preferredWidth: root._statusLabelWidth
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontStatus
+                text: "Post-Trigger"
+            }
+
+            StyledComboBox {
+                readonly property var seconds: [5, 10, 30, 60, 120]
+
+                currentIndex: Math.max(0, seconds.indexOf(Logger.postTriggerSeconds))
+                model: ["5 s", "10 s", "30 s", "60 s", "120 s"]
+
+                onActivated: index => Logger.postTriggerSeconds = seconds[index]
+            }
+
+            Text {
+                Layout.preferredWidth: root._statusLabelWidth
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontStatus
+                text: "Digital Input"
+            }
+
+            StyledComboBox {
+                currentIndex: Logger.triggerDigitalInput
+                model: ["Off", "DI 1", "DI 2", "DI 3", "DI 4", "DI 5", "DI 6", "DI 7", "DI 8"]
+
+                onActivated: index => Logger.triggerDigitalInput = index
+            }
+
+            Item {
+                Layout.fillWidth: true
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            StyledTextField {
+                Layout.preferredWidth: 180
+                inputMethodHints: Qt.ImhNoPredictiveText
+                placeholderText: "Trigger sensor key"
+                text: Logger.triggerSensor
+
+                onEditingFinished: Logger.triggerSensor = text
+            }
+
+            StyledComboBox {
+                currentIndex: Logger.triggerAbove ? 0 : 1
+                model: ["Above", "Below"]
+
+                onActivated: index => Logger.triggerAbove = index === 0
+            }
+
+            StyledTextField {
+                Layout.preferredWidth: 100
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+                text: Logger.triggerThreshold
+
+                onEditingFinished: Logger.triggerThreshold = Number(text)
+            }
+
+            Item {
+                Layout.fillWidth: true
+            }
+
+            Text {
+                color: Logger.capturing ? SettingsTheme.success : SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: Logger.capturing ? "Capturing" : (Logger.preTriggerSeconds > 0 ? "Armed" : "Off")
+            }
+
+            StyledButton {
+                enabled: !Logger.logging
+                primary: false
+                text: "Trigger"
+
+                onClicked: Logger.trigger()
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            StyledSwitch {
+                id: blackBoxToggle
+
+                checked: Logger.blackBoxEnabled
+
+                onCheckedChanged: Logger.blackBoxEnabled = checked
+            }
+
+            Text {
+                color: blackBoxToggle.checked ? SettingsTheme.success : SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: blackBoxToggle.checked ? "Black box recording" : "Black box off"
+            }
+
+            Item {
+                Layout.fillWidth: true
+            }
+
+            Text {
+                Layout.preferredWidth: root._statusLabelWidth
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontStatus
+                text: "Black Box Length"
+            }
+
+            StyledComboBox {
+                readonly property var minutes: [2, 5, 10, 30]
+
+                currentIndex: Math.max(0, minutes.indexOf(Logger.blackBoxMinutes))
+                enabled: blackBoxToggle.checked
+                model: ["2 min", "5 min", "10 min", "30 min"]
+
+                onActivated: index => Logger.blackBoxMinutes = minutes[index]
+            }
+        }
+
+        Text {
+            id: loggerStatsText
+
+            Layout.fillWidth: true
+            color: Logger.logging ? SettingsTheme.textPrimary : SettingsTheme.textSecondary
+            font.family: SettingsTheme.fontFamilyMono
+            font.pixelSize: SettingsTheme.fontCaption
+            text: Logger.writerStatsText()
+            wrapMode: Text.WordWrap
+        }
+
+        Timer {
+            interval: 1000
+            repeat: true
+            running: !dataLoggerSection.collapsed
+            triggeredOnStart: true
+
+            onTriggered: loggerStatsText.text = Logger.writerStatsText()
+        }
+    }
+
+    // * LOG PLAYBACK
+    SettingsSection {
+        id: logPlaybackSection
+
+        function formatTime(ms) {
+            const seconds = Math.floor(ms / 1000);
+            return Math.floor(seconds / 60) + ":" + String(seconds % 60).padStart(2, "0");
+        }
+
+        Layout.fillWidth: true
+        collapsed: true
+        collapsible: true
+        title: "Log Playback"
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            StyledTextField {
+                id: playbackPathField
+
+                Layout.fillWidth: true
+                inputMethodHints: Qt.ImhNoPredictiveText
+                placeholderText: "Log file (CSV, .ptlog, .ptz)"
+                text: LogPlayer.loaded ? LogPlayer.path : Logger.lastLogPath
+            }
+
+            StyledButton {
+                enabled: !LogPlayer.loading
+                primary: false
+                text: LogPlayer.loading ? "Loading..." : "Load"
+
+                onClicked: LogPlayer.load(playbackPathField.text)
+            }
+
+            StyledButton {
+                enabled: LogPlayer.loaded
+                primary: false
+                text: "Unload"
+
+                onClicked: LogPlayer.unload()
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            enabled: LogPlayer.loaded
+            spacing: SettingsTheme.contentSpacing
+
+            StyledButton {
+                primary: false
+                text: LogPlayer.playing ? "Pause" : "Play"
+
+                onClicked: LogPlayer.playing ? LogPlayer.pause() : LogPlayer.play()
+            }
+
+            Slider {
+                id: playbackSlider
+
+                Layout.fillWidth: true
+                Layout.preferredHeight: SettingsTheme.controlHeight
+                from: 0
+                to: Math.max(1, LogPlayer.duration)
+                value: LogPlayer.position
+
+                onMoved: LogPlayer.seek(value)
+            }
+
+            Text {
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamilyMono
+                font.pixelSize: SettingsTheme.fontCaption
+                text: logPlaybackSection.formatTime(LogPlayer.position) + " / "
+                      + logPlaybackSection.formatTime(LogPlayer.duration)
+            }
+
+            StyledComboBox {
+                readonly property var speeds: [0.25, 0.5, 1, 2, 4, 8]
+
+                currentIndex: Math.max(0, speeds.indexOf(LogPlayer.speed))
+                model: ["0.25x", "0.5x", "1x", "2x", "4x", "8x"]
+
+                onActivated: index => LogPlayer.speed = speeds[index]
+            }
+
+            StyledSwitch {
+                id: playbackLoopToggle
+
+                checked: LogPlayer.loop
+
+                onCheckedChanged: LogPlayer.loop = checked
+            }
+
+            Text {
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: "Loop"
+            }
+        }
+
+        Text {
+            Layout.fillWidth: true
+            color: SettingsTheme.textSecondary
+            font.family: SettingsTheme.fontFamily
+            font.pixelSize: SettingsTheme.fontStatus
+            text: LogPlayer.loaded ? LogPlayer.channelCount + " channels drive the dashboard models"
+                                   : "Replays a recorded session into the live dashboard; disconnect the ECU first."
+            wrapMode: Text.WordWrap
+        }
+    }
+
+    // * RENDER TIMING
+    SettingsSection {
+        id: renderTimingSection
+
+        Layout.fillWidth: true
+        collapsed: true
+        collapsible: true
+        title: "Render Timing"
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            StyledSwitch {
+                id: frameTimingToggle
+
+                checked: FrameTiming.enabled
+
+                onCheckedChanged: FrameTiming.enabled = checked
+            }
+
+            Text {
+                color: frameTimingToggle.checked ? SettingsTheme.success : SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: frameTimingToggle.checked ? "Measuring" : "Stopped"
+            }
+
+            Item {
+                Layout.fillWidth: true
+            }
+
+            StyledSwitch {
+                id: frameTimingLogToggle
+
+                checked: FrameTiming.logEnabled
+
+                onCheckedChanged: FrameTiming.logEnabled = checked
+            }
+
+            Text {
+                color: SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: "Log every second"
+            }
+
+            StyledButton {
+                primary: false
+                text: "Log Summary"
+
+                onClicked: FrameTiming.logSummary()
+            }
+
+            StyledButton {
+                primary: false
+                text: "Reset"
+
+                onClicked: FrameTiming.reset()
+            }
+        }
+
+        Repeater {
+            model: [
+                { label: "Frame Rate", value: FrameTiming.frameRate.toFixed(1) + " fps" },
+                { label: "Frame p50", value: FrameTiming.frameP50Ms.toFixed(2) + " ms" },
+                { label: "Frame p95", value: FrameTiming.frameP95Ms.toFixed(2) + " ms" },
+                { label: "Frame p99", value: FrameTiming.frameP99Ms.toFixed(2) + " ms" },
+                { label: "Frame Max", value: FrameTiming.frameMaxMs.toFixed(2) + " ms" },
+                { label: "Sync", value: FrameTiming.syncMs.toFixed(2) + " ms" },
+                { label: "Render", value: FrameTiming.renderMs.toFixed(2) + " ms" },
+                { label: "Swap", value: FrameTiming.swapMs.toFixed(2) + " ms" },
+                { label: "Dropped", value: FrameTiming.droppedFrames + " (vsync " + FrameTiming.vsyncIntervalMs.toFixed(2)
+                                           + " ms)" }
+            ]
+
+            RowLayout {
+                required property var modelData
+
+                Layout.fillWidth: true
+                Layout.preferredHeight: root._statusRowHeight
+                spacing: SettingsTheme.contentSpacing
+
+                Text {
+                    Layout.preferredWidth: root._statusLabelWidth
+                    color: SettingsTheme.textSecondary
+                    font.family: SettingsTheme.fontFamily
+                    font.pixelSize: SettingsTheme.fontStatus
+                    text: modelData.label
+                }
+
+                Text {
+                    Layout.fillWidth: true
+                    color: FrameTiming.enabled ? SettingsTheme.textPrimary : SettingsTheme.textDisabled
+                    font.family: SettingsTheme.fontFamily
+                    font.pixelSize: SettingsTheme.fontStatus
+                    text: modelData.value
+                }
+            }
+        }
+    }
+
+    // * TRACE CAPTURE
+    SettingsSection {
+        id: traceSection
+
+        Layout.fillWidth: true
+        collapsed: true
+        collapsible: true
+        title: "Trace Capture"
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: SettingsTheme.contentSpacing
+
+            StyledSwitch {
+                id: traceToggle
+
+                checked: Tracer.recording
+                enabled: Tracer.compiledIn
+
+                onCheckedChanged: Tracer.recording = checked
+            }
+
+            Text {
+                color: traceToggle.checked ? SettingsTheme.success : SettingsTheme.textSecondary
+                font.family: SettingsTheme.fontFamily
+                font.pixelSize: SettingsTheme.fontCaption
+                text: !Tracer.compiledIn ? "Not compiled in" : (traceToggle.checked ? "Recording" : "Stopped")
+            }
+
+            Item {
+                Layout.fillWidth: true
+            }
+
+            StyledButton {
+                enabled: Tracer.compiledIn
+                primary: true
+                text: "Dump Trace"
+
+                onClicked: Tracer.dumpChromeTrace()
+            }
+
+            StyledButton {
+                enabled: Tracer.compiledIn
+                primary: false
+                text: "Clear"
+
+                onClicked: Tracer.clear()
+            }
+        }
+
+        Text {
+            Layout.fillWidth: true
+            color: SettingsTheme.textSecondary
+            elide: Text.ElideMiddle
+            font.family: SettingsTheme.fontFamilyMono
+            font.pixelSize: SettingsTheme.fontCaption
+            text: Tracer.lastDumpPath !== "" ? Tracer.lastDumpPath : "Open dumps in ui.perfetto.dev or chrome://tracing"
+        }
+    }
 }
@@ -78,7 +78,6 @@ SettingsPage {
     }
 
     function connectEcu() {
-        Connect.setOdometer(odometer.text);
         Connect.setWeight(weight.text);
         var backendIdx = ecuBackendMap[ecuSelect.currentIndex];
         Connect.openConnection("", backendIdx, baseadresstext.text, shiftlightbaseadresstext.text);
@@ -128,14 +127,14 @@ SettingsPage {
         unitSelect1.currentIndex = AppSettings.getValue("ui/unitSelector1", 0);
         unitSelect.currentIndex = AppSettings.getValue("ui/unitSelector", 0);
         unitSelect2.currentIndex = AppSettings.getValue("ui/unitSelector2", 0);
-        odometer.text = AppSettings.getValue("ui/odometer", "0");
-        tripmeter.text = AppSettings.getValue("ui/tripmeter", "0");
+        // Odo and Trip are restored from the odometer journal at startup
+        odometer.text = Vehicle.Odo.toFixed(3);
+        tripmeter.text = Vehicle.Trip.toFixed(3);
         baseadresstext.text = AppSettings.getValue("ui/extenderCanBase", "");
         shiftlightbaseadresstext.text = AppSettings.getValue("ui/shiftLightCanBase", "");
         languageselect.currentIndex = AppSettings.getValue("Language", 0);
         mainspeedsource.currentIndex = AppSettings.getValue("ui/mainSpeedSource", 0);
         canbitrateselect.currentIndex = AppSettings.getValue("ui/bitrateSelect", 0);
-        Vehicle.setTrip(tripmeter.text);
         AppSettings.setSpeedUnitIndex(unitSelect1.currentIndex);
         AppSettings.setTempUnitIndex(unitSelect.currentIndex);
         AppSettings.setPressureUnitIndex(unitSelect2.currentIndex);
@@ -546,8 +545,7 @@ SettingsPage {
                         inputMethodHints: Qt.ImhFormattedNumbersOnly
                         text: "0"
 
-                        onTextChanged: if (settingsLoaded)
-                                           AppSettings.setValue("ui/odometer", text)
+                        onEditingFinished: Connect.setOdometer(text)
                     }
                 }
 
@@ -565,9 +563,6 @@ SettingsPage {
                             Layout.preferredHeight: SettingsTheme.controlHeight
                             readOnly: true
                             text: "0"
-
-                            onTextChanged: if (settingsLoaded)
-                                               AppSettings.setValue("ui/tripmeter", text)
                         }
 
                         StyledButton {
@@ -0,0 +1,56 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file ptblackbox.cpp
+ * @brief Command-line extractor for the black box ring file (blackbox.ptbb).
+ *
+ * Run after a reboot on the file left by the interrupted session (the app
+ * keeps it as blackbox_prev.ptbb once it starts again). Records are written
+ * oldest first in the logger CSV layout; time_ms is wall-clock epoch ms.
+ *
+ * Usage: ptblackbox <blackbox.ptbb> [output.csv]
+ */
+
+#include "Utils/BlackBoxRecorder.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFileInfo>
+
+#include <cstdio>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("ptblackbox"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Extract the PowerTune black box ring to CSV."));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("input"), QStringLiteral("Black box file (.ptbb)"));
+    parser.addPositionalArgument(QStringLiteral("output"), QStringLiteral("CSV file (default: input.csv)"),
+                                 QStringLiteral("[output]"));
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.isEmpty() || args.size() > 2)
+        parser.showHelp(1);
+
+    const QString input = args.at(0);
+    QString output = args.size() > 1 ? args.at(1) : QString();
+    if (output.isEmpty()) {
+        const QFileInfo info(input);
+        output = info.path() + QLatin1Char('/') + info.completeBaseName() + QStringLiteral(".csv");
+    }
+
+    QString error;
+    qint64 records = 0;
+    qint64 torn = 0;
+    if (!BlackBoxRecorder::extractCsv(input, output, &error, &records, &torn)) {
+        std::fprintf(stderr, "ptblackbox: %s\n", qPrintable(error));
+        return 1;
+    }
+    std::printf("%s: %lld records, %lld torn\n", qPrintable(output), static_cast<long long>(records),
+                static_cast<long long>(torn));
+    return 0;
+}
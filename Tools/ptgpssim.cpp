@@ -0,0 +1,204 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file ptgpssim.cpp
+ * @brief Bench stand-in for a serial GPS receiver: streams NMEA on a pseudo-terminal.
+ *
+ * Opens a pty, prints its slave path and writes GGA + RMC at the requested
+ * rate (1-25 Hz), either for a car lapping a circle or replayed from a
+ * recorded .nmea file. Point the dash at the printed path (--gps <path>) to
+ * exercise GpsReceiver without hardware.
+ *
+ * Usage: ptgpssim [--rate HZ] [--speed KPH] [--radius M] [--center LAT,LON] [--replay file.nmea]
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+constexpr double PI = 3.14159265358979323846;
+constexpr double EARTH_RADIUS_M = 6371000.0;
+constexpr double KPH_TO_KNOTS = 1.0 / 1.852;
+
+/// Appends "*hh\r\n" to a "$..." body
+QByteArray withChecksum(const QByteArray &body)
+{
+    quint8 sum = 0;
+    for (int i = 1; i < body.size(); ++i)
+        sum ^= static_cast<quint8>(body.at(i));
+    char tail[8];
+    std::snprintf(tail, sizeof(tail), "*%02X\r\n", sum);
+    return body + tail;
+}
+
+/// "ddmm.mmmmmm,H" for latitude (2 degree digits) or longitude (3)
+QByteArray coordinate(double degrees, int degreeDigits, char positive, char negative)
+{
+    const char hemisphere = degrees < 0.0 ? negative : positive;
+    degrees = std::fabs(degrees);
+    const int whole = static_cast<int>(degrees);
+    char text[32];
+    std::snprintf(text, sizeof(text), "%0*d%09.6f,%c", degreeDigits, whole, (degrees - whole) * 60.0, hemisphere);
+    return text;
+}
+
+QByteArray timeOfDay(qint64 utcMs)
+{
+    utcMs %= 86400000;
+    char text[16];
+    std::snprintf(text, sizeof(text), "%02d%02d%02d.%03d", static_cast<int>(utcMs / 3600000),
+                  static_cast<int>(utcMs / 60000 % 60), static_cast<int>(utcMs / 1000 % 60),
+                  static_cast<int>(utcMs % 1000));
+    return text;
+}
+
+void sleepUntil(timespec &deadline, long periodNs)
+{
+    deadline.tv_nsec += periodNs;
+    while (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_nsec -= 1000000000L;
+        ++deadline.tv_sec;
+    }
+    while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+    }
+}
+
+bool writeAll(int fd, const QByteArray &data)
+{
+    qsizetype written = 0;
+    while (written < data.size()) {
+        const ssize_t n = ::write(fd, data.constData() + written, data.size() - written);
+        if (n < 0 && errno != EINTR)
+            return false;
+        if (n > 0)
+            written += n;
+    }
+    return true;
+}
+
+/// The time field of a sentence, which groups the sentences of one epoch
+QByteArray epochOf(const QByteArray &line)
+{
+    const int first = line.indexOf(',');
+    const int second = first < 0 ? -1 : line.indexOf(',', first + 1);
+    return second < 0 ? QByteArray() : line.mid(first + 1, second - first - 1);
+}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("ptgpssim"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Stream simulated NMEA GPS on a pseudo-terminal."));
+    parser.addHelpOption();
+    const QCommandLineOption rateOption(QStringLiteral("rate"), QStringLiteral("Fix rate in Hz, 1-25 (default 10)"),
+                                        QStringLiteral("hz"), QStringLiteral("10"));
+    const QCommandLineOption speedOption(QStringLiteral("speed"), QStringLiteral("Speed in km/h (default 120)"),
+                                         QStringLiteral("kph"), QStringLiteral("120"));
+    const QCommandLineOption radiusOption(QStringLiteral("radius"),
+                                          QStringLiteral("Radius of the circular track in m (default 300)"),
+                                          QStringLiteral("m"), QStringLiteral("300"));
+    const QCommandLineOption centerOption(QStringLiteral("center"),
+                                          QStringLiteral("Track centre (default -27.6900,153.1700)"),
+                                          QStringLiteral("lat,lon"), QStringLiteral("-27.6900,153.1700"));
+    const QCommandLineOption replayOption(QStringLiteral("replay"),
+                                          QStringLiteral("Replay a recorded NMEA file, one epoch per tick"),
+                                          QStringLiteral("file"));
+    parser.addOptions({rateOption, speedOption, radiusOption, centerOption, replayOption});
+    parser.process(app);
+
+    const int rate = qBound(1, parser.value(rateOption).toInt(), 25);
+    const double speedKph = parser.value(speedOption).toDouble();
+    const double radius = qMax(10.0, parser.value(radiusOption).toDouble());
+    const QStringList center = parser.value(centerOption).split(QLatin1Char(','));
+    const double centerLat = center.value(0).toDouble();
+    const double centerLon = center.value(1).toDouble();
+
+    QList<QByteArray> replay;
+    if (parser.isSet(replayOption)) {
+        QFile file(parser.value(replayOption));
+        if (!file.open(QIODevice::ReadOnly)) {
+            std::fprintf(stderr, "ptgpssim: %s\n", qPrintable(file.errorString()));
+            return 1;
+        }
+        while (!file.atEnd()) {
+            const QByteArray line = file.readLine().trimmed();
+            if (line.startsWith('$'))
+                replay.append(line + "\r\n");
+        }
+        if (replay.isEmpty()) {
+            std::fprintf(stderr, "ptgpssim: no NMEA sentences in %s\n", qPrintable(parser.value(replayOption)));
+            return 1;
+        }
+    }
+
+    const int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0) {
+        std::fprintf(stderr, "ptgpssim: cannot create a pty: %s\n", std::strerror(errno));
+        return 1;
+    }
+    termios tio{};
+    if (::tcgetattr(master, &tio) == 0) {
+        ::cfmakeraw(&tio);
+        ::tcsetattr(master, TCSANOW, &tio);
+    }
+    std::printf("%s\n", ::ptsname(master));
+    std::fflush(stdout);
+
+    const long periodNs = 1000000000L / rate;
+    timespec deadline{};
+    ::clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    const double angularSpeed = speedKph / 3.6 / radius;  // rad/s
+    const double metresPerDegreeLat = EARTH_RADIUS_M * PI / 180.0;
+    const double metresPerDegreeLon = metresPerDegreeLat * std::cos(centerLat * PI / 180.0);
+    qint64 utcMs = static_cast<qint64>(std::time(nullptr)) % 86400 * 1000;
+    qsizetype replayIndex = 0;
+
+    for (;;) {
+        QByteArray epoch;
+        if (!replay.isEmpty()) {
+            const QByteArray time = epochOf(replay.at(replayIndex));
+            do {
+                epoch += replay.at(replayIndex);
+                replayIndex = (replayIndex + 1) % replay.size();
+            } while (replayIndex != 0 && epochOf(replay.at(replayIndex)) == time);
+        } else {
+            // Counter-clockwise around the centre; course is the tangent, clockwise from north.
+            const double angle = angularSpeed * utcMs / 1000.0;
+            const double lat = centerLat + radius * std::sin(angle) / metresPerDegreeLat;
+            const double lon = centerLon + radius * std::cos(angle) / metresPerDegreeLon;
+            const double turned = std::fmod(angle * 180.0 / PI, 360.0);
+            const double course = turned > 0.0 ? 360.0 - turned : 0.0;
+            const QByteArray time = timeOfDay(utcMs);
+            const QByteArray latText = coordinate(lat, 2, 'N', 'S');
+            const QByteArray lonText = coordinate(lon, 3, 'E', 'W');
+
+            char motion[48];
+            std::snprintf(motion, sizeof(motion), "%.2f,%.1f", speedKph * KPH_TO_KNOTS, course);
+            epoch += withChecksum("$GPGGA," + time + ',' + latText + ',' + lonText + ",1,12,0.8,25.0,M,38.0,M,,");
+            epoch += withChecksum("$GPRMC," + time + ",A," + latText + ',' + lonText + ',' + motion +
+                                  ",010126,,,A");
+            utcMs += 1000 / rate;
+        }
+        if (!writeAll(master, epoch)) {
+            std::fprintf(stderr, "ptgpssim: write failed: %s\n", std::strerror(errno));
+            return 1;
+        }
+        sleepUntil(deadline, periodNs);
+    }
+}
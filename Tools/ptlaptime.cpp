@@ -0,0 +1,127 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file ptlaptime.cpp
+ * @brief Command-line lap timing over a recorded NMEA file, with the dash's LapTimer.
+ *
+ * Fixes are timed by their GPS time of day (wrapping at midnight) rather than
+ * by when they were received, so results are repeatable for a given file.
+ * Lines are "lat1,lon1,lat2,lon2", the two ends of the gate.
+ *
+ * Usage: ptlaptime --line LAT1,LON1,LAT2,LON2 [--sector LAT1,LON1,LAT2,LON2 ...] <file.nmea>
+ */
+
+#include "Hardware/NmeaParser.h"
+#include "Utils/LapTimer.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+
+#include <cstdio>
+
+namespace {
+constexpr qint64 DAY_MS = 86400000;
+
+QString lapTime(int ms)
+{
+    return QStringLiteral("%1:%2.%3")
+        .arg(ms / 60000, 2, 10, QLatin1Char('0'))
+        .arg((ms / 1000) % 60, 2, 10, QLatin1Char('0'))
+        .arg(ms % 1000, 3, 10, QLatin1Char('0'));
+}
+
+bool parseLine(const QString &text, LapTimer::Line &line)
+{
+    const QStringList parts = text.split(QLatin1Char(','));
+    bool ok[4] = {};
+    if (parts.size() != 4)
+        return false;
+    line = LapTimer::Line{parts.at(0).toDouble(&ok[0]), parts.at(1).toDouble(&ok[1]), parts.at(2).toDouble(&ok[2]),
+                          parts.at(3).toDouble(&ok[3])};
+    return ok[0] && ok[1] && ok[2] && ok[3];
+}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("ptlaptime"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Time laps in a recorded NMEA file."));
+    parser.addHelpOption();
+    const QCommandLineOption lineOption(QStringLiteral("line"), QStringLiteral("Start/finish line"),
+                                        QStringLiteral("lat1,lon1,lat2,lon2"));
+    const QCommandLineOption sectorOption(QStringLiteral("sector"),
+                                          QStringLiteral("Sector line, in driving order (repeatable)"),
+                                          QStringLiteral("lat1,lon1,lat2,lon2"));
+    parser.addOptions({lineOption, sectorOption});
+    parser.addPositionalArgument(QStringLiteral("input"), QStringLiteral("NMEA file"));
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    LapTimer::Line startFinish;
+    if (args.size() != 1 || !parseLine(parser.value(lineOption), startFinish))
+        parser.showHelp(1);
+    QVector<LapTimer::Line> sectors;
+    for (const QString &text : parser.values(sectorOption)) {
+        LapTimer::Line sector;
+        if (!parseLine(text, sector)) {
+            std::fprintf(stderr, "ptlaptime: bad sector line %s\n", qPrintable(text));
+            return 1;
+        }
+        sectors.append(sector);
+    }
+
+    QFile file(args.at(0));
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::fprintf(stderr, "ptlaptime: %s\n", qPrintable(file.errorString()));
+        return 1;
+    }
+
+    LapTimer timer;
+    timer.setTrack(startFinish, sectors);
+    if (!timer.hasTrack()) {
+        std::fprintf(stderr, "ptlaptime: the start/finish line has no length\n");
+        return 1;
+    }
+
+    NmeaParser nmea;
+    qint64 fixes = 0;
+    qint64 dayOffsetMs = 0;
+    int lastUtcMs = -1;
+    QVector<int> splits;
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine();
+        if (!line.endsWith('\n'))
+            line += '\n';
+        unsigned updates = 0;
+        nmea.parse(line.constData(), line.size(), 0, &updates);
+        const GpsFix &fix = nmea.fix();
+        if (!(updates & NmeaParser::PositionUpdated) || fix.utcMs < 0 || fix.utcMs == lastUtcMs)
+            continue;
+        if (lastUtcMs >= 0 && fix.utcMs < lastUtcMs - DAY_MS / 2)
+            dayOffsetMs += DAY_MS;
+        lastUtcMs = fix.utcMs;
+        ++fixes;
+
+        const unsigned events = timer.addFix((dayOffsetMs + fix.utcMs) * 1000, fix.latitude, fix.longitude);
+        if (events & LapTimer::SectorCompleted)
+            splits.append(timer.lastSectorMs());
+        if (events & LapTimer::LapCompleted) {
+            std::printf("lap %3d  %s", timer.currentLap() - 1, qPrintable(lapTime(timer.lastLapMs())));
+            for (int split : splits)
+                std::printf("  %s", qPrintable(lapTime(split)));
+            std::printf("%s\n", timer.lastLapMs() == timer.bestLapMs() ? "  *" : "");
+        }
+        if (events & LapTimer::LapStarted)
+            splits.clear();
+    }
+
+    std::printf("%lld fixes, %llu sentences, %llu checksum errors, best %s\n", static_cast<long long>(fixes),
+                static_cast<unsigned long long>(nmea.sentenceCount()),
+                static_cast<unsigned long long>(nmea.checksumErrors()),
+                timer.bestLapMs() > 0 ? qPrintable(lapTime(timer.bestLapMs())) : "-");
+    return 0;
+}
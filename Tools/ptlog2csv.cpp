@@ -0,0 +1,55 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file ptlog2csv.cpp
+ * @brief Command-line converter from binary .ptlog data logs to the logger CSV layout.
+ *
+ * Compressed logs (.ptlog.ptz, .csv.ptz) are unpacked as well.
+ *
+ * Usage: ptlog2csv <input.ptlog|input.ptz> [output.csv]
+ */
+
+#include "Utils/BinaryLogFormat.h"
+#include "Utils/CompressedLogFormat.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFileInfo>
+
+#include <cstdio>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("ptlog2csv"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Convert a PowerTune binary data log to CSV."));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("input"), QStringLiteral("Binary or compressed log (.ptlog, .ptz)"));
+    parser.addPositionalArgument(QStringLiteral("output"), QStringLiteral("CSV file (default: input.csv)"),
+                                 QStringLiteral("[output]"));
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.isEmpty() || args.size() > 2)
+        parser.showHelp(1);
+
+    const QString input = args.at(0);
+    QString output = args.size() > 1 ? args.at(1) : QString();
+    if (output.isEmpty()) {
+        QString stem = input;
+        if (stem.endsWith(CompressedLog::fileSuffix()))
+            stem.chop(CompressedLog::fileSuffix().size());
+        const QFileInfo info(stem);
+        output = info.path() + QLatin1Char('/') + info.completeBaseName() + QStringLiteral(".csv");
+    }
+
+    QString error;
+    if (!BinaryLogReader::exportCsv(input, output, &error)) {
+        std::fprintf(stderr, "ptlog2csv: %s\n", qPrintable(error));
+        return 1;
+    }
+    std::printf("%s\n", qPrintable(output));
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file ptlogstats.cpp
+ * @brief Command-line statistics over data logs: per-channel summary, percentiles, histograms and laps.
+ *
+ * Each log is scanned in parallel chunks on all cores (see LogAnalysis.h).
+ * Raw analog columns can be put through the sensor presets of the
+ * calibration UI before they are counted.
+ *
+ * Usage: ptlogstats [--threads N] [--histogram] [--linear column=preset ...] <log> [log ...]
+ */
+
+#include "Utils/CalibrationHelper.h"
+#include "Utils/LogAnalysis.h"
+#include "Utils/SteinhartCalculator.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+QString lapTime(qint64 ms)
+{
+    return QStringLiteral("%1:%2.%3")
+        .arg(ms / 60000)
+        .arg((ms / 1000) % 60, 2, 10, QLatin1Char('0'))
+        .arg(ms % 1000, 3, 10, QLatin1Char('0'));
+}
+
+void printReport(const QString &path, const LogAnalysis::Report &report, bool histograms)
+{
+    const double seconds = report.elapsedUs / 1e6;
+    const double mib = report.inputBytes / (1024.0 * 1024.0);
+    std::printf("%s: %lld rows over %s, %.1f MiB in %.3f s (%.0f MiB/s, %d chunks on %d threads)\n",
+                qPrintable(path), static_cast<long long>(report.rows),
+                qPrintable(lapTime(report.lastMs - report.firstMs)), mib, seconds,
+                seconds > 0.0 ? mib / seconds : 0.0, report.chunks, report.threads);
+
+    std::printf("  %-20s %10s %12s %12s %12s %12s %12s %12s %12s\n", "channel", "count", "min", "max", "mean",
+                "stddev", "p50", "p95", "p99");
+    for (const LogAnalysis::ChannelStats &channel : report.channels) {
+        if (channel.count == 0)
+            continue;
+        std::printf("  %-20s %10lld %12.4g %12.4g %12.4g %12.4g %12.4g %12.4g %12.4g\n", channel.name.constData(),
+                    static_cast<long long>(channel.count), channel.min, channel.max, channel.mean, channel.stddev,
+                    channel.p50, channel.p95, channel.p99);
+        if (!histograms)
+            continue;
+        const qint64 peak = *std::max_element(channel.histogram.cbegin(), channel.histogram.cend());
+        const double width = (channel.max - channel.min) / LogAnalysis::HISTOGRAM_BINS;
+        for (int bin = 0; bin < channel.histogram.size(); ++bin) {
+            const int bar = peak > 0 ? static_cast<int>(channel.histogram.at(bin) * 40 / peak) : 0;
+            std::printf("    %12.4g %10lld %s\n", channel.min + bin * width,
+                        static_cast<long long>(channel.histogram.at(bin)), QByteArray(bar, '#').constData());
+        }
+    }
+
+    if (report.laps.isEmpty())
+        return;
+    const auto best = std::min_element(report.laps.cbegin(), report.laps.cend(),
+                                       [](const auto &a, const auto &b) { return a.durationMs < b.durationMs; });
+    std::printf("  laps:\n");
+    for (const LogAnalysis::Lap &lap : report.laps) {
+        std::printf("    %3d  %s  %+.3f%s\n", lap.number, qPrintable(lapTime(lap.durationMs)),
+                    (lap.durationMs - best->durationMs) / 1000.0, lap.durationMs == best->durationMs ? "  best" : "");
+    }
+}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("ptlogstats"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Per-channel statistics, percentiles and laps of PowerTune logs."));
+    parser.addHelpOption();
+    const QCommandLineOption threadsOption(QStringLiteral("threads"),
+                                           QStringLiteral("Worker threads (default: all cores)."),
+                                           QStringLiteral("n"), QStringLiteral("0"));
+    const QCommandLineOption histogramOption(QStringLiteral("histogram"),
+                                             QStringLiteral("Print a histogram per channel."));
+    const QCommandLineOption linearOption(
+        QStringLiteral("linear"),
+        QStringLiteral("Convert a raw voltage column with a linear sensor preset, e.g. ex_an0=\"0-100 PSI Pressure\"."),
+        QStringLiteral("column=preset"));
+    parser.addOption(threadsOption);
+    parser.addOption(histogramOption);
+    parser.addOption(linearOption);
+    parser.addPositionalArgument(QStringLiteral("logs"), QStringLiteral("CSV, .ptlog or .ptz logs"),
+                                 QStringLiteral("<log> [log ...]"));
+    parser.process(app);
+
+    const QStringList inputs = parser.positionalArguments();
+    if (inputs.isEmpty())
+        parser.showHelp(1);
+
+    LogAnalysis::Options options;
+    options.threads = parser.value(threadsOption).toInt();
+
+    // Presets are resolved once; the workers only run the linear math.
+    SteinhartCalculator steinhart;
+    CalibrationHelper calibration(&steinhart);
+    for (const QString &spec : parser.values(linearOption)) {
+        const qsizetype split = spec.indexOf(QLatin1Char('='));
+        const QString preset = split > 0 ? spec.mid(split + 1) : QString();
+        if (preset.isEmpty() || calibration.getLinearPreset(preset).isEmpty()) {
+            std::fprintf(stderr, "ptlogstats: unknown linear preset in \"%s\"\n", qPrintable(spec));
+            return 1;
+        }
+        const double minVoltage = calibration.getPresetMinVoltage(preset);
+        const double maxVoltage = calibration.getPresetMaxVoltage(preset);
+        const double at0V = calibration.getLinearPresetValueAt0V(preset);
+        const double at5V = calibration.getLinearPresetValueAt5V(preset);
+        CalibrationHelper *helper = &calibration;
+        options.transforms.insert(spec.left(split).toUtf8(), [=](double volts) {
+            return helper->calculateLinearValue(helper->normalizeVoltage(volts, minVoltage, maxVoltage), at0V, at5V);
+        });
+    }
+
+    QElapsedTimer total;
+    total.start();
+    int failures = 0;
+    for (const QString &input : inputs) {
+        LogAnalysis::Report report;
+        QString error;
+        if (!LogAnalysis::analyze(input, options, report, &error)) {
+            std::fprintf(stderr, "ptlogstats: %s\n", qPrintable(error));
+            ++failures;
+            continue;
+        }
+        printReport(input, report, parser.isSet(histogramOption));
+    }
+    if (inputs.size() > 1)
+        std::printf("%lld logs in %.3f s\n", static_cast<long long>(inputs.size()), total.nsecsElapsed() / 1e9);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,199 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file ptshmread.c
+ * @brief Example co-process reader of the dash's shared-memory sensor snapshot (see Hardware/ptshm.h).
+ *
+ * Plain C with no Qt, as a starting point for overlays and loggers. Prints
+ * the schema once, then the selected sensors at the requested rate:
+ *     12.345678 #4521 rpm=4520 speed=87.5
+ * Reopens the segment when the dash restarts or its schema changes.
+ *
+ * Usage: ptshmread [-n /name] [-r hz] [-c count] [key ...]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Hardware/ptshm.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// Give up on a snapshot after this many torn reads (the dash died mid-write)
+#define MAX_READ_ATTEMPTS 1000
+
+typedef struct
+{
+    const pt_shm_header *header;
+    size_t size;
+} segment;
+
+static void sleep_ms(long ms)
+{
+    struct timespec delay = {ms / 1000, (ms % 1000) * 1000000L};
+    nanosleep(&delay, NULL);
+}
+
+static void close_segment(segment *shm)
+{
+    if (shm->header)
+        munmap((void *)shm->header, shm->size);
+    shm->header = NULL;
+    shm->size = 0;
+}
+
+/// @return 0 on success; the segment may not exist yet or may still be being set up
+static int open_segment(segment *shm, const char *name)
+{
+    const int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+        return -1;
+
+    // The dash sizes the object after creating it; reading a page past its size raises SIGBUS.
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < PT_SHM_HEADER_SIZE) {
+        close(fd);
+        return -1;
+    }
+
+    int result = -1;
+    const pt_shm_header *header = mmap(NULL, PT_SHM_HEADER_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    if (header != MAP_FAILED) {
+        if (pt_shm_check(header) && !pt_shm_is_stale(header) && header->total_size >= PT_SHM_HEADER_SIZE
+            && header->total_size <= (uint64_t)info.st_size) {
+            const size_t size = (size_t)header->total_size;
+            const void *full = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (full != MAP_FAILED) {
+                shm->header = full;
+                shm->size = size;
+                result = 0;
+            }
+        }
+        munmap((void *)header, PT_SHM_HEADER_SIZE);
+    }
+    close(fd);
+    return result;
+}
+
+/// Map each requested key to its slot; with no keys, select every slot
+static uint32_t select_slots(const pt_shm_header *header, char **keys, int key_count, uint32_t *selected)
+{
+    uint32_t count = 0;
+    for (uint32_t slot = 0; slot < header->slot_count; ++slot) {
+        int wanted = key_count == 0;
+        for (int k = 0; k < key_count && !wanted; ++k)
+            wanted = strcmp(pt_shm_key(header, slot), keys[k]) == 0;
+        if (wanted)
+            selected[count++] = slot;
+    }
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *name = PT_SHM_DEFAULT_NAME;
+    double rate_hz = 10.0;
+    long remaining = -1;
+    int option;
+    while ((option = getopt(argc, argv, "n:r:c:h")) != -1) {
+        switch (option) {
+        case 'n':
+            name = optarg;
+            break;
+        case 'r':
+            rate_hz = atof(optarg);
+            break;
+        case 'c':
+            remaining = atol(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n /name] [-r hz] [-c count] [key ...]\n", argv[0]);
+            return option == 'h' ? 0 : 1;
+        }
+    }
+    if (rate_hz <= 0.0)
+        rate_hz = 10.0;
+    char **keys = argv + optind;
+    const int key_count = argc - optind;
+    const long interval_ms = (long)(1000.0 / rate_hz);
+
+    segment shm = {NULL, 0};
+    double *values = NULL;
+    uint32_t *selected = NULL;
+    uint32_t selected_count = 0;
+    int waiting_reported = 0;
+
+    while (remaining != 0) {
+        if (!shm.header) {
+            if (open_segment(&shm, name) != 0) {
+                if (!waiting_reported)
+                    fprintf(stderr, "ptshmread: waiting for %s\n", name);
+                waiting_reported = 1;
+                sleep_ms(500);
+                continue;
+            }
+            waiting_reported = 0;
+
+            const pt_shm_header *header = shm.header;
+            free(values);
+            free(selected);
+            values = malloc(((size_t)header->slot_count + 1) * sizeof(double));
+            selected = malloc(((size_t)header->slot_count + 1) * sizeof(uint32_t));
+            if (!values || !selected) {
+                fprintf(stderr, "ptshmread: out of memory\n");
+                return 1;
+            }
+            selected_count = select_slots(header, keys, key_count, selected);
+            printf("# %s: %u slots at %u Hz, dash pid %u\n", name, header->slot_count, header->publish_hz,
+                   header->publisher_pid);
+            for (uint32_t i = 0; i < selected_count; ++i) {
+                const uint32_t slot = selected[i];
+                printf("# %4u %-32s %-8s %u decimals\n", slot, pt_shm_key(header, slot), pt_shm_unit(header, slot),
+                       pt_shm_decimals(header)[slot]);
+            }
+        }
+
+        const pt_shm_header *header = shm.header;
+        if (pt_shm_is_stale(header)) {
+            close_segment(&shm);
+            continue;
+        }
+
+        // Seqlock read: copy everything, keep it only if no write overlapped the copy.
+        uint64_t start = 0;
+        uint64_t timestamp_ns = 0;
+        uint64_t publish_count = 0;
+        int attempts = 0;
+        do {
+            start = pt_shm_read_begin(header);
+            memcpy(values, pt_shm_values(header), (size_t)header->slot_count * sizeof(double));
+            timestamp_ns = header->timestamp_ns;
+            publish_count = header->publish_count;
+        } while (pt_shm_read_retry(header, start) && ++attempts < MAX_READ_ATTEMPTS);
+
+        if (attempts < MAX_READ_ATTEMPTS && publish_count > 0) {
+            printf("%llu.%06llu #%llu", (unsigned long long)(timestamp_ns / 1000000000u),
+                   (unsigned long long)(timestamp_ns % 1000000000u / 1000u), (unsigned long long)publish_count);
+            for (uint32_t i = 0; i < selected_count; ++i) {
+                const uint32_t slot = selected[i];
+                printf(" %s=%.*f", pt_shm_key(header, slot), pt_shm_decimals(header)[slot], values[slot]);
+            }
+            printf("\n");
+            fflush(stdout);
+            if (remaining > 0)
+                --remaining;
+        }
+        sleep_ms(interval_ms);
+    }
+
+    close_segment(&shm);
+    free(values);
+    free(selected);
+    return 0;
+}
@@ -0,0 +1,172 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file pttelemetry.cpp
+ * @brief Reference receiver for the dash's telemetry broadcast (see TelemetryFormat.h).
+ *
+ * Listens on the broadcast port (joining a multicast group if given),
+ * decodes keyframes and deltas with TelemetryDecoder and prints the
+ * channels that changed, one line per datagram:
+ *     12.340 K rpm=4520 speed=87.5 ...      (K = keyframe)
+ * Each channel's key and unit are printed once, as "# id key unit", when a
+ * schema datagram first names it; values are in that unit. With --stats it
+ * prints a per-second summary instead. Channels show as "#id" until the
+ * first schema datagram names them.
+ *
+ * Usage: pttelemetry [--port N] [--group ADDR] [--keys rpm,speed] [--stats]
+ */
+
+#include "Hardware/TelemetryFormat.h"
+
+#include <QByteArrayList>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QSet>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+constexpr int RECEIVE_TIMEOUT_MS = 1000;
+
+qint64 monotonicMs()
+{
+    timespec now{};
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<qint64>(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("pttelemetry"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Decode and print the dash telemetry broadcast."));
+    parser.addHelpOption();
+    const QCommandLineOption portOption(QStringLiteral("port"), QStringLiteral("UDP port (default 45460)"),
+                                        QStringLiteral("n"), QString::number(Telemetry::DEFAULT_PORT));
+    const QCommandLineOption groupOption(QStringLiteral("group"), QStringLiteral("Join this multicast group"),
+                                         QStringLiteral("addr"));
+    const QCommandLineOption keysOption(QStringLiteral("keys"), QStringLiteral("Only print these channels"),
+                                        QStringLiteral("key,key"));
+    const QCommandLineOption statsOption(QStringLiteral("stats"), QStringLiteral("Print a per-second summary only"));
+    parser.addOptions({portOption, groupOption, keysOption, statsOption});
+    parser.process(app);
+
+    const quint16 port = static_cast<quint16>(parser.value(portOption).toUInt());
+    const bool statsOnly = parser.isSet(statsOption);
+    QSet<QByteArray> keys;
+    for (const QByteArray &key : parser.value(keysOption).toUtf8().split(',')) {
+        if (!key.isEmpty())
+            keys.insert(key.trimmed());
+    }
+
+    const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    const int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    timeval timeout{RECEIVE_TIMEOUT_MS / 1000, (RECEIVE_TIMEOUT_MS % 1000) * 1000};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (fd < 0 || ::bind(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) < 0) {
+        std::fprintf(stderr, "pttelemetry: cannot bind port %u: %s\n", port, std::strerror(errno));
+        return 1;
+    }
+    if (parser.isSet(groupOption)) {
+        ip_mreq membership = {};
+        membership.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (::inet_pton(AF_INET, parser.value(groupOption).toLatin1().constData(), &membership.imr_multiaddr) != 1
+            || ::setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) < 0) {
+            std::fprintf(stderr, "pttelemetry: cannot join %s: %s\n", qPrintable(parser.value(groupOption)),
+                         std::strerror(errno));
+            return 1;
+        }
+    }
+
+    TelemetryDecoder decoder;
+    QSet<int> described;
+    char buffer[Telemetry::MAX_DATAGRAM_SIZE + 1];
+    QByteArray line;
+    quint64 packets = 0;
+    quint64 bytes = 0;
+    quint64 keyframes = 0;
+    quint64 records = 0;
+    quint64 invalid = 0;
+    qint64 nextReportMs = monotonicMs() + 1000;
+
+    for (;;) {
+        const ssize_t size = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (size < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            std::fprintf(stderr, "pttelemetry: receive failed: %s\n", std::strerror(errno));
+            return 1;
+        }
+
+        if (size > 0) {
+            const TelemetryDecoder::Result result = decoder.feed(buffer, static_cast<int>(size));
+            ++packets;
+            bytes += static_cast<quint64>(size);
+            if (result == TelemetryDecoder::Result::Invalid) {
+                ++invalid;
+            } else if (result == TelemetryDecoder::Result::Schema && !statsOnly) {
+                for (int id = 0; id < decoder.channelCount(); ++id) {
+                    const QByteArray key = decoder.key(id);
+                    if (key.isEmpty() || described.contains(id) || (!keys.isEmpty() && !keys.contains(key)))
+                        continue;
+                    std::printf("# %4d %-32s %s\n", id, key.constData(), decoder.unit(id).constData());
+                    described.insert(id);
+                }
+            } else if (result == TelemetryDecoder::Result::Data) {
+                const bool keyframe = decoder.lastHeader().type == Telemetry::Type::Keyframe;
+                keyframes += keyframe ? 1 : 0;
+                records += static_cast<quint64>(decoder.changed().size());
+                if (!statsOnly) {
+                    char head[32];
+                    std::snprintf(head, sizeof(head), "%.3f %c", decoder.lastHeader().timeMs / 1000.0,
+                                  keyframe ? 'K' : 'D');
+                    line = head;
+                    bool any = false;
+                    for (const int id : decoder.changed()) {
+                        QByteArray key = decoder.key(id);
+                        if (!keys.isEmpty() && !keys.contains(key))
+                            continue;
+                        if (key.isEmpty())
+                            key = '#' + QByteArray::number(id);
+                        line += ' ' + key + '=' + QByteArray::number(decoder.value(id), 'g', 10);
+                        any = true;
+                    }
+                    if (any)
+                        std::printf("%s\n", line.constData());
+                }
+            }
+        }
+
+        if (statsOnly && monotonicMs() >= nextReportMs) {
+            nextReportMs += 1000;
+            int valid = 0;
+            for (int id = 0; id < decoder.channelCount(); ++id)
+                valid += decoder.isValid(id) ? 1 : 0;
+            std::printf("packets %llu/s  %llu B/s  records %llu/s  keyframes %llu  lost %llu  invalid %llu  "
+                        "channels %d/%d\n",
+                        static_cast<unsigned long long>(packets), static_cast<unsigned long long>(bytes),
+                        static_cast<unsigned long long>(records), static_cast<unsigned long long>(keyframes),
+                        static_cast<unsigned long long>(decoder.lostDatagrams()),
+                        static_cast<unsigned long long>(invalid), valid, decoder.channelCount());
+            std::fflush(stdout);
+            packets = 0;
+            bytes = 0;
+            records = 0;
+            keyframes = 0;
+        }
+    }
+}
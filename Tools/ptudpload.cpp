@@ -0,0 +1,278 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file ptudpload.cpp
+ * @brief UDP sensor feed load generator and loopback ingest benchmark.
+ *
+ * Sends ident/value samples at a fixed rate (default 50k samples/s) in the
+ * binary or legacy text encoding of UdpSensorFormat.h. By default it also
+ * binds the port on loopback and drains it with the same batched reader as
+ * the dash (UdpBatchSocket), printing per-second send/receive rates, batch
+ * sizes, lost datagrams and reader CPU. With --send-only it just feeds a
+ * running dash (--udp-port) on --host.
+ *
+ * Exit status is 2 if the loopback receiver saw fewer samples than were sent.
+ *
+ * Usage: ptudpload [--rate N] [--records N] [--idents N] [--first-ident N] [--seconds N]
+ *                  [--port N] [--host ADDR] [--text] [--send-only]
+ */
+
+#include "Hardware/UdpBatchSocket.h"
+#include "Hardware/UdpSensorFormat.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+constexpr int MAX_TEXT_RECORDS = 64;
+constexpr int RECEIVE_TIMEOUT_MS = 50;
+constexpr int DRAIN_MS = 300;
+
+struct ReceiverStats
+{
+    std::atomic<quint64> samples{0};
+    std::atomic<quint64> datagrams{0};
+    std::atomic<quint64> batches{0};
+    std::atomic<quint64> lost{0};
+    std::atomic<quint64> rejected{0};
+    std::atomic<qint64> cpuUs{0};
+};
+
+qint64 threadCpuUs()
+{
+    rusage usage{};
+    ::getrusage(RUSAGE_THREAD, &usage);
+    return static_cast<qint64>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000
+           + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+qint64 monotonicNs()
+{
+    timespec now{};
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<qint64>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+void sleepUntilNs(qint64 deadlineNs)
+{
+    const timespec deadline{static_cast<time_t>(deadlineNs / 1000000000), static_cast<long>(deadlineNs % 1000000000)};
+    while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+    }
+}
+
+/// The dash's reader loop without the model hand-off
+void receiveLoop(UdpBatchSocket &socket, ReceiverStats &stats, const std::atomic<bool> &stop)
+{
+    std::vector<UdpSensor::Sample> samples(UdpSensor::MAX_SAMPLES);
+    bool haveSequence = false;
+    quint32 expected = 0;
+    while (!stop.load(std::memory_order_acquire)) {
+        const int count = socket.receive(RECEIVE_TIMEOUT_MS);
+        if (count <= 0)
+            continue;
+
+        quint64 decoded = 0;
+        for (int i = 0; i < count; ++i) {
+            quint32 sequence = 0;
+            const char *data = socket.datagram(i);
+            const int size = socket.datagramSize(i);
+            const int n = UdpSensor::decode(data, size, samples.data(), UdpSensor::MAX_SAMPLES, &sequence);
+            if (n < 0) {
+                stats.rejected.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (UdpSensor::isBinary(data, size)) {
+                const quint32 gap = sequence - expected;
+                if (haveSequence && gap != 0 && gap < 0x80000000u)
+                    stats.lost.fetch_add(gap, std::memory_order_relaxed);
+                haveSequence = true;
+                expected = sequence + 1;
+            }
+            decoded += static_cast<quint64>(n);
+        }
+        stats.samples.fetch_add(decoded, std::memory_order_relaxed);
+        stats.datagrams.fetch_add(static_cast<quint64>(count), std::memory_order_relaxed);
+        stats.batches.fetch_add(1, std::memory_order_relaxed);
+        stats.cpuUs.store(threadCpuUs(), std::memory_order_relaxed);
+    }
+}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("ptudpload"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Load the UDP sensor feed and measure batched ingest."));
+    parser.addHelpOption();
+    const QCommandLineOption rateOption(QStringLiteral("rate"), QStringLiteral("Samples per second (default 50000)"),
+                                        QStringLiteral("n"), QStringLiteral("50000"));
+    const QCommandLineOption recordsOption(QStringLiteral("records"),
+                                           QStringLiteral("Samples per datagram (default 32)"), QStringLiteral("n"),
+                                           QStringLiteral("32"));
+    const QCommandLineOption identsOption(QStringLiteral("idents"),
+                                          QStringLiteral("Distinct idents to cycle through (default 64)"),
+                                          QStringLiteral("n"), QStringLiteral("64"));
+    const QCommandLineOption firstIdentOption(QStringLiteral("first-ident"),
+                                              QStringLiteral("First ident sent (default 1)"), QStringLiteral("n"),
+                                              QStringLiteral("1"));
+    const QCommandLineOption secondsOption(QStringLiteral("seconds"), QStringLiteral("Test length (default 10)"),
+                                           QStringLiteral("n"), QStringLiteral("10"));
+    const QCommandLineOption portOption(QStringLiteral("port"), QStringLiteral("UDP port (default 45454)"),
+                                        QStringLiteral("n"), QString::number(UdpSensor::DEFAULT_PORT));
+    const QCommandLineOption hostOption(QStringLiteral("host"),
+                                        QStringLiteral("Destination for --send-only (default 127.0.0.1)"),
+                                        QStringLiteral("addr"), QStringLiteral("127.0.0.1"));
+    const QCommandLineOption textOption(QStringLiteral("text"), QStringLiteral("Send the legacy text encoding"));
+    const QCommandLineOption sendOnlyOption(QStringLiteral("send-only"),
+                                            QStringLiteral("Do not receive; feed a running dash instead"));
+    parser.addOptions({rateOption, recordsOption, identsOption, firstIdentOption, secondsOption, portOption,
+                       hostOption, textOption, sendOnlyOption});
+    parser.process(app);
+
+    const bool text = parser.isSet(textOption);
+    const bool sendOnly = parser.isSet(sendOnlyOption);
+    const double rate = qMax(1.0, parser.value(rateOption).toDouble());
+    const int maxRecords = text ? MAX_TEXT_RECORDS : UdpSensor::MAX_RECORDS;
+    const int records = qBound(1, parser.value(recordsOption).toInt(), maxRecords);
+    const int idents = qBound(1, parser.value(identsOption).toInt(), 0x10000);
+    const int firstIdent = qBound(0, parser.value(firstIdentOption).toInt(), 0xFFFF);
+    const int seconds = qMax(1, parser.value(secondsOption).toInt());
+    const quint16 port = static_cast<quint16>(parser.value(portOption).toUInt());
+
+    UdpBatchSocket receiver;
+    ReceiverStats received;
+    std::atomic<bool> stop{false};
+    std::thread receiverThread;
+    if (!sendOnly) {
+        QString error;
+        if (!receiver.bind(port, true, &error)) {
+            std::fprintf(stderr, "ptudpload: %s (is the dash listening? use --send-only or --port)\n",
+                         qPrintable(error));
+            return 1;
+        }
+        receiverThread = std::thread([&]() { receiveLoop(receiver, received, stop); });
+    }
+
+    const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    sockaddr_in target = {};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(port);
+    const QByteArray host = sendOnly ? parser.value(hostOption).toLatin1() : QByteArrayLiteral("127.0.0.1");
+    if (fd < 0 || ::inet_pton(AF_INET, host.constData(), &target.sin_addr) != 1
+        || ::connect(fd, reinterpret_cast<const sockaddr *>(&target), sizeof(target)) < 0) {
+        std::fprintf(stderr, "ptudpload: cannot send to %s:%u: %s\n", host.constData(), port, std::strerror(errno));
+        stop.store(true);
+        if (receiverThread.joinable())
+            receiverThread.join();
+        return 1;
+    }
+
+    std::printf("%s, %.0f samples/s, %d per datagram, %d idents from %d, %s:%u\n", text ? "text" : "binary", rate,
+                records, idents, firstIdent, host.constData(), port);
+    std::printf("%4s %10s %10s %10s %8s %8s %8s %7s\n", "s", "sent/s", "recv/s", "dgram/s", "batch", "lost",
+                "sendErr", "rxCPU%");
+
+    const qint64 periodNs = static_cast<qint64>(1e9 * records / rate);
+    const qint64 startNs = monotonicNs();
+    const qint64 endNs = startNs + static_cast<qint64>(seconds) * 1000000000;
+    qint64 deadlineNs = startNs;
+    qint64 nextReportNs = startNs + 1000000000;
+    QByteArray datagram;
+    datagram.reserve(UdpSensor::MAX_DATAGRAM_SIZE);
+    quint32 sequence = 0;
+    quint64 counter = 0;
+    quint64 sent = 0;
+    quint64 sendErrors = 0;
+    quint64 lastSent = 0;
+    quint64 lastReceived = 0;
+    quint64 lastDatagrams = 0;
+    quint64 lastBatches = 0;
+    qint64 lastCpuUs = 0;
+    int second = 0;
+
+    while (deadlineNs < endNs) {
+        if (text)
+            datagram.clear();
+        else
+            UdpSensor::beginDatagram(datagram, sequence);
+        for (int r = 0; r < records; ++r, ++counter) {
+            const auto ident = static_cast<quint16>(firstIdent + static_cast<int>(counter % idents));
+            const double value = 100.0 * std::sin(static_cast<double>(counter) * 0.001);
+            if (text)
+                UdpSensor::appendTextRecord(datagram, ident, value);
+            else
+                UdpSensor::appendRecord(datagram, ident, static_cast<float>(value));
+        }
+        ++sequence;
+        if (::send(fd, datagram.constData(), static_cast<size_t>(datagram.size()), 0) < 0)
+            ++sendErrors;
+        else
+            sent += static_cast<quint64>(records);
+
+        deadlineNs += periodNs;
+        sleepUntilNs(deadlineNs);
+
+        if (monotonicNs() >= nextReportNs) {
+            nextReportNs += 1000000000;
+            ++second;
+            const quint64 receivedNow = received.samples.load(std::memory_order_relaxed);
+            const quint64 datagramsNow = received.datagrams.load(std::memory_order_relaxed);
+            const quint64 batchesNow = received.batches.load(std::memory_order_relaxed);
+            const qint64 cpuNow = received.cpuUs.load(std::memory_order_relaxed);
+            const quint64 batches = batchesNow - lastBatches;
+            std::printf("%4d %10llu %10llu %10llu %8.1f %8llu %8llu %7.1f\n", second,
+                        static_cast<unsigned long long>(sent - lastSent),
+                        static_cast<unsigned long long>(receivedNow - lastReceived),
+                        static_cast<unsigned long long>(datagramsNow - lastDatagrams),
+                        batches > 0 ? static_cast<double>(datagramsNow - lastDatagrams) / batches : 0.0,
+                        static_cast<unsigned long long>(received.lost.load(std::memory_order_relaxed)),
+                        static_cast<unsigned long long>(sendErrors), (cpuNow - lastCpuUs) / 1e4);
+            std::fflush(stdout);
+            lastSent = sent;
+            lastReceived = receivedNow;
+            lastDatagrams = datagramsNow;
+            lastBatches = batchesNow;
+            lastCpuUs = cpuNow;
+        }
+    }
+    const double elapsed = (monotonicNs() - startNs) / 1e9;
+    ::close(fd);
+
+    std::printf("sent: %llu samples in %.2f s (%.0f/s), %llu send errors\n", static_cast<unsigned long long>(sent),
+                elapsed, sent / elapsed, static_cast<unsigned long long>(sendErrors));
+    if (sendOnly)
+        return 0;
+
+    sleepUntilNs(monotonicNs() + static_cast<qint64>(DRAIN_MS) * 1000000);
+    stop.store(true, std::memory_order_release);
+    receiverThread.join();
+
+    const quint64 total = received.samples.load();
+    const quint64 batches = received.batches.load();
+    std::printf("received: %llu samples (%.3f%%), %llu datagrams in %llu batches (%.1f per recvmmsg)\n",
+                static_cast<unsigned long long>(total), sent > 0 ? 100.0 * total / sent : 0.0,
+                static_cast<unsigned long long>(received.datagrams.load()), static_cast<unsigned long long>(batches),
+                batches > 0 ? static_cast<double>(received.datagrams.load()) / batches : 0.0);
+    std::printf("lost datagrams: %llu, rejected: %llu, truncated: %llu, reader CPU: %.1f%%\n",
+                static_cast<unsigned long long>(received.lost.load()),
+                static_cast<unsigned long long>(received.rejected.load()),
+                static_cast<unsigned long long>(receiver.truncated()), received.cpuUs.load() / 1e4 / elapsed);
+    return total < sent ? 2 : 0;
+}
@@ -0,0 +1,471 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file BinaryLogFormat.cpp
+ * @brief Implementation of the .ptlog formatter and reader.
+ */
+
+#include "BinaryLogFormat.h"
+
+#include "CompressedLogFormat.h"
+
+#include <QTemporaryFile>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr char MAGIC[8] = {'P', 'T', 'L', 'O', 'G', '\0', '\0', '\1'};
+constexpr char INDEX_MAGIC[8] = {'P', 'T', 'K', 'E', 'Y', 'I', 'D', 'X'};
+constexpr int INDEX_TRAILER_SIZE = 16;
+constexpr quint16 FORMAT_VERSION = 1;
+constexpr int FIXED_HEADER_SIZE = 32;
+constexpr quint8 TYPE_FLOAT32 = 1;
+constexpr quint8 TYPE_TEXT = 2;
+constexpr quint16 FLAG_SPARSE = 0x0001;
+constexpr qint64 EXPORT_CHUNK_ROWS = 4096;
+
+template <typename T>
+void appendLittleEndian(QByteArray &out, T value)
+{
+    char bytes[sizeof(T)];
+    qToLittleEndian(value, bytes);
+    out.append(bytes, sizeof(T));
+}
+
+int alignTo8(int size)
+{
+    return (size + 7) & ~7;
+}
+
+quint32 floatBits(float value)
+{
+    quint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float bitsToFloat(quint32 bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// BinaryLogFormatter
+// ---------------------------------------------------------------------------
+
+QString BinaryLogFormatter::fileExtension() const
+{
+    return QStringLiteral(".ptlog");
+}
+
+int BinaryLogFormatter::recordSize(const QVector<LogColumn> &columns)
+{
+    int size = static_cast<int>(sizeof(qint64));
+    for (const LogColumn &column : columns)
+        size += column.isText ? TEXT_WIDTH : static_cast<int>(sizeof(quint32));
+    return alignTo8(size);
+}
+
+void BinaryLogFormatter::batchLayout(const QVector<LogColumn> &columns, int &numericColumns, int &textColumns) const
+{
+    if (m_layout == Layout::Sparse) {
+        numericColumns = 2;  // channel, value
+        textColumns = 0;
+        return;
+    }
+    LogFormatter::batchLayout(columns, numericColumns, textColumns);
+}
+
+QByteArray BinaryLogFormatter::header(const QVector<LogColumn> &columns) const
+{
+    const bool sparse = m_layout == Layout::Sparse;
+    m_keyframeRows.clear();
+    m_rowsWritten = 0;
+
+    QByteArray table;
+    for (const LogColumn &column : columns) {
+        const QByteArray name = column.name.left(255);
+        table.append(static_cast<char>(column.isText && !sparse ? TYPE_TEXT : TYPE_FLOAT32));
+        table.append(static_cast<char>(name.size()));
+        table.append(name);
+    }
+    const int headerSize = alignTo8(FIXED_HEADER_SIZE + static_cast<int>(table.size()));
+
+    QByteArray out;
+    out.reserve(headerSize);
+    out.append(MAGIC, sizeof(MAGIC));
+    appendLittleEndian<quint16>(out, FORMAT_VERSION);
+    appendLittleEndian<quint16>(out, sparse ? FLAG_SPARSE : 0);
+    appendLittleEndian<quint32>(out, static_cast<quint32>(headerSize));
+    appendLittleEndian<quint32>(out, static_cast<quint32>(sparse ? SPARSE_RECORD_SIZE : recordSize(columns)));
+    appendLittleEndian<quint32>(out, static_cast<quint32>(columns.size()));
+    appendLittleEndian<quint32>(out, TEXT_WIDTH);
+    appendLittleEndian<quint32>(out, 0);
+    out.append(table);
+    out.append(headerSize - out.size(), '\0');
+    return out;
+}
+
+void BinaryLogFormatter::appendRows(const QVector<LogColumn> &columns, const LogSampleBatch &batch,
+                                    QByteArray &out) const
+{
+    const int rows = batch.rowCount();
+    if (rows == 0)
+        return;
+
+    if (m_layout == Layout::Sparse) {
+        const qsizetype start = out.size();
+        out.append(static_cast<qsizetype>(rows) * SPARSE_RECORD_SIZE, '\0');
+        uchar *dest = reinterpret_cast<uchar *>(out.data()) + start;
+        for (int row = 0; row < rows; ++row, dest += SPARSE_RECORD_SIZE) {
+            const double *event = batch.numericRow(row);
+            const auto channel = static_cast<quint32>(event[0]);
+            if (channel == KEYFRAME_CHANNEL)
+                m_keyframeRows.append(m_rowsWritten + row);
+            qToLittleEndian<qint64>(batch.timestamp(row), dest);
+            qToLittleEndian<quint32>(channel, dest + 8);
+            qToLittleEndian<quint32>(floatBits(static_cast<float>(event[1])), dest + 12);
+        }
+        m_rowsWritten += rows;
+        return;
+    }
+
+    const int size = recordSize(columns);
+    const qsizetype start = out.size();
+    out.append(static_cast<qsizetype>(rows) * size, '\0');
+    uchar *dest = reinterpret_cast<uchar *>(out.data()) + start;
+
+    for (int row = 0; row < rows; ++row, dest += size) {
+        const double *numeric = batch.numericRow(row);
+        const QString *text = batch.textRow(row);
+        uchar *field = dest;
+        qToLittleEndian<qint64>(batch.timestamp(row), field);
+        field += sizeof(qint64);
+        for (const LogColumn &column : columns) {
+            if (column.isText) {
+                const QByteArray utf8 = (text++)->toUtf8();
+                std::memcpy(field, utf8.constData(), qMin<qsizetype>(utf8.size(), TEXT_WIDTH));
+                field += TEXT_WIDTH;
+            } else {
+                qToLittleEndian<quint32>(floatBits(static_cast<float>(*numeric++)), field);
+                field += sizeof(quint32);
+            }
+        }
+    }
+}
+
+QByteArray BinaryLogFormatter::trailer() const
+{
+    if (m_layout != Layout::Sparse)
+        return QByteArray();
+
+    QByteArray out;
+    out.reserve(m_keyframeRows.size() * static_cast<qsizetype>(sizeof(qint64)) + INDEX_TRAILER_SIZE);
+    for (const qint64 row : m_keyframeRows)
+        appendLittleEndian<qint64>(out, row);
+    out.append(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    appendLittleEndian<quint64>(out, static_cast<quint64>(m_keyframeRows.size()));
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// BinaryLogReader
+// ---------------------------------------------------------------------------
+
+BinaryLogReader::~BinaryLogReader()
+{
+    close();
+}
+
+bool BinaryLogReader::open(const QString &path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = QStringLiteral("Cannot open %1: %2").arg(path, m_file.errorString());
+        return false;
+    }
+
+    const qint64 fileSize = m_file.size();
+    const uchar *data = fileSize >= FIXED_HEADER_SIZE ? m_file.map(0, fileSize) : nullptr;
+    if (!data || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        m_error = QStringLiteral("%1 is not a PowerTune binary log").arg(path);
+        close();
+        return false;
+    }
+
+    const quint16 version = qFromLittleEndian<quint16>(data + 8);
+    const quint16 flags = qFromLittleEndian<quint16>(data + 10);
+    const qint64 headerSize = qFromLittleEndian<quint32>(data + 12);
+    const qint64 recordSize = qFromLittleEndian<quint32>(data + 16);
+    const quint32 columnCount = qFromLittleEndian<quint32>(data + 20);
+    const int textWidth = static_cast<int>(qFromLittleEndian<quint32>(data + 24));
+    if (version != FORMAT_VERSION || headerSize < FIXED_HEADER_SIZE || headerSize > fileSize || recordSize <= 0) {
+        m_error = QStringLiteral("%1: unsupported log version or corrupt header").arg(path);
+        m_file.unmap(const_cast<uchar *>(data));
+        close();
+        return false;
+    }
+
+    // Parse the column table and compute field offsets.
+    qint64 pos = FIXED_HEADER_SIZE;
+    int offset = static_cast<int>(sizeof(qint64));
+    for (quint32 i = 0; i < columnCount; ++i) {
+        if (pos + 2 > headerSize)
+            break;
+        const quint8 type = data[pos];
+        const int nameLength = data[pos + 1];
+        if (pos + 2 + nameLength > headerSize)
+            break;
+        LogColumn column;
+        column.name = QByteArray(reinterpret_cast<const char *>(data + pos + 2), nameLength);
+        column.isText = type == TYPE_TEXT;
+        m_columns.append(column);
+        m_offsets.append(offset);
+        offset += column.isText ? textWidth : static_cast<int>(sizeof(quint32));
+        pos += 2 + nameLength;
+    }
+    const bool sparse = (flags & FLAG_SPARSE) != 0;
+    const qint64 minimumRecordSize = sparse ? BinaryLogFormatter::SPARSE_RECORD_SIZE : offset;
+    if (m_columns.size() != static_cast<int>(columnCount) || recordSize < minimumRecordSize) {
+        m_error = QStringLiteral("%1: corrupt column table").arg(path);
+        m_file.unmap(const_cast<uchar *>(data));
+        close();
+        return false;
+    }
+
+    m_data = data;
+    m_headerSize = headerSize;
+    m_recordSize = recordSize;
+    m_textWidth = textWidth;
+    m_sparse = sparse;
+    m_rowCount = (fileSize - headerSize) / recordSize;
+    if (sparse && !readKeyframeIndex(fileSize)) {
+        // Closed without an index (power loss): one pass over the records, at open only.
+        for (qint64 row = 0; row < m_rowCount; ++row) {
+            if (isKeyframe(row))
+                m_keyframes.append(row);
+        }
+    }
+    m_error.clear();
+    return true;
+}
+
+bool BinaryLogReader::readKeyframeIndex(qint64 fileSize)
+{
+    const qint64 trailer = fileSize - INDEX_TRAILER_SIZE;
+    if (trailer < m_headerSize || std::memcmp(m_data + trailer, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0)
+        return false;
+    const quint64 count = qFromLittleEndian<quint64>(m_data + trailer + sizeof(INDEX_MAGIC));
+    if (count > static_cast<quint64>(trailer - m_headerSize) / sizeof(qint64))
+        return false;
+    const qint64 indexStart = trailer - static_cast<qint64>(count * sizeof(qint64));
+    if ((indexStart - m_headerSize) % m_recordSize != 0)
+        return false;
+
+    const qint64 rows = (indexStart - m_headerSize) / m_recordSize;
+    QVector<qint64> keyframes(static_cast<qsizetype>(count));
+    for (quint64 i = 0; i < count; ++i) {
+        const qint64 row = qFromLittleEndian<qint64>(m_data + indexStart + i * sizeof(qint64));
+        if (row < 0 || row >= rows || (i > 0 && row <= keyframes.at(static_cast<qsizetype>(i - 1))))
+            return false;
+        keyframes[static_cast<qsizetype>(i)] = row;
+    }
+    m_rowCount = rows;
+    m_keyframes = std::move(keyframes);
+    return true;
+}
+
+void BinaryLogReader::close()
+{
+    if (m_data)
+        m_file.unmap(const_cast<uchar *>(m_data));
+    m_data = nullptr;
+    m_file.close();
+    m_columns.clear();
+    m_offsets.clear();
+    m_keyframes.clear();
+    m_rowCount = 0;
+    m_sparse = false;
+}
+
+qint64 BinaryLogReader::timestamp(qint64 row) const
+{
+    return qFromLittleEndian<qint64>(record(row));
+}
+
+int BinaryLogReader::eventChannel(qint64 row) const
+{
+    return static_cast<int>(qFromLittleEndian<quint32>(record(row) + 8));
+}
+
+double BinaryLogReader::eventValue(qint64 row) const
+{
+    return bitsToFloat(qFromLittleEndian<quint32>(record(row) + 12));
+}
+
+bool BinaryLogReader::isKeyframe(qint64 row) const
+{
+    return m_sparse && qFromLittleEndian<quint32>(record(row) + 8) == BinaryLogFormatter::KEYFRAME_CHANNEL;
+}
+
+qint64 BinaryLogReader::lowerBound(qint64 timestamp) const
+{
+    // Timestamps come from a monotonic clock, so the records are sorted by time.
+    qint64 first = 0;
+    qint64 count = m_rowCount;
+    while (count > 0) {
+        const qint64 half = count / 2;
+        if (this->timestamp(first + half) < timestamp) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+qint64 BinaryLogReader::keyframeBefore(qint64 row) const
+{
+    const auto after = std::upper_bound(m_keyframes.cbegin(), m_keyframes.cend(), row);
+    return after == m_keyframes.cbegin() ? -1 : *(after - 1);
+}
+
+double BinaryLogReader::value(qint64 row, int column) const
+{
+    if (m_sparse || m_columns.at(column).isText)
+        return 0.0;
+    return bitsToFloat(qFromLittleEndian<quint32>(record(row) + m_offsets.at(column)));
+}
+
+QString BinaryLogReader::text(qint64 row, int column) const
+{
+    if (m_sparse || !m_columns.at(column).isText)
+        return QString();
+    const char *field = reinterpret_cast<const char *>(record(row) + m_offsets.at(column));
+    return QString::fromUtf8(field, static_cast<qsizetype>(qstrnlen(field, static_cast<size_t>(m_textWidth))));
+}
+
+void BinaryLogReader::readRows(qint64 first, qint64 count, LogSampleBatch &batch) const
+{
+    int numericColumns = 0;
+    int textColumns = 0;
+    for (const LogColumn &column : m_columns)
+        ++(column.isText ? textColumns : numericColumns);
+    batch.setLayout(numericColumns, textColumns);
+    if (m_sparse)
+        return;
+
+    QVector<double> numeric(numericColumns);
+    QVector<QString> text(textColumns);
+    const qint64 last = qMin(m_rowCount, first + count);
+    for (qint64 row = first; row < last; ++row) {
+        int n = 0;
+        int t = 0;
+        for (int column = 0; column < m_columns.size(); ++column) {
+            if (m_columns.at(column).isText)
+                text[t++] = this->text(row, column);
+            else
+                numeric[n++] = value(row, column);
+        }
+        batch.appendRow(timestamp(row), numeric.constData(), text.constData());
+    }
+}
+
+bool BinaryLogReader::exportCsv(const QString &binaryPath, const QString &csvPath, QString *errorString)
+{
+    if (CompressedLog::isCompressed(binaryPath)) {
+        // Unpack next to the output, then either convert the inner .ptlog or keep the inner CSV as is.
+        QTemporaryFile plain(csvPath + QStringLiteral(".XXXXXX"));
+        if (!plain.open()) {
+            if (errorString)
+                *errorString = QStringLiteral("Cannot create temporary file: %1").arg(plain.errorString());
+            return false;
+        }
+        plain.close();
+        if (!CompressedLog::decompressFile(binaryPath, plain.fileName(), errorString))
+            return false;
+
+        plain.open();
+        const QByteArray head = plain.read(sizeof(MAGIC));
+        plain.close();
+        if (head.size() == sizeof(MAGIC) && std::memcmp(head.constData(), MAGIC, sizeof(MAGIC)) == 0)
+            return exportCsv(plain.fileName(), csvPath, errorString);
+
+        QFile::remove(csvPath);
+        if (!plain.rename(csvPath)) {
+            if (errorString)
+                *errorString = QStringLiteral("Cannot write %1: %2").arg(csvPath, plain.errorString());
+            return false;
+        }
+        plain.setAutoRemove(false);
+        return true;
+    }
+
+    BinaryLogReader reader;
+    if (!reader.open(binaryPath)) {
+        if (errorString)
+            *errorString = reader.errorString();
+        return false;
+    }
+
+    QFile out(csvPath);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (errorString)
+            *errorString = QStringLiteral("Cannot open %1: %2").arg(csvPath, out.errorString());
+        return false;
+    }
+
+    const CsvLogFormatter csv;
+    const QVector<LogColumn> &columns = reader.columns();
+    QByteArray buffer = csv.header(columns);
+    LogSampleBatch batch;
+
+    const auto writeBatch = [&]() {
+        csv.appendRows(columns, batch, buffer);
+        batch.clear();
+        if (out.write(buffer) != buffer.size()) {
+            if (errorString)
+                *errorString = QStringLiteral("Write to %1 failed: %2").arg(csvPath, out.errorString());
+            return false;
+        }
+        buffer.clear();
+        return true;
+    };
+
+    if (!reader.isSparse()) {
+        for (qint64 first = 0; first < reader.rowCount(); first += EXPORT_CHUNK_ROWS) {
+            reader.readRows(first, EXPORT_CHUNK_ROWS, batch);
+            if (!writeBatch())
+                return false;
+        }
+        return writeBatch();
+    }
+
+    // Sparse: sample-and-hold every channel, one row per distinct millisecond.
+    QVector<double> held(columns.size(), 0.0);
+    batch.setLayout(static_cast<int>(columns.size()), 0);
+    qint64 rowMs = -1;
+    for (qint64 row = 0; row < reader.rowCount(); ++row) {
+        const qint64 ms = reader.timestamp(row) / 1000;
+        if (rowMs >= 0 && ms != rowMs) {
+            batch.appendRow(rowMs, held.constData(), nullptr);
+            if (batch.rowCount() >= EXPORT_CHUNK_ROWS && !writeBatch())
+                return false;
+        }
+        rowMs = ms;
+        const int channel = reader.eventChannel(row);
+        if (channel >= 0 && channel < held.size())
+            held[channel] = reader.eventValue(row);
+    }
+    if (rowMs >= 0)
+        batch.appendRow(rowMs, held.constData(), nullptr);
+    return writeBatch();
+}
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file BinaryLogFormat.h
+ * @brief Fixed-width binary data log format (.ptlog), its writer-side formatter and an mmap reader.
+ *
+ * Layout (all integers little-endian):
+ *
+ *   Header, 32 bytes
+ *     char    magic[8]      "PTLOG\0\0\1"
+ *     quint16 version       1
+ *     quint16 flags         bit 0: sparse change records (see below)
+ *     quint32 headerSize    bytes from file start to the first record (multiple of 8)
+ *     quint32 recordSize    bytes per record (multiple of 8)
+ *     quint32 columnCount
+ *     quint32 textWidth     bytes per text field
+ *     quint32 reserved
+ *   Column table, columnCount entries
+ *     quint8  type          1 = float32, 2 = text (UTF-8, zero padded to textWidth)
+ *     quint8  nameLength
+ *     char    name[nameLength]
+ *   Zero padding up to headerSize
+ *   Records, recordSize bytes each
+ *     dense:  qint64 timestampMs (monotonic, since logging started),
+ *             fields in column order, zero padding up to recordSize
+ *     sparse: qint64 timestampUs (monotonic, since logging started),
+ *             quint32 channel (index into the column table), float32 value
+ *   Keyframe index, sparse logs only, written when the file is closed
+ *     qint64  row[count]    record index of each keyframe marker, ascending
+ *     char    magic[8]      "PTKEYIDX"
+ *     quint64 count
+ *
+ * Dense logs hold one row of every column per sample. Sparse logs hold one
+ * 16-byte record per channel update, so channels sampled at different rates
+ * or only on change share one file; they carry numeric columns only.
+ *
+ * Sparse keyframes: a record with channel KEYFRAME_CHANNEL (0xFFFFFFFF)
+ * whose value is a record count N is followed by N records holding the
+ * current value of every channel. The logger writes one at the start and
+ * then periodically, so a reader can seek by binary search on the
+ * timestamps, find the keyframe before that row by binary search on the
+ * keyframe index and replay from there. Readers that do not know about
+ * keyframes skip the marker as an out-of-range channel.
+ *
+ * Because every record has the same size the row count is derived from the
+ * file size (less the keyframe index) and any row can be addressed directly
+ * in a mapped file. A partially written trailing record (e.g. after power
+ * loss) is ignored. A file cut short before it was closed has no keyframe
+ * index; journal recovery truncates a partly written one, and the reader
+ * then collects the keyframes with one pass over the records.
+ */
+
+#ifndef BINARYLOGFORMAT_H
+#define BINARYLOGFORMAT_H
+
+#include "LogFormat.h"
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Writes .ptlog records. Numeric columns are stored as float32.
+ *
+ * In the sparse layout the formatter notes the row of every keyframe marker
+ * it writes and emits them as the keyframe index in trailer(); header()
+ * starts a new, empty index.
+ */
+class BinaryLogFormatter : public LogFormatter
+{
+public:
+    enum class Layout {
+        Dense,   ///< One row of all columns per sample
+        Sparse,  ///< Batch rows are (channel, value) pairs with a microsecond timestamp
+    };
+
+    static constexpr int TEXT_WIDTH = 16;
+    static constexpr int SPARSE_RECORD_SIZE = 16;
+    static constexpr quint32 KEYFRAME_CHANNEL = 0xFFFFFFFF;
+
+    explicit BinaryLogFormatter(Layout layout = Layout::Dense) : m_layout(layout) {}
+
+    QString fileExtension() const override;
+    QByteArray header(const QVector<LogColumn> &columns) const override;
+    void appendRows(const QVector<LogColumn> &columns, const LogSampleBatch &batch, QByteArray &out) const override;
+    QByteArray trailer() const override;
+    void batchLayout(const QVector<LogColumn> &columns, int &numericColumns, int &textColumns) const override;
+
+    /// Dense record size for @p columns, including the timestamp and trailing padding
+    static int recordSize(const QVector<LogColumn> &columns);
+
+private:
+    Layout m_layout;
+    // Writer-thread state for the keyframe index of the file being written
+    mutable QVector<qint64> m_keyframeRows;
+    mutable qint64 m_rowsWritten = 0;
+};
+
+/**
+ * @brief Read-only, memory-mapped view of a .ptlog file.
+ *
+ * Opening only parses the header; rows are decoded on access straight from
+ * the mapping. Not thread-safe for open/close, but concurrent reads of an
+ * open log are fine.
+ */
+class BinaryLogReader
+{
+public:
+    BinaryLogReader() = default;
+    ~BinaryLogReader();
+
+    BinaryLogReader(const BinaryLogReader &) = delete;
+    BinaryLogReader &operator=(const BinaryLogReader &) = delete;
+
+    bool open(const QString &path);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    QString errorString() const { return m_error; }
+
+    const QVector<LogColumn> &columns() const { return m_columns; }
+    qint64 rowCount() const { return m_rowCount; }
+    bool isSparse() const { return m_sparse; }
+
+    /// Record timestamp: milliseconds for dense logs, microseconds for sparse logs
+    qint64 timestamp(qint64 row) const;
+    /// Numeric value of @p column (index into columns()); 0 for text columns
+    double value(qint64 row, int column) const;
+    /// Text value of @p column; empty for numeric columns
+    QString text(qint64 row, int column) const;
+
+    /// Sparse logs: channel (column index) and value of a change record
+    int eventChannel(qint64 row) const;
+    double eventValue(qint64 row) const;
+    /// Sparse logs: true if @p row is a keyframe marker; eventValue() is then the snapshot record count
+    bool isKeyframe(qint64 row) const;
+
+    /// First row whose timestamp is at or after @p timestamp (rowCount() if none); O(log n)
+    qint64 lowerBound(qint64 timestamp) const;
+    /// Sparse logs: the last keyframe marker at or before @p row, or -1 if there is none; O(log k)
+    qint64 keyframeBefore(qint64 row) const;
+    /// Sparse logs: rows of all keyframe markers, ascending
+    const QVector<qint64> &keyframes() const { return m_keyframes; }
+
+    /// Decode dense rows [first, first + count) into @p batch (layout is set by the reader)
+    void readRows(qint64 first, qint64 count, LogSampleBatch &batch) const;
+
+    /**
+     * @brief Convert a .ptlog file to the CSV layout written by CsvLogFormatter.
+     *
+     * Sparse logs are expanded to one row per distinct millisecond holding the
+     * last value of every channel. Compressed (.ptz) logs are unpacked first;
+     * if they hold a CSV log it is written out unchanged.
+     * @param errorString Receives a description on failure (may be null)
+     */
+    static bool exportCsv(const QString &binaryPath, const QString &csvPath, QString *errorString = nullptr);
+
+private:
+    const uchar *record(qint64 row) const { return m_data + m_headerSize + row * m_recordSize; }
+    bool readKeyframeIndex(qint64 fileSize);
+
+    QFile m_file;
+    const uchar *m_data = nullptr;
+    qint64 m_headerSize = 0;
+    qint64 m_recordSize = 0;
+    qint64 m_rowCount = 0;
+    int m_textWidth = 0;
+    bool m_sparse = false;
+    QVector<LogColumn> m_columns;
+    QVector<int> m_offsets;       ///< Byte offset of each column within a record
+    QVector<qint64> m_keyframes;  ///< Sparse logs: rows of the keyframe markers
+    QString m_error;
+};
+
+#endif  // BINARYLOGFORMAT_H
@@ -0,0 +1,281 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file BlackBoxRecorder.cpp
+ * @brief Implementation of the BlackBoxRecorder class.
+ */
+
+#include "BlackBoxRecorder.h"
+
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+    #include <fcntl.h>
+    #include <sys/mman.h>
+#endif
+
+namespace {
+constexpr char MAGIC[8] = {'P', 'T', 'B', 'B', 'O', 'X', '\0', '\1'};
+constexpr quint16 VERSION = 1;
+constexpr int FIXED_HEADER_SIZE = 32;
+/// Leading sequence, timestamp and trailing sequence
+constexpr int RECORD_OVERHEAD = 24;
+}  // namespace
+
+BlackBoxRecorder::~BlackBoxRecorder()
+{
+    close();
+}
+
+QString BlackBoxRecorder::previousPath(const QString &path)
+{
+    const QFileInfo info(path);
+    return info.path() + QLatin1Char('/') + info.completeBaseName() + QStringLiteral("_prev.") + info.suffix();
+}
+
+uchar *BlackBoxRecorder::slotAddress(int slot) const
+{
+    const qint64 page = 1 + slot / m_recordsPerPage;
+    return m_data + page * PAGE_SIZE + (slot % m_recordsPerPage) * m_recordSize;
+}
+
+bool BlackBoxRecorder::open(const QString &path, const QVector<LogColumn> &columns, int capacity, int sampleRateHz)
+{
+    close();
+
+    QByteArray table;
+    m_columnCount = 0;
+    for (const LogColumn &column : columns) {
+        if (column.isText)
+            continue;
+        const QByteArray name = column.name.left(255);
+        table.append(static_cast<char>(name.size()));
+        table.append(name);
+        ++m_columnCount;
+    }
+    m_recordSize = RECORD_OVERHEAD + m_columnCount * static_cast<int>(sizeof(float));
+    if (m_columnCount == 0 || FIXED_HEADER_SIZE + table.size() > PAGE_SIZE || m_recordSize > PAGE_SIZE) {
+        m_error = QStringLiteral("Black box layout does not fit a page");
+        return false;
+    }
+    m_recordsPerPage = PAGE_SIZE / m_recordSize;
+    const int pages = (qMax(1, capacity) + m_recordsPerPage - 1) / m_recordsPerPage;
+    m_capacity = pages * m_recordsPerPage;
+    m_size = static_cast<qint64>(1 + pages) * PAGE_SIZE;
+
+    if (!m_previousKept && QFile::exists(path)) {
+        const QString previous = previousPath(path);
+        QFile::remove(previous);
+        QFile::rename(path, previous);
+    }
+    m_previousKept = true;
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        m_error = QStringLiteral("Cannot open black box %1: %2").arg(path, m_file.errorString());
+        return false;
+    }
+
+    // Reserve every block up front: a store into an unbacked page on a full card raises SIGBUS.
+#if defined(Q_OS_UNIX)
+    const bool reserved = ::posix_fallocate(m_file.handle(), 0, m_size) == 0;
+#else
+    const bool reserved = m_file.resize(m_size);
+#endif
+    m_data = reserved ? m_file.map(0, m_size) : nullptr;
+    if (!m_data) {
+        m_error = QStringLiteral("Cannot reserve %1 KiB for black box %2").arg(m_size / 1024).arg(path);
+        m_file.close();
+        m_file.remove();
+        return false;
+    }
+
+    std::memcpy(m_data, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint16>(VERSION, m_data + 8);
+    qToLittleEndian<quint16>(static_cast<quint16>(m_columnCount), m_data + 10);
+    qToLittleEndian<quint32>(static_cast<quint32>(m_recordSize), m_data + 12);
+    qToLittleEndian<quint32>(static_cast<quint32>(m_recordsPerPage), m_data + 16);
+    qToLittleEndian<quint32>(static_cast<quint32>(m_capacity), m_data + 20);
+    qToLittleEndian<quint32>(static_cast<quint32>(sampleRateHz), m_data + 24);
+    std::memcpy(m_data + FIXED_HEADER_SIZE, table.constData(), table.size());
+
+    m_nextSlot = 0;
+    m_flushSlot = 0;
+    m_dirtyRecords = 0;
+    m_lastFlushMs = 0;
+    m_sequence = 0;
+    m_flushes = 0;
+    m_error.clear();
+
+    // The header is written back once; from here on only record pages are dirtied.
+#if defined(Q_OS_LINUX)
+    ::sync_file_range(m_file.handle(), 0, PAGE_SIZE, SYNC_FILE_RANGE_WRITE);
+#elif defined(Q_OS_UNIX)
+    ::msync(m_data, PAGE_SIZE, MS_ASYNC);
+#endif
+    return true;
+}
+
+void BlackBoxRecorder::close()
+{
+    if (m_data) {
+        flushDirty();
+        m_file.unmap(m_data);
+    }
+    m_data = nullptr;
+    m_file.close();
+}
+
+void BlackBoxRecorder::append(qint64 timestampMs, const double *values)
+{
+    if (!m_data)
+        return;
+
+    uchar *record = slotAddress(m_nextSlot);
+    const quint64 sequence = ++m_sequence;
+
+    // Leading sequence first and trailing sequence last: if write-back copies
+    // the page mid-update the two ends differ and the extractor skips the record.
+    qToLittleEndian<quint64>(sequence, record);
+    std::atomic_thread_fence(std::memory_order_release);
+    qToLittleEndian<qint64>(timestampMs, record + 8);
+    uchar *field = record + 16;
+    for (int column = 0; column < m_columnCount; ++column, field += sizeof(float))
+        qToLittleEndian<float>(static_cast<float>(values[column]), field);
+    std::atomic_thread_fence(std::memory_order_release);
+    qToLittleEndian<quint64>(sequence, field);
+
+    m_nextSlot = m_nextSlot + 1 == m_capacity ? 0 : m_nextSlot + 1;
+    m_dirtyRecords = qMin(m_dirtyRecords + 1, m_capacity);
+    if (qAbs(timestampMs - m_lastFlushMs) >= FLUSH_INTERVAL_MS) {
+        flushDirty();
+        m_lastFlushMs = timestampMs;
+    }
+}
+
+void BlackBoxRecorder::flushDirty()
+{
+    if (m_dirtyRecords == 0)
+        return;
+
+    if (m_dirtyRecords >= m_capacity) {
+        queueWriteBack(0, m_capacity - 1);
+    } else {
+        const int last = (m_flushSlot + m_dirtyRecords - 1) % m_capacity;
+        if (last >= m_flushSlot) {
+            queueWriteBack(m_flushSlot, last);
+        } else {
+            queueWriteBack(m_flushSlot, m_capacity - 1);
+            queueWriteBack(0, last);
+        }
+    }
+    m_flushSlot = m_nextSlot;
+    m_dirtyRecords = 0;
+    ++m_flushes;
+}
+
+void BlackBoxRecorder::queueWriteBack(int firstSlot, int lastSlot)
+{
+    const qint64 start = (1 + firstSlot / m_recordsPerPage) * static_cast<qint64>(PAGE_SIZE);
+    const qint64 end = (2 + lastSlot / m_recordsPerPage) * static_cast<qint64>(PAGE_SIZE);
+#if defined(Q_OS_LINUX)
+    // Starts write-back of the dirty pages in the range without waiting for it.
+    ::sync_file_range(m_file.handle(), start, end - start, SYNC_FILE_RANGE_WRITE);
+#elif defined(Q_OS_UNIX)
+    ::msync(m_data + start, static_cast<size_t>(end - start), MS_ASYNC);
+#else
+    Q_UNUSED(start);
+    Q_UNUSED(end);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Extraction
+// ---------------------------------------------------------------------------
+
+bool BlackBoxRecorder::extractCsv(const QString &path, const QString &outputPath, QString *errorString,
+                                  qint64 *records, qint64 *torn)
+{
+    const auto fail = [errorString](const QString &message) {
+        if (errorString)
+            *errorString = message;
+        return false;
+    };
+
+    QFile in(path);
+    if (!in.open(QIODevice::ReadOnly))
+        return fail(QStringLiteral("Cannot open %1: %2").arg(path, in.errorString()));
+
+    const qint64 size = in.size();
+    const uchar *data = size >= PAGE_SIZE ? in.map(0, size) : nullptr;
+    if (!data || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || qFromLittleEndian<quint16>(data + 8) != VERSION)
+        return fail(QStringLiteral("%1 is not a PowerTune black box").arg(path));
+
+    const int columnCount = qFromLittleEndian<quint16>(data + 10);
+    const int recordSize = static_cast<int>(qFromLittleEndian<quint32>(data + 12));
+    const int recordsPerPage = static_cast<int>(qFromLittleEndian<quint32>(data + 16));
+    const int capacity = static_cast<int>(qFromLittleEndian<quint32>(data + 20));
+    if (recordSize != RECORD_OVERHEAD + columnCount * static_cast<int>(sizeof(float)) || recordsPerPage <= 0
+        || recordsPerPage * recordSize > PAGE_SIZE
+        || (1 + (capacity + recordsPerPage - 1) / static_cast<qint64>(recordsPerPage)) * PAGE_SIZE > size)
+        return fail(QStringLiteral("%1 has a damaged header").arg(path));
+
+    QVector<LogColumn> columns;
+    const uchar *entry = data + FIXED_HEADER_SIZE;
+    for (int i = 0; i < columnCount; ++i) {
+        const int length = *entry++;
+        if (entry + length > data + PAGE_SIZE)
+            return fail(QStringLiteral("%1 has a damaged column table").arg(path));
+        columns.append(LogColumn{QByteArray(reinterpret_cast<const char *>(entry), length), false});
+        entry += length;
+    }
+
+    // Collect the intact records and order them by sequence; the ring position is not stored.
+    std::vector<std::pair<quint64, const uchar *>> intact;
+    intact.reserve(capacity);
+    qint64 tornCount = 0;
+    for (int slot = 0; slot < capacity; ++slot) {
+        const uchar *record = data + (1 + slot / recordsPerPage) * static_cast<qint64>(PAGE_SIZE)
+                              + (slot % recordsPerPage) * recordSize;
+        const quint64 sequence = qFromLittleEndian<quint64>(record);
+        if (sequence == 0)
+            continue;
+        if (qFromLittleEndian<quint64>(record + recordSize - 8) != sequence) {
+            ++tornCount;
+            continue;
+        }
+        intact.emplace_back(sequence, record);
+    }
+    std::sort(intact.begin(), intact.end());
+
+    LogSampleBatch batch;
+    batch.setLayout(columnCount, 0);
+    QVector<double> values(columnCount);
+    for (const auto &item : intact) {
+        const uchar *field = item.second + 16;
+        for (int column = 0; column < columnCount; ++column, field += sizeof(float))
+            values[column] = qFromLittleEndian<float>(field);
+        batch.appendRow(qFromLittleEndian<qint64>(item.second + 8), values.constData(), nullptr);
+    }
+
+    const CsvLogFormatter formatter;
+    QByteArray csv = formatter.header(columns);
+    formatter.appendRows(columns, batch, csv);
+
+    QFile out(outputPath);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate) || out.write(csv) != csv.size())
+        return fail(QStringLiteral("Cannot write %1: %2").arg(outputPath, out.errorString()));
+
+    if (records)
+        *records = static_cast<qint64>(intact.size());
+    if (torn)
+        *torn = tornCount;
+    return true;
+}
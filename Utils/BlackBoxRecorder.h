@@ -0,0 +1,120 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file BlackBoxRecorder.h
+ * @brief Fixed-size, memory-mapped circular record of the last minutes of logger channels.
+ *
+ * The file is created once at full size with every block reserved and mapped
+ * shared. Each sample is a plain store into the mapping; the kernel writes
+ * the dirty pages back, so a power cut loses at most the last flush interval.
+ * Every second the pages touched since the previous flush are queued for
+ * write-back with sync_file_range() (no fsync, never waits), so I/O stays at
+ * a few page writes per second.
+ *
+ * Layout (little-endian, 4096-byte pages):
+ *
+ *   Page 0, header
+ *     char    magic[8]        "PTBBOX\0\1"
+ *     quint16 version         1
+ *     quint16 columnCount
+ *     quint32 recordSize
+ *     quint32 recordsPerPage
+ *     quint32 capacity        records in the ring
+ *     quint32 sampleRateHz
+ *     quint32 reserved
+ *     column table            per column: quint8 length, name bytes
+ *   Pages 1.., records packed per page, never straddling a page
+ *     quint64 sequence        1, 2, 3, ... (0 = never written)
+ *     qint64  timestampMs     wall clock, ms since the epoch
+ *     float   values[columnCount]
+ *     quint64 sequence        repeated; a record torn by write-back has mismatching ends
+ *
+ * The first open() keeps an existing file as previousPath() so the minutes
+ * before a crash are not overwritten by the next session; reopening with new
+ * settings later in the same session replaces the file.
+ */
+
+#ifndef BLACKBOXRECORDER_H
+#define BLACKBOXRECORDER_H
+
+#include "LogFormat.h"
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+class BlackBoxRecorder
+{
+public:
+    static constexpr int PAGE_SIZE = 4096;
+    /// Write-back is queued for the dirty pages at this interval
+    static constexpr int FLUSH_INTERVAL_MS = 1000;
+
+    BlackBoxRecorder() = default;
+    ~BlackBoxRecorder();
+
+    BlackBoxRecorder(const BlackBoxRecorder &) = delete;
+    BlackBoxRecorder &operator=(const BlackBoxRecorder &) = delete;
+
+    /**
+     * @brief Create @p path holding at least @p capacity records of the numeric @p columns.
+     *
+     * Text columns are skipped, so append() takes the same numeric values as
+     * a LogSampleBatch row. Values are stored as float32.
+     * @return false if the file could not be created, reserved or mapped (see errorString())
+     */
+    bool open(const QString &path, const QVector<LogColumn> &columns, int capacity, int sampleRateHz);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    QString errorString() const { return m_error; }
+    QString filePath() const { return m_file.fileName(); }
+
+    /**
+     * @brief Store one record; values follow the numeric columns given to open().
+     *
+     * Only writes to mapped memory, plus a non-blocking write-back request
+     * once per FLUSH_INTERVAL_MS.
+     */
+    void append(qint64 timestampMs, const double *values);
+
+    quint64 recordsWritten() const { return m_sequence; }
+    int capacity() const { return m_capacity; }
+    qint64 fileSize() const { return m_size; }
+    quint64 flushes() const { return m_flushes; }
+
+    /// Where open() keeps the previous session, e.g. "blackbox_prev.ptbb"
+    static QString previousPath(const QString &path);
+
+    /**
+     * @brief Write the intact records of @p path, oldest first, as logger CSV (time_ms is epoch ms).
+     * @param records Receives the number of records written (may be null)
+     * @param torn Receives the number of records skipped as torn (may be null)
+     * @param errorString Receives a description on failure (may be null)
+     */
+    static bool extractCsv(const QString &path, const QString &outputPath, QString *errorString = nullptr,
+                           qint64 *records = nullptr, qint64 *torn = nullptr);
+
+private:
+    uchar *slotAddress(int slot) const;
+    void flushDirty();
+    void queueWriteBack(int firstSlot, int lastSlot);
+
+    QFile m_file;
+    uchar *m_data = nullptr;
+    qint64 m_size = 0;
+    QString m_error;
+    int m_columnCount = 0;
+    int m_recordSize = 0;
+    int m_recordsPerPage = 0;
+    int m_capacity = 0;
+    int m_nextSlot = 0;
+    int m_flushSlot = 0;     ///< First slot written since the last flush
+    int m_dirtyRecords = 0;  ///< Records written since the last flush (capped at capacity)
+    qint64 m_lastFlushMs = 0;
+    quint64 m_sequence = 0;
+    quint64 m_flushes = 0;
+    bool m_previousKept = false;
+};
+
+#endif  // BLACKBOXRECORDER_H
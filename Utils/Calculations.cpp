@@ -13,50 +13,29 @@
 #include "../Core/Models/SettingsData.h"
 #include "../Core/Models/TimingData.h"
 #include "../Core/Models/VehicleData.h"
+#include "../Core/TraceRecorder.h"
+#include "../Core/appsettings.h"
 
 #include <QDebug>
+#include <QDir>
+#include <QStandardPaths>
 
-qreal Power;
-qreal Torque;
-qreal odometer;
-qreal tripmeter;
-qreal traveleddistance;
-qreal timesincelastupdate;
-
-QTime startTime;
-QTime reactiontimerdiff = QTime::currentTime();
-qreal dragdistance;
-qreal dragdistancetotal;
-qreal totaldragtime;
-qreal zerotohundredtime;
-qreal twohundredtime;
-qreal threehundredtime;
-qreal reactiontime;
-qreal qmlgreentime;
-
-int zerotohundredset = 0;
-int hundredtotwohundredset = 0;
-int twohundredtothreehundredset = 0;
-int sixtyfootset = 0;
-int threhundredthirtyfootset = 0;
-int eightmileset = 0;
-int quartermileset = 0;
-int thousandfootset = 0;
-int startdragcalculation = 0;
-
-int weight;  // just set this to 1300 for testing
-int gearratio;
-int odoisset;
-int PreviousSpeed;
-int Gear1;
-int Gear2;
-int Gear3;
-int Gear4;
-int Gear5;
-int Gear6;
-int GearN;
-double prev_speed = 0;
-qint64 prev_timestamp = QDateTime::currentMSecsSinceEpoch();
+#include <chrono>
+
+namespace {
+const QString LAP_START_FINISH_KEY = QStringLiteral("ui/laptimer/startFinish");
+const QString LAP_SECTORS_KEY = QStringLiteral("ui/laptimer/sectors");
+/// Pre-journal settings values; they only seed an empty odometer journal
+const QString ODOMETER_KEY = QStringLiteral("ui/odometer");
+const QString TRIPMETER_KEY = QStringLiteral("ui/tripmeter");
+
+/// Fallback clock of the speed samples when the CAN backend gives no frame timestamp
+qint64 wallClockUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+}  // namespace
 
 calculations::calculations(QObject *parent)
     : QObject(parent),
@@ -72,236 +51,345 @@ calculations::calculations(VehicleData *vehicleData, EngineData *engineData, Tim
       m_engineData(engineData),
       m_timingData(timingData),
       m_settingsData(settingsData)
-{}
+{
+    for (auto changed : {&SettingsData::gearcalc1Changed, &SettingsData::gearcalc2Changed,
+                         &SettingsData::gearcalc3Changed, &SettingsData::gearcalc4Changed,
+                         &SettingsData::gearcalc5Changed, &SettingsData::gearcalc6Changed,
+                         &SettingsData::gearcalcactivationChanged})
+        connect(m_settingsData, changed, this, &calculations::rebuildGearClassifier);
+    connect(m_engineData, &EngineData::rpmChanged, this, &calculations::updateCalculatedGear);
+    m_gearClock.start();
+    m_gearConfirmTimer.setSingleShot(true);
+    connect(&m_gearConfirmTimer, &QTimer::timeout, this, &calculations::updateCalculatedGear);
+    rebuildGearClassifier();
+
+    connect(&m_updateodotimer, &QTimer::timeout, this, &calculations::saveodoandtriptofile);
+    const QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    dir.mkpath(QStringLiteral("."));
+    if (!m_odometerJournal.open(dir.filePath(QStringLiteral("odometer.journal"))))
+        qWarning() << m_odometerJournal.errorString();
+}
 
 void calculations::setExpanderBoardData(ExpanderBoardData *expander)
 {
     m_expanderBoardData = expander;
 }
 
+void calculations::setUnitPreferences(const UnitPreferences &preferences)
+{
+    const Unit speedUnit = displayUnit(Unit::KilometersPerHour, preferences);
+    m_displaySpeed = UnitConversion::between(Unit::KilometersPerHour, speedUnit);
+    m_dragUnits = speedUnit == Unit::MilesPerHour ? DragTimer::Units::Imperial : DragTimer::Units::Metric;
+}
+
+void calculations::setAppSettings(AppSettings *appSettings)
+{
+    // Restoring the saved track must not write it straight back
+    m_appSettings = nullptr;
+    if (appSettings)
+        setLapTrack(appSettings->getValue(LAP_START_FINISH_KEY).toString(),
+                    appSettings->getValue(LAP_SECTORS_KEY).toStringList());
+    m_appSettings = appSettings;
+
+    // The odometer journal is authoritative; restore it once here, not from the settings page.
+    if (!readodoandtrip() && appSettings && m_vehicleData) {
+        m_vehicleData->setOdo(appSettings->getValue(ODOMETER_KEY, 0).toReal());
+        m_vehicleData->setTrip(appSettings->getValue(TRIPMETER_KEY, 0).toReal());
+        saveodoandtriptofile();
+    }
+}
+
 void calculations::start()
 {
-    if (m_updatetimer.isActive())
+    if (m_running)
         return;
 
-    connect(&m_updatetimer, &QTimer::timeout, this, &calculations::calculate, Qt::UniqueConnection);
-    connect(&m_updateodotimer, &QTimer::timeout, this, &calculations::saveodoandtriptofile, Qt::UniqueConnection);
-    odometer = m_vehicleData->Odo();
-    tripmeter = m_vehicleData->Trip();
-    m_updatetimer.setInterval(25);
-    // m_updateodotimer.start(10000);
-    m_updatetimer.start();
+    m_updateodotimer.start(JOURNAL_INTERVAL_MS);
+    m_running = true;
 }
 void calculations::stop()
 {
-    m_updatetimer.stop();
+    m_running = false;
+    m_updateodotimer.stop();
+    saveodoandtriptofile();
 }
 void calculations::resettrip()
 {
-    tripmeter = 0;
     m_vehicleData->setTrip(0);
+    saveodoandtriptofile();
+}
+qint64 calculations::sampleClockUs() const
+{
+    // Frame timestamps may come from another clock than ours (kernel or adapter time).
+    return wallClockUs() + m_sampleClockOffsetUs;
 }
 void calculations::startdragtimer()
 {
-    zerotohundredtime = 0;
-    twohundredtime = 0;
-    threehundredtime = 0;
-
-    dragdistance = 0;
-    totaldragtime = 0;
-    dragdistancetotal = 0;
-    zerotohundredset = 0;
-    hundredtotwohundredset = 0;
-    twohundredtothreehundredset = 0;
-    sixtyfootset = 0, threhundredthirtyfootset = 0;
-    eightmileset = 0;
-    quartermileset = 0;
-    thousandfootset = 0;
-    startdragcalculation = 0;
-    startdragcalculation = 1;
+    m_dragTimer.start(sampleClockUs(), m_dragUnits);
 }
 void calculations::startreactiontimer()
 {
     // qDebug() << "Reactiontimer start";
-    reactiontime = 0;
-    qmlgreentime = 0;
-    reactiontimerdiff = QTime::currentTime();
+    m_reactionTime = 0;
+    m_qmlGreenTime = 0;
+    m_reactionStart = QTime::currentTime();
     m_reactiontimer.start();
 }
 
 void calculations::qmlrealtime()
 {
     // qDebug() << "QML Light Green";
-    qmlgreentime = (reactiontimerdiff.msecsTo(QTime::currentTime()) / 1000);  // reactiontime
+    m_qmlGreenTime = (m_reactionStart.msecsTo(QTime::currentTime()) / 1000);  // reactiontime
 }
 void calculations::stopreactiontimer()
 {
     // qDebug() << "stop reaction timer";
     m_reactiontimer.stop();
-    startTime = QTime::currentTime();
-    reactiontime = (reactiontimerdiff.msecsTo(QTime::currentTime()));  // reactiontime
-    m_timingData->setreactiontime(reactiontime / 1000);
+    // The run is timed from the launch, as long as the car has not moved yet.
+    if (m_dragTimer.isRunning() && m_dragTimer.distanceFeet() == 0.0)
+        m_dragTimer.start(sampleClockUs(), m_dragTimer.units());
+    m_reactionTime = (m_reactionStart.msecsTo(QTime::currentTime()));  // reactiontime
+    m_timingData->setreactiontime(m_reactionTime / 1000);
 }
 
 
 /*
 void calculations::calculatereactiontime()
 {
-    m_timingData->setreactiontime((reactiontime / 1000) - qmlgreentime) ;
+    m_timingData->setreactiontime((m_reactionTime / 1000) - m_qmlGreenTime) ;
 }
 */
-void calculations::readodoandtrip()
+bool calculations::readodoandtrip()
 {
-    // Call this from QML to read Odo and Trip from file
+    if (!m_vehicleData || !m_odometerJournal.hasRecord())
+        return false;
+    m_journaledOdo = m_odometerJournal.odometer();
+    m_journaledTrip = m_odometerJournal.trip();
+    m_vehicleData->setOdo(m_journaledOdo);
+    m_vehicleData->setTrip(m_journaledTrip);
+    return true;
 }
 void calculations::saveodoandtriptofile()
 {
-    // To avoid file corruption  save this every 10 seconds only if speed is greater 10 KM/h
-    //  m_updateodotimer.start(600);
-    // qDebug() << "Update Odometer";
+    journalOdometer(true);
 }
-// 1 foot = 0,00018939 miles =
-// 60 Feet = 0,0113634 miles = 0,01828762 km
-// 330 Feet  = 0,0624987 miles = 0,10058191 km
-void calculations::calculate()
+void calculations::journalOdometer(bool sync)
 {
-    weight = m_vehicleData->Weight();
-    const qreal currentSpeed = m_expanderBoardData ? m_expanderBoardData->EXSpeed() : 0.0;
-    m_updatetimer.start(25);
-
-    if (m_settingsData->speedunits() == "metric" && startdragcalculation == 1) {
-        timesincelastupdate = (startTime.msecsTo(QTime::currentTime())) - totaldragtime;
-        dragdistance = (timesincelastupdate * (currentSpeed / 3600000));
-        totaldragtime = (startTime.msecsTo(QTime::currentTime()));
-        dragdistancetotal += dragdistance;
-        if (dragdistancetotal >= 0.01828762 && sixtyfootset == 0) {
-            m_timingData->setsixtyfoottime(totaldragtime / 1000);
-            m_timingData->setsixtyfootspeed(currentSpeed);
-            sixtyfootset = 1;
-        }
-        if (dragdistancetotal >= 0.10058191 && threhundredthirtyfootset == 0) {
-            m_timingData->setthreehundredthirtyfoottime(totaldragtime / 1000);
-            m_timingData->setthreehundredthirtyfootspeed(currentSpeed);
-            threhundredthirtyfootset = 1;
-        }
-        if (dragdistancetotal >= 0.201168 && eightmileset == 0) {
-            m_timingData->seteightmiletime(totaldragtime / 1000);
-            m_timingData->seteightmilespeed(currentSpeed);
-            eightmileset = 1;
-        }
-        if (dragdistancetotal >= 0.402336 && quartermileset == 0) {
-            m_timingData->setquartermiletime(totaldragtime / 1000);
-            m_timingData->setquartermilespeed(currentSpeed);
-            quartermileset = 1;
-        }
-        if (dragdistancetotal >= 0.3048 && thousandfootset == 0) {
-            m_timingData->setthousandfoottime(totaldragtime / 1000);
-            m_timingData->setthousandfootspeed(currentSpeed);
-            thousandfootset = 1;
-        }
-        if (currentSpeed >= 100 && zerotohundredset == 0) {
-            zerotohundredtime = totaldragtime;
-            m_timingData->setzerotohundredt(totaldragtime / 1000);
-            zerotohundredset = 1;
-        }
-        if (currentSpeed >= 200 && hundredtotwohundredset == 0) {
-            twohundredtime = totaldragtime - zerotohundredtime;
-            m_timingData->sethundredtotwohundredtime(twohundredtime / 1000);
-            hundredtotwohundredset = 1;
-        }
-        if (currentSpeed >= 300 && twohundredtothreehundredset == 0) {
-            threehundredtime = totaldragtime - zerotohundredtime - twohundredtime;
-            m_timingData->settwohundredtothreehundredtime(threehundredtime / 1000);
-            twohundredtothreehundredset = 1;
-        }
-    }
-    if (m_settingsData->speedunits() == "imperial" && startdragcalculation == 1) {
-        timesincelastupdate = (startTime.msecsTo(QTime::currentTime())) - totaldragtime;
-        dragdistance = (timesincelastupdate * (currentSpeed / 3600000));
-        totaldragtime = (startTime.msecsTo(QTime::currentTime()));
-        dragdistancetotal += dragdistance;
-        if (dragdistancetotal >= 0.01136364 && sixtyfootset == 0) {
-            m_timingData->setsixtyfoottime(totaldragtime / 1000);
-            m_timingData->setsixtyfootspeed(currentSpeed);
-            sixtyfootset = 1;
-        }
-        if (dragdistancetotal >= 0.0625 && threhundredthirtyfootset == 0) {
-            m_timingData->setthreehundredthirtyfoottime(totaldragtime / 1000);
-            m_timingData->setthreehundredthirtyfootspeed(currentSpeed);
-            threhundredthirtyfootset = 1;
-        }
-        if (dragdistancetotal >= 0.125 && eightmileset == 0) {
-            m_timingData->seteightmiletime(totaldragtime / 1000);
-            m_timingData->seteightmilespeed(currentSpeed);
-            eightmileset = 1;
-        }
-        if (dragdistancetotal >= 0.25 && quartermileset == 0) {
-            m_timingData->setquartermiletime(totaldragtime / 1000);
-            m_timingData->setquartermilespeed(currentSpeed);
-            quartermileset = 1;
-        }
-        if (dragdistancetotal >= 0.18939394 && thousandfootset == 0) {
-            m_timingData->setthousandfoottime(totaldragtime / 1000);
-            m_timingData->setthousandfootspeed(currentSpeed);
-            thousandfootset = 1;
-        }
-        if (currentSpeed >= 60 && zerotohundredset == 0) {
-            zerotohundredtime = totaldragtime;
-            m_timingData->setzerotohundredt(totaldragtime / 1000);
-            zerotohundredset = 1;
-        }
-        if (currentSpeed >= 120 && hundredtotwohundredset == 0) {
-            twohundredtime = totaldragtime - zerotohundredtime;
-            m_timingData->sethundredtotwohundredtime(twohundredtime / 1000);
-            hundredtotwohundredset = 1;
-        }
-        if (currentSpeed >= 180 && twohundredtothreehundredset == 0) {
-            threehundredtime = totaldragtime - zerotohundredtime - twohundredtime;
-            m_timingData->settwohundredtothreehundredtime(threehundredtime / 1000);
-            twohundredtothreehundredset = 1;
+    // One 32-byte append per change instead of rewriting the settings file while driving.
+    if (!m_vehicleData || !m_odometerJournal.isOpen())
+        return;
+    const qreal odo = m_vehicleData->Odo();
+    const qreal trip = m_vehicleData->Trip();
+    if (odo != m_journaledOdo || trip != m_journaledTrip) {
+        if (!m_odometerJournal.append(odo, trip)) {
+            qWarning() << m_odometerJournal.errorString();
+            return;
         }
+        m_journaledOdo = odo;
+        m_journaledTrip = trip;
     }
+    if (sync)
+        m_odometerJournal.sync();
+}
+void calculations::onSpeedSample(qreal speedKph, qint64 timestampUs)
+{
+    PT_TRACE_SCOPE("calculations.speedSample");
+    // Between GPS fixes, carry the lap distance forward at this speed for the lap delta.
+    if (m_lapDelta.isRecording() && timestampUs > m_lastFixUs && timestampUs - m_lastFixUs <= LapTimer::MAX_GAP_US)
+        publishLapDelta(timestampUs, m_lastFixDistanceM + speedKph / 3.6 * (timestampUs - m_lastFixUs) / 1e6);
+    m_sampleClockOffsetUs = timestampUs - wallClockUs();
+    if (!m_running)
+        return;
+    const qreal currentSpeed = m_displaySpeed.apply(speedKph);
 
-    if (m_settingsData->gearcalcactivation() == 1 && !m_settingsData->gearSourceExpander()) {
-        int N = m_engineData->rpm() / (currentSpeed == 0.0 ? 0.01 : currentSpeed);
-        int CurrentGear =
-            (N > (m_settingsData->gearcalc1() * 1.5)
-                 ? 0.0
-                 : (N > ((m_settingsData->gearcalc1() + m_settingsData->gearcalc2()) / 2.0)
-                        ? 1.0
-                        : (N > ((m_settingsData->gearcalc2() + m_settingsData->gearcalc3()) / 2.0)
-                               ? 2.0
-                               : (N > ((m_settingsData->gearcalc3() + m_settingsData->gearcalc4()) / 2.0)
-                                      ? 3.0
-                                      : (N > ((m_settingsData->gearcalc4() + m_settingsData->gearcalc5()) / 2.0)
-                                             ? 4.0
-                                             : (m_settingsData->gearcalc5() == 0
-                                                    ? 0.0
-                                                    : (N > ((m_settingsData->gearcalc5() +
-                                                             m_settingsData->gearcalc6()) /
-                                                            2.0)
-                                                           ? 5.0
-                                                           : (m_settingsData->gearcalc6() == 0
-                                                                  ? 0.0
-                                                                  : (N > (m_settingsData->gearcalc6() / 2.0)
-                                                                         ? 6.0
-                                                                         : 0.0)))))))));
-        m_vehicleData->setGear(CurrentGear);
-        m_vehicleData->setGearCalculation(CurrentGear);
+    if (m_dragTimer.isRunning()) {
+        const unsigned reached = m_dragTimer.addSample(timestampUs, currentSpeed);
+        if (reached != 0)
+            publishDragMarks(reached);
     }
 
-    if (currentSpeed > 0) {
-        qint64 current_timestamp = QDateTime::currentMSecsSinceEpoch();
-        double time_interval = (current_timestamp - prev_timestamp) / 1000.0;
-        double current_speed_mps = currentSpeed / 3.6;
-        if (prev_timestamp == 0)
-            prev_speed = current_speed_mps;
-        double distance_traveled = ((current_speed_mps + prev_speed) * time_interval * 0.5) / 1000;
+    m_lastSpeed = speedKph;
+    updateCalculatedGear();
+
+    if (speedKph > 0) {
+        qint64 current_timestamp = timestampUs;
+        double current_speed_mps = speedKph / 3.6;
+        if (m_prevSpeedTimestampUs == 0) {
+            m_prevSpeedMps = current_speed_mps;
+            m_prevSpeedTimestampUs = current_timestamp;
+        }
+        double time_interval = (current_timestamp - m_prevSpeedTimestampUs) / 1000000.0;
+        double distance_traveled = ((current_speed_mps + m_prevSpeedMps) * time_interval * 0.5) / 1000;
         if (distance_traveled < 0.005) {
             m_vehicleData->setOdo(m_vehicleData->Odo() + distance_traveled);
             m_vehicleData->setTrip(m_vehicleData->Trip() + distance_traveled);
+            if (m_vehicleData->Odo() - m_journaledOdo >= JOURNAL_DISTANCE_KM)
+                journalOdometer(false);
         }
-        prev_speed = current_speed_mps;
-        prev_timestamp = current_timestamp;
+        m_prevSpeedMps = current_speed_mps;
+        m_prevSpeedTimestampUs = current_timestamp;
+    }
+}
+
+void calculations::onPositionSample(double latitude, double longitude, qint64 timestampUs)
+{
+    PT_TRACE_SCOPE("calculations.positionSample");
+    if (!m_lapTimer.hasTrack())
+        return;
+    const unsigned events = m_lapTimer.addFix(timestampUs, latitude, longitude);
+    if (events & LapTimer::LapCompleted)
+        m_lapDelta.completeLap(m_lapTimer.lastLapMs() == m_lapTimer.bestLapMs());
+    if (events & LapTimer::LapStarted)
+        m_lapDelta.beginLap(m_lapTimer.lapStartUs());
+    m_lastFixUs = timestampUs;
+    m_lastFixDistanceM = m_lapTimer.lapDistanceM();
+    m_lapDelta.record(timestampUs, m_lastFixDistanceM);
+    publishLap(events, timestampUs);
+    publishLapDelta(timestampUs, m_lastFixDistanceM);
+}
+
+bool calculations::setLapTrack(const QString &startFinish, const QStringList &sectors)
+{
+    const auto parseLine = [](const QString &text, LapTimer::Line &line) {
+        const QStringList parts = text.split(QLatin1Char(','));
+        bool ok[4] = {};
+        if (parts.size() != 4)
+            return false;
+        line = LapTimer::Line{parts.at(0).trimmed().toDouble(&ok[0]), parts.at(1).trimmed().toDouble(&ok[1]),
+                              parts.at(2).trimmed().toDouble(&ok[2]), parts.at(3).trimmed().toDouble(&ok[3])};
+        return ok[0] && ok[1] && ok[2] && ok[3];
+    };
+
+    LapTimer::Line startFinishLine;
+    QVector<LapTimer::Line> sectorLines;
+    bool valid = parseLine(startFinish, startFinishLine);
+    for (const QString &text : sectors) {
+        LapTimer::Line line;
+        if (parseLine(text, line))
+            sectorLines.append(line);
     }
+    if (valid)
+        m_lapTimer.setTrack(startFinishLine, sectorLines);
+    else
+        m_lapTimer.clearTrack();
+    valid = valid && m_lapTimer.hasTrack();
+    resetlaptimer();
+
+    if (m_appSettings && (valid || startFinish.trimmed().isEmpty())) {
+        m_appSettings->setValue(LAP_START_FINISH_KEY, valid ? startFinish.trimmed() : QString());
+        m_appSettings->setValue(LAP_SECTORS_KEY, valid ? sectors : QStringList());
+    }
+    return valid;
+}
+
+void calculations::resetlaptimer()
+{
+    m_lapTimer.reset();
+    m_lapDelta.clear();
+    if (!m_timingData)
+        return;
+    m_timingData->setlapDelta(0);
+    m_timingData->setlaptimeMs(0);
+    m_timingData->setLastlaptimeMs(0);
+    m_timingData->setbestlaptimeMs(0);
+    m_timingData->setlastSectorMs(0);
+    m_timingData->setcurrentLap(0);
+    m_timingData->setcurrentSector(m_lapTimer.currentSector());
+}
+
+void calculations::publishLap(unsigned events, qint64 timestampUs)
+{
+    if (events & LapTimer::LapCompleted) {
+        m_timingData->setLastlaptimeMs(m_lapTimer.lastLapMs());
+        m_timingData->setbestlaptimeMs(m_lapTimer.bestLapMs());
+    }
+    if (events & LapTimer::SectorCompleted)
+        m_timingData->setlastSectorMs(m_lapTimer.lastSectorMs());
+    if (events & LapTimer::LapStarted)
+        m_timingData->setcurrentLap(m_lapTimer.currentLap());
+    m_timingData->setcurrentSector(m_lapTimer.currentSector());
+    // The running clock is an int per fix; it is only formatted if something shows it.
+    m_timingData->setlaptimeMs(m_lapTimer.elapsedMs(timestampUs));
+}
+
+void calculations::publishLapDelta(qint64 timestampUs, double lapDistanceM)
+{
+    int deltaMs = 0;
+    if (m_lapDelta.delta(timestampUs, lapDistanceM, &deltaMs))
+        m_timingData->setlapDelta(deltaMs / 1000.0);
+}
+
+void calculations::publishDragMarks(unsigned reached)
+{
+    const auto crossing = [this, reached](DragTimer::Mark mark) -> const DragTimer::Crossing * {
+        return (reached & (1u << mark)) != 0 ? &m_dragTimer.crossing(mark) : nullptr;
+    };
+
+    if (const DragTimer::Crossing *c = crossing(DragTimer::SixtyFoot)) {
+        m_timingData->setsixtyfoottime(c->seconds);
+        m_timingData->setsixtyfootspeed(c->speed);
+    }
+    if (const DragTimer::Crossing *c = crossing(DragTimer::ThreeThirtyFoot)) {
+        m_timingData->setthreehundredthirtyfoottime(c->seconds);
+        m_timingData->setthreehundredthirtyfootspeed(c->speed);
+    }
+    if (const DragTimer::Crossing *c = crossing(DragTimer::EighthMile)) {
+        m_timingData->seteightmiletime(c->seconds);
+        m_timingData->seteightmilespeed(c->speed);
+    }
+    if (const DragTimer::Crossing *c = crossing(DragTimer::ThousandFoot)) {
+        m_timingData->setthousandfoottime(c->seconds);
+        m_timingData->setthousandfootspeed(c->speed);
+    }
+    if (const DragTimer::Crossing *c = crossing(DragTimer::QuarterMile)) {
+        m_timingData->setquartermiletime(c->seconds);
+        m_timingData->setquartermilespeed(c->speed);
+    }
+
+    // Speed splits: 0-100, 100-200 and 200-300 km/h (0-60, 60-120, 120-180 mph)
+    if (const DragTimer::Crossing *c = crossing(DragTimer::FirstSpeed))
+        m_timingData->setzerotohundredt(c->seconds);
+    if (const DragTimer::Crossing *c = crossing(DragTimer::SecondSpeed))
+        m_timingData->sethundredtotwohundredtime(c->seconds - m_dragTimer.crossing(DragTimer::FirstSpeed).seconds);
+    if (const DragTimer::Crossing *c = crossing(DragTimer::ThirdSpeed))
+        m_timingData->settwohundredtothreehundredtime(c->seconds
+                                                      - m_dragTimer.crossing(DragTimer::SecondSpeed).seconds);
+}
+
+void calculations::rebuildGearClassifier()
+{
+    // Ratios fall from gear 1 upwards; a zero ratio ends the list (gearbox with fewer gears).
+    const int ratios[] = {m_settingsData->gearcalc1(), m_settingsData->gearcalc2(), m_settingsData->gearcalc3(),
+                          m_settingsData->gearcalc4(), m_settingsData->gearcalc5(), m_settingsData->gearcalc6()};
+    GearClassifier::Config config;
+    for (int gear = 1; gear <= 6 && ratios[gear - 1] > 0; ++gear)
+        config.targets.append({gear, static_cast<double>(ratios[gear - 1])});
+    if (!config.targets.isEmpty()) {
+        // Beyond these the clutch is in or the car is stopped: neutral.
+        config.highLimit = config.targets.first().value * 1.5;
+        config.lowLimit = config.targets.last().value / 2.0;
+    }
+    config.unknownGear = 0;
+    m_gearClassifier.configure(config);
+    m_gearConfirmTimer.stop();
+}
+
+void calculations::updateCalculatedGear()
+{
+    if (!m_running || m_settingsData->gearcalcactivation() != 1 || m_settingsData->gearSourceExpander()
+        || !m_gearClassifier.isConfigured())
+        return;
+
+    const double ratio = m_engineData->rpm() / (m_lastSpeed == 0.0 ? 0.01 : m_lastSpeed);
+    const qint64 nowMs = m_gearClock.elapsed();
+    const bool changed = m_gearClassifier.update(ratio, nowMs);
+    const qint64 pendingMs = m_gearClassifier.pendingMs(nowMs);
+    if (pendingMs >= 0)
+        m_gearConfirmTimer.start(static_cast<int>(pendingMs));
+    else
+        m_gearConfirmTimer.stop();
+    if (!changed)
+        return;
+    m_vehicleData->setGear(m_gearClassifier.gear());
+    m_vehicleData->setGearCalculation(m_gearClassifier.gear());
 }
@@ -1,5 +1,13 @@
 #ifndef CALCULATIONS_H
 #define CALCULATIONS_H
+#include "DragTimer.h"
+#include "GearClassifier.h"
+#include "LapDelta.h"
+#include "LapTimer.h"
+#include "OdometerJournal.h"
+#include "UnitConversion.h"
+
+#include <QElapsedTimer>
 #include <QObject>
 #include <QThread>
 #include <QTime>
@@ -10,6 +18,7 @@ class EngineData;
 class TimingData;
 class SettingsData;
 class ExpanderBoardData;
+class AppSettings;
 
 class calculations : public QObject
 {
@@ -17,10 +26,25 @@ class calculations : public QObject
 
 
 public:
+    /// Odometer and trip are journaled after this much distance ...
+    static constexpr qreal JOURNAL_DISTANCE_KM = 0.1;
+    /// ... or at this interval while they change; the journal is also synced then
+    static constexpr int JOURNAL_INTERVAL_MS = 10000;
+
     explicit calculations(QObject *parent = nullptr);
     explicit calculations(VehicleData *vehicleData, EngineData *engineData, TimingData *timingData,
                           SettingsData *settingsData, QObject *parent = nullptr);
     void setExpanderBoardData(ExpanderBoardData *expander);
+    /// Drag marks use the display speed unit; the calculated gear always uses km/h
+    void setUnitPreferences(const UnitPreferences &preferences);
+    /**
+     * @brief Restore the saved lap track, and Odo and Trip from the odometer journal.
+     *
+     * Called once at startup. An empty journal is seeded from the settings
+     * values written before the journal existed. setLapTrack() saves the
+     * track from then on.
+     */
+    void setAppSettings(AppSettings *appSettings);
 
 public slots:
     Q_INVOKABLE void startdragtimer();
@@ -28,21 +52,77 @@ public slots:
     Q_INVOKABLE void qmlrealtime();
     Q_INVOKABLE void stopreactiontimer();
     // Q_INVOKABLE void calculatereactiontime();
-    Q_INVOKABLE void readodoandtrip();
+    /// Journal the current Odo and Trip if they changed and sync the journal
     void saveodoandtriptofile();
-    void calculate();
+    /**
+     * @brief Drag timing, gear calculation and odometer for one speed sample.
+     * @param speedKph Speed in km/h
+     * @param timestampUs Receive time of the sample (epoch microseconds), see ExBoardCan::speedSampled()
+     */
+    void onSpeedSample(qreal speedKph, qint64 timestampUs);
+    /**
+     * @brief Lap and sector timing for one GPS fix.
+     * @param timestampUs Receive time of the fix (epoch microseconds), see GpsReceiver::fixReceived()
+     */
+    void onPositionSample(double latitude, double longitude, qint64 timestampUs);
+    /**
+     * @brief Set the lap timing gates, each "lat1,lon1,lat2,lon2" (the two ends of the line).
+     * The track is saved to the app settings, so it survives a restart. An
+     * empty start/finish line clears it; a malformed one is not saved.
+     * @param sectors Sector lines in driving order; may be empty
+     * @return false if the start/finish line is malformed (lap timing is then off)
+     */
+    Q_INVOKABLE bool setLapTrack(const QString &startFinish, const QStringList &sectors = QStringList());
+    Q_INVOKABLE void resetlaptimer();
     void start();
     void stop();
     void resettrip();
 
 
+private slots:
+    void rebuildGearClassifier();
+    void updateCalculatedGear();
+
 private:
+    void publishDragMarks(unsigned reached);
+    void publishLap(unsigned events, qint64 timestampUs);
+    void publishLapDelta(qint64 timestampUs, double lapDistanceM);
+    /**
+     * @brief Restore Odo and Trip from the odometer journal.
+     * @return false if the journal holds no reading yet (Odo and Trip are left as they are)
+     */
+    bool readodoandtrip();
+    void journalOdometer(bool sync);
+    /// Current time on the clock the speed samples carry
+    qint64 sampleClockUs() const;
+
     VehicleData *m_vehicleData;
     EngineData *m_engineData;
     TimingData *m_timingData;
     SettingsData *m_settingsData;
     ExpanderBoardData *m_expanderBoardData = nullptr;
-    QTimer m_updatetimer;
+    AppSettings *m_appSettings = nullptr;
+    DragTimer m_dragTimer;
+    DragTimer::Units m_dragUnits = DragTimer::Units::Metric;
+    UnitConversion m_displaySpeed;  ///< km/h to the display speed unit
+    GearClassifier m_gearClassifier;  ///< rpm / speed ratio to gear, built from gearcalc1-6
+    QElapsedTimer m_gearClock;
+    QTimer m_gearConfirmTimer;  ///< Re-evaluates a pending gear once it is due, rpm and speed may not change again
+    LapTimer m_lapTimer;
+    LapDelta m_lapDelta;  ///< Against the best lap; also updated between fixes from speed samples
+    qint64 m_lastFixUs = 0;
+    double m_lastFixDistanceM = 0.0;
+    qreal m_lastSpeed = 0.0;  ///< km/h, so the gear ratios do not depend on the unit settings
+    qint64 m_sampleClockOffsetUs = 0;  ///< Speed sample timestamp minus our wall clock, from the last sample
+    double m_prevSpeedMps = 0.0;  ///< Previous moving sample, for the odometer
+    qint64 m_prevSpeedTimestampUs = 0;
+    QTime m_reactionStart;
+    qreal m_reactionTime = 0.0;  ///< Milliseconds
+    qreal m_qmlGreenTime = 0.0;
+    bool m_running = false;
+    OdometerJournal m_odometerJournal;
+    qreal m_journaledOdo = 0.0;
+    qreal m_journaledTrip = 0.0;
     QTimer m_updateodotimer;
     QTimer m_reactiontimer;
     QTimer m_dynotimer;
@@ -0,0 +1,178 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file CompressedLogFormat.cpp
+ * @brief Block compression and decompression for .ptz log containers.
+ */
+
+#include "CompressedLogFormat.h"
+
+#include <QFile>
+#include <QtEndian>
+
+#include <cstring>
+
+#ifdef POWERTUNE_HAVE_ZSTD
+    #include <zstd.h>
+#endif
+
+namespace {
+constexpr char MAGIC[8] = {'P', 'T', 'Z', 'B', 'L', 'K', '\0', '\1'};
+constexpr quint16 VERSION = 1;
+/// Fast levels: the writer runs on a Pi core next to the UI
+constexpr int ZLIB_LEVEL = 3;
+constexpr int ZSTD_LEVEL = 3;
+
+bool decodeBlock(CompressedLog::Codec codec, const QByteArray &stored, quint32 rawSize, QByteArray &raw)
+{
+    switch (codec) {
+    case CompressedLog::Codec::Zlib:
+        raw = qUncompress(stored);
+        return raw.size() == static_cast<qsizetype>(rawSize);
+#ifdef POWERTUNE_HAVE_ZSTD
+    case CompressedLog::Codec::Zstd: {
+        raw.resize(rawSize);
+        const size_t result = ZSTD_decompress(raw.data(), rawSize, stored.constData(), stored.size());
+        return !ZSTD_isError(result) && result == rawSize;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+}  // namespace
+
+namespace CompressedLog {
+
+bool isAvailable(Codec codec)
+{
+    switch (codec) {
+    case Codec::Zlib:
+        return true;
+    case Codec::Zstd:
+#ifdef POWERTUNE_HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return false;
+    }
+}
+
+QByteArray fileHeader(Codec codec)
+{
+    QByteArray header(FILE_HEADER_SIZE, '\0');
+    std::memcpy(header.data(), MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint16>(VERSION, header.data() + 8);
+    header[10] = static_cast<char>(codec);
+    return header;
+}
+
+bool appendBlock(QByteArray &out, Codec codec, const char *data, qsizetype size)
+{
+    const qsizetype start = out.size();
+    qsizetype stored = 0;
+
+    switch (codec) {
+    case Codec::Zlib: {
+        const QByteArray compressed = qCompress(reinterpret_cast<const uchar *>(data), size, ZLIB_LEVEL);
+        if (compressed.isEmpty())
+            return false;
+        out.resize(start + BLOCK_HEADER_SIZE);
+        out.append(compressed);
+        stored = compressed.size();
+        break;
+    }
+#ifdef POWERTUNE_HAVE_ZSTD
+    case Codec::Zstd: {
+        // Compress straight into the output buffer to avoid a second copy.
+        const size_t bound = ZSTD_compressBound(static_cast<size_t>(size));
+        out.resize(start + BLOCK_HEADER_SIZE + static_cast<qsizetype>(bound));
+        const size_t result = ZSTD_compress(out.data() + start + BLOCK_HEADER_SIZE, bound, data,
+                                            static_cast<size_t>(size), ZSTD_LEVEL);
+        if (ZSTD_isError(result)) {
+            out.resize(start);
+            return false;
+        }
+        stored = static_cast<qsizetype>(result);
+        out.resize(start + BLOCK_HEADER_SIZE + stored);
+        break;
+    }
+#endif
+    default:
+        return false;
+    }
+
+    qToLittleEndian<quint32>(static_cast<quint32>(size), out.data() + start);
+    qToLittleEndian<quint32>(static_cast<quint32>(stored), out.data() + start + 4);
+    return true;
+}
+
+bool isCompressed(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    const QByteArray head = file.read(sizeof(MAGIC));
+    return head.size() == sizeof(MAGIC) && std::memcmp(head.constData(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool decompressFile(const QString &inputPath, const QString &outputPath, QString *errorString, bool *truncated)
+{
+    const auto fail = [errorString](const QString &message) {
+        if (errorString)
+            *errorString = message;
+        return false;
+    };
+    if (truncated)
+        *truncated = false;
+
+    QFile in(inputPath);
+    if (!in.open(QIODevice::ReadOnly))
+        return fail(QStringLiteral("Cannot open %1: %2").arg(inputPath, in.errorString()));
+
+    const QByteArray header = in.read(FILE_HEADER_SIZE);
+    if (header.size() != FILE_HEADER_SIZE || std::memcmp(header.constData(), MAGIC, sizeof(MAGIC)) != 0
+        || qFromLittleEndian<quint16>(header.constData() + 8) != VERSION)
+        return fail(QStringLiteral("%1 is not a compressed PowerTune log").arg(inputPath));
+
+    const auto codec = static_cast<Codec>(header.at(10));
+    if (!isAvailable(codec))
+        return fail(QStringLiteral("%1 uses a codec this build does not support").arg(inputPath));
+
+    QFile out(outputPath);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return fail(QStringLiteral("Cannot open %1: %2").arg(outputPath, out.errorString()));
+
+    QByteArray stored;
+    QByteArray raw;
+    for (;;) {
+        const QByteArray blockHeader = in.read(BLOCK_HEADER_SIZE);
+        if (blockHeader.isEmpty())
+            break;
+
+        bool complete = blockHeader.size() == BLOCK_HEADER_SIZE;
+        if (complete) {
+            const quint32 rawSize = qFromLittleEndian<quint32>(blockHeader.constData());
+            const quint32 storedSize = qFromLittleEndian<quint32>(blockHeader.constData() + 4);
+            complete = rawSize <= MAX_BLOCK_SIZE && storedSize <= MAX_BLOCK_SIZE;
+            if (complete) {
+                stored = in.read(storedSize);
+                complete = stored.size() == static_cast<qsizetype>(storedSize)
+                           && decodeBlock(codec, stored, rawSize, raw);
+            }
+        }
+        if (!complete) {
+            if (truncated)
+                *truncated = true;
+            break;
+        }
+
+        if (out.write(raw) != raw.size())
+            return fail(QStringLiteral("Write to %1 failed: %2").arg(outputPath, out.errorString()));
+    }
+    return true;
+}
+
+}  // namespace CompressedLog
@@ -0,0 +1,76 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file CompressedLogFormat.h
+ * @brief Block-compressed container (.ptz) for data logs of any inner format.
+ *
+ * The logger's byte stream (CSV or .ptlog) is cut into blocks that are
+ * compressed independently, so a file cut short by power loss decodes up to
+ * its last complete block. Layout (little-endian):
+ *
+ *   Header, 16 bytes
+ *     char    magic[8]      "PTZBLK\0\1"
+ *     quint16 version       1
+ *     quint8  codec         1 = zlib, 2 = zstd
+ *     quint8  reserved[5]
+ *   Blocks
+ *     quint32 rawSize       uncompressed bytes in this block
+ *     quint32 storedSize    bytes of compressed payload that follow
+ *     payload               zlib: qCompress() output; zstd: one zstd frame
+ *
+ * zlib is always available through Qt; zstd is used when the build found
+ * libzstd (POWERTUNE_HAVE_ZSTD).
+ */
+
+#ifndef COMPRESSEDLOGFORMAT_H
+#define COMPRESSEDLOGFORMAT_H
+
+#include <QByteArray>
+#include <QString>
+
+namespace CompressedLog {
+enum class Codec : quint8 {
+    None = 0,
+    Zlib = 1,
+    Zstd = 2,
+};
+
+constexpr int FILE_HEADER_SIZE = 16;
+constexpr int BLOCK_HEADER_SIZE = 8;
+/// Largest block a reader accepts; guards against garbage sizes in a damaged tail
+constexpr quint32 MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+
+/// Appended to the inner file name, e.g. "log.ptlog.ptz"
+inline QString fileSuffix()
+{
+    return QStringLiteral(".ptz");
+}
+
+/// Whether @p codec can be used in this build
+bool isAvailable(Codec codec);
+
+/// File header for a container using @p codec
+QByteArray fileHeader(Codec codec);
+
+/**
+ * @brief Compress @p size bytes at @p data as one independent block and append it to @p out.
+ * @return false if the codec failed (nothing is appended)
+ */
+bool appendBlock(QByteArray &out, Codec codec, const char *data, qsizetype size);
+
+/// True if @p path starts with a container header
+bool isCompressed(const QString &path);
+
+/**
+ * @brief Decompress a container to @p outputPath.
+ *
+ * Decoding stops cleanly at the first incomplete or damaged block; everything
+ * before it is written and the call still succeeds.
+ * @param truncated Set when such a tail was dropped (may be null)
+ * @param errorString Receives a description on failure (may be null)
+ */
+bool decompressFile(const QString &inputPath, const QString &outputPath, QString *errorString = nullptr,
+                    bool *truncated = nullptr);
+}  // namespace CompressedLog
+
+#endif  // COMPRESSEDLOGFORMAT_H
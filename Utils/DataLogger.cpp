@@ -5,17 +5,107 @@
 #include "../Core/Models/ExpanderBoardData.h"
 #include "../Core/Models/TimingData.h"
 #include "../Core/Models/VehicleData.h"
+#include "../Core/PropertyRouter.h"
+#include "../Core/SensorRegistry.h"
+#include "../Core/TraceRecorder.h"
+#include "../Core/appsettings.h"
+#include "BinaryLogFormat.h"
+#include "BlackBoxRecorder.h"
+#include "CompressedLogFormat.h"
+#include "LogFormat.h"
+#include "LogJournal.h"
+#include "LogWriter.h"
 
-#include <QFile>
-#include <QTextStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QMetaMethod>
+#include <QThread>
+#include <QVariantMap>
+
+#include <array>
+#include <memory>
 
 namespace {
-qreal elapsedMs(const QTime &startTime)
+// CSV column layout, unchanged from the original QTextStream writer.
+constexpr int NUMERIC_COLUMNS = 36;
+constexpr int TEXT_COLUMNS = 3;
+constexpr int FIRST_DIGITAL_INPUT_COLUMN = 27;
+
+constexpr int MAX_CHANNEL_RATE_HZ = 500;
+constexpr int CHANNEL_BATCH_ROWS = 512;
+constexpr int CHANNEL_FLUSH_INTERVAL_MS = 250;
+/// Full snapshot of every channel, so playback can seek without replaying from the start
+constexpr int KEYFRAME_INTERVAL_MS = 1000;
+const QString CHANNEL_RATES_KEY = QStringLiteral("ui/logger/channelRates");
+
+constexpr int MAX_PRE_TRIGGER_SECONDS = 60;
+constexpr int MAX_POST_TRIGGER_SECONDS = 600;
+const QString TRIGGER_SETTINGS_KEY = QStringLiteral("ui/logger/trigger");
+
+/// Fixed so the file size only depends on the configured minutes
+constexpr int BLACK_BOX_RATE_HZ = 10;
+constexpr int MAX_BLACK_BOX_MINUTES = 30;
+const QString BLACK_BOX_SETTINGS_KEY = QStringLiteral("ui/logger/blackBox");
+const QString BLACK_BOX_FILE = QStringLiteral("blackbox.ptbb");
+
+QString compressionSuffix(int codec)
 {
-    return static_cast<qreal>(startTime.msecsTo(QTime::currentTime()));
+    return codec == 0 ? QString() : CompressedLog::fileSuffix();
 }
+
+/// Writer options shared by the fixed-column and registry channel logs
+LogWriter::Options writerOptions(const datalogger &logger)
+{
+    LogWriter::Options options;
+    options.fsyncPolicy = static_cast<LogWriter::FsyncPolicy>(logger.fsyncMode());
+    options.compression = static_cast<CompressedLog::Codec>(logger.compression());
+    options.segmentBytes = static_cast<qint64>(logger.segmentSizeMiB()) * 1024 * 1024;
+    options.segmentSeconds = logger.segmentMinutes() * 60;
+    options.diskBudgetBytes = static_cast<qint64>(logger.diskBudgetMiB()) * 1024 * 1024;
+    return options;
 }
 
+bool isNumericProperty(const QMetaProperty &property)
+{
+    switch (property.metaType().id()) {
+    case QMetaType::Double:
+    case QMetaType::Float:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Bool:
+        return true;
+    default:
+        return false;
+    }
+}
+
+QVector<LogColumn> logColumns()
+{
+    QVector<LogColumn> columns;
+    const auto add = [&columns](const QByteArray &name, bool isText = false) {
+        columns.append(LogColumn{name, isText});
+    };
+    for (const char *name : {"rpm", "power", "torque", "gear", "gear_calculation", "odo", "trip", "ex_speed",
+                             "ex_gear", "differential_sensor"})
+        add(name);
+    add("lap_time", true);
+    add("best_lap", true);
+    add("last_lap", true);
+    add("current_lap");
+    for (int i = 0; i < 8; ++i)
+        add("ex_an" + QByteArray::number(i));
+    for (int i = 0; i < 8; ++i)
+        add("ex_calc" + QByteArray::number(i));
+    for (int i = 1; i <= 8; ++i)
+        add("di" + QByteArray::number(i));
+    add("di1_freq");
+    return columns;
+}
+}  // namespace
+
 datalogger::datalogger(QObject *parent) : QObject(parent) {}
 
 datalogger::datalogger(EngineData *engineData, VehicleData *vehicleData, ExpanderBoardData *expanderBoardData,
@@ -28,79 +118,786 @@ datalogger::datalogger(EngineData *engineData, VehicleData *vehicleData, Expande
       m_timingData(timingData)
 {}
 
+datalogger::~datalogger()
+{
+    stopLog();
+    if (m_exportThread)
+        m_exportThread->wait();
+}
+
+bool datalogger::isLogging() const
+{
+    return m_writer && m_writer->isOpen();
+}
+
+void datalogger::setSampleRateHz(int hz)
+{
+    hz = qBound(1, hz, 100);
+    if (m_sampleRateHz == hz)
+        return;
+
+    m_sampleRateHz = hz;
+    if (m_updatetimer.isActive())
+        m_updatetimer.start(1000 / m_sampleRateHz);
+    if (m_preTriggerSeconds > 0)
+        resetPreTrigger();
+    emit sampleRateHzChanged();
+}
+
+void datalogger::setFsyncMode(int mode)
+{
+    mode = qBound(0, mode, 2);
+    if (m_fsyncMode == mode)
+        return;
+
+    m_fsyncMode = mode;
+    emit fsyncModeChanged();
+}
+
+void datalogger::setSensorRegistry(SensorRegistry *sensorRegistry)
+{
+    m_sensorRegistry = sensorRegistry;
+}
+
+void datalogger::setPropertyRouter(PropertyRouter *propertyRouter)
+{
+    m_propertyRouter = propertyRouter;
+    resolveTriggerSensor();
+}
+
+void datalogger::setAppSettings(AppSettings *appSettings)
+{
+    m_appSettings = appSettings;
+    if (!m_appSettings)
+        return;
+
+    m_channelRates.clear();
+    const QVariantMap rates = m_appSettings->getValue(CHANNEL_RATES_KEY).toMap();
+    for (auto it = rates.cbegin(); it != rates.cend(); ++it)
+        m_channelRates.insert(it.key(), it.value().toInt());
+
+    const QVariantMap blackBox = m_appSettings->getValue(BLACK_BOX_SETTINGS_KEY).toMap();
+    m_blackBoxEnabled = blackBox.value(QStringLiteral("enabled"), m_blackBoxEnabled).toBool();
+    m_blackBoxMinutes =
+        qBound(1, blackBox.value(QStringLiteral("minutes"), m_blackBoxMinutes).toInt(), MAX_BLACK_BOX_MINUTES);
+    applyBlackBox();
+    emit blackBoxChanged();
+
+    const QVariantMap trigger = m_appSettings->getValue(TRIGGER_SETTINGS_KEY).toMap();
+    if (trigger.isEmpty())
+        return;
+    m_preTriggerSeconds = qBound(0, trigger.value(QStringLiteral("preSeconds")).toInt(), MAX_PRE_TRIGGER_SECONDS);
+    m_postTriggerSeconds = qBound(1, trigger.value(QStringLiteral("postSeconds"), m_postTriggerSeconds).toInt(),
+                                  MAX_POST_TRIGGER_SECONDS);
+    m_triggerSensor = trigger.value(QStringLiteral("sensor")).toString();
+    m_triggerThreshold = trigger.value(QStringLiteral("threshold")).toDouble();
+    m_triggerAbove = trigger.value(QStringLiteral("above"), true).toBool();
+    m_triggerDigitalInput = qBound(0, trigger.value(QStringLiteral("digitalInput")).toInt(), 8);
+    resetPreTrigger();
+    resolveTriggerSensor();
+    updateSampling();
+    emit triggerChanged();
+}
+
+void datalogger::setChannelLogging(bool enabled)
+{
+    if (m_channelLogging == enabled)
+        return;
+    if (enabled && m_preTriggerSeconds > 0) {
+        // Channel logs are sparse per-sensor records; the pre-trigger ring holds fixed-column rows.
+        emit errorOccurred(QStringLiteral("Logger: channel logging cannot record a pre-trigger window; "
+                                          "set pre-trigger seconds to 0 first"));
+        emit channelLoggingChanged();
+        return;
+    }
+
+    m_channelLogging = enabled;
+    emit channelLoggingChanged();
+}
+
+int datalogger::channelRate(const QString &key) const
+{
+    return m_channelRates.value(key, 0);
+}
+
+void datalogger::setChannelRate(const QString &key, int hz)
+{
+    hz = qBound(0, hz, MAX_CHANNEL_RATE_HZ);
+    if (channelRate(key) == hz)
+        return;
+
+    if (hz == 0)
+        m_channelRates.remove(key);
+    else
+        m_channelRates.insert(key, hz);
+
+    if (m_appSettings) {
+        QVariantMap rates;
+        for (auto it = m_channelRates.cbegin(); it != m_channelRates.cend(); ++it)
+            rates.insert(it.key(), it.value());
+        m_appSettings->setValue(CHANNEL_RATES_KEY, rates);
+    }
+}
+
+void datalogger::setBinaryFormat(bool binary)
+{
+    if (m_binaryFormat == binary)
+        return;
+
+    m_binaryFormat = binary;
+    emit binaryFormatChanged();
+}
+
+bool datalogger::zstdAvailable() const
+{
+    return CompressedLog::isAvailable(CompressedLog::Codec::Zstd);
+}
+
+void datalogger::setCompression(int codec)
+{
+    codec = qBound(0, codec, 2);
+    if (m_compression == codec)
+        return;
+
+    m_compression = codec;
+    emit compressionChanged();
+}
+
+void datalogger::setSegmentSizeMiB(int mib)
+{
+    mib = qMax(0, mib);
+    if (m_segmentSizeMiB == mib)
+        return;
+
+    m_segmentSizeMiB = mib;
+    emit rotationChanged();
+}
+
+void datalogger::setSegmentMinutes(int minutes)
+{
+    minutes = qMax(0, minutes);
+    if (m_segmentMinutes == minutes)
+        return;
+
+    m_segmentMinutes = minutes;
+    emit rotationChanged();
+}
+
+void datalogger::setDiskBudgetMiB(int mib)
+{
+    mib = qMax(0, mib);
+    if (m_diskBudgetMiB == mib)
+        return;
+
+    m_diskBudgetMiB = mib;
+    emit rotationChanged();
+}
+
+void datalogger::recoverLogs(const QString &directory)
+{
+    const QStringList repaired = LogJournal::recoverDirectory(directory.isEmpty() ? QDir::currentPath() : directory);
+    for (const QString &description : repaired)
+        emit logRecovered(description);
+}
+
+void datalogger::exportCsv(const QString &binaryPath)
+{
+    const QString source = binaryPath.isEmpty() ? m_lastLogPath : binaryPath;
+    const bool compressed = source.endsWith(CompressedLog::fileSuffix());
+    if (!compressed && !source.endsWith(QStringLiteral(".ptlog"))) {
+        emit errorOccurred(QStringLiteral("Logger: no binary log to export"));
+        return;
+    }
+    if (m_exportThread) {
+        emit errorOccurred(QStringLiteral("Logger: CSV export already running"));
+        return;
+    }
+
+    // "x.ptlog", "x.ptlog.ptz" and "x.csv.ptz" all export to "x.csv".
+    const QFileInfo info(compressed ? source.chopped(CompressedLog::fileSuffix().size()) : source);
+    const QString target = info.path() + QLatin1Char('/') + info.completeBaseName() + QStringLiteral(".csv");
+    // Signals emitted from the export thread are queued to their GUI-thread receivers.
+    m_exportThread = QThread::create([this, source, target]() {
+        QString error;
+        if (BinaryLogReader::exportCsv(source, target, &error))
+            emit csvExported(target);
+        else
+            emit errorOccurred(QStringLiteral("Logger: CSV export failed: %1").arg(error));
+    });
+    m_exportThread->setObjectName(QStringLiteral("LogExport"));
+    connect(m_exportThread, &QThread::finished, this, [this]() {
+        m_exportThread->deleteLater();
+        m_exportThread = nullptr;
+    });
+    m_exportThread->start(QThread::LowPriority);
+}
+
 void datalogger::startLog(QString logFilename)
 {
+    if (openLog(std::move(logFilename)))
+        emit loggingChanged();
+}
+
+bool datalogger::openLog(QString logFilename)
+{
+    stopLog();
     m_logBasePath = std::move(logFilename);
-    m_loggerStartTime = QTime::currentTime();
-    createHeader();
-    connect(&m_updatetimer, &QTimer::timeout, this, &datalogger::updateLog, Qt::UniqueConnection);
-    m_updatetimer.start(100);
+    recoverLogs(QFileInfo(m_logBasePath).absolutePath());
+
+    if (!m_writer) {
+        m_writer = new LogWriter(this);
+        connect(m_writer, &LogWriter::errorOccurred, this, &datalogger::errorOccurred, Qt::QueuedConnection);
+    }
+
+    if (m_channelLogging && m_sensorRegistry && m_propertyRouter) {
+        // The setters keep the two apart; never drop an armed window without saying so.
+        if (m_preTriggerSeconds > 0) {
+            emit errorOccurred(QStringLiteral("Logger: pre-trigger window not supported with channel logging"));
+            return false;
+        }
+        return startChannelLog(m_logBasePath);
+    }
+
+    LogWriter::Options options = writerOptions(*this);
+    // Hand off roughly every 300 ms regardless of rate so the GUI thread only touches the lock a few times a second.
+    options.batchRows = qMax(1, m_sampleRateHz * 3 / 10);
+
+    // The armed window becomes the head of this log. Swapping it out is O(1)
+    // here; the writer thread transposes the frozen rows, with timestamps
+    // relative to the start of the log.
+    m_loggerClock.start();
+    if (m_preTriggerSeconds > 0 && m_preTrigger.size() > 0) {
+        m_frozenPreTrigger.swap(m_preTrigger);
+        if (m_preTrigger.capacity() != m_frozenPreTrigger.capacity())
+            m_preTrigger.reset(NUMERIC_COLUMNS, TEXT_COLUMNS, m_frozenPreTrigger.capacity());
+        else
+            m_preTrigger.clear();
+        const PreTriggerBuffer *window = &m_frozenPreTrigger;
+        const qint64 offsetMs = -m_armClock.elapsed();
+        options.prologue = [window, offsetMs](LogSampleBatch &batch) { window->copyTo(batch, offsetMs); };
+    }
+
+    std::unique_ptr<LogFormatter> formatter;
+    if (m_binaryFormat)
+        formatter = std::make_unique<BinaryLogFormatter>();
+    else
+        formatter = std::make_unique<CsvLogFormatter>();
+    const QString path = m_logBasePath + formatter->fileExtension() + compressionSuffix(m_compression);
+    if (!m_writer->open(path, logColumns(), std::move(formatter), options))
+        return false;
+
+    m_lastLogPath = path;
+
+    updateSampling();
+    return true;
 }
 
 void datalogger::stopLog()
 {
-    m_updatetimer.stop();
+    m_postTriggerTimer.stop();
+    stopChannelLog();
+    if (isLogging()) {
+        m_writer->close();
+        emit loggingChanged();
+    }
+    if (m_preTriggerSeconds == 0)
+        m_frozenPreTrigger.release();
+    updateSampling();
 }
 
-void datalogger::createHeader()
+void datalogger::updateSampling()
 {
-    QFile file(m_logBasePath + ".csv");
-    if (!file.open(QFile::WriteOnly | QFile::Text))
+    // Fixed-column logs and the armed pre-trigger ring share the sample timer.
+    const bool fixedLog = isLogging() && m_channels.isEmpty();
+    if (!fixedLog && m_preTriggerSeconds == 0) {
+        m_updatetimer.stop();
         return;
+    }
+    connect(&m_updatetimer, &QTimer::timeout, this, &datalogger::updateLog, Qt::UniqueConnection);
+    m_updatetimer.setTimerType(Qt::PreciseTimer);
+    if (!m_updatetimer.isActive())
+        m_updatetimer.start(1000 / m_sampleRateHz);
+}
+
+QString datalogger::writerStatsText() const
+{
+    const QString armed = m_preTriggerSeconds == 0
+                              ? QString()
+                              : QStringLiteral("\npre-trigger %1/%2 rows, %3 KiB")
+                                    .arg(m_preTrigger.size())
+                                    .arg(m_preTrigger.capacity())
+                                    .arg((m_preTrigger.memoryBytes() + m_frozenPreTrigger.memoryBytes()) / 1024);
+    const QString blackBox = !m_blackBox.isOpen()
+                                 ? QString()
+                                 : QStringLiteral("\nblack box %1 records, %2 KiB ring, %3 write-backs")
+                                       .arg(m_blackBox.recordsWritten())
+                                       .arg(m_blackBox.fileSize() / 1024)
+                                       .arg(m_blackBox.flushes());
+    if (!m_writer)
+        return QStringLiteral("Not started") + armed + blackBox;
 
-    QTextStream out(&file);
-    out << "time_ms,rpm,power,torque,gear,gear_calculation,odo,trip,ex_speed,ex_gear,differential_sensor,"
-           "lap_time,best_lap,last_lap,current_lap,"
-           "ex_an0,ex_an1,ex_an2,ex_an3,ex_an4,ex_an5,ex_an6,ex_an7,"
-           "ex_calc0,ex_calc1,ex_calc2,ex_calc3,ex_calc4,ex_calc5,ex_calc6,ex_calc7,"
-           "di1,di2,di3,di4,di5,di6,di7,di8,di1_freq\n";
+    const LogWriter::Stats stats = m_writer->stats();
+    QString text = QStringLiteral("%1 rows, %2 KiB in %3 writes, %4 fsyncs, worst write %5 ms")
+                       .arg(stats.rowsWritten)
+                       .arg(stats.bytesWritten / 1024)
+                       .arg(stats.blockWrites)
+                       .arg(stats.fsyncs)
+                       .arg(stats.worstWriteUs / 1000.0, 0, 'f', 2);
+    if (stats.rowsDropped > 0)
+        text += QStringLiteral(", %1 rows dropped (writer behind)").arg(stats.rowsDropped);
+    if (stats.compressCpuUs > 0 && stats.bytesWritten > 0) {
+        const double rawMiB = stats.rawBytes / (1024.0 * 1024.0);
+        text += QStringLiteral("\ncompression %1:1, %2 ms CPU (%3 ms/MiB)")
+                    .arg(static_cast<double>(stats.rawBytes) / stats.bytesWritten, 0, 'f', 1)
+                    .arg(stats.compressCpuUs / 1000.0, 0, 'f', 0)
+                    .arg(rawMiB > 0.0 ? stats.compressCpuUs / 1000.0 / rawMiB : 0.0, 0, 'f', 1);
+    }
+    if (stats.rawBytes > 0) {
+        // Device bytes come from the kernel's per-thread I/O accounting when available.
+        const bool measured = stats.deviceBytes > 0;
+        const double physical = measured ? stats.deviceBytes : stats.bytesWritten + stats.journalBytes;
+        text += QStringLiteral("\nsegment %1, write amplification %2x (%3), worst sync %4 ms, pruned %5 MiB")
+                    .arg(stats.segments)
+                    .arg(physical / stats.rawBytes, 0, 'f', 2)
+                    .arg(measured ? QStringLiteral("device") : QStringLiteral("file + journal"))
+                    .arg(stats.worstSyncUs / 1000.0, 0, 'f', 2)
+                    .arg(stats.prunedBytes / (1024.0 * 1024.0), 0, 'f', 1);
+    }
+    return text + armed + blackBox;
 }
 
 void datalogger::updateLog()
 {
-    QFile file(m_logBasePath + ".csv");
-    if (!file.open(QFile::Append | QFile::Text))
-        return;
-
-    QTextStream out(&file);
-    out << elapsedMs(m_loggerStartTime) << ","
-        << (m_engineData ? m_engineData->rpm() : 0.0) << ","
-        << (m_engineData ? m_engineData->Power() : 0.0) << ","
-        << (m_engineData ? m_engineData->Torque() : 0.0) << ","
-        << (m_vehicleData ? m_vehicleData->Gear() : 0) << ","
-        << (m_vehicleData ? m_vehicleData->GearCalculation() : 0.0) << ","
-        << (m_vehicleData ? m_vehicleData->Odo() : 0.0) << ","
-        << (m_vehicleData ? m_vehicleData->Trip() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXSpeed() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXGear() : 0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->differentialSensor() : 0.0) << ","
-        << (m_timingData ? m_timingData->laptime() : QString()) << ","
-        << (m_timingData ? m_timingData->bestlaptime() : QString()) << ","
-        << (m_timingData ? m_timingData->Lastlaptime() : QString()) << ","
-        << (m_timingData ? m_timingData->currentLap() : 0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogInput0() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogInput1() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogInput2() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogInput3() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogInput4() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogInput5() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogInput6() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogInput7() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogCalc0() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogCalc1() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogCalc2() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogCalc3() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogCalc4() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogCalc5() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogCalc6() : 0.0) << ","
-        << (m_expanderBoardData ? m_expanderBoardData->EXAnalogCalc7() : 0.0) << ","
-        << (m_digitalInputs ? m_digitalInputs->EXDigitalInput1() : 0) << ","
-        << (m_digitalInputs ? m_digitalInputs->EXDigitalInput2() : 0) << ","
-        << (m_digitalInputs ? m_digitalInputs->EXDigitalInput3() : 0) << ","
-        << (m_digitalInputs ? m_digitalInputs->EXDigitalInput4() : 0) << ","
-        << (m_digitalInputs ? m_digitalInputs->EXDigitalInput5() : 0) << ","
-        << (m_digitalInputs ? m_digitalInputs->EXDigitalInput6() : 0) << ","
-        << (m_digitalInputs ? m_digitalInputs->EXDigitalInput7() : 0) << ","
-        << (m_digitalInputs ? m_digitalInputs->EXDigitalInput8() : 0) << ","
-        << (m_digitalInputs ? m_digitalInputs->frequencyDIEX1() : 0.0) << "\n";
+    PT_TRACE_SCOPE("logger.updateLog");
+    const bool fixedLog = isLogging() && m_channels.isEmpty();
+    const bool armed = m_preTriggerSeconds > 0;
+    if (!fixedLog && !armed)
+        return;
+
+    // Snapshot only; formatting and I/O happen on the writer thread.
+    std::array<double, NUMERIC_COLUMNS> numeric{};
+    std::array<QString, TEXT_COLUMNS> text;
+    snapshot(numeric.data(), text.data());
+
+    if (armed) {
+        m_preTrigger.append(m_armClock.elapsed(), numeric.data(), text.data());
+        // A capture started here already holds this sample in its pre-trigger window.
+        if (checkTriggers(numeric.data()))
+            return;
+    }
+    if (fixedLog)
+        m_writer->appendRow(m_loggerClock.elapsed(), numeric.data(), text.data());
+}
+
+void datalogger::snapshot(double *numeric, QString *text) const
+{
+    if (m_engineData) {
+        numeric[0] = m_engineData->rpm();
+        numeric[1] = m_engineData->Power();
+        numeric[2] = m_engineData->Torque();
+    }
+    if (m_vehicleData) {
+        numeric[3] = m_vehicleData->Gear();
+        numeric[4] = m_vehicleData->GearCalculation();
+        numeric[5] = m_vehicleData->Odo();
+        numeric[6] = m_vehicleData->Trip();
+    }
+    if (m_expanderBoardData) {
+        numeric[7] = m_expanderBoardData->EXSpeed();
+        numeric[8] = m_expanderBoardData->EXGear();
+        numeric[9] = m_expanderBoardData->differentialSensor();
+    }
+    if (m_timingData) {
+        if (text) {
+            text[0] = m_timingData->laptime();
+            text[1] = m_timingData->bestlaptime();
+            text[2] = m_timingData->Lastlaptime();
+        }
+        numeric[10] = m_timingData->currentLap();
+    }
+    int n = 11;
+    if (m_expanderBoardData) {
+        const ExpanderBoardData *ex = m_expanderBoardData;
+        for (qreal value : {ex->EXAnalogInput0(), ex->EXAnalogInput1(), ex->EXAnalogInput2(), ex->EXAnalogInput3(),
+                            ex->EXAnalogInput4(), ex->EXAnalogInput5(), ex->EXAnalogInput6(), ex->EXAnalogInput7(),
+                            ex->EXAnalogCalc0(), ex->EXAnalogCalc1(), ex->EXAnalogCalc2(), ex->EXAnalogCalc3(),
+                            ex->EXAnalogCalc4(), ex->EXAnalogCalc5(), ex->EXAnalogCalc6(), ex->EXAnalogCalc7()})
+            numeric[n++] = value;
+    }
+    n = FIRST_DIGITAL_INPUT_COLUMN;
+    if (m_digitalInputs) {
+        const DigitalInputs *di = m_digitalInputs;
+        for (qreal value : {di->EXDigitalInput1(), di->EXDigitalInput2(), di->EXDigitalInput3(), di->EXDigitalInput4(),
+                          di->EXDigitalInput5(), di->EXDigitalInput6(), di->EXDigitalInput7(), di->EXDigitalInput8()})
+            numeric[n++] = value;
+        numeric[n] = di->frequencyDIEX1();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Pre-trigger capture
+// ---------------------------------------------------------------------------
+
+void datalogger::setPreTriggerSeconds(int seconds)
+{
+    seconds = qBound(0, seconds, MAX_PRE_TRIGGER_SECONDS);
+    if (m_preTriggerSeconds == seconds)
+        return;
+    if (seconds > 0 && m_channelLogging) {
+        emit errorOccurred(QStringLiteral("Logger: a pre-trigger window cannot be recorded into a channel log; "
+                                          "turn channel logging off first"));
+        emit triggerChanged();
+        return;
+    }
+
+    m_preTriggerSeconds = seconds;
+    resetPreTrigger();
+    updateSampling();
+    saveTriggerSettings();
+    emit triggerChanged();
+}
+
+void datalogger::setPostTriggerSeconds(int seconds)
+{
+    seconds = qBound(1, seconds, MAX_POST_TRIGGER_SECONDS);
+    if (m_postTriggerSeconds == seconds)
+        return;
+
+    m_postTriggerSeconds = seconds;
+    saveTriggerSettings();
+    emit triggerChanged();
+}
+
+void datalogger::setTriggerSensor(const QString &key)
+{
+    if (m_triggerSensor == key)
+        return;
+
+    m_triggerSensor = key;
+    resolveTriggerSensor();
+    saveTriggerSettings();
+    emit triggerChanged();
+}
+
+void datalogger::setTriggerThreshold(double threshold)
+{
+    if (m_triggerThreshold == threshold)
+        return;
+
+    m_triggerThreshold = threshold;
+    saveTriggerSettings();
+    emit triggerChanged();
+}
+
+void datalogger::setTriggerAbove(bool above)
+{
+    if (m_triggerAbove == above)
+        return;
+
+    m_triggerAbove = above;
+    saveTriggerSettings();
+    emit triggerChanged();
+}
+
+void datalogger::setTriggerDigitalInput(int input)
+{
+    input = qBound(0, input, 8);
+    if (m_triggerDigitalInput == input)
+        return;
+
+    m_triggerDigitalInput = input;
+    m_triggerConditionMet = false;
+    saveTriggerSettings();
+    emit triggerChanged();
+}
+
+void datalogger::trigger()
+{
+    if (isLogging()) {
+        emit errorOccurred(QStringLiteral("Logger: already logging, trigger ignored"));
+        return;
+    }
+    fireTrigger(QStringLiteral("manual"));
+}
+
+void datalogger::resetPreTrigger()
+{
+    if (m_preTriggerSeconds == 0) {
+        m_preTrigger.release();
+        // The frozen window may still be read by the writer thread; stopLog() frees it.
+        if (!isLogging())
+            m_frozenPreTrigger.release();
+        return;
+    }
+    // All memory is taken here; appending while armed never allocates.
+    m_preTrigger.reset(NUMERIC_COLUMNS, TEXT_COLUMNS, m_preTriggerSeconds * m_sampleRateHz);
+    m_armClock.start();
+}
+
+void datalogger::resolveTriggerSensor()
+{
+    m_triggerModel = nullptr;
+    m_triggerProperty = QMetaProperty();
+    m_triggerConditionMet = false;
+
+    QObject *model = nullptr;
+    int propertyIndex = -1;
+    if (m_triggerSensor.isEmpty() || !m_propertyRouter
+        || !m_propertyRouter->resolveProperty(m_triggerSensor, &model, &propertyIndex))
+        return;
+    const QMetaProperty property = model->metaObject()->property(propertyIndex);
+    if (!isNumericProperty(property))
+        return;
+    m_triggerModel = model;
+    m_triggerProperty = property;
+}
+
+bool datalogger::checkTriggers(const double *numeric)
+{
+    const bool inputHigh =
+        m_triggerDigitalInput > 0 && numeric[FIRST_DIGITAL_INPUT_COLUMN + m_triggerDigitalInput - 1] > 0.5;
+    double value = 0.0;
+    bool sensorMet = false;
+    if (m_triggerModel) {
+        value = m_triggerProperty.read(m_triggerModel).toDouble();
+        sensorMet = m_triggerAbove ? value > m_triggerThreshold : value < m_triggerThreshold;
+    }
+
+    // Fire on the rising edge only, so a condition that stays true does not retrigger.
+    const bool met = inputHigh || sensorMet;
+    const bool rising = met && !m_triggerConditionMet;
+    m_triggerConditionMet = met;
+    if (!rising || isLogging())
+        return false;
+
+    if (inputHigh)
+        fireTrigger(QStringLiteral("digital input %1").arg(m_triggerDigitalInput));
+    else
+        fireTrigger(QStringLiteral("%1 = %2").arg(m_triggerSensor).arg(value));
+    return isLogging();
+}
+
+void datalogger::fireTrigger(const QString &reason)
+{
+    const QString directory =
+        m_logBasePath.isEmpty() ? QDir::currentPath() : QFileInfo(m_logBasePath).absolutePath();
+    if (!openLog(directory + QStringLiteral("/Trigger_")
+                 + QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd_HHmmss"))))
+        return;
+
+    connect(&m_postTriggerTimer, &QTimer::timeout, this, &datalogger::stopLog, Qt::UniqueConnection);
+    m_postTriggerTimer.setSingleShot(true);
+    m_postTriggerTimer.start(m_postTriggerSeconds * 1000);
+    // Once, after the capture timer runs, so "logging" and "capturing" update together.
+    emit loggingChanged();
+    emit triggered(reason, m_lastLogPath);
+}
+
+void datalogger::saveTriggerSettings()
+{
+    if (!m_appSettings)
+        return;
+
+    QVariantMap trigger;
+    trigger.insert(QStringLiteral("preSeconds"), m_preTriggerSeconds);
+    trigger.insert(QStringLiteral("postSeconds"), m_postTriggerSeconds);
+    trigger.insert(QStringLiteral("sensor"), m_triggerSensor);
+    trigger.insert(QStringLiteral("threshold"), m_triggerThreshold);
+    trigger.insert(QStringLiteral("above"), m_triggerAbove);
+    trigger.insert(QStringLiteral("digitalInput"), m_triggerDigitalInput);
+    m_appSettings->setValue(TRIGGER_SETTINGS_KEY, trigger);
+}
+
+// ---------------------------------------------------------------------------
+// Black box
+// ---------------------------------------------------------------------------
+
+void datalogger::setBlackBoxEnabled(bool enabled)
+{
+    if (m_blackBoxEnabled == enabled)
+        return;
+
+    m_blackBoxEnabled = enabled;
+    applyBlackBox();
+    emit blackBoxChanged();
+}
+
+void datalogger::setBlackBoxMinutes(int minutes)
+{
+    minutes = qBound(1, minutes, MAX_BLACK_BOX_MINUTES);
+    if (m_blackBoxMinutes == minutes)
+        return;
+
+    m_blackBoxMinutes = minutes;
+    applyBlackBox();
+    emit blackBoxChanged();
+}
+
+void datalogger::applyBlackBox()
+{
+    m_blackBoxTimer.stop();
+    m_blackBox.close();
+    if (!m_appSettings)
+        return;
+
+    QVariantMap settings;
+    settings.insert(QStringLiteral("enabled"), m_blackBoxEnabled);
+    settings.insert(QStringLiteral("minutes"), m_blackBoxMinutes);
+    m_appSettings->setValue(BLACK_BOX_SETTINGS_KEY, settings);
+    if (!m_blackBoxEnabled)
+        return;
+
+    const int capacity = m_blackBoxMinutes * 60 * BLACK_BOX_RATE_HZ;
+    if (!m_blackBox.open(QDir::current().filePath(BLACK_BOX_FILE), logColumns(), capacity, BLACK_BOX_RATE_HZ)) {
+        emit errorOccurred(QStringLiteral("Logger: %1").arg(m_blackBox.errorString()));
+        return;
+    }
+    connect(&m_blackBoxTimer, &QTimer::timeout, this, &datalogger::sampleBlackBox, Qt::UniqueConnection);
+    m_blackBoxTimer.start(1000 / BLACK_BOX_RATE_HZ);
+}
+
+void datalogger::sampleBlackBox()
+{
+    PT_TRACE_SCOPE("logger.blackBox");
+    std::array<double, NUMERIC_COLUMNS> numeric{};
+    snapshot(numeric.data(), nullptr);
+    m_blackBox.append(QDateTime::currentMSecsSinceEpoch(), numeric.data());
+}
+
+// ---------------------------------------------------------------------------
+// Registry channel logging
+// ---------------------------------------------------------------------------
+
+bool datalogger::startChannelLog(const QString &basePath)
+{
+    QVector<LogColumn> columns;
+    m_channels.clear();
+    const QStringList keys = m_sensorRegistry->sensorKeys();
+    for (const QString &key : keys) {
+        LogChannel channel;
+        int propertyIndex = -1;
+        if (!m_propertyRouter->resolveProperty(key, &channel.model, &propertyIndex))
+            continue;
+        channel.property = channel.model->metaObject()->property(propertyIndex);
+        if (!isNumericProperty(channel.property))
+            continue;
+        channel.rateHz = channelRate(key);
+        m_channels.append(channel);
+        columns.append(LogColumn{key.toUtf8(), false});
+    }
+    if (m_channels.isEmpty()) {
+        emit errorOccurred(QStringLiteral("Logger: no registry channels to log"));
+        return false;
+    }
+
+    LogWriter::Options options = writerOptions(*this);
+    options.batchRows = CHANNEL_BATCH_ROWS;
+
+    auto formatter = std::make_unique<BinaryLogFormatter>(BinaryLogFormatter::Layout::Sparse);
+    const QString path = basePath + formatter->fileExtension() + compressionSuffix(m_compression);
+    if (!m_writer->open(path, columns, std::move(formatter), options)) {
+        m_channels.clear();
+        return false;
+    }
+    m_lastLogPath = path;
+    m_loggerClock.start();
+
+    // On-change channels hang off their model's NOTIFY signal; fixed-rate
+    // channels are grouped into one timer per rate. Channels without a NOTIFY
+    // signal are polled at the logger sample rate and written on change.
+    const QMetaMethod relay = metaObject()->method(metaObject()->indexOfSlot("onChannelChanged()"));
+    QHash<int, QVector<int>> rateGroups;
+    QVector<int> polled;
+    writeKeyframe();
+    for (int i = 0; i < m_channels.size(); ++i) {
+        const LogChannel &channel = m_channels.at(i);
+        if (channel.rateHz > 0) {
+            rateGroups[channel.rateHz].append(i);
+        } else if (channel.property.hasNotifySignal()) {
+            const QMetaMethod notify = channel.property.notifySignal();
+            connect(channel.model, notify, this, relay, Qt::UniqueConnection);
+            m_channelsBySignal[channel.model][notify.methodIndex()].append(i);
+        } else {
+            polled.append(i);
+        }
+    }
+
+    const auto addTimer = [this](int hz, const QVector<int> &group, bool onlyIfChanged) {
+        auto *timer = new QTimer(this);
+        timer->setTimerType(Qt::PreciseTimer);
+        connect(timer, &QTimer::timeout, this, [this, group, onlyIfChanged]() {
+            for (int channel : group)
+                sampleChannel(channel, onlyIfChanged);
+        });
+        timer->start(qMax(1, 1000 / hz));
+        m_rateTimers.append(timer);
+    };
+    for (auto it = rateGroups.cbegin(); it != rateGroups.cend(); ++it)
+        addTimer(it.key(), it.value(), false);
+    if (!polled.isEmpty())
+        addTimer(m_sampleRateHz, polled, true);
+
+    auto *keyframeTimer = new QTimer(this);
+    connect(keyframeTimer, &QTimer::timeout, this, &datalogger::writeKeyframe);
+    keyframeTimer->start(KEYFRAME_INTERVAL_MS);
+    m_rateTimers.append(keyframeTimer);
+
+    // Slow channels alone may never fill a batch; hand off on a timer as well.
+    connect(&m_flushTimer, &QTimer::timeout, m_writer, &LogWriter::flush, Qt::UniqueConnection);
+    m_flushTimer.start(CHANNEL_FLUSH_INTERVAL_MS);
+    return true;
+}
+
+void datalogger::stopChannelLog()
+{
+    m_flushTimer.stop();
+    qDeleteAll(m_rateTimers);
+    m_rateTimers.clear();
+
+    const QMetaMethod relay = metaObject()->method(metaObject()->indexOfSlot("onChannelChanged()"));
+    for (auto modelIt = m_channelsBySignal.cbegin(); modelIt != m_channelsBySignal.cend(); ++modelIt) {
+        QObject *model = modelIt.key();
+        for (auto signalIt = modelIt->cbegin(); signalIt != modelIt->cend(); ++signalIt)
+            disconnect(model, model->metaObject()->method(signalIt.key()), this, relay);
+    }
+    m_channelsBySignal.clear();
+    m_channels.clear();
+}
+
+void datalogger::onChannelChanged()
+{
+    PT_TRACE_SCOPE("logger.channelChanged");
+    const auto modelIt = m_channelsBySignal.constFind(sender());
+    if (modelIt == m_channelsBySignal.constEnd())
+        return;
+
+    const auto signalIt = modelIt->constFind(senderSignalIndex());
+    if (signalIt == modelIt->constEnd())
+        return;
+
+    for (int channel : *signalIt)
+        sampleChannel(channel, true);
+}
+
+void datalogger::sampleChannel(int channel, bool onlyIfChanged)
+{
+    LogChannel &entry = m_channels[channel];
+    const double value = entry.property.read(entry.model).toDouble();
+    if (onlyIfChanged && entry.hasValue && value == entry.lastValue)
+        return;
+
+    entry.lastValue = value;
+    entry.hasValue = true;
+    const double record[2] = {static_cast<double>(channel), value};
+    m_writer->appendRow(m_loggerClock.nsecsElapsed() / 1000, record, nullptr);
+}
+
+void datalogger::writeKeyframe()
+{
+    // Marker followed by the current value of every channel (see BinaryLogFormat.h).
+    const double marker[2] = {static_cast<double>(BinaryLogFormatter::KEYFRAME_CHANNEL),
+                              static_cast<double>(m_channels.size())};
+    m_writer->appendRow(m_loggerClock.nsecsElapsed() / 1000, marker, nullptr);
+    for (int i = 0; i < m_channels.size(); ++i)
+        sampleChannel(i, false);
 }
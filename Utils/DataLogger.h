@@ -1,9 +1,15 @@
 #ifndef DATALOGGER_H
 #define DATALOGGER_H
+#include "BlackBoxRecorder.h"
+#include "PreTriggerBuffer.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMetaProperty>
 #include <QObject>
-#include <QThread>
-#include <QTime>
 #include <QTimer>
+#include <QVector>
 
 class datalogger;
 
@@ -12,35 +18,253 @@ class VehicleData;
 class ExpanderBoardData;
 class DigitalInputs;
 class TimingData;
+class LogWriter;
+class AppSettings;
+class PropertyRouter;
+class SensorRegistry;
+class QThread;
 
 class datalogger : public QObject
 {
     Q_OBJECT
+    Q_PROPERTY(bool logging READ isLogging NOTIFY loggingChanged)
+    Q_PROPERTY(int sampleRateHz READ sampleRateHz WRITE setSampleRateHz NOTIFY sampleRateHzChanged)
+    Q_PROPERTY(int fsyncMode READ fsyncMode WRITE setFsyncMode NOTIFY fsyncModeChanged)
+    Q_PROPERTY(bool binaryFormat READ binaryFormat WRITE setBinaryFormat NOTIFY binaryFormatChanged)
+    Q_PROPERTY(int compression READ compression WRITE setCompression NOTIFY compressionChanged)
+    Q_PROPERTY(bool zstdAvailable READ zstdAvailable CONSTANT)
+    Q_PROPERTY(int segmentSizeMiB READ segmentSizeMiB WRITE setSegmentSizeMiB NOTIFY rotationChanged)
+    Q_PROPERTY(int segmentMinutes READ segmentMinutes WRITE setSegmentMinutes NOTIFY rotationChanged)
+    Q_PROPERTY(int diskBudgetMiB READ diskBudgetMiB WRITE setDiskBudgetMiB NOTIFY rotationChanged)
+    Q_PROPERTY(QString lastLogPath READ lastLogPath NOTIFY loggingChanged)
+    Q_PROPERTY(bool channelLogging READ channelLogging WRITE setChannelLogging NOTIFY channelLoggingChanged)
+    Q_PROPERTY(int channelCount READ channelCount NOTIFY loggingChanged)
+    Q_PROPERTY(int preTriggerSeconds READ preTriggerSeconds WRITE setPreTriggerSeconds NOTIFY triggerChanged)
+    Q_PROPERTY(int postTriggerSeconds READ postTriggerSeconds WRITE setPostTriggerSeconds NOTIFY triggerChanged)
+    Q_PROPERTY(QString triggerSensor READ triggerSensor WRITE setTriggerSensor NOTIFY triggerChanged)
+    Q_PROPERTY(double triggerThreshold READ triggerThreshold WRITE setTriggerThreshold NOTIFY triggerChanged)
+    Q_PROPERTY(bool triggerAbove READ triggerAbove WRITE setTriggerAbove NOTIFY triggerChanged)
+    Q_PROPERTY(int triggerDigitalInput READ triggerDigitalInput WRITE setTriggerDigitalInput NOTIFY triggerChanged)
+    Q_PROPERTY(bool capturing READ isCapturing NOTIFY loggingChanged)
+    Q_PROPERTY(bool blackBoxEnabled READ blackBoxEnabled WRITE setBlackBoxEnabled NOTIFY blackBoxChanged)
+    Q_PROPERTY(int blackBoxMinutes READ blackBoxMinutes WRITE setBlackBoxMinutes NOTIFY blackBoxChanged)
 
 
 public:
     explicit datalogger(QObject *parent = nullptr);
     explicit datalogger(EngineData *engineData, VehicleData *vehicleData, ExpanderBoardData *expanderBoardData,
                         DigitalInputs *digitalInputs, TimingData *timingData, QObject *parent = nullptr);
+    ~datalogger() override;
     Q_INVOKABLE void startLog(QString Logfilename);
     Q_INVOKABLE void stopLog();
 
+    bool isLogging() const;
+    int sampleRateHz() const { return m_sampleRateHz; }
+    int fsyncMode() const { return m_fsyncMode; }
+    bool binaryFormat() const { return m_binaryFormat; }
+    int compression() const { return m_compression; }
+    int segmentSizeMiB() const { return m_segmentSizeMiB; }
+    int segmentMinutes() const { return m_segmentMinutes; }
+    int diskBudgetMiB() const { return m_diskBudgetMiB; }
+    bool zstdAvailable() const;
+    QString lastLogPath() const { return m_lastLogPath; }
+    bool channelLogging() const { return m_channelLogging; }
+    int channelCount() const { return static_cast<int>(m_channels.size()); }
+    int preTriggerSeconds() const { return m_preTriggerSeconds; }
+    int postTriggerSeconds() const { return m_postTriggerSeconds; }
+    QString triggerSensor() const { return m_triggerSensor; }
+    double triggerThreshold() const { return m_triggerThreshold; }
+    bool triggerAbove() const { return m_triggerAbove; }
+    int triggerDigitalInput() const { return m_triggerDigitalInput; }
+    bool isCapturing() const { return m_postTriggerTimer.isActive(); }
+    bool blackBoxEnabled() const { return m_blackBoxEnabled; }
+    int blackBoxMinutes() const { return m_blackBoxMinutes; }
+
+    void setSensorRegistry(SensorRegistry *sensorRegistry);
+    void setPropertyRouter(PropertyRouter *propertyRouter);
+    void setAppSettings(AppSettings *appSettings);
+
+    /// Sample rate in Hz (1-100), applied immediately when logging
+    void setSampleRateHz(int hz);
+    /// 0 = never, 1 = periodic (default), 2 = every block; applied on the next startLog()
+    void setFsyncMode(int mode);
+    /// Write compact .ptlog files instead of CSV; applied on the next startLog()
+    void setBinaryFormat(bool binary);
+    /// 0 = off, 1 = zlib, 2 = zstd (falls back to zlib if unavailable); adds .ptz, applied on the next startLog()
+    void setCompression(int codec);
+    /// Start a new numbered segment file at this size / age (0 = off); applied on the next startLog()
+    void setSegmentSizeMiB(int mib);
+    void setSegmentMinutes(int minutes);
+    /// Keep the log directory under this size by deleting the oldest sessions (0 = off)
+    void setDiskBudgetMiB(int mib);
+
+    /**
+     * @brief Repair logs left open by a power cut in @p directory (default: working directory).
+     *
+     * Preallocated segments are trimmed to the last record their journal
+     * confirmed; emits logRecovered() for each one.
+     */
+    void recoverLogs(const QString &directory = QString());
+
+    /**
+     * @brief Convert a .ptlog (or compressed .ptz) file to CSV next to it, on a background thread.
+     * @param binaryPath Log to convert; defaults to the last log written
+     *
+     * Emits csvExported() or errorOccurred() when done.
+     */
+    Q_INVOKABLE void exportCsv(const QString &binaryPath = QString());
+
+    /**
+     * @brief Log every SensorRegistry channel as sparse change records (.ptlog).
+     *
+     * The channel list is taken from the registry at startLog(). Each channel
+     * is written either when it changes or at its own fixed rate (see
+     * setChannelRate()), with its own timestamp. Applied on the next startLog().
+     */
+    void setChannelLogging(bool enabled);
+
+    /// Fixed sample rate for @p key in Hz, or 0 to log on change (default)
+    Q_INVOKABLE int channelRate(const QString &key) const;
+    Q_INVOKABLE void setChannelRate(const QString &key, int hz);
+
+    /**
+     * @brief Keep the last @p seconds of samples in memory while not logging (0 = off).
+     *
+     * Every startLog() then begins with that window, timestamped relative to
+     * the start (negative times). Not used with channel logging.
+     */
+    void setPreTriggerSeconds(int seconds);
+    /// Length of a triggered capture after the trigger
+    void setPostTriggerSeconds(int seconds);
+    /// Registry key compared against the threshold on every sample (empty = off)
+    void setTriggerSensor(const QString &key);
+    void setTriggerThreshold(double threshold);
+    /// Fire when the sensor rises above (true) or drops below (false) the threshold
+    void setTriggerAbove(bool above);
+    /// Fire when expander digital input 1-8 goes high (0 = off)
+    void setTriggerDigitalInput(int input);
+
+    /**
+     * @brief Start a capture now: pre-trigger window plus postTriggerSeconds, then stop.
+     *
+     * Conditions fire this automatically on their rising edge while armed and
+     * not already logging. The file is "Trigger_<date>_<time>" next to the
+     * last log, in the configured format.
+     */
+    Q_INVOKABLE void trigger();
+
+    /**
+     * @brief Keep the last minutes of the logger columns in blackbox.ptbb, always (default on).
+     *
+     * Independent of startLog(). The file is memory-mapped and survives a
+     * power cut; extract it with ptblackbox. Applied immediately once
+     * AppSettings is set.
+     */
+    void setBlackBoxEnabled(bool enabled);
+    void setBlackBoxMinutes(int minutes);
+
+    /// Writer statistics for the diagnostics page
+    Q_INVOKABLE QString writerStatsText() const;
+
+signals:
+    void loggingChanged();
+    void sampleRateHzChanged();
+    void fsyncModeChanged();
+    void binaryFormatChanged();
+    void compressionChanged();
+    void rotationChanged();
+    void logRecovered(const QString &description);
+    void channelLoggingChanged();
+    void triggerChanged();
+    void triggered(const QString &reason, const QString &path);
+    void blackBoxChanged();
+    void csvExported(const QString &csvPath);
+    void errorOccurred(const QString &message);
 
 public slots:
 
     void updateLog();
-    void createHeader();
+
+private slots:
+    void onChannelChanged();
 
 private:
+    struct LogChannel
+    {
+        QObject *model = nullptr;
+        QMetaProperty property;
+        int rateHz = 0;
+        double lastValue = 0.0;
+        bool hasValue = false;
+    };
+
+    /// startLog() without the loggingChanged() notification; @return true if logging started
+    bool openLog(QString logFilename);
+    bool startChannelLog(const QString &basePath);
+    void stopChannelLog();
+    void sampleChannel(int channel, bool onlyIfChanged);
+    void writeKeyframe();
+    void snapshot(double *numeric, QString *text) const;
+    void updateSampling();
+    void resetPreTrigger();
+    void resolveTriggerSensor();
+    bool checkTriggers(const double *numeric);
+    void fireTrigger(const QString &reason);
+    void saveTriggerSettings();
+    void applyBlackBox();
+    void sampleBlackBox();
+
     EngineData *m_engineData = nullptr;
     VehicleData *m_vehicleData = nullptr;
     ExpanderBoardData *m_expanderBoardData = nullptr;
     DigitalInputs *m_digitalInputs = nullptr;
     TimingData *m_timingData = nullptr;
 
+    LogWriter *m_writer = nullptr;
     QTimer m_updatetimer;
     QString m_logBasePath;
-    QTime m_loggerStartTime;
+    QElapsedTimer m_loggerClock;
+    int m_sampleRateHz = 10;
+    int m_fsyncMode = 1;
+    bool m_binaryFormat = false;
+    int m_compression = 0;
+    int m_segmentSizeMiB = 0;
+    int m_segmentMinutes = 0;
+    int m_diskBudgetMiB = 0;
+    QString m_lastLogPath;
+    QThread *m_exportThread = nullptr;
+
+    // * Registry channel logging
+    SensorRegistry *m_sensorRegistry = nullptr;
+    PropertyRouter *m_propertyRouter = nullptr;
+    AppSettings *m_appSettings = nullptr;
+    bool m_channelLogging = false;
+    QHash<QString, int> m_channelRates;
+    QVector<LogChannel> m_channels;
+    QHash<QObject *, QHash<int, QVector<int>>> m_channelsBySignal;  ///< model -> notify signal -> channels
+    QList<QTimer *> m_rateTimers;
+    QTimer m_flushTimer;
+
+    // * Pre-trigger capture
+    PreTriggerBuffer m_preTrigger;        ///< Live ring, fed by updateLog() while armed
+    PreTriggerBuffer m_frozenPreTrigger;  ///< Window being written by the current log
+    QElapsedTimer m_armClock;
+    QTimer m_postTriggerTimer;
+    int m_preTriggerSeconds = 0;
+    int m_postTriggerSeconds = 10;
+    QString m_triggerSensor;
+    double m_triggerThreshold = 0.0;
+    bool m_triggerAbove = true;
+    int m_triggerDigitalInput = 0;
+    QObject *m_triggerModel = nullptr;
+    QMetaProperty m_triggerProperty;
+    bool m_triggerConditionMet = false;
+
+    // * Black box
+    BlackBoxRecorder m_blackBox;
+    QTimer m_blackBoxTimer;
+    bool m_blackBoxEnabled = true;
+    int m_blackBoxMinutes = 5;
 };
 
 #endif  // DATALOGGER_H
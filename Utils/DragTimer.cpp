@@ -0,0 +1,95 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file DragTimer.cpp
+ * @brief Implementation of the DragTimer class.
+ */
+
+#include "DragTimer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int DISTANCE_MARKS = DragTimer::FirstSpeed;
+/// SixtyFoot ... QuarterMile
+constexpr double MARK_FEET[DISTANCE_MARKS] = {60.0, 330.0, 660.0, 1000.0, 1320.0};
+constexpr double METRIC_SPEED_MARKS[3] = {100.0, 200.0, 300.0};
+constexpr double IMPERIAL_SPEED_MARKS[3] = {60.0, 120.0, 180.0};
+
+constexpr double FEET_PER_KM = 1000.0 / 0.3048;
+constexpr double FEET_PER_MILE = 5280.0;
+
+/**
+ * Time into a segment of length @p dt at which @p distance is covered, with
+ * the speed ramping linearly from @p v0 to @p v1: solves
+ * v0 * t + (v1 - v0) / (2 * dt) * t^2 = distance.
+ */
+double crossingTime(double v0, double v1, double dt, double distance)
+{
+    const double a = (v1 - v0) / (2.0 * dt);
+    double t = 0.0;
+    if (std::abs(a) < 1e-9)
+        t = v0 > 0.0 ? distance / v0 : dt;
+    else
+        t = (-v0 + std::sqrt(std::max(0.0, v0 * v0 + 4.0 * a * distance))) / (2.0 * a);
+    return std::clamp(t, 0.0, dt);
+}
+}  // namespace
+
+void DragTimer::start(qint64 startUs, Units units)
+{
+    m_units = units;
+    m_feetPerSecondPerUnit = (units == Units::Metric ? FEET_PER_KM : FEET_PER_MILE) / 3600.0;
+    m_running = true;
+    m_startUs = startUs;
+    m_lastUs = startUs;
+    m_lastSpeed = 0.0;
+    m_distanceFeet = 0.0;
+    m_crossings.fill(Crossing());
+}
+
+unsigned DragTimer::addSample(qint64 timestampUs, double speed)
+{
+    if (!m_running || timestampUs <= m_lastUs)
+        return 0;
+
+    const double dt = (timestampUs - m_lastUs) / 1e6;
+    const double segmentStart = (m_lastUs - m_startUs) / 1e6;
+    const double v0 = m_lastSpeed * m_feetPerSecondPerUnit;
+    const double v1 = speed * m_feetPerSecondPerUnit;
+    const double segmentFeet = 0.5 * (v0 + v1) * dt;
+    const auto speedAt = [&](double t) { return m_lastSpeed + (speed - m_lastSpeed) * t / dt; };
+
+    unsigned reached = 0;
+    for (int mark = 0; mark < DISTANCE_MARKS; ++mark) {
+        Crossing &crossing = m_crossings[mark];
+        if (crossing.reached || m_distanceFeet + segmentFeet < MARK_FEET[mark])
+            continue;
+        const double t = crossingTime(v0, v1, dt, MARK_FEET[mark] - m_distanceFeet);
+        crossing = Crossing{true, segmentStart + t, speedAt(t)};
+        reached |= 1u << mark;
+    }
+
+    const double *speedMarks = m_units == Units::Metric ? METRIC_SPEED_MARKS : IMPERIAL_SPEED_MARKS;
+    for (int i = 0; i < 3; ++i) {
+        Crossing &crossing = m_crossings[FirstSpeed + i];
+        if (crossing.reached || speed < speedMarks[i])
+            continue;
+        const double t =
+            m_lastSpeed >= speedMarks[i] ? 0.0 : (speedMarks[i] - m_lastSpeed) / (speed - m_lastSpeed) * dt;
+        crossing = Crossing{true, segmentStart + t, speedMarks[i]};
+        reached |= 1u << (FirstSpeed + i);
+    }
+
+    m_distanceFeet += segmentFeet;
+    m_lastUs = timestampUs;
+    m_lastSpeed = speed;
+
+    bool done = true;
+    for (const Crossing &crossing : m_crossings)
+        done = done && crossing.reached;
+    if (done)
+        m_running = false;
+    return reached;
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file DragTimer.h
+ * @brief Drag run timing from timestamped speed samples, with interpolated mark crossings.
+ *
+ * Each speed sample is integrated at its own receive timestamp, assuming the
+ * speed changes linearly between samples (trapezoidal distance). When a
+ * distance mark (60 ft ... 1/4 mile) falls inside a segment, the crossing
+ * time is solved from that same linear speed model; speed marks (0-100,
+ * 100-200, 200-300 km/h or 0-60, 60-120, 120-180 mph) are interpolated
+ * linearly. Results are therefore limited by the timestamp resolution, not
+ * by the sample interval.
+ *
+ * A run is a standing start: the speed at startUs is taken as zero.
+ */
+
+#ifndef DRAGTIMER_H
+#define DRAGTIMER_H
+
+#include <QtGlobal>
+
+#include <array>
+
+class DragTimer
+{
+public:
+    enum class Units {
+        Metric,    ///< Speed samples in km/h
+        Imperial,  ///< Speed samples in mph
+    };
+
+    enum Mark {
+        SixtyFoot,
+        ThreeThirtyFoot,
+        EighthMile,
+        ThousandFoot,
+        QuarterMile,
+        FirstSpeed,   ///< 100 km/h or 60 mph
+        SecondSpeed,  ///< 200 km/h or 120 mph
+        ThirdSpeed,   ///< 300 km/h or 180 mph
+        MARK_COUNT
+    };
+
+    struct Crossing
+    {
+        bool reached = false;
+        double seconds = 0.0;  ///< Since the start of the run
+        double speed = 0.0;    ///< Interpolated speed at the crossing
+    };
+
+    /// Start a run at @p startUs; earlier samples are ignored
+    void start(qint64 startUs, Units units);
+    void stop() { m_running = false; }
+    bool isRunning() const { return m_running; }
+    Units units() const { return m_units; }
+
+    /**
+     * @brief Integrate one speed sample.
+     * @return Bit mask (1 << Mark) of the marks first reached by this sample
+     */
+    unsigned addSample(qint64 timestampUs, double speed);
+
+    const Crossing &crossing(Mark mark) const { return m_crossings[mark]; }
+    /// Distance covered since the start, in feet
+    double distanceFeet() const { return m_distanceFeet; }
+
+private:
+    Units m_units = Units::Metric;
+    double m_feetPerSecondPerUnit = 0.0;
+    bool m_running = false;
+    qint64 m_startUs = 0;
+    qint64 m_lastUs = 0;
+    double m_lastSpeed = 0.0;
+    double m_distanceFeet = 0.0;
+    std::array<Crossing, MARK_COUNT> m_crossings{};
+};
+
+#endif  // DRAGTIMER_H
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file GearClassifier.cpp
+ * @brief Implementation of the GearClassifier class.
+ */
+
+#include "GearClassifier.h"
+
+#include <algorithm>
+#include <cmath>
+
+void GearClassifier::configure(const Config &config)
+{
+    QVector<Target> targets = config.targets.mid(0, MAX_GEARS);
+    std::sort(targets.begin(), targets.end(), [](const Target &a, const Target &b) { return a.value < b.value; });
+
+    m_count = static_cast<int>(targets.size());
+    for (int i = 0; i < m_count; ++i) {
+        m_targets[i] = targets.at(i).value;
+        m_gears[i] = targets.at(i).gear;
+    }
+    m_edges[0] = config.lowLimit;
+    for (int i = 1; i < m_count; ++i)
+        m_edges[i] = (m_targets[i - 1] + m_targets[i]) / 2.0;
+    m_edges[m_count] = config.highLimit;
+
+    m_tolerance = config.tolerance;
+    m_hysteresis = qMax(0.0, config.hysteresis);
+    m_confirmMs = qMax(0, config.confirmMs);
+    m_unknownGear = config.unknownGear;
+    reset();
+}
+
+void GearClassifier::reset()
+{
+    m_bin = -1;
+    m_gear = std::numeric_limits<int>::min();
+    m_pending = false;
+    m_pendingBin = -1;
+    m_pendingSinceMs = 0;
+}
+
+bool GearClassifier::insideBin(int bin, double value, double margin) const
+{
+    // Outer edges have no neighbouring target; their gap is mirrored from the edge instead.
+    const double target = m_targets[bin];
+    double low = m_edges[bin];
+    double high = m_edges[bin + 1];
+    if (margin > 0.0) {
+        if (std::isfinite(low))
+            low -= margin * (bin > 0 ? target - m_targets[bin - 1] : 2.0 * (target - low));
+        if (std::isfinite(high))
+            high += margin * (bin + 1 < m_count ? m_targets[bin + 1] - target : 2.0 * (high - target));
+    }
+    if (!(value >= low && value < high))
+        return false;
+    return m_tolerance <= 0.0 || std::abs(value - target) <= m_tolerance * (1.0 + 2.0 * margin);
+}
+
+int GearClassifier::binOf(double value) const
+{
+    for (int bin = 0; bin < m_count; ++bin) {
+        if (insideBin(bin, value, 0.0))
+            return bin;
+    }
+    return -1;
+}
+
+bool GearClassifier::update(double value, qint64 nowMs)
+{
+    const bool published = m_gear != std::numeric_limits<int>::min();
+    int bin = binOf(value);
+    if (m_bin >= 0 && bin != m_bin && insideBin(m_bin, value, m_hysteresis))
+        bin = m_bin;
+
+    if (published && bin == m_bin) {
+        m_pending = false;
+        return false;
+    }
+    if (!m_pending || bin != m_pendingBin) {
+        m_pending = true;
+        m_pendingBin = bin;
+        m_pendingSinceMs = nowMs;
+    }
+    if (published && nowMs - m_pendingSinceMs < m_confirmMs)
+        return false;
+
+    m_bin = bin;
+    m_pending = false;
+    const int gear = bin >= 0 ? m_gears[bin] : m_unknownGear;
+    if (gear == m_gear)
+        return false;
+    m_gear = gear;
+    return true;
+}
+
+qint64 GearClassifier::pendingMs(qint64 nowMs) const
+{
+    if (!m_pending)
+        return -1;
+    return qMax<qint64>(0, m_pendingSinceMs + m_confirmMs - nowMs);
+}
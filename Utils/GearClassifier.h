@@ -0,0 +1,98 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file GearClassifier.h
+ * @brief Debounced nearest-target gear classification, shared by the ratio and voltage gear sources.
+ *
+ * Each gear has a target value of some measurement: the rpm / speed ratio
+ * of the calculated gear, or the gear position sensor voltage of the EX
+ * Board. configure() sorts the targets once and places the bin edges at
+ * the midpoints between neighbours, so update() is a scan over at most
+ * MAX_GEARS edges with no settings lookups.
+ *
+ * A new gear is taken only once the measurement has left the current gear's
+ * bin by a hysteresis margin (a fraction of the gap to the neighbouring
+ * target) and has stayed in the new gear for confirmMs. update() reports
+ * whether the published gear changed, so callers only write the models on a
+ * real shift.
+ *
+ * The debounce is by time, not by sample count, because both sources are
+ * edge-driven: they update only when the measurement changes, so a clean
+ * step to a steady value arrives once. Callers re-run update() with the last
+ * value after pendingMs() (e.g. from a single-shot timer) to confirm it.
+ */
+
+#ifndef GEARCLASSIFIER_H
+#define GEARCLASSIFIER_H
+
+#include <QVector>
+
+#include <array>
+#include <limits>
+
+class GearClassifier
+{
+public:
+    static constexpr int MAX_GEARS = 8;
+
+    struct Target
+    {
+        int gear = 0;
+        double value = 0.0;
+    };
+
+    struct Config
+    {
+        QVector<Target> targets;  ///< Up to MAX_GEARS, any order
+        /// Measurements outside [lowLimit, highLimit] classify as unknownGear
+        double lowLimit = -std::numeric_limits<double>::infinity();
+        double highLimit = std::numeric_limits<double>::infinity();
+        /// Largest distance from a target still counted as that gear; 0 = up to the bin edges
+        double tolerance = 0.0;
+        /// Margin past a bin edge before the gear changes, as a fraction of the gap between the two targets
+        double hysteresis = 0.1;
+        /// How long a new gear must persist before it is published
+        int confirmMs = 100;
+        int unknownGear = 0;
+    };
+
+    void configure(const Config &config);
+    bool isConfigured() const { return m_count > 0; }
+
+    /// Forget the current gear; the next update() publishes whatever it classifies
+    void reset();
+
+    /**
+     * @brief Classify one measurement.
+     * @param nowMs Monotonic time of the measurement
+     * @return true if gear() changed
+     */
+    bool update(double value, qint64 nowMs);
+    int gear() const { return m_gear; }
+
+    /// Time until a gear that differs from gear() confirms, or -1 if there is none pending
+    qint64 pendingMs(qint64 nowMs) const;
+
+private:
+    /// Bin containing @p value, or -1 for none
+    int binOf(double value) const;
+    /// True if @p value lies in @p bin with its edges moved out by @p margin (see Config::hysteresis)
+    bool insideBin(int bin, double value, double margin) const;
+
+    int m_count = 0;
+    std::array<double, MAX_GEARS> m_targets{};    ///< Ascending
+    std::array<int, MAX_GEARS> m_gears{};         ///< Gear of each target
+    std::array<double, MAX_GEARS + 1> m_edges{};  ///< m_edges[i] and m_edges[i + 1] bound bin i
+    double m_tolerance = 0.0;
+    double m_hysteresis = 0.0;
+    int m_confirmMs = 0;
+    int m_unknownGear = 0;
+
+    int m_bin = -1;  ///< Bin of the published gear, -1 if unknown
+    int m_gear = std::numeric_limits<int>::min();
+    bool m_pending = false;
+    int m_pendingBin = -1;
+    qint64 m_pendingSinceMs = 0;
+};
+
+#endif  // GEARCLASSIFIER_H
@@ -0,0 +1,74 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LapDelta.cpp
+ * @brief Implementation of the LapDelta class.
+ */
+
+#include "LapDelta.h"
+
+#include <cmath>
+#include <utility>
+
+LapDelta::LapDelta() : m_reference(MAX_POINTS), m_current(MAX_POINTS) {}
+
+void LapDelta::clear()
+{
+    m_referencePoints = 0;
+    m_currentPoints = 0;
+    m_lapStartUs = -1;
+}
+
+void LapDelta::beginLap(qint64 startUs)
+{
+    m_lapStartUs = startUs;
+    m_lastUs = startUs;
+    m_lastDistanceM = 0.0;
+    m_current[0] = 0;
+    m_currentPoints = 1;
+}
+
+void LapDelta::completeLap(bool best)
+{
+    if (best && m_currentPoints > 1) {
+        std::swap(m_reference, m_current);
+        m_referencePoints = m_currentPoints;
+    }
+    m_currentPoints = 0;
+    m_lapStartUs = -1;
+}
+
+void LapDelta::record(qint64 timestampUs, double distanceM)
+{
+    if (!isRecording() || timestampUs <= m_lastUs || distanceM <= m_lastDistanceM)
+        return;
+
+    // Every grid point passed since the last sample gets its time interpolated along the segment.
+    const double dt = static_cast<double>(timestampUs - m_lastUs);
+    const double span = distanceM - m_lastDistanceM;
+    while (m_currentPoints < MAX_POINTS) {
+        const double pointM = m_currentPoints * RESOLUTION_M;
+        if (pointM > distanceM)
+            break;
+        const double atUs = m_lastUs + dt * (pointM - m_lastDistanceM) / span;
+        m_current[m_currentPoints++] = static_cast<qint32>(std::lround((atUs - m_lapStartUs) / 1000.0));
+    }
+    m_lastUs = timestampUs;
+    m_lastDistanceM = distanceM;
+}
+
+bool LapDelta::delta(qint64 timestampUs, double distanceM, int *deltaMs) const
+{
+    if (!hasReference() || !isRecording() || distanceM < 0.0)
+        return false;
+    const double position = distanceM / RESOLUTION_M;
+    const int index = static_cast<int>(position);
+    if (index + 1 >= m_referencePoints)
+        return false;
+
+    const double fraction = position - index;
+    const double referenceMs = m_reference.at(index) + fraction * (m_reference.at(index + 1) - m_reference.at(index));
+    const double elapsedMs = (timestampUs - m_lapStartUs) / 1000.0;
+    *deltaMs = static_cast<int>(std::lround(elapsedMs - referenceMs));
+    return true;
+}
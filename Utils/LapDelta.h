@@ -0,0 +1,66 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LapDelta.h
+ * @brief Predictive lap delta against the best lap, indexed by distance into the lap.
+ *
+ * The lap being driven is resampled onto a fixed distance grid (one elapsed
+ * time per RESOLUTION_M metres) as it is recorded. When it becomes the best
+ * lap, its grid is swapped in as the reference. The delta at any distance is
+ * then two array reads and a linear interpolation between the neighbouring
+ * grid points, so it can run on every GPS fix and speed sample.
+ *
+ * Both grids are allocated once at MAX_POINTS entries; laps longer than
+ * MAX_POINTS * RESOLUTION_M metres are compared over that length only.
+ */
+
+#ifndef LAPDELTA_H
+#define LAPDELTA_H
+
+#include <QVector>
+#include <QtGlobal>
+
+class LapDelta
+{
+public:
+    static constexpr double RESOLUTION_M = 2.0;
+    /// 16 km of track at RESOLUTION_M
+    static constexpr int MAX_POINTS = 8192;
+
+    LapDelta();
+
+    /// Drop the recording and the reference (new track, or timer reset)
+    void clear();
+
+    /// Start recording a lap that began at @p startUs
+    void beginLap(qint64 startUs);
+    /**
+     * @brief End the recorded lap.
+     * @param best The lap is the new best lap and becomes the reference
+     */
+    void completeLap(bool best);
+
+    /// Record the current lap at @p distanceM (metres since the line) and time @p timestampUs
+    void record(qint64 timestampUs, double distanceM);
+
+    /**
+     * @brief Delta of the current lap against the reference at the same distance.
+     * @param deltaMs Receives elapsed time minus the reference time; positive means slower
+     * @return false without a reference, before a lap started, or beyond the reference lap's length
+     */
+    bool delta(qint64 timestampUs, double distanceM, int *deltaMs) const;
+
+    bool hasReference() const { return m_referencePoints > 1; }
+    bool isRecording() const { return m_lapStartUs >= 0; }
+
+private:
+    QVector<qint32> m_reference;  ///< Elapsed ms at i * RESOLUTION_M of the best lap
+    QVector<qint32> m_current;    ///< Same for the lap being driven
+    int m_referencePoints = 0;
+    int m_currentPoints = 0;
+    qint64 m_lapStartUs = -1;
+    qint64 m_lastUs = 0;
+    double m_lastDistanceM = 0.0;
+};
+
+#endif  // LAPDELTA_H
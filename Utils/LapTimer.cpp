@@ -0,0 +1,166 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LapTimer.cpp
+ * @brief Implementation of the LapTimer class.
+ */
+
+#include "LapTimer.h"
+
+#include <cmath>
+
+namespace {
+constexpr double PI = 3.14159265358979323846;
+constexpr double EARTH_RADIUS_M = 6371000.0;
+}  // namespace
+
+void LapTimer::setTrack(const Line &startFinish, const QVector<Line> &sectors)
+{
+    // Equirectangular projection around the start/finish line: within a circuit's extent the
+    // error is far below GPS noise, and it keeps the per-fix work to two multiplications.
+    m_originLatitude = (startFinish.latitude1 + startFinish.latitude2) / 2.0;
+    m_originLongitude = (startFinish.longitude1 + startFinish.longitude2) / 2.0;
+    m_metresPerDegreeLatitude = EARTH_RADIUS_M * PI / 180.0;
+    m_metresPerDegreeLongitude = m_metresPerDegreeLatitude * std::cos(m_originLatitude * PI / 180.0);
+
+    m_startFinish = makeGate(startFinish);
+    m_sectors.clear();
+    m_sectors.reserve(sectors.size());
+    for (const Line &line : sectors)
+        m_sectors.append(makeGate(line));
+    m_hasTrack = m_startFinish.halfWidth > 0.0;
+    reset();
+}
+
+void LapTimer::clearTrack()
+{
+    m_hasTrack = false;
+    m_sectors.clear();
+    reset();
+}
+
+void LapTimer::reset()
+{
+    m_hasPrevious = false;
+    m_direction = 0;
+    m_lap = 0;
+    m_nextSector = 0;
+    m_lapStartUs = -1;
+    m_sectorStartUs = -1;
+    m_lapDistanceM = 0.0;
+    m_lastLapMs = 0;
+    m_bestLapMs = 0;
+    m_lastSectorMs = 0;
+}
+
+void LapTimer::project(double latitude, double longitude, double &x, double &y) const
+{
+    x = (longitude - m_originLongitude) * m_metresPerDegreeLongitude;
+    y = (latitude - m_originLatitude) * m_metresPerDegreeLatitude;
+}
+
+LapTimer::Gate LapTimer::makeGate(const Line &line) const
+{
+    double x1 = 0.0;
+    double y1 = 0.0;
+    double x2 = 0.0;
+    double y2 = 0.0;
+    project(line.latitude1, line.longitude1, x1, y1);
+    project(line.latitude2, line.longitude2, x2, y2);
+
+    Gate gate;
+    const double length = std::hypot(x2 - x1, y2 - y1);
+    if (length <= 0.0)
+        return gate;
+    gate.nx = -(y2 - y1) / length;
+    gate.ny = (x2 - x1) / length;
+    gate.c = -(gate.nx * x1 + gate.ny * y1);
+    gate.midX = (x1 + x2) / 2.0;
+    gate.midY = (y1 + y2) / 2.0;
+    gate.halfWidth = length / 2.0;
+    return gate;
+}
+
+double LapTimer::crossing(const Gate &gate, double x, double y, int *direction) const
+{
+    const double d0 = gate.nx * m_previousX + gate.ny * m_previousY + gate.c;
+    const double d1 = gate.nx * x + gate.ny * y + gate.c;
+    // A fix exactly on the line counts as the positive side, so it is not crossed twice.
+    if ((d0 < 0.0) == (d1 < 0.0))
+        return -1.0;
+
+    const double fraction = d0 / (d0 - d1);
+    const double px = m_previousX + fraction * (x - m_previousX);
+    const double py = m_previousY + fraction * (y - m_previousY);
+    // Position along the gate: the tangent is the normal turned back by 90 degrees.
+    const double along = (px - gate.midX) * gate.ny - (py - gate.midY) * gate.nx;
+    if (std::abs(along) > gate.halfWidth)
+        return -1.0;
+    if (direction)
+        *direction = d1 < 0.0 ? -1 : 1;
+    return fraction;
+}
+
+unsigned LapTimer::addFix(qint64 timestampUs, double latitude, double longitude)
+{
+    if (!m_hasTrack)
+        return 0;
+
+    double x = 0.0;
+    double y = 0.0;
+    project(latitude, longitude, x, y);
+
+    unsigned events = 0;
+    const qint64 dtUs = timestampUs - m_previousUs;
+    if (m_hasPrevious && dtUs > 0 && dtUs <= MAX_GAP_US) {
+        const double segmentM = std::hypot(x - m_previousX, y - m_previousY);
+        m_lapDistanceM += segmentM;
+        if (isTiming() && m_nextSector < m_sectors.size()) {
+            const double fraction = crossing(m_sectors.at(m_nextSector), x, y);
+            if (fraction >= 0.0) {
+                const qint64 atUs = m_previousUs + std::llround(fraction * dtUs);
+                m_lastSectorMs = toMs(atUs - m_sectorStartUs);
+                m_sectorStartUs = atUs;
+                ++m_nextSector;
+                events |= SectorCompleted;
+            }
+        }
+
+        int direction = 0;
+        const double fraction = crossing(m_startFinish, x, y, &direction);
+        if (fraction >= 0.0 && (m_direction == 0 || direction == m_direction)) {
+            const qint64 atUs = m_previousUs + std::llround(fraction * dtUs);
+            const double pastLineM = (1.0 - fraction) * segmentM;
+            if (!isTiming()) {
+                m_direction = direction;
+                m_lap = 1;
+                m_lapStartUs = atUs;
+                m_sectorStartUs = atUs;
+                m_nextSector = 0;
+                m_lapDistanceM = pastLineM;
+                events |= LapStarted;
+            } else if (atUs - m_lapStartUs >= MIN_LAP_US) {
+                // The last sector ends at the line; missed sector lines leave it spanning several.
+                if (!m_sectors.isEmpty()) {
+                    m_lastSectorMs = toMs(atUs - m_sectorStartUs);
+                    events |= SectorCompleted;
+                }
+                m_lastLapMs = toMs(atUs - m_lapStartUs);
+                if (m_bestLapMs == 0 || m_lastLapMs < m_bestLapMs)
+                    m_bestLapMs = m_lastLapMs;
+                ++m_lap;
+                m_lapStartUs = atUs;
+                m_sectorStartUs = atUs;
+                m_nextSector = 0;
+                m_lapDistanceM = pastLineM;
+                events |= LapCompleted | LapStarted;
+            }
+        }
+    }
+
+    m_hasPrevious = true;
+    m_previousUs = timestampUs;
+    m_previousX = x;
+    m_previousY = y;
+    return events;
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LapTimer.h
+ * @brief GPS lap and sector timing with interpolated line crossings.
+ *
+ * The start/finish line and the sector lines are gates given by their two
+ * end points. setTrack() projects them once onto a local flat plane around
+ * the start/finish line and stores each as a normalised line equation plus
+ * its extent, so a fix costs one projection and two multiply-adds per gate.
+ *
+ * When the segment between two fixes changes the sign of a gate's equation
+ * within the gate's width, the crossing time is interpolated linearly along
+ * the segment; at 25 Hz and racing speeds that is accurate to about a
+ * millisecond. Times are kept as integers (microseconds internally,
+ * milliseconds for results); formatting is left to whoever displays them.
+ *
+ * Sector lines are taken in the order given; the last sector ends at the
+ * start/finish line. The direction of the first start/finish crossing is
+ * the direction of travel from then on.
+ */
+
+#ifndef LAPTIMER_H
+#define LAPTIMER_H
+
+#include <QVector>
+#include <QtGlobal>
+
+class LapTimer
+{
+public:
+    /// Re-crossings sooner than this (GPS noise at the line, a spin) do not end a lap
+    static constexpr qint64 MIN_LAP_US = 10000000;
+    /// No crossing is interpolated over a gap in the fixes longer than this
+    static constexpr qint64 MAX_GAP_US = 2000000;
+
+    struct Line
+    {
+        double latitude1 = 0.0;
+        double longitude1 = 0.0;
+        double latitude2 = 0.0;
+        double longitude2 = 0.0;
+    };
+
+    enum Event : unsigned {
+        LapStarted = 1u << 0,
+        LapCompleted = 1u << 1,
+        SectorCompleted = 1u << 2,
+    };
+
+    void setTrack(const Line &startFinish, const QVector<Line> &sectors);
+    void clearTrack();
+    bool hasTrack() const { return m_hasTrack; }
+    int sectorCount() const { return m_sectors.size() + (m_sectors.isEmpty() ? 0 : 1); }
+
+    /// Forget laps, best lap and direction; the track is kept
+    void reset();
+
+    /**
+     * @brief Feed one position fix.
+     * @param timestampUs Time of the fix in microseconds (receive time, or GPS time for recorded files)
+     * @return Event bits for what this fix completed
+     */
+    unsigned addFix(qint64 timestampUs, double latitude, double longitude);
+
+    bool isTiming() const { return m_lapStartUs >= 0; }
+    /// Laps started, counting the one being driven
+    int currentLap() const { return m_lap; }
+    /// 1-based sector being driven; 0 without sector lines
+    int currentSector() const { return m_sectors.isEmpty() ? 0 : m_nextSector + 1; }
+    /// Time into the current lap at @p nowUs
+    int elapsedMs(qint64 nowUs) const { return isTiming() ? toMs(nowUs - m_lapStartUs) : 0; }
+    /// Crossing time of the start/finish line that started the current lap
+    qint64 lapStartUs() const { return m_lapStartUs; }
+    int lastLapMs() const { return m_lastLapMs; }
+    int bestLapMs() const { return m_bestLapMs; }
+    int lastSectorMs() const { return m_lastSectorMs; }
+    /// Distance driven since the start/finish crossing, in metres along the fixes
+    double lapDistanceM() const { return m_lapDistanceM; }
+
+private:
+    struct Gate
+    {
+        double nx = 0.0;  ///< Unit normal, so n . p + c is the signed distance in metres
+        double ny = 0.0;
+        double c = 0.0;
+        double midX = 0.0;
+        double midY = 0.0;
+        double halfWidth = 0.0;
+    };
+
+    static int toMs(qint64 us) { return static_cast<int>((us + 500) / 1000); }
+
+    void project(double latitude, double longitude, double &x, double &y) const;
+    Gate makeGate(const Line &line) const;
+    /// Fraction of the segment at which it crosses @p gate, or -1; @p direction gets the side it crosses to
+    double crossing(const Gate &gate, double x, double y, int *direction = nullptr) const;
+
+    bool m_hasTrack = false;
+    double m_originLatitude = 0.0;
+    double m_originLongitude = 0.0;
+    double m_metresPerDegreeLatitude = 0.0;
+    double m_metresPerDegreeLongitude = 0.0;
+    Gate m_startFinish;
+    QVector<Gate> m_sectors;
+
+    bool m_hasPrevious = false;
+    qint64 m_previousUs = 0;
+    double m_previousX = 0.0;
+    double m_previousY = 0.0;
+
+    int m_direction = 0;  ///< Side of the start/finish line laps cross to; 0 until the first crossing
+    int m_lap = 0;
+    int m_nextSector = 0;
+    qint64 m_lapStartUs = -1;
+    qint64 m_sectorStartUs = -1;
+    double m_lapDistanceM = 0.0;
+    int m_lastLapMs = 0;
+    int m_bestLapMs = 0;
+    int m_lastSectorMs = 0;
+};
+
+#endif  // LAPTIMER_H
@@ -0,0 +1,445 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LogAnalysis.cpp
+ * @brief Chunked, multi-threaded log statistics.
+ */
+
+#include "LogAnalysis.h"
+
+#include "BinaryLogFormat.h"
+#include "CompressedLogFormat.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryFile>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+const QByteArray LAP_COLUMN = QByteArrayLiteral("current_lap");
+
+struct Accumulator
+{
+    qint64 count = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double sum = 0.0;
+    double sumSquares = 0.0;
+
+    void add(double value)
+    {
+        ++count;
+        min = std::min(min, value);
+        max = std::max(max, value);
+        sum += value;
+        sumSquares += value * value;
+    }
+
+    void merge(const Accumulator &other)
+    {
+        count += other.count;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+        sum += other.sum;
+        sumSquares += other.sumSquares;
+    }
+};
+
+/// First-pass result of one chunk
+struct ChunkResult
+{
+    QVector<Accumulator> channels;
+    qint64 rows = 0;
+    qint64 firstMs = 0;
+    qint64 lastMs = 0;
+    QVector<std::pair<qint64, double>> lapChanges;  ///< (time, lap), first entry is the chunk's first lap sample
+};
+
+/// Run body(index, worker) for every index in [0, count) on @p threads threads
+void parallelFor(int count, int threads, const std::function<void(int, int)> &body)
+{
+    std::atomic<int> next{0};
+    const auto work = [&](int worker) {
+        for (int index = next.fetch_add(1); index < count; index = next.fetch_add(1))
+            body(index, worker);
+    };
+    std::vector<std::thread> pool;
+    for (int worker = 1; worker < threads; ++worker)
+        pool.emplace_back(work, worker);
+    work(0);
+    for (std::thread &thread : pool)
+        thread.join();
+}
+
+// ---------------------------------------------------------------------------
+// Sources: each scans one chunk and reports row(timeMs) / value(column, value)
+// ---------------------------------------------------------------------------
+
+class CsvSource
+{
+public:
+    bool open(const QString &path, qint64 chunkBytes, QString *errorString)
+    {
+        m_file.setFileName(path);
+        if (!m_file.open(QIODevice::ReadOnly)) {
+            *errorString = QStringLiteral("Cannot open %1: %2").arg(path, m_file.errorString());
+            return false;
+        }
+        m_size = m_file.size();
+        m_data = m_size > 0 ? reinterpret_cast<const char *>(m_file.map(0, m_size)) : nullptr;
+        const char *headerEnd = m_data ? static_cast<const char *>(std::memchr(m_data, '\n', m_size)) : nullptr;
+        if (!headerEnd || std::strncmp(m_data, "time_ms,", 8) != 0) {
+            *errorString = QStringLiteral("%1 is not a PowerTune log").arg(path);
+            return false;
+        }
+
+        const QByteArray header(m_data, headerEnd - m_data);
+        m_columns = header.trimmed().split(',');
+        m_columns.removeFirst();
+
+        // Chunk starts are moved forward to the next line start so no line is split.
+        const qint64 body = headerEnd + 1 - m_data;
+        const qint64 chunks = qMax<qint64>(1, (m_size - body + chunkBytes - 1) / chunkBytes);
+        m_bounds.append(body);
+        for (qint64 i = 1; i < chunks; ++i) {
+            const qint64 target = body + (m_size - body) * i / chunks;
+            const void *newline = std::memchr(m_data + target, '\n', m_size - target);
+            m_bounds.append(newline ? static_cast<const char *>(newline) + 1 - m_data : m_size);
+        }
+        m_bounds.append(m_size);
+        return true;
+    }
+
+    QVector<QByteArray> columns() const { return m_columns; }
+    int chunkCount() const { return static_cast<int>(m_bounds.size()) - 1; }
+    qint64 size() const { return m_size; }
+
+    template<typename Visitor>
+    void scan(int chunk, Visitor &visitor) const
+    {
+        const char *p = m_data + m_bounds.at(chunk);
+        const char *end = m_data + m_bounds.at(chunk + 1);
+        const int columnCount = static_cast<int>(m_columns.size());
+        while (p < end) {
+            const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+            if (!lineEnd)
+                lineEnd = end;
+
+            long long timeMs = 0;
+            const auto [timeEnd, timeError] = std::from_chars(p, lineEnd, timeMs);
+            if (timeError == std::errc() && timeEnd < lineEnd && *timeEnd == ',') {
+                visitor.row(timeMs);
+                const char *field = timeEnd + 1;
+                for (int column = 0; column < columnCount && field <= lineEnd; ++column) {
+                    const char *fieldEnd = static_cast<const char *>(std::memchr(field, ',', lineEnd - field));
+                    if (!fieldEnd)
+                        fieldEnd = lineEnd;
+                    // Text fields (lap times) and empty fields do not parse completely and are skipped.
+                    double value = 0.0;
+                    const auto [valueEnd, valueError] = std::from_chars(field, fieldEnd, value);
+                    if (valueError == std::errc() && (valueEnd == fieldEnd || *valueEnd == '\r'))
+                        visitor.value(column, value);
+                    field = fieldEnd + 1;
+                }
+            }
+            p = lineEnd + 1;
+        }
+    }
+
+private:
+    QFile m_file;
+    const char *m_data = nullptr;
+    qint64 m_size = 0;
+    QVector<QByteArray> m_columns;
+    QVector<qint64> m_bounds;
+};
+
+class BinarySource
+{
+public:
+    BinarySource(const BinaryLogReader &reader, qint64 chunkBytes, qint64 fileSize)
+        : m_reader(reader), m_size(fileSize)
+    {
+        // Close enough for sizing chunks; the header is small next to the records.
+        const qint64 recordSize = qMax<qint64>(1, fileSize / qMax<qint64>(1, reader.rowCount()));
+        m_chunkRows = qMax<qint64>(1, chunkBytes / recordSize);
+        for (int column = 0; column < reader.columns().size(); ++column) {
+            if (!reader.columns().at(column).isText)
+                m_numeric.append(column);
+        }
+    }
+
+    QVector<QByteArray> columns() const
+    {
+        QVector<QByteArray> names;
+        for (const LogColumn &column : m_reader.columns())
+            names.append(column.name);
+        return names;
+    }
+    int chunkCount() const
+    {
+        return static_cast<int>(qMax<qint64>(1, (m_reader.rowCount() + m_chunkRows - 1) / m_chunkRows));
+    }
+    qint64 size() const { return m_size; }
+
+    template<typename Visitor>
+    void scan(int chunk, Visitor &visitor) const
+    {
+        const qint64 first = chunk * m_chunkRows;
+        const qint64 last = qMin(m_reader.rowCount(), first + m_chunkRows);
+        if (m_reader.isSparse()) {
+            const int channels = static_cast<int>(m_reader.columns().size());
+            // Keyframe snapshots repeat values that were already logged, so they are not samples. Only the
+            // keyframe that opens the log (row 0) is kept: it holds each channel's initial value. A
+            // snapshot begun in the previous chunk holds at most one record per channel.
+            qint64 snapshotEnd = first;
+            for (qint64 row = first - 1; row >= 0 && row >= first - channels - 1; --row) {
+                if (m_reader.isKeyframe(row)) {
+                    if (row > 0)
+                        snapshotEnd = row + 1 + qMin<qint64>(channels, static_cast<qint64>(m_reader.eventValue(row)));
+                    break;
+                }
+            }
+            for (qint64 row = first; row < last; ++row) {
+                if (m_reader.isKeyframe(row)) {
+                    if (row > 0)
+                        snapshotEnd = row + 1 + qMin<qint64>(channels, static_cast<qint64>(m_reader.eventValue(row)));
+                    continue;
+                }
+                if (row < snapshotEnd)
+                    continue;
+                const int channel = m_reader.eventChannel(row);
+                visitor.row(m_reader.timestamp(row) / 1000);
+                if (channel >= 0 && channel < channels)
+                    visitor.value(channel, m_reader.eventValue(row));
+            }
+            return;
+        }
+        for (qint64 row = first; row < last; ++row) {
+            visitor.row(m_reader.timestamp(row));
+            for (int column : m_numeric)
+                visitor.value(column, m_reader.value(row, column));
+        }
+    }
+
+private:
+    const BinaryLogReader &m_reader;
+    qint64 m_size = 0;
+    qint64 m_chunkRows = 1;
+    QVector<int> m_numeric;
+};
+
+// ---------------------------------------------------------------------------
+// Passes
+// ---------------------------------------------------------------------------
+
+struct StatsVisitor
+{
+    ChunkResult &result;
+    const QVector<LogAnalysis::Transform> &transforms;
+    int lapColumn;
+    qint64 timeMs = 0;
+
+    void row(qint64 ms)
+    {
+        if (result.rows++ == 0)
+            result.firstMs = ms;
+        result.lastMs = ms;
+        timeMs = ms;
+    }
+
+    void value(int column, double value)
+    {
+        if (transforms.at(column))
+            value = transforms.at(column)(value);
+        if (!std::isfinite(value))
+            return;
+        result.channels[column].add(value);
+        if (column == lapColumn && (result.lapChanges.isEmpty() || result.lapChanges.constLast().second != value))
+            result.lapChanges.append({timeMs, value});
+    }
+};
+
+struct HistogramVisitor
+{
+    QVector<QVector<qint64>> &bins;  ///< Per channel, PERCENTILE_BINS each (empty for unused channels)
+    const QVector<LogAnalysis::Transform> &transforms;
+    const QVector<Accumulator> &ranges;
+
+    void row(qint64) {}
+
+    void value(int column, double value)
+    {
+        if (transforms.at(column))
+            value = transforms.at(column)(value);
+        QVector<qint64> &channelBins = bins[column];
+        if (!std::isfinite(value) || channelBins.isEmpty())
+            return;
+        const Accumulator &range = ranges.at(column);
+        const double width = range.max - range.min;
+        const int bin = width > 0.0 ? static_cast<int>((value - range.min) / width * LogAnalysis::PERCENTILE_BINS) : 0;
+        ++channelBins[qBound(0, bin, LogAnalysis::PERCENTILE_BINS - 1)];
+    }
+};
+
+double percentile(const QVector<qint64> &bins, const Accumulator &range, double fraction)
+{
+    const double target = fraction * range.count;
+    const double width = (range.max - range.min) / LogAnalysis::PERCENTILE_BINS;
+    qint64 below = 0;
+    for (int bin = 0; bin < bins.size(); ++bin) {
+        if (below + bins.at(bin) >= target && bins.at(bin) > 0)
+            return range.min + (bin + (target - below) / bins.at(bin)) * width;
+        below += bins.at(bin);
+    }
+    return range.max;
+}
+
+template<typename Source>
+void analyzeSource(const Source &source, const LogAnalysis::Options &options, LogAnalysis::Report &report)
+{
+    const QVector<QByteArray> names = source.columns();
+    const int columnCount = static_cast<int>(names.size());
+    QVector<LogAnalysis::Transform> transforms(columnCount);
+    for (int column = 0; column < columnCount; ++column)
+        transforms[column] = options.transforms.value(names.at(column));
+    const int lapColumn = static_cast<int>(names.indexOf(LAP_COLUMN));
+
+    const int chunks = source.chunkCount();
+    const int cores = static_cast<int>(std::thread::hardware_concurrency());
+    const int threads = qBound(1, options.threads > 0 ? options.threads : cores, chunks);
+    report.chunks = chunks;
+    report.threads = threads;
+    report.inputBytes = source.size();
+
+    // * Pass 1: per-chunk accumulators, merged in chunk order
+    QVector<ChunkResult> results(chunks);
+    ChunkResult *resultData = results.data();
+    parallelFor(chunks, threads, [&](int chunk, int) {
+        ChunkResult &result = resultData[chunk];
+        result.channels.resize(columnCount);
+        StatsVisitor visitor{result, transforms, lapColumn};
+        source.scan(chunk, visitor);
+    });
+
+    QVector<Accumulator> totals(columnCount);
+    QVector<std::pair<qint64, double>> lapChanges;
+    bool first = true;
+    for (const ChunkResult &result : results) {
+        for (int column = 0; column < columnCount; ++column)
+            totals[column].merge(result.channels.at(column));
+        if (result.rows > 0) {
+            if (first)
+                report.firstMs = result.firstMs;
+            report.lastMs = result.lastMs;
+            first = false;
+        }
+        report.rows += result.rows;
+        for (const auto &change : result.lapChanges) {
+            if (lapChanges.isEmpty() || lapChanges.constLast().second != change.second)
+                lapChanges.append(change);
+        }
+    }
+
+    // * Pass 2: fine histograms over each channel's range, one set per worker
+    QVector<QVector<QVector<qint64>>> workerBins(threads, QVector<QVector<qint64>>(columnCount));
+    for (QVector<QVector<qint64>> &bins : workerBins) {
+        for (int column = 0; column < columnCount; ++column) {
+            if (totals.at(column).count > 0)
+                bins[column].fill(0, LogAnalysis::PERCENTILE_BINS);
+        }
+    }
+    QVector<QVector<qint64>> *binData = workerBins.data();
+    parallelFor(chunks, threads, [&](int chunk, int worker) {
+        HistogramVisitor visitor{binData[worker], transforms, totals};
+        source.scan(chunk, visitor);
+    });
+
+    for (int column = 0; column < columnCount; ++column) {
+        const Accumulator &total = totals.at(column);
+        LogAnalysis::ChannelStats stats;
+        stats.name = names.at(column);
+        stats.count = total.count;
+        if (total.count > 0) {
+            QVector<qint64> bins(LogAnalysis::PERCENTILE_BINS, 0);
+            for (const QVector<QVector<qint64>> &worker : workerBins) {
+                for (int bin = 0; bin < LogAnalysis::PERCENTILE_BINS; ++bin)
+                    bins[bin] += worker.at(column).at(bin);
+            }
+            stats.min = total.min;
+            stats.max = total.max;
+            stats.mean = total.sum / total.count;
+            stats.stddev = std::sqrt(std::max(0.0, total.sumSquares / total.count - stats.mean * stats.mean));
+            stats.p50 = percentile(bins, total, 0.50);
+            stats.p95 = percentile(bins, total, 0.95);
+            stats.p99 = percentile(bins, total, 0.99);
+            stats.histogram.fill(0, LogAnalysis::HISTOGRAM_BINS);
+            constexpr int perBin = LogAnalysis::PERCENTILE_BINS / LogAnalysis::HISTOGRAM_BINS;
+            for (int bin = 0; bin < LogAnalysis::PERCENTILE_BINS; ++bin)
+                stats.histogram[bin / perBin] += bins.at(bin);
+        }
+        report.channels.append(stats);
+    }
+
+    // The first lap sample marks the start of the log, not a line crossing.
+    for (qsizetype i = 1; i + 1 < lapChanges.size(); ++i) {
+        const LogAnalysis::Lap lap{static_cast<int>(lapChanges.at(i).second), lapChanges.at(i).first,
+                                   lapChanges.at(i + 1).first - lapChanges.at(i).first};
+        report.laps.append(lap);
+    }
+}
+}  // namespace
+
+namespace LogAnalysis {
+
+bool analyze(const QString &path, const Options &options, Report &report, QString *errorString)
+{
+    QString error;
+    const auto fail = [errorString, &error]() {
+        if (errorString)
+            *errorString = error;
+        return false;
+    };
+
+    QElapsedTimer clock;
+    clock.start();
+    report = Report();
+
+    // Compressed logs are unpacked to a temporary file and analysed from there.
+    QString input = path;
+    QTemporaryFile plain;
+    if (CompressedLog::isCompressed(path)) {
+        if (!plain.open()) {
+            error = QStringLiteral("Cannot create temporary file: %1").arg(plain.errorString());
+            return fail();
+        }
+        plain.close();
+        if (!CompressedLog::decompressFile(path, plain.fileName(), &error))
+            return fail();
+        input = plain.fileName();
+    }
+
+    BinaryLogReader reader;
+    if (reader.open(input)) {
+        analyzeSource(BinarySource(reader, options.chunkBytes, QFile(input).size()), options, report);
+    } else {
+        CsvSource csv;
+        if (!csv.open(input, options.chunkBytes, &error))
+            return fail();
+        analyzeSource(csv, options, report);
+    }
+
+    report.elapsedUs = clock.nsecsElapsed() / 1000;
+    return true;
+}
+
+}  // namespace LogAnalysis
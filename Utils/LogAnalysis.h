@@ -0,0 +1,84 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LogAnalysis.h
+ * @brief Offline statistics over data logs (CSV, .ptlog, .ptz), computed in parallel chunks.
+ *
+ * The log is memory-mapped and cut into chunks (at line boundaries for CSV,
+ * at record boundaries for .ptlog) that worker threads scan independently.
+ * A first pass collects count, min, max, mean and standard deviation per
+ * channel plus lap changes; a second pass bins every value into a fine
+ * histogram over the channel's range, from which percentiles (to 0.1 % of
+ * the range) and the coarse report histogram are taken. Partial results are
+ * merged in chunk order, so the report does not depend on the thread count.
+ *
+ * Laps are split on changes of the "current_lap" column; only laps with a
+ * recorded start and end are reported.
+ */
+
+#ifndef LOGANALYSIS_H
+#define LOGANALYSIS_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+namespace LogAnalysis {
+constexpr int HISTOGRAM_BINS = 20;
+constexpr int PERCENTILE_BINS = 1000;
+
+struct ChannelStats
+{
+    QByteArray name;
+    qint64 count = 0;  ///< 0 for text columns
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    QVector<qint64> histogram;  ///< HISTOGRAM_BINS equal bins from min to max
+};
+
+struct Lap
+{
+    int number = 0;
+    qint64 startMs = 0;
+    qint64 durationMs = 0;
+};
+
+struct Report
+{
+    qint64 rows = 0;  ///< Rows (CSV, dense .ptlog) or change records (sparse .ptlog)
+    qint64 firstMs = 0;
+    qint64 lastMs = 0;
+    qint64 inputBytes = 0;
+    int chunks = 0;
+    int threads = 0;
+    qint64 elapsedUs = 0;
+    QVector<ChannelStats> channels;
+    QVector<Lap> laps;
+};
+
+/// Applied to every value of a column before it is counted, e.g. a sensor calibration
+using Transform = std::function<double(double)>;
+
+struct Options
+{
+    int threads = 0;                     ///< 0 = all cores
+    qint64 chunkBytes = 8 * 1024 * 1024;  ///< Work unit per thread
+    QHash<QByteArray, Transform> transforms;
+};
+
+/**
+ * @brief Analyse the log at @p path.
+ * @param errorString Receives a description on failure (may be null)
+ */
+bool analyze(const QString &path, const Options &options, Report &report, QString *errorString = nullptr);
+}  // namespace LogAnalysis
+
+#endif  // LOGANALYSIS_H
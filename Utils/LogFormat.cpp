@@ -0,0 +1,42 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LogFormat.cpp
+ * @brief CSV formatter for the data logger writer thread.
+ */
+
+#include "LogFormat.h"
+
+QString CsvLogFormatter::fileExtension() const
+{
+    return QStringLiteral(".csv");
+}
+
+QByteArray CsvLogFormatter::header(const QVector<LogColumn> &columns) const
+{
+    QByteArray out("time_ms");
+    for (const LogColumn &column : columns) {
+        out.append(',');
+        out.append(column.name);
+    }
+    out.append('\n');
+    return out;
+}
+
+void CsvLogFormatter::appendRows(const QVector<LogColumn> &columns, const LogSampleBatch &batch,
+                                 QByteArray &out) const
+{
+    for (int row = 0; row < batch.rowCount(); ++row) {
+        const double *numeric = batch.numericRow(row);
+        const QString *text = batch.textRow(row);
+        out.append(QByteArray::number(batch.timestamp(row)));
+        for (const LogColumn &column : columns) {
+            out.append(',');
+            if (column.isText)
+                out.append((text++)->toUtf8());
+            else
+                out.append(QByteArray::number(*numeric++, 'g', 6));
+        }
+        out.append('\n');
+    }
+}
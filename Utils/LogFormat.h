@@ -0,0 +1,130 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LogFormat.h
+ * @brief Sample batches and on-disk formatters shared by the data logger writer.
+ *
+ * The GUI thread only snapshots values into a LogSampleBatch; formatting into
+ * bytes happens on the writer thread through a LogFormatter.
+ */
+
+#ifndef LOGFORMAT_H
+#define LOGFORMAT_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include <utility>
+
+/// One logged column. Text columns hold strings (e.g. lap times), everything else is numeric.
+struct LogColumn
+{
+    QByteArray name;
+    bool isText = false;
+};
+
+/**
+ * @brief Row-major batch of snapshotted samples.
+ *
+ * Numeric and text values are stored in two flat arrays with a fixed stride
+ * per row so appending a row never allocates once capacity has been reached.
+ */
+class LogSampleBatch
+{
+public:
+    void setLayout(int numericColumns, int textColumns)
+    {
+        m_numericStride = numericColumns;
+        m_textStride = textColumns;
+        clear();
+    }
+
+    void appendRow(qint64 timestampMs, const double *numeric, const QString *text)
+    {
+        m_timestamps.append(timestampMs);
+        for (int i = 0; i < m_numericStride; ++i)
+            m_numeric.append(numeric[i]);
+        for (int i = 0; i < m_textStride; ++i)
+            m_text.append(text[i]);
+    }
+
+    /// Append all rows of @p other (same layout)
+    void appendBatch(const LogSampleBatch &other)
+    {
+        m_timestamps.append(other.m_timestamps);
+        m_numeric.append(other.m_numeric);
+        m_text.append(other.m_text);
+    }
+
+    void clear()
+    {
+        // Qt 6 containers keep their capacity on clear() when not shared.
+        m_timestamps.clear();
+        m_numeric.clear();
+        m_text.clear();
+    }
+
+    void swap(LogSampleBatch &other) noexcept
+    {
+        m_timestamps.swap(other.m_timestamps);
+        m_numeric.swap(other.m_numeric);
+        m_text.swap(other.m_text);
+        std::swap(m_numericStride, other.m_numericStride);
+        std::swap(m_textStride, other.m_textStride);
+    }
+
+    int rowCount() const { return static_cast<int>(m_timestamps.size()); }
+    int numericStride() const { return m_numericStride; }
+    int textStride() const { return m_textStride; }
+    qint64 timestamp(int row) const { return m_timestamps.at(row); }
+    const double *numericRow(int row) const { return m_numeric.constData() + row * m_numericStride; }
+    const QString *textRow(int row) const { return m_text.constData() + row * m_textStride; }
+
+private:
+    int m_numericStride = 0;
+    int m_textStride = 0;
+    QVector<qint64> m_timestamps;
+    QVector<double> m_numeric;
+    QVector<QString> m_text;
+};
+
+/// Serialises sample batches into a byte stream. Called only from the writer thread.
+class LogFormatter
+{
+public:
+    virtual ~LogFormatter() = default;
+
+    /// File extension including the dot (e.g. ".csv")
+    virtual QString fileExtension() const = 0;
+
+    /// Bytes written once at the start of a file; also starts the per-file state behind trailer()
+    virtual QByteArray header(const QVector<LogColumn> &columns) const = 0;
+
+    /// Bytes written once when a file is closed, after its last rows (none by default)
+    virtual QByteArray trailer() const { return QByteArray(); }
+
+    /// Append the serialised rows of @p batch to @p out
+    virtual void appendRows(const QVector<LogColumn> &columns, const LogSampleBatch &batch,
+                            QByteArray &out) const = 0;
+
+    /// Batch layout the producer fills for @p columns; by default one value per column
+    virtual void batchLayout(const QVector<LogColumn> &columns, int &numericColumns, int &textColumns) const
+    {
+        numericColumns = 0;
+        textColumns = 0;
+        for (const LogColumn &column : columns)
+            ++(column.isText ? textColumns : numericColumns);
+    }
+};
+
+/// Comma separated text, one row per sample, leading time_ms column.
+class CsvLogFormatter : public LogFormatter
+{
+public:
+    QString fileExtension() const override;
+    QByteArray header(const QVector<LogColumn> &columns) const override;
+    void appendRows(const QVector<LogColumn> &columns, const LogSampleBatch &batch, QByteArray &out) const override;
+};
+
+#endif  // LOGFORMAT_H
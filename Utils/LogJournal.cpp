@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LogJournal.cpp
+ * @brief Implementation of the LogJournal class.
+ */
+
+#include "LogJournal.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QtEndian>
+
+#ifdef Q_OS_UNIX
+    #include <unistd.h>
+#endif
+
+namespace {
+constexpr quint32 SLOT_MAGIC = 0x4C4A5450;  // "PTJL"
+constexpr int CRC_OFFSET = 28;
+const QString JOURNAL_SUFFIX = QStringLiteral(".journal");
+
+/// Decode one slot; returns false if it is empty, torn or damaged
+bool readSlot(const char *slot, quint32 &sequence, qint64 &validOffset)
+{
+    if (qFromLittleEndian<quint32>(slot) != SLOT_MAGIC)
+        return false;
+    if (qFromLittleEndian<quint16>(slot + CRC_OFFSET) != qChecksum(QByteArrayView(slot, CRC_OFFSET)))
+        return false;
+    sequence = qFromLittleEndian<quint32>(slot + 4);
+    validOffset = qFromLittleEndian<qint64>(slot + 8);
+    return validOffset >= 0;
+}
+}  // namespace
+
+LogJournal::~LogJournal()
+{
+    m_file.close();
+}
+
+QString LogJournal::journalPath(const QString &segmentPath)
+{
+    return segmentPath + JOURNAL_SUFFIX;
+}
+
+bool LogJournal::open(const QString &segmentPath)
+{
+    m_file.close();
+    m_file.setFileName(journalPath(segmentPath));
+    m_sequence = 0;
+    return m_file.open(QIODevice::ReadWrite | QIODevice::Truncate | QIODevice::Unbuffered);
+}
+
+bool LogJournal::record(qint64 validOffset, bool sync)
+{
+    if (!m_file.isOpen())
+        return false;
+
+    char slot[SLOT_SIZE] = {};
+    qToLittleEndian<quint32>(SLOT_MAGIC, slot);
+    qToLittleEndian<quint32>(++m_sequence, slot + 4);
+    qToLittleEndian<qint64>(validOffset, slot + 8);
+    qToLittleEndian<quint16>(qChecksum(QByteArrayView(slot, CRC_OFFSET)), slot + CRC_OFFSET);
+
+    // Alternate slots so the previous record survives a torn write.
+    if (!m_file.seek((m_sequence % 2) * SLOT_SIZE) || m_file.write(slot, SLOT_SIZE) != SLOT_SIZE)
+        return false;
+
+#if defined(Q_OS_LINUX)
+    if (sync)
+        ::fdatasync(m_file.handle());
+#elif defined(Q_OS_UNIX)
+    if (sync)
+        ::fsync(m_file.handle());
+#else
+    Q_UNUSED(sync);
+#endif
+    return true;
+}
+
+void LogJournal::remove()
+{
+    if (m_file.fileName().isEmpty())
+        return;
+    m_file.close();
+    m_file.remove();
+}
+
+QStringList LogJournal::recoverDirectory(const QString &directory)
+{
+    QStringList repaired;
+    const QDir dir(directory);
+    const QStringList journals = dir.entryList({QStringLiteral("*") + JOURNAL_SUFFIX}, QDir::Files);
+    for (const QString &name : journals) {
+        const QString journalFile = dir.filePath(name);
+        QFile journal(journalFile);
+        if (!journal.open(QIODevice::ReadOnly))
+            continue;
+        const QByteArray content = journal.read(2 * SLOT_SIZE);
+        journal.close();
+
+        bool found = false;
+        quint32 bestSequence = 0;
+        qint64 validOffset = 0;
+        for (qsizetype offset = 0; offset + SLOT_SIZE <= content.size(); offset += SLOT_SIZE) {
+            quint32 sequence = 0;
+            qint64 slotOffset = 0;
+            if (readSlot(content.constData() + offset, sequence, slotOffset) && (!found || sequence > bestSequence)) {
+                found = true;
+                bestSequence = sequence;
+                validOffset = slotOffset;
+            }
+        }
+
+        // Without a valid slot nothing was confirmed on disk and the segment is emptied.
+        const QString segmentPath = journalFile.chopped(JOURNAL_SUFFIX.size());
+        QFile segment(segmentPath);
+        if (segment.exists() && segment.size() > validOffset && segment.resize(validOffset))
+            repaired.append(QStringLiteral("%1 (%2 bytes kept)").arg(segmentPath).arg(validOffset));
+        QFile::remove(journalFile);
+    }
+    return repaired;
+}
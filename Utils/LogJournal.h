@@ -0,0 +1,70 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LogJournal.h
+ * @brief Tiny side file recording the last durable record boundary of an open log segment.
+ *
+ * Log segments are synced only at checkpoints, so after a power cut the file
+ * may end in a torn record or in data that never reached the card. While a
+ * segment is open, "<segment>.journal" holds the byte offset of the last
+ * record boundary that was synced. It has two 32-byte slots written
+ * alternately, each carrying a sequence number and a CRC, so a torn journal
+ * write still leaves the previous slot intact:
+ *
+ *     quint32 magic        "PTJL"
+ *     quint32 sequence
+ *     qint64  validOffset
+ *     quint8  reserved[12]
+ *     quint16 crc          qChecksum() of the preceding 28 bytes
+ *     quint16 reserved
+ *
+ * A clean close truncates the segment to its real size and removes the
+ * journal; any journal found later belongs to an interrupted session.
+ */
+
+#ifndef LOGJOURNAL_H
+#define LOGJOURNAL_H
+
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+class LogJournal
+{
+public:
+    static constexpr int SLOT_SIZE = 32;
+
+    LogJournal() = default;
+    ~LogJournal();
+
+    LogJournal(const LogJournal &) = delete;
+    LogJournal &operator=(const LogJournal &) = delete;
+
+    /// Create the journal for @p segmentPath (replacing any old one)
+    bool open(const QString &segmentPath);
+
+    /// Record that everything before @p validOffset is on disk; @p sync also syncs the journal
+    bool record(qint64 validOffset, bool sync);
+
+    /// Delete the journal after a clean close
+    void remove();
+
+    bool isOpen() const { return m_file.isOpen(); }
+
+    static QString journalPath(const QString &segmentPath);
+
+    /**
+     * @brief Repair every interrupted segment in @p directory.
+     *
+     * Each segment with a journal is truncated to its last recorded offset
+     * and the journal is removed.
+     * @return One "path (N bytes kept)" line per repaired segment
+     */
+    static QStringList recoverDirectory(const QString &directory);
+
+private:
+    QFile m_file;
+    quint32 m_sequence = 0;
+};
+
+#endif  // LOGJOURNAL_H
@@ -0,0 +1,547 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LogPlayer.cpp
+ * @brief Implementation of the LogPlayer class.
+ */
+
+#include "LogPlayer.h"
+
+#include "../Core/PropertyRouter.h"
+#include "../Core/TraceRecorder.h"
+#include "CompressedLogFormat.h"
+
+#include <QTemporaryFile>
+#include <QThread>
+
+#include <charconv>
+#include <cstring>
+
+namespace {
+/// Fixed logger columns (see logColumns() in DataLogger.cpp) and the model property each one is read from
+struct ColumnProperty
+{
+    const char *column;
+    const char *property;
+};
+
+constexpr ColumnProperty FIXED_COLUMNS[] = {
+    {"rpm", "rpm"},
+    {"power", "Power"},
+    {"torque", "Torque"},
+    {"gear", "Gear"},
+    {"gear_calculation", "GearCalculation"},
+    {"odo", "Odo"},
+    {"trip", "Trip"},
+    {"ex_speed", "EXSpeed"},
+    {"ex_gear", "EXGear"},
+    {"differential_sensor", "differentialSensor"},
+    {"lap_time", "laptime"},
+    {"best_lap", "bestlaptime"},
+    {"last_lap", "Lastlaptime"},
+    {"current_lap", "currentLap"},
+    {"di1_freq", "frequencyDIEX1"},
+};
+
+/// Never played back: the odometer journal would save the log's readings as the car's own
+constexpr const char *LIVE_ONLY_PROPERTIES[] = {"Odo", "Trip"};
+
+bool isLiveOnly(const QString &property)
+{
+    for (const char *name : LIVE_ONLY_PROPERTIES) {
+        if (property == QLatin1String(name))
+            return true;
+    }
+    return false;
+}
+
+QString propertyForColumn(const QByteArray &column)
+{
+    for (const ColumnProperty &entry : FIXED_COLUMNS) {
+        if (column == entry.column)
+            return QString::fromLatin1(entry.property);
+    }
+    // ex_an0-7, ex_calc0-7, di1-8
+    if (column.startsWith("ex_an") && column.size() == 6)
+        return QStringLiteral("EXAnalogInput") + QLatin1Char(column.back());
+    if (column.startsWith("ex_calc") && column.size() == 8)
+        return QStringLiteral("EXAnalogCalc") + QLatin1Char(column.back());
+    if (column.startsWith("di") && column.size() == 3)
+        return QStringLiteral("EXDigitalInput") + QLatin1Char(column.back());
+    return QString::fromUtf8(column);
+}
+}  // namespace
+
+LogPlayer::LogPlayer(QObject *parent) : QObject(parent)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &LogPlayer::advance);
+}
+
+LogPlayer::~LogPlayer()
+{
+    // The load worker writes into this object.
+    unload();
+}
+
+void LogPlayer::setPropertyRouter(PropertyRouter *propertyRouter)
+{
+    m_propertyRouter = propertyRouter;
+}
+
+bool LogPlayer::fail(const QString &message)
+{
+    m_error = message;
+    emit errorOccurred(message);
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Loading
+// ---------------------------------------------------------------------------
+
+bool LogPlayer::load(const QString &path)
+{
+    if (m_loadThread)
+        return fail(QStringLiteral("Playback: %1 is still loading").arg(m_loadingPath));
+    unload();
+
+    m_loadingPath = path;
+    m_loadError.clear();
+    m_cancelLoad.store(false);
+    if (CompressedLog::isCompressed(path))
+        m_unpacked = std::make_unique<QTemporaryFile>();
+
+    QThread *thread = QThread::create([this, path]() {
+        QString error;
+        if (!prepare(path, error))
+            m_loadError = error.isEmpty() ? QStringLiteral("Cannot load %1").arg(path) : error;
+    });
+    thread->setObjectName(QStringLiteral("LogLoad"));
+    thread->setParent(this);
+    // unload() may have abandoned this load; only the current one is finished here.
+    connect(thread, &QThread::finished, this, [this, thread]() {
+        if (thread == m_loadThread)
+            finishLoad();
+        thread->deleteLater();
+    });
+    m_loadThread = thread;
+    thread->start(QThread::LowPriority);
+    emit loadingChanged();
+    return true;
+}
+
+bool LogPlayer::prepare(const QString &path, QString &error)
+{
+    QString input = path;
+    if (m_unpacked) {
+        if (!m_unpacked->open()) {
+            error = QStringLiteral("Cannot create temporary file: %1").arg(m_unpacked->errorString());
+            return false;
+        }
+        m_unpacked->close();
+        if (!CompressedLog::decompressFile(path, m_unpacked->fileName(), &error))
+            return false;
+        input = m_unpacked->fileName();
+    }
+
+    m_loadedNames.clear();
+    if (m_reader.open(input)) {
+        for (const LogColumn &column : m_reader.columns())
+            m_loadedNames.append(column.name);
+        m_loadedSource = m_reader.isSparse() ? Source::Sparse : Source::Dense;
+        return true;
+    }
+    return indexCsv(input, error);
+}
+
+bool LogPlayer::indexCsv(const QString &path, QString &error)
+{
+    m_csvFile.setFileName(path);
+    if (!m_csvFile.open(QIODevice::ReadOnly)) {
+        error = QStringLiteral("Cannot open %1: %2").arg(path, m_csvFile.errorString());
+        return false;
+    }
+    m_csvSize = m_csvFile.size();
+    m_csvData = m_csvSize > 0 ? m_csvFile.map(0, m_csvSize) : nullptr;
+    const char *data = reinterpret_cast<const char *>(m_csvData);
+    const char *headerEnd = data ? static_cast<const char *>(std::memchr(data, '\n', m_csvSize)) : nullptr;
+    if (!headerEnd || std::strncmp(data, "time_ms,", 8) != 0) {
+        error = QStringLiteral("%1 is not a PowerTune log").arg(path);
+        return false;
+    }
+
+    m_loadedNames = QByteArray(data, headerEnd - data).trimmed().split(',');
+    m_loadedNames.removeFirst();
+
+    // One pass over the line ends; rows are parsed only when they are shown.
+    const char *end = data + m_csvSize;
+    for (const char *line = headerEnd + 1; line < end;) {
+        if (m_cancelLoad.load(std::memory_order_relaxed))
+            return false;
+        const char *lineEnd = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        if (!lineEnd)
+            break;  // Partially written last row
+        if (*line >= '0' && *line <= '9')
+            m_lineOffsets.append(line - data);
+        line = lineEnd + 1;
+    }
+
+    m_loadedSource = Source::Csv;
+    return true;
+}
+
+void LogPlayer::finishLoad()
+{
+    m_loadThread = nullptr;
+    const bool playWhenLoaded = m_playWhenLoaded;
+    m_playWhenLoaded = false;
+    emit loadingChanged();
+
+    if (!m_loadError.isEmpty()) {
+        releaseFiles();
+        fail(m_loadError);
+        return;
+    }
+
+    m_source = m_loadedSource;
+    bindColumns(m_loadedNames, m_loadedSource == Source::Sparse);
+    m_loadedNames.clear();
+    if (rowCount() == 0) {
+        m_source = Source::None;
+        releaseFiles();
+        fail(QStringLiteral("%1 holds no samples").arg(m_loadingPath));
+        return;
+    }
+
+    m_path = m_loadingPath;
+    m_firstMs = rowTimeMs(0);
+    m_durationMs = qMax<qint64>(0, rowTimeMs(rowCount() - 1) - m_firstMs);
+    m_error.clear();
+    emit loadedChanged();
+    showPosition(0);
+    emit positionChanged();
+    if (playWhenLoaded)
+        play();
+}
+
+void LogPlayer::bindColumns(const QVector<QByteArray> &names, bool registryKeys)
+{
+    m_targets = QVector<Target>(names.size());
+    m_channelCount = 0;
+    if (!m_propertyRouter)
+        return;
+
+    for (int column = 0; column < names.size(); ++column) {
+        const QString name = registryKeys ? QString::fromUtf8(names.at(column)) : propertyForColumn(names.at(column));
+        if (isLiveOnly(name))
+            continue;
+        QObject *model = nullptr;
+        int propertyIndex = -1;
+        if (!m_propertyRouter->resolveProperty(name, &model, &propertyIndex))
+            continue;
+        const QMetaProperty property = model->metaObject()->property(propertyIndex);
+        if (!property.isWritable())
+            continue;
+
+        Target &target = m_targets[column];
+        target.model = model;
+        target.property = property;
+        target.isText = property.metaType().id() == QMetaType::QString;
+        ++m_channelCount;
+    }
+}
+
+void LogPlayer::unload()
+{
+    if (m_loadThread) {
+        m_cancelLoad.store(true);
+        m_loadThread->wait();
+        m_loadThread = nullptr;
+        m_playWhenLoaded = false;
+        emit loadingChanged();
+    }
+
+    const bool wasLoaded = isLoaded();
+    pause();
+    releaseFiles();
+    m_targets.clear();
+    m_channelCount = 0;
+    m_source = Source::None;
+    m_path.clear();
+    m_firstMs = 0;
+    m_durationMs = 0;
+    m_nextRow = 0;
+    m_positionMs = 0;
+    if (wasLoaded) {
+        emit loadedChanged();
+        emit positionChanged();
+    }
+}
+
+void LogPlayer::releaseFiles()
+{
+    m_reader.close();
+    m_csvFile.close();
+    m_csvData = nullptr;
+    m_csvSize = 0;
+    m_lineOffsets.clear();
+    m_unpacked.reset();
+}
+
+// ---------------------------------------------------------------------------
+// Row access
+// ---------------------------------------------------------------------------
+
+qint64 LogPlayer::rowCount() const
+{
+    switch (m_source) {
+    case Source::Csv:
+        return m_lineOffsets.size();
+    case Source::Dense:
+    case Source::Sparse:
+        return m_reader.rowCount();
+    case Source::None:
+        break;
+    }
+    return 0;
+}
+
+qint64 LogPlayer::rowTimeMs(qint64 row) const
+{
+    switch (m_source) {
+    case Source::Csv: {
+        const char *line = reinterpret_cast<const char *>(m_csvData) + m_lineOffsets.at(row);
+        long long timeMs = 0;
+        std::from_chars(line, reinterpret_cast<const char *>(m_csvData) + m_csvSize, timeMs);
+        return timeMs;
+    }
+    case Source::Dense:
+        return m_reader.timestamp(row);
+    case Source::Sparse:
+        return m_reader.timestamp(row) / 1000;
+    case Source::None:
+        break;
+    }
+    return 0;
+}
+
+qint64 LogPlayer::lowerBound(qint64 timeMs) const
+{
+    if (m_source == Source::Dense)
+        return m_reader.lowerBound(timeMs);
+    if (m_source == Source::Sparse)
+        return m_reader.lowerBound(timeMs * 1000);
+
+    qint64 first = 0;
+    qint64 count = rowCount();
+    while (count > 0) {
+        const qint64 half = count / 2;
+        if (rowTimeMs(first + half) < timeMs) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+void LogPlayer::stageValue(int column, double value)
+{
+    Target &target = m_targets[column];
+    if (!target.model || target.isText || target.value == value)
+        return;
+    target.value = value;
+    target.dirty = true;
+}
+
+void LogPlayer::stageRow(qint64 row)
+{
+    if (m_source == Source::Csv) {
+        stageCsvRow(row);
+        return;
+    }
+
+    const QVector<LogColumn> &columns = m_reader.columns();
+    for (int column = 0; column < columns.size(); ++column) {
+        Target &target = m_targets[column];
+        if (!target.model)
+            continue;
+        if (!columns.at(column).isText) {
+            stageValue(column, m_reader.value(row, column));
+        } else if (target.isText) {
+            const QString text = m_reader.text(row, column);
+            if (text != target.text) {
+                target.text = text;
+                target.dirty = true;
+            }
+        }
+    }
+}
+
+void LogPlayer::stageCsvRow(qint64 row)
+{
+    // Indexed rows always end in a newline, so the searches stay inside the mapping.
+    const char *line = reinterpret_cast<const char *>(m_csvData) + m_lineOffsets.at(row);
+    const char *lineEnd = static_cast<const char *>(std::memchr(line, '\n', m_csvSize - m_lineOffsets.at(row)));
+    if (lineEnd[-1] == '\r')
+        --lineEnd;
+    const char *field = static_cast<const char *>(std::memchr(line, ',', lineEnd - line));
+
+    for (int column = 0; column < m_targets.size() && field && field < lineEnd; ++column) {
+        ++field;
+        const char *fieldEnd = static_cast<const char *>(std::memchr(field, ',', lineEnd - field));
+        if (!fieldEnd)
+            fieldEnd = lineEnd;
+
+        Target &target = m_targets[column];
+        if (target.isText) {
+            const QString text = QString::fromUtf8(field, fieldEnd - field);
+            if (text != target.text) {
+                target.text = text;
+                target.dirty = true;
+            }
+        } else if (target.model) {
+            double value = 0.0;
+            const auto [valueEnd, valueError] = std::from_chars(field, fieldEnd, value);
+            if (valueError == std::errc() && valueEnd == fieldEnd)
+                stageValue(column, value);
+        }
+        field = fieldEnd;
+    }
+}
+
+void LogPlayer::stageEvent(qint64 row)
+{
+    // Keyframe markers and channels outside the table fall out here.
+    const int channel = m_reader.eventChannel(row);
+    if (channel >= 0 && channel < m_targets.size())
+        stageValue(channel, m_reader.eventValue(row));
+}
+
+void LogPlayer::publish(bool force)
+{
+    PT_TRACE_SCOPE("player.publish");
+    for (Target &target : m_targets) {
+        if (!target.model || !(target.dirty || force))
+            continue;
+        target.property.write(target.model, target.isText ? QVariant(target.text) : QVariant(target.value));
+        target.dirty = false;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Transport
+// ---------------------------------------------------------------------------
+
+void LogPlayer::showPosition(qint64 positionMs)
+{
+    positionMs = qBound<qint64>(0, positionMs, m_durationMs);
+    const qint64 end = lowerBound(m_firstMs + positionMs + 1);
+    if (m_source == Source::Sparse) {
+        // Only a log without any keyframe before the target replays from the start.
+        const qint64 keyframe = m_reader.keyframeBefore(end - 1);
+        for (qint64 row = qMax<qint64>(0, keyframe); row < end; ++row)
+            stageEvent(row);
+    } else if (end > 0) {
+        stageRow(end - 1);
+    }
+    m_nextRow = end;
+    publish(true);
+    m_positionMs = positionMs;
+    m_lastNotifyMs = positionMs;
+}
+
+void LogPlayer::restartClock(qint64 positionMs)
+{
+    m_clockBaseMs = positionMs;
+    m_clock.start();
+}
+
+void LogPlayer::play()
+{
+    if (isLoading()) {
+        m_playWhenLoaded = true;
+        return;
+    }
+    if (!isLoaded() || isPlaying())
+        return;
+    if (m_positionMs >= m_durationMs)
+        showPosition(0);
+    restartClock(m_positionMs);
+    m_timer.start(FRAME_INTERVAL_MS);
+    emit playingChanged();
+    emit positionChanged();
+}
+
+void LogPlayer::pause()
+{
+    if (!isPlaying())
+        return;
+    m_timer.stop();
+    emit playingChanged();
+    emit positionChanged();
+}
+
+void LogPlayer::seek(qint64 positionMs)
+{
+    if (!isLoaded())
+        return;
+    showPosition(positionMs);
+    if (isPlaying())
+        restartClock(m_positionMs);
+    emit positionChanged();
+}
+
+void LogPlayer::setSpeed(double speed)
+{
+    speed = qBound(MIN_SPEED, speed, MAX_SPEED);
+    if (qFuzzyCompare(speed, m_speed))
+        return;
+    if (isPlaying())
+        restartClock(m_positionMs);
+    m_speed = speed;
+    emit speedChanged();
+}
+
+void LogPlayer::setLoop(bool loop)
+{
+    if (loop == m_loop)
+        return;
+    m_loop = loop;
+    emit loopChanged();
+}
+
+void LogPlayer::advance()
+{
+    PT_TRACE_SCOPE("player.advance");
+    const qint64 positionMs = qMin(m_durationMs, m_clockBaseMs + static_cast<qint64>(m_clock.elapsed() * m_speed));
+    const qint64 end = lowerBound(m_firstMs + positionMs + 1);
+    if (m_source == Source::Sparse) {
+        for (; m_nextRow < end; ++m_nextRow)
+            stageEvent(m_nextRow);
+    } else if (end > m_nextRow) {
+        // Rows are complete snapshots; only the newest one due this frame matters.
+        stageRow(end - 1);
+        m_nextRow = end;
+    }
+    publish(false);
+    m_positionMs = positionMs;
+
+    if (positionMs >= m_durationMs) {
+        if (m_loop) {
+            showPosition(0);
+            restartClock(0);
+            emit positionChanged();
+        } else {
+            pause();
+            emit finished();
+        }
+        return;
+    }
+    if (positionMs - m_lastNotifyMs >= POSITION_NOTIFY_MS) {
+        m_lastNotifyMs = positionMs;
+        emit positionChanged();
+    }
+}
@@ -0,0 +1,189 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LogPlayer.h
+ * @brief Plays a recorded data log back into the live data models, with pause, speed and seek.
+ *
+ * The log (CSV, .ptlog or .ptz) is memory-mapped and read in place; the
+ * models are written through their properties, so the normal dashboard
+ * animates exactly as it does from live data. Values are written once per
+ * display frame, and only for channels that changed, however many log rows
+ * a frame covers. Live sources keep writing the same models, so playback is
+ * meant for use without a connected ECU. Odo and Trip are not played back,
+ * so the odometer journal never records a log's readings as the car's.
+ *
+ * Seeking is a binary search on the record timestamps. Dense logs (CSV,
+ * fixed-column .ptlog) hold a complete row per sample; sparse channel logs
+ * are restored from the nearest keyframe before the target, found by binary
+ * search on the log's keyframe index (see BinaryLogFormat.h), and replayed
+ * forward from there, so a seek costs O(log n) plus at most one keyframe
+ * interval of records.
+ *
+ * Loading runs on a worker thread: unpacking a .ptz and indexing the lines
+ * of a CSV log touch the whole file. Only binding the columns to the models
+ * and showing the first sample happen on the GUI thread.
+ *
+ * With loop enabled the player doubles as a repeatable render workload for
+ * profiling the dashboard (see --log-playback in main.cpp).
+ */
+
+#ifndef LOGPLAYER_H
+#define LOGPLAYER_H
+
+#include "BinaryLogFormat.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMetaProperty>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+#include <atomic>
+#include <memory>
+
+class PropertyRouter;
+class QTemporaryFile;
+class QThread;
+
+class LogPlayer : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool loaded READ isLoaded NOTIFY loadedChanged)
+    Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged)
+    Q_PROPERTY(QString path READ path NOTIFY loadedChanged)
+    Q_PROPERTY(qint64 duration READ duration NOTIFY loadedChanged)
+    Q_PROPERTY(int channelCount READ channelCount NOTIFY loadedChanged)
+    Q_PROPERTY(bool playing READ isPlaying NOTIFY playingChanged)
+    Q_PROPERTY(double speed READ speed WRITE setSpeed NOTIFY speedChanged)
+    Q_PROPERTY(bool loop READ loop WRITE setLoop NOTIFY loopChanged)
+    Q_PROPERTY(qint64 position READ position NOTIFY positionChanged)
+
+public:
+    static constexpr int FRAME_INTERVAL_MS = 16;
+    /// positionChanged() rate while playing; the models themselves update every frame
+    static constexpr int POSITION_NOTIFY_MS = 100;
+    static constexpr double MIN_SPEED = 0.1;
+    static constexpr double MAX_SPEED = 16.0;
+
+    explicit LogPlayer(QObject *parent = nullptr);
+    ~LogPlayer() override;
+
+    void setPropertyRouter(PropertyRouter *propertyRouter);
+
+    /**
+     * @brief Start loading @p path in the background; any previous log is unloaded.
+     *
+     * loadedChanged() follows once the first sample is shown, or
+     * errorOccurred() if the file cannot be played. Columns are matched to
+     * model properties by the logger's column names (rpm, ex_an0, ...) or,
+     * for channel logs, by SensorRegistry key. Columns without a matching
+     * property are skipped.
+     * @return false if another log is still loading
+     */
+    Q_INVOKABLE bool load(const QString &path);
+    /// Also cancels a load in progress
+    Q_INVOKABLE void unload();
+    /// While a log is loading, playback starts as soon as it is loaded
+    Q_INVOKABLE void play();
+    Q_INVOKABLE void pause();
+    /// Show the state at @p positionMs from the start of the log; keeps playing if it was
+    Q_INVOKABLE void seek(qint64 positionMs);
+
+    bool isLoaded() const { return m_source != Source::None; }
+    bool isLoading() const { return m_loadThread != nullptr; }
+    QString path() const { return m_path; }
+    qint64 duration() const { return m_durationMs; }
+    int channelCount() const { return m_channelCount; }
+    bool isPlaying() const { return m_timer.isActive(); }
+    double speed() const { return m_speed; }
+    void setSpeed(double speed);
+    bool loop() const { return m_loop; }
+    void setLoop(bool loop);
+    qint64 position() const { return m_positionMs; }
+    QString errorString() const { return m_error; }
+
+signals:
+    void loadedChanged();
+    void loadingChanged();
+    void playingChanged();
+    void speedChanged();
+    void loopChanged();
+    void positionChanged();
+    /// End of the log reached without loop
+    void finished();
+    void errorOccurred(const QString &message);
+
+private slots:
+    void advance();
+
+private:
+    enum class Source { None, Csv, Dense, Sparse };
+
+    struct Target
+    {
+        QObject *model = nullptr;
+        QMetaProperty property;
+        bool isText = false;
+        double value = 0.0;
+        QString text;
+        bool dirty = false;
+    };
+
+    bool fail(const QString &message);
+    /// Worker thread: open or unpack @p path and index its rows
+    bool prepare(const QString &path, QString &error);
+    bool indexCsv(const QString &path, QString &error);
+    void finishLoad();
+    void releaseFiles();
+    void bindColumns(const QVector<QByteArray> &names, bool registryKeys);
+    qint64 rowCount() const;
+    qint64 rowTimeMs(qint64 row) const;
+    /// First row at or after @p timeMs (log time)
+    qint64 lowerBound(qint64 timeMs) const;
+    void stageRow(qint64 row);
+    void stageCsvRow(qint64 row);
+    void stageEvent(qint64 row);
+    void stageValue(int column, double value);
+    void publish(bool force);
+    void showPosition(qint64 positionMs);
+    void restartClock(qint64 positionMs);
+
+    PropertyRouter *m_propertyRouter = nullptr;
+    Source m_source = Source::None;
+    QString m_path;
+    QString m_error;
+
+    BinaryLogReader m_reader;
+    std::unique_ptr<QTemporaryFile> m_unpacked;  ///< Decompressed copy of a .ptz log
+    QFile m_csvFile;
+    const uchar *m_csvData = nullptr;
+    qint64 m_csvSize = 0;
+    QVector<qint64> m_lineOffsets;  ///< Start of each CSV data row
+
+    // * Background load: while it runs the worker owns the file members above and the results below
+    QThread *m_loadThread = nullptr;
+    QString m_loadingPath;
+    std::atomic<bool> m_cancelLoad{false};
+    bool m_playWhenLoaded = false;
+    Source m_loadedSource = Source::None;
+    QVector<QByteArray> m_loadedNames;
+    QString m_loadError;
+
+    QVector<Target> m_targets;  ///< Indexed by log column
+    int m_channelCount = 0;
+    qint64 m_firstMs = 0;
+    qint64 m_durationMs = 0;
+    qint64 m_nextRow = 0;  ///< First row not yet applied
+
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_clockBaseMs = 0;  ///< Position at m_clock start
+    qint64 m_positionMs = 0;
+    qint64 m_lastNotifyMs = 0;
+    double m_speed = 1.0;
+    bool m_loop = false;
+};
+
+#endif  // LOGPLAYER_H
@@ -0,0 +1,551 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LogWriter.cpp
+ * @brief Implementation of the LogWriter class.
+ */
+
+#include "LogWriter.h"
+
+#include "../Core/TraceRecorder.h"
+
+#include <QDateTime>
+#include <QDeadlineTimer>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QThread>
+
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+    #include <fcntl.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+/// CPU time consumed by the calling thread, so compression cost is not inflated by preemption
+qint64 threadCpuUs()
+{
+#ifdef Q_OS_UNIX
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return static_cast<qint64>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#endif
+    static QElapsedTimer fallback;
+    if (!fallback.isValid())
+        fallback.start();
+    return fallback.nsecsElapsed() / 1000;
+}
+
+/// Bytes the calling thread has sent to the storage layer, or -1 where the kernel does not report it
+qint64 threadDeviceWriteBytes()
+{
+#ifdef Q_OS_LINUX
+    QFile io(QStringLiteral("/proc/thread-self/io"));
+    if (!io.open(QIODevice::ReadOnly))
+        return -1;
+    const QByteArray content = io.readAll();
+    const qsizetype key = content.indexOf("\nwrite_bytes:");
+    if (key < 0)
+        return -1;
+    const qsizetype start = key + 13;
+    const qsizetype end = content.indexOf('\n', start);
+    return content.mid(start, end < 0 ? -1 : end - start).trimmed().toLongLong();
+#else
+    return -1;
+#endif
+}
+
+/// Logger file name: session stem, optional "_NNN" segment number, format extension, optional container/journal
+const QRegularExpression LOG_FILE_PATTERN(QStringLiteral(R"(^(.+?)(_\d{3})?\.(csv|ptlog)(\.ptz)?(\.journal)?$)"));
+
+/**
+ * Whether @p path (a LOG_FILE_PATTERN match) starts the way LogWriter writes it. Session names are
+ * chosen by the user, so the name alone does not prove the logger wrote a file; pruning only deletes
+ * files with the logger's own signature.
+ */
+bool isLoggerFile(const QString &path, const QRegularExpressionMatch &match)
+{
+    if (match.captured(4) == QLatin1String(".ptz") && match.captured(5).isEmpty())
+        return CompressedLog::isCompressed(path);
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    const QByteArray head = file.read(LogJournal::SLOT_SIZE * 2);
+    if (!match.captured(5).isEmpty())
+        return head.startsWith("PTJL") || head.mid(LogJournal::SLOT_SIZE).startsWith("PTJL");  // LogJournal slots
+    if (match.captured(3) == QLatin1String("ptlog"))
+        return head.startsWith(QByteArray("PTLOG\0\0\1", 8));  // BinaryLogFormat.h
+    return head.startsWith("time_ms");  // CsvLogFormatter header
+}
+}  // namespace
+
+QString LogWriter::segmentPath(const QString &path, const QString &suffix, int index)
+{
+    if (index == 0)
+        return path;
+    const QString stem = path.endsWith(suffix) ? path.chopped(suffix.size()) : path;
+    return stem + QStringLiteral("_%1").arg(index + 1, 3, 10, QLatin1Char('0')) + suffix;
+}
+
+LogWriter::LogWriter(QObject *parent) : QObject(parent) {}
+
+LogWriter::~LogWriter()
+{
+    close();
+}
+
+bool LogWriter::open(const QString &path, const QVector<LogColumn> &columns, std::unique_ptr<LogFormatter> formatter,
+                     const Options &options)
+{
+    close();
+
+    m_path = path;
+    m_columns = columns;
+    m_formatter = std::move(formatter);
+    m_options = options;
+    m_options.blockSize = qMax(4096, (options.blockSize / 4096) * 4096);
+    m_options.batchRows = qMax(1, options.batchRows);
+    m_options.maxPendingRows = qMax(m_options.batchRows, options.maxPendingRows);
+    if (!CompressedLog::isAvailable(m_options.compression) && m_options.compression != CompressedLog::Codec::None)
+        m_options.compression = CompressedLog::Codec::Zlib;
+    m_suffix = m_formatter->fileExtension();
+    if (m_options.compression != CompressedLog::Codec::None)
+        m_suffix += CompressedLog::fileSuffix();
+
+    // Reusing a session name replaces the whole session, including segments beyond the first.
+    for (int index = 1; QFile::exists(segmentPath(m_path, m_suffix, index)); ++index)
+        QFile::remove(segmentPath(m_path, m_suffix, index));
+
+    m_file.setFileName(m_path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+        emit errorOccurred(QStringLiteral("Logger: cannot open %1: %2").arg(m_path, m_file.errorString()));
+        return false;
+    }
+
+    int numericColumns = 0;
+    int textColumns = 0;
+    m_formatter->batchLayout(m_columns, numericColumns, textColumns);
+    m_front.setLayout(numericColumns, textColumns);
+    m_back.setLayout(numericColumns, textColumns);
+    m_work.setLayout(numericColumns, textColumns);
+
+    m_block.clear();
+    m_block.reserve(m_options.blockSize * 2);
+    m_block.append(m_formatter->header(m_columns));
+    m_compressed.clear();
+    if (m_options.compression != CompressedLog::Codec::None)
+        m_compressed = CompressedLog::fileHeader(m_options.compression);
+
+    m_stats = Stats();
+    m_backPending = false;
+    m_stopRequested = false;
+    m_failed.store(false);
+    m_lastSyncMs = 0;
+    m_segmentIndex = 0;
+
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName(QStringLiteral("LogWriter"));
+    m_thread->start(QThread::LowPriority);
+    return true;
+}
+
+void LogWriter::close()
+{
+    if (!m_thread)
+        return;
+
+    flush();
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopRequested = true;
+        m_wake.wakeOne();
+    }
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+    m_file.close();
+    m_front.clear();
+}
+
+void LogWriter::appendRow(qint64 timestampMs, const double *numeric, const QString *text)
+{
+    if (!m_thread)
+        return;
+
+    m_front.appendRow(timestampMs, numeric, text);
+    if (m_front.rowCount() >= m_options.batchRows)
+        handOff();
+}
+
+void LogWriter::flush()
+{
+    if (m_thread && m_front.rowCount() > 0)
+        handOff();
+}
+
+LogWriter::Stats LogWriter::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
+
+void LogWriter::handOff()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_backPending) {
+        // Writer has not picked up the previous batch yet: merge rather than block, up to the cap.
+        if (m_back.rowCount() + m_front.rowCount() <= m_options.maxPendingRows)
+            m_back.appendBatch(m_front);
+        else
+            m_stats.rowsDropped += static_cast<quint64>(m_front.rowCount());
+        m_front.clear();
+    } else {
+        m_front.swap(m_back);
+        m_backPending = true;
+    }
+    m_wake.wakeOne();
+}
+
+// ---------------------------------------------------------------------------
+// Writer thread
+// ---------------------------------------------------------------------------
+
+void LogWriter::run()
+{
+    QElapsedTimer clock;
+    clock.start();
+    m_deviceBaseline = threadDeviceWriteBytes();
+    beginSegment(0);
+
+    if (m_options.prologue) {
+        PT_TRACE_SCOPE("logger.prologue");
+        m_options.prologue(m_work);
+        const int rows = m_work.rowCount();
+        m_formatter->appendRows(m_columns, m_work, m_block);
+        m_work.clear();
+        QMutexLocker locker(&m_mutex);
+        m_stats.rowsWritten += static_cast<quint64>(rows);
+    }
+
+    // Checkpoints flush the partial tail, sync (unless the policy is Never) and update the journal.
+    const bool periodic = m_options.fsyncPolicy == FsyncPolicy::Periodic || m_options.journal
+                          || m_options.segmentSeconds > 0;
+
+    for (;;) {
+        bool stop = false;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (!m_backPending && !m_stopRequested) {
+                if (periodic)
+                    m_wake.wait(&m_mutex, QDeadlineTimer(m_options.fsyncIntervalMs));
+                else
+                    m_wake.wait(&m_mutex);
+                if (periodic && clock.elapsed() - m_lastSyncMs >= m_options.fsyncIntervalMs)
+                    break;
+            }
+            if (m_backPending) {
+                m_work.swap(m_back);
+                m_backPending = false;
+            }
+            stop = m_stopRequested;
+        }
+
+        const int rows = m_work.rowCount();
+        if (rows > 0) {
+            PT_TRACE_SCOPE("logger.format");
+            m_formatter->appendRows(m_columns, m_work, m_block);
+            m_work.clear();
+        }
+
+        // A due checkpoint also pushes out the partial tail so at most one
+        // interval of data is lost on power failure. m_block ends on a record
+        // boundary here, so a full write leaves the file at one too.
+        const qint64 nowMs = clock.elapsed();
+        const bool rotate = !stop && !m_failed.load() && rotationDue(nowMs);
+        const bool checkpointDue = periodic && nowMs - m_lastSyncMs >= m_options.fsyncIntervalMs;
+        writeBlocks(m_block, stop || checkpointDue || rotate);
+        if (rotate) {
+            finishSegment();
+            if (openNextSegment())
+                beginSegment(nowMs);
+            m_lastSyncMs = nowMs;
+        } else if (checkpointDue) {
+            checkpoint();
+            m_lastSyncMs = nowMs;
+        }
+
+        if (rows > 0) {
+            QMutexLocker locker(&m_mutex);
+            m_stats.rowsWritten += static_cast<quint64>(rows);
+        }
+
+        if (stop)
+            break;
+    }
+
+    finishSegment();
+}
+
+bool LogWriter::rotationDue(qint64 nowMs) const
+{
+    if (m_options.segmentSeconds > 0 && nowMs - m_segmentStartMs >= m_options.segmentSeconds * 1000LL)
+        return true;
+    if (m_options.segmentBytes <= 0)
+        return false;
+    // Uncompressed output is counted before it is written; compressed size is only known afterwards.
+    const qint64 pending = m_options.compression == CompressedLog::Codec::None ? m_block.size() : 0;
+    return m_segmentOffset + pending >= m_options.segmentBytes;
+}
+
+void LogWriter::beginSegment(qint64 nowMs)
+{
+    m_segmentStartMs = nowMs;
+    m_segmentOffset = 0;
+    m_allocatedBytes = 0;
+    m_preallocate = m_options.preallocateBytes > 0;
+
+    const QString path = segmentPath(m_path, m_suffix, m_segmentIndex);
+    if (m_options.journal && m_journal.open(path))
+        recordJournal(0, false);
+    if (m_options.diskBudgetBytes > 0)
+        pruneSessions();
+
+    QMutexLocker locker(&m_mutex);
+    ++m_stats.segments;
+}
+
+void LogWriter::finishSegment()
+{
+    if (!m_file.isOpen())
+        return;
+
+    QByteArray trailer = m_formatter->trailer();
+    if (!trailer.isEmpty())
+        writeBlocks(trailer, true);
+
+    // Give back the unused preallocation beyond the end of the data.
+    if (!m_failed.load() && m_allocatedBytes > m_segmentOffset) {
+#if defined(Q_OS_LINUX)
+        if (::fallocate(m_file.handle(), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, m_segmentOffset,
+                        m_allocatedBytes - m_segmentOffset)
+            != 0)
+#endif
+            m_file.resize(m_segmentOffset);
+    }
+    if (m_options.fsyncPolicy != FsyncPolicy::Never)
+        syncFile();
+    m_journal.remove();
+    updateDeviceBytes();
+}
+
+bool LogWriter::openNextSegment()
+{
+    m_file.close();
+    ++m_segmentIndex;
+    const QString path = segmentPath(m_path, m_suffix, m_segmentIndex);
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+        m_failed.store(true);
+        emit errorOccurred(QStringLiteral("Logger: cannot open %1: %2").arg(path, m_file.errorString()));
+        return false;
+    }
+
+    // Every segment is a complete file on its own.
+    m_block.prepend(m_formatter->header(m_columns));
+    if (m_options.compression != CompressedLog::Codec::None)
+        m_compressed = CompressedLog::fileHeader(m_options.compression);
+    return true;
+}
+
+void LogWriter::checkpoint()
+{
+    const bool sync = m_options.fsyncPolicy != FsyncPolicy::Never;
+    if (sync)
+        syncFile();
+    recordJournal(m_segmentOffset, sync);
+    updateDeviceBytes();
+}
+
+void LogWriter::ensureAllocated(qint64 end)
+{
+    if (!m_preallocate || end <= m_allocatedBytes)
+        return;
+
+    const qint64 step = m_options.segmentBytes > 0 ? m_options.segmentBytes : m_options.preallocateBytes;
+    const qint64 target = qMax(end, m_allocatedBytes + step);
+#if defined(Q_OS_LINUX)
+    PT_TRACE_SCOPE("logger.fallocate");
+    // KEEP_SIZE reserves the blocks without moving end-of-file, so a segment that is read before crash
+    // recovery never shows a zero-filled tail as records.
+    if (::fallocate(m_file.handle(), FALLOC_FL_KEEP_SIZE, m_allocatedBytes, target - m_allocatedBytes) == 0) {
+        m_allocatedBytes = target;
+        return;
+    }
+#endif
+    // Not supported here (e.g. some FAT drivers): fall back to plain appends.
+    m_preallocate = false;
+}
+
+void LogWriter::pruneSessions()
+{
+    PT_TRACE_SCOPE("logger.prune");
+    const QFileInfo current(segmentPath(m_path, m_suffix, m_segmentIndex));
+    const QString currentSession = LOG_FILE_PATTERN.match(QFileInfo(m_path).fileName()).captured(1);
+
+    // * Prune units: whole older sessions, and finished segments of this session (oldest first)
+    struct Unit
+    {
+        QStringList files;
+        qint64 bytes = 0;
+        QDateTime newest;
+    };
+    QHash<QString, Unit> units;
+    qint64 total = 0;
+
+    const QDir dir = current.dir();
+    const QFileInfoList entries = dir.entryInfoList(QDir::Files);
+    for (const QFileInfo &info : entries) {
+        const QRegularExpressionMatch match = LOG_FILE_PATTERN.match(info.fileName());
+        if (!match.hasMatch())
+            continue;
+        if (info.fileName() == current.fileName() || info.fileName() == LogJournal::journalPath(current.fileName())) {
+            total += info.size();
+            continue;
+        }
+        if (!isLoggerFile(info.absoluteFilePath(), match))
+            continue;
+        total += info.size();
+
+        const QString session = match.captured(1);
+        Unit &unit = units[session == currentSession ? info.fileName() : session];
+        unit.files.append(info.absoluteFilePath());
+        unit.bytes += info.size();
+        if (!unit.newest.isValid() || info.lastModified() > unit.newest)
+            unit.newest = info.lastModified();
+    }
+    if (total <= m_options.diskBudgetBytes)
+        return;
+
+    QVector<Unit> ordered(units.cbegin(), units.cend());
+    std::sort(ordered.begin(), ordered.end(), [](const Unit &a, const Unit &b) { return a.newest < b.newest; });
+
+    quint64 pruned = 0;
+    for (const Unit &unit : ordered) {
+        if (total <= m_options.diskBudgetBytes)
+            break;
+        for (const QString &file : unit.files)
+            QFile::remove(file);
+        total -= unit.bytes;
+        pruned += static_cast<quint64>(unit.bytes);
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_stats.prunedBytes += pruned;
+}
+
+void LogWriter::recordJournal(qint64 validOffset, bool sync)
+{
+    if (!m_journal.record(validOffset, sync))
+        return;
+    QMutexLocker locker(&m_mutex);
+    m_stats.journalBytes += LogJournal::SLOT_SIZE;
+}
+
+void LogWriter::updateDeviceBytes()
+{
+    if (m_deviceBaseline < 0)
+        return;
+    const qint64 deviceBytes = threadDeviceWriteBytes() - m_deviceBaseline;
+
+    QMutexLocker locker(&m_mutex);
+    m_stats.deviceBytes = static_cast<quint64>(qMax<qint64>(0, deviceBytes));
+}
+
+bool LogWriter::writeBlocks(QByteArray &buffer, bool final)
+{
+    if (m_failed.load()) {
+        buffer.clear();
+        return false;
+    }
+
+    const qsizetype writable = final ? buffer.size() : (buffer.size() / m_options.blockSize) * m_options.blockSize;
+    if (writable <= 0)
+        return true;
+
+    // Each block is compressed on its own so a truncated file stays readable up to the last whole block.
+    const bool compressed = m_options.compression != CompressedLog::Codec::None;
+    qint64 compressUs = 0;
+    if (compressed) {
+        PT_TRACE_SCOPE("logger.compress");
+        const qint64 cpuStartUs = threadCpuUs();
+        for (qsizetype offset = 0; offset < writable; offset += m_options.blockSize) {
+            const qsizetype size = qMin<qsizetype>(m_options.blockSize, writable - offset);
+            if (!CompressedLog::appendBlock(m_compressed, m_options.compression, buffer.constData() + offset, size)) {
+                m_failed.store(true);
+                buffer.clear();
+                emit errorOccurred(QStringLiteral("Logger: compression failed for %1").arg(m_path));
+                return false;
+            }
+        }
+        compressUs = threadCpuUs() - cpuStartUs;
+    }
+    const QByteArray &data = compressed ? m_compressed : buffer;
+    const qsizetype size = compressed ? m_compressed.size() : writable;
+
+    PT_TRACE_SCOPE("logger.write");
+    QElapsedTimer timer;
+    timer.start();
+    ensureAllocated(m_segmentOffset + size);
+    const qint64 written = m_file.write(data.constData(), size);
+    const qint64 elapsedUs = timer.nsecsElapsed() / 1000;
+
+    if (written != size) {
+        m_failed.store(true);
+        buffer.clear();
+        emit errorOccurred(QStringLiteral("Logger: write to %1 failed: %2").arg(m_path, m_file.errorString()));
+        return false;
+    }
+    buffer.remove(0, writable);
+    m_compressed.clear();
+    m_segmentOffset += written;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stats.rawBytes += static_cast<quint64>(writable);
+        m_stats.bytesWritten += static_cast<quint64>(written);
+        ++m_stats.blockWrites;
+        m_stats.worstWriteUs = qMax(m_stats.worstWriteUs, elapsedUs);
+        m_stats.compressCpuUs += compressUs;
+    }
+
+    if (m_options.fsyncPolicy == FsyncPolicy::EveryBlock)
+        syncFile();
+    return true;
+}
+
+void LogWriter::syncFile()
+{
+    if (m_failed.load() || !m_file.isOpen())
+        return;
+
+    PT_TRACE_SCOPE("logger.fsync");
+    QElapsedTimer timer;
+    timer.start();
+#if defined(Q_OS_LINUX)
+    ::fdatasync(m_file.handle());
+#elif defined(Q_OS_UNIX)
+    ::fsync(m_file.handle());
+#endif
+    const qint64 elapsedUs = timer.nsecsElapsed() / 1000;
+
+    QMutexLocker locker(&m_mutex);
+    ++m_stats.fsyncs;
+    m_stats.worstSyncUs = qMax(m_stats.worstSyncUs, elapsedUs);
+}
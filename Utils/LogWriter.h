@@ -0,0 +1,187 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file LogWriter.h
+ * @brief Persistent, double-buffered log file writer running on its own thread.
+ *
+ * The producer (GUI thread) appends snapshotted rows to a front batch. Every
+ * batchRows rows the front batch is handed to the writer thread by swapping it
+ * with the back batch under a short lock; if the writer is still busy with the
+ * previous hand-off the rows are merged instead, so the producer never blocks
+ * on I/O. The merged backlog is capped at maxPendingRows: if the writer stalls
+ * (slow or failing card) further rows are counted as dropped instead of
+ * growing memory. The writer formats rows, accumulates them into a block buffer and
+ * issues block-sized writes to a file that stays open for the whole session,
+ * then syncs according to the configured fsync policy.
+ *
+ * With compression enabled each block is compressed independently on the
+ * writer thread into a .ptz container (see CompressedLogFormat.h) before it
+ * is written; the producer side is unchanged.
+ *
+ * Crash safety: segments are preallocated with fallocate(FALLOC_FL_KEEP_SIZE)
+ * so the card is not fragmented by growth while the file size still ends at
+ * the last written byte, and a LogJournal records the last synced record
+ * boundary at every checkpoint. A clean close releases the unused
+ * preallocation. Sessions can be split into numbered segments by size or
+ * age ("name.csv", "name_002.csv", ...) and the log directory can be kept
+ * under a disk budget by pruning the oldest sessions; only files that carry
+ * the logger's own header signature are ever pruned.
+ */
+
+#ifndef LOGWRITER_H
+#define LOGWRITER_H
+
+#include "CompressedLogFormat.h"
+#include "LogFormat.h"
+#include "LogJournal.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class QThread;
+
+class LogWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class FsyncPolicy {
+        Never,       ///< Leave write-back to the kernel
+        Periodic,    ///< fdatasync at most every fsyncIntervalMs
+        EveryBlock,  ///< fdatasync after every block write
+    };
+
+    struct Options
+    {
+        int blockSize = 64 * 1024;  ///< Write granularity in bytes (multiple of 4096); uncompressed size per block
+        int batchRows = 32;         ///< Rows buffered on the producer side before hand-off
+        int maxPendingRows = 8192;  ///< Rows waiting for the writer beyond which new rows are dropped
+        FsyncPolicy fsyncPolicy = FsyncPolicy::Periodic;
+        int fsyncIntervalMs = 5000;
+        /// Block codec; None writes the formatter output as is. Unavailable codecs fall back to zlib.
+        CompressedLog::Codec compression = CompressedLog::Codec::None;
+        /// fallocate() step when segmentBytes is 0 (segments are otherwise allocated whole); 0 disables preallocation
+        qint64 preallocateBytes = 8 * 1024 * 1024;
+        qint64 segmentBytes = 0;     ///< Start a new segment at this file size (0 = never)
+        int segmentSeconds = 0;      ///< Start a new segment after this long (0 = never)
+        qint64 diskBudgetBytes = 0;  ///< Prune the oldest sessions in the directory beyond this (0 = off)
+        bool journal = true;         ///< Keep a LogJournal next to the open segment
+        /// Called once on the writer thread to fill the first rows, ahead of anything appended (e.g. a pre-trigger
+        /// window); must stay valid until close()
+        std::function<void(LogSampleBatch &)> prologue;
+    };
+
+    struct Stats
+    {
+        quint64 rowsWritten = 0;
+        quint64 rowsDropped = 0;   ///< Rows dropped because the writer fell maxPendingRows behind
+        quint64 rawBytes = 0;      ///< Formatter output before compression
+        quint64 bytesWritten = 0;  ///< Bytes written to the file
+        quint64 blockWrites = 0;
+        quint64 fsyncs = 0;
+        qint64 worstWriteUs = 0;   ///< Includes preallocation triggered by the write
+        qint64 worstSyncUs = 0;
+        qint64 compressCpuUs = 0;  ///< Writer-thread CPU time spent compressing
+        quint64 journalBytes = 0;
+        quint64 deviceBytes = 0;   ///< Writer-thread bytes sent to storage (/proc/thread-self/io), 0 if unknown
+        int segments = 0;
+        quint64 prunedBytes = 0;
+    };
+
+    explicit LogWriter(QObject *parent = nullptr);
+    ~LogWriter() override;
+
+    /**
+     * @brief Open @p path (truncating it), write the header and start the writer thread.
+     * @param formatter Serialiser for header and rows; owned by the writer
+     * @return false if the file could not be opened
+     */
+    bool open(const QString &path, const QVector<LogColumn> &columns, std::unique_ptr<LogFormatter> formatter,
+              const Options &options);
+
+    /// Hand off pending rows, drain the writer thread, sync and close the file.
+    void close();
+
+    bool isOpen() const { return m_thread != nullptr; }
+    /// Path of the first segment of the session
+    QString filePath() const { return m_path; }
+
+    /// Path of segment @p index (0-based) of the session started at @p path with file suffix @p suffix
+    static QString segmentPath(const QString &path, const QString &suffix, int index);
+
+    /**
+     * @brief Append one snapshotted row (producer thread only).
+     * @param numeric Numeric values in the formatter's batch layout (column order by default)
+     * @param text Text values in the formatter's batch layout
+     */
+    void appendRow(qint64 timestampMs, const double *numeric, const QString *text);
+
+    /// Hand the current front batch to the writer thread without waiting for batchRows.
+    void flush();
+
+    /// Snapshot of the writer statistics (thread-safe)
+    Stats stats() const;
+
+signals:
+    /// Emitted from the writer thread; connect with a queued connection.
+    void errorOccurred(const QString &message);
+
+private:
+    void handOff();
+    void run();
+    bool writeBlocks(QByteArray &buffer, bool final);
+    void syncFile();
+    void checkpoint();
+    void beginSegment(qint64 nowMs);
+    void finishSegment();
+    bool openNextSegment();
+    bool rotationDue(qint64 nowMs) const;
+    void ensureAllocated(qint64 end);
+    void pruneSessions();
+    void recordJournal(qint64 validOffset, bool sync);
+    void updateDeviceBytes();
+
+    QString m_path;
+    QString m_suffix;  ///< Formatter extension plus container suffix, e.g. ".ptlog.ptz"
+
+    QVector<LogColumn> m_columns;
+    std::unique_ptr<LogFormatter> m_formatter;
+    Options m_options;
+    QFile m_file;
+    QThread *m_thread = nullptr;
+
+    // * Producer side
+    LogSampleBatch m_front;
+
+    // * Shared hand-off (guarded by m_mutex)
+    mutable QMutex m_mutex;
+    QWaitCondition m_wake;
+    LogSampleBatch m_back;
+    bool m_backPending = false;
+    bool m_stopRequested = false;
+    Stats m_stats;
+
+    // * Writer thread only
+    LogSampleBatch m_work;
+    QByteArray m_block;
+    QByteArray m_compressed;
+    qint64 m_lastSyncMs = 0;
+    int m_segmentIndex = 0;
+    qint64 m_segmentOffset = 0;  ///< Bytes written to the current segment
+    qint64 m_segmentStartMs = 0;
+    qint64 m_allocatedBytes = 0;
+    bool m_preallocate = false;
+    qint64 m_deviceBaseline = -1;
+    LogJournal m_journal;
+    std::atomic<bool> m_failed{false};
+};
+
+#endif  // LOGWRITER_H
@@ -0,0 +1,222 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file OdometerJournal.cpp
+ * @brief Implementation of the OdometerJournal class.
+ */
+
+#include "OdometerJournal.h"
+
+#include <QtEndian>
+
+#include <cstdio>
+#include <cstring>
+
+#include <QFileInfo>
+
+#ifdef Q_OS_UNIX
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+constexpr quint32 RECORD_MAGIC = 0x444F5450;  // "PTOD"
+constexpr int CRC_OFFSET = 28;
+constexpr qint64 FILE_SIZE = qint64(OdometerJournal::CAPACITY) * OdometerJournal::RECORD_SIZE;
+
+void encodeRecord(char *record, quint32 sequence, double odometer, double trip)
+{
+    quint64 odometerBits = 0;
+    quint64 tripBits = 0;
+    std::memcpy(&odometerBits, &odometer, sizeof(odometerBits));
+    std::memcpy(&tripBits, &trip, sizeof(tripBits));
+
+    std::memset(record, 0, OdometerJournal::RECORD_SIZE);
+    qToLittleEndian<quint32>(RECORD_MAGIC, record);
+    qToLittleEndian<quint32>(sequence, record + 4);
+    qToLittleEndian<quint64>(odometerBits, record + 8);
+    qToLittleEndian<quint64>(tripBits, record + 16);
+    qToLittleEndian<quint16>(qChecksum(QByteArrayView(record, CRC_OFFSET)), record + CRC_OFFSET);
+}
+
+/// True if any byte of the slot was written (the unused tail is all zeroes)
+bool slotUsed(const uchar *record)
+{
+    for (int i = 0; i < OdometerJournal::RECORD_SIZE; ++i) {
+        if (record[i] != 0)
+            return true;
+    }
+    return false;
+}
+
+/// Decode one record; returns false if it is unused, torn or damaged
+bool decodeRecord(const uchar *record, quint32 &sequence, double &odometer, double &trip)
+{
+    if (qFromLittleEndian<quint32>(record) != RECORD_MAGIC)
+        return false;
+    if (qFromLittleEndian<quint16>(record + CRC_OFFSET) !=
+        qChecksum(QByteArrayView(reinterpret_cast<const char *>(record), CRC_OFFSET)))
+        return false;
+    const quint64 odometerBits = qFromLittleEndian<quint64>(record + 8);
+    const quint64 tripBits = qFromLittleEndian<quint64>(record + 16);
+    std::memcpy(&odometer, &odometerBits, sizeof(odometer));
+    std::memcpy(&trip, &tripBits, sizeof(trip));
+    sequence = qFromLittleEndian<quint32>(record + 4);
+    return true;
+}
+
+void syncFile(QFile &file)
+{
+#if defined(Q_OS_LINUX)
+    ::fdatasync(file.handle());
+#elif defined(Q_OS_UNIX)
+    ::fsync(file.handle());
+#else
+    file.flush();
+#endif
+}
+
+/// Make a rename in the directory of @p path durable
+void syncDirectory(const QString &path)
+{
+#if defined(Q_OS_UNIX)
+    const int fd = ::open(QFile::encodeName(QFileInfo(path).absolutePath()).constData(), O_RDONLY | O_DIRECTORY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    Q_UNUSED(path);
+#endif
+}
+}  // namespace
+
+OdometerJournal::~OdometerJournal()
+{
+    sync();
+    m_file.close();
+}
+
+bool OdometerJournal::open(const QString &path)
+{
+    m_file.close();
+    m_path = path;
+    m_error.clear();
+    m_sequence = 0;
+    m_nextSlot = 0;
+    m_hasRecord = false;
+    m_unsynced = false;
+
+    m_file.setFileName(path);
+    qint64 records = 0;
+    if (m_file.exists() && m_file.open(QIODevice::ReadWrite | QIODevice::Unbuffered)) {
+        records = qMin<qint64>(m_file.size() / RECORD_SIZE, CAPACITY);
+        const uchar *data = records > 0 ? m_file.map(0, records * RECORD_SIZE) : nullptr;
+        // Written slots form a prefix: find its end with O(log n) page touches.
+        qint64 used = 0;
+        for (qint64 count = data ? records : 0; count > 0;) {
+            const qint64 half = count / 2;
+            if (slotUsed(data + (used + half) * RECORD_SIZE)) {
+                used += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        // The newest valid record is the last one, or the one before a torn write.
+        for (qint64 slot = used - 1; data && slot >= 0; --slot) {
+            if (decodeRecord(data + slot * RECORD_SIZE, m_sequence, m_odometer, m_trip)) {
+                m_hasRecord = true;
+                m_nextSlot = slot + 1;
+                break;
+            }
+        }
+        if (data)
+            m_file.unmap(const_cast<uchar *>(data));
+    }
+
+    // New, truncated or full files are rebuilt at full size around the latest record.
+    if (!m_file.isOpen() || m_file.size() != FILE_SIZE || m_nextSlot >= CAPACITY)
+        return compact();
+    return true;
+}
+
+bool OdometerJournal::append(double odometer, double trip)
+{
+    if (!m_file.isOpen())
+        return false;
+
+    m_odometer = odometer;
+    m_trip = trip;
+    m_hasRecord = true;
+    ++m_sequence;
+    if (m_nextSlot >= CAPACITY)
+        return compact();
+
+    char record[RECORD_SIZE];
+    encodeRecord(record, m_sequence, odometer, trip);
+    if (!m_file.seek(m_nextSlot * RECORD_SIZE) || m_file.write(record, RECORD_SIZE) != RECORD_SIZE) {
+        m_error = QStringLiteral("Cannot write odometer journal %1: %2").arg(m_path, m_file.errorString());
+        return false;
+    }
+    ++m_nextSlot;
+    m_unsynced = true;
+    return true;
+}
+
+void OdometerJournal::sync()
+{
+    if (!m_unsynced || !m_file.isOpen())
+        return;
+    syncFile(m_file);
+    m_unsynced = false;
+}
+
+bool OdometerJournal::compact()
+{
+    m_file.close();
+
+    const QString freshPath = m_path + QStringLiteral(".new");
+    QFile fresh(freshPath);
+    if (!fresh.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_error = QStringLiteral("Cannot create odometer journal %1: %2").arg(freshPath, fresh.errorString());
+        return false;
+    }
+#if defined(Q_OS_UNIX)
+    const bool reserved = ::posix_fallocate(fresh.handle(), 0, FILE_SIZE) == 0;
+#else
+    const bool reserved = fresh.resize(FILE_SIZE);
+#endif
+    bool written = reserved;
+    if (written && m_hasRecord) {
+        char record[RECORD_SIZE];
+        encodeRecord(record, m_sequence, m_odometer, m_trip);
+        written = fresh.write(record, RECORD_SIZE) == RECORD_SIZE && fresh.flush();
+    }
+    if (written)
+        syncFile(fresh);
+    fresh.close();
+
+    // The old file stays in place until the new one is complete on disk.
+#if defined(Q_OS_UNIX)
+    written = written &&
+              std::rename(QFile::encodeName(freshPath).constData(), QFile::encodeName(m_path).constData()) == 0;
+#else
+    written = written && (!QFile::exists(m_path) || QFile::remove(m_path)) && QFile::rename(freshPath, m_path);
+#endif
+    if (!written) {
+        m_error = QStringLiteral("Cannot compact odometer journal %1").arg(m_path);
+        QFile::remove(freshPath);
+        return false;
+    }
+    syncDirectory(m_path);
+
+    m_file.setFileName(m_path);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Unbuffered)) {
+        m_error = QStringLiteral("Cannot open odometer journal %1: %2").arg(m_path, m_file.errorString());
+        return false;
+    }
+    m_nextSlot = m_hasRecord ? 1 : 0;
+    m_unsynced = false;
+    return true;
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file OdometerJournal.h
+ * @brief Append-only journal of odometer and trip readings, recovered from its last valid record.
+ *
+ * The journal file is preallocated to CAPACITY fixed-size records, so an
+ * append is a single 32-byte write that never changes the file size or
+ * rewrites anything else. Each record carries its own CRC:
+ *
+ *     quint32 magic        "PTOD"
+ *     quint32 sequence
+ *     double  odometer     km
+ *     double  trip         km
+ *     quint8  reserved[4]
+ *     quint16 crc          qChecksum() of the preceding 28 bytes
+ *     quint16 reserved
+ *
+ * Records are written in order from the start of the file and the unused
+ * tail stays zeroed, so open() binary-searches for the first zeroed slot
+ * (a dozen probes for the whole file) and walks back from there to the
+ * first record that checks out; a torn final write just falls back to the
+ * one before it. When the file is full it is compacted: a fresh file holding
+ * only the latest record is synced and renamed over it, and the directory is
+ * synced so the rename survives power loss.
+ */
+
+#ifndef ODOMETERJOURNAL_H
+#define ODOMETERJOURNAL_H
+
+#include <QFile>
+#include <QString>
+
+class OdometerJournal
+{
+public:
+    static constexpr int RECORD_SIZE = 32;
+    /// Records per file before compaction (128 KiB)
+    static constexpr int CAPACITY = 4096;
+
+    OdometerJournal() = default;
+    ~OdometerJournal();
+
+    OdometerJournal(const OdometerJournal &) = delete;
+    OdometerJournal &operator=(const OdometerJournal &) = delete;
+
+    /// Open or create the journal at @p path and recover its latest record
+    bool open(const QString &path);
+    bool isOpen() const { return m_file.isOpen(); }
+
+    bool hasRecord() const { return m_hasRecord; }
+    double odometer() const { return m_odometer; }
+    double trip() const { return m_trip; }
+
+    /// Append a reading; it is durable once the kernel writes it back or after sync()
+    bool append(double odometer, double trip);
+    /// Flush appended records to the card; does nothing if there are none
+    void sync();
+
+    QString errorString() const { return m_error; }
+
+private:
+    /// Replace the file with a fresh preallocated one starting with the latest record
+    bool compact();
+
+    QFile m_file;
+    QString m_path;
+    QString m_error;
+    quint32 m_sequence = 0;
+    qint64 m_nextSlot = 0;
+    bool m_hasRecord = false;
+    bool m_unsynced = false;
+    double m_odometer = 0.0;
+    double m_trip = 0.0;
+};
+
+#endif  // ODOMETERJOURNAL_H
@@ -0,0 +1,90 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file PreTriggerBuffer.cpp
+ * @brief Implementation of the PreTriggerBuffer class.
+ */
+
+#include "PreTriggerBuffer.h"
+
+#include "LogFormat.h"
+
+#include <utility>
+
+void PreTriggerBuffer::reset(int numericColumns, int textColumns, int capacity)
+{
+    m_numericColumns = numericColumns;
+    m_textColumns = textColumns;
+    m_capacity = qMax(0, capacity);
+    m_timestamps.fill(0, m_capacity);
+    m_numeric.fill(0.0, static_cast<qsizetype>(m_numericColumns) * m_capacity);
+    m_text.fill(QString(), static_cast<qsizetype>(m_textColumns) * m_capacity);
+    m_timestamps.squeeze();
+    m_numeric.squeeze();
+    m_text.squeeze();
+    clear();
+}
+
+void PreTriggerBuffer::release()
+{
+    m_timestamps = QVector<qint64>();
+    m_numeric = QVector<double>();
+    m_text = QVector<QString>();
+    m_capacity = 0;
+    clear();
+}
+
+void PreTriggerBuffer::append(qint64 timestampMs, const double *numeric, const QString *text)
+{
+    if (m_capacity == 0)
+        return;
+
+    // data() on the unshared vectors does not detach or allocate.
+    const int slot = m_head;
+    m_timestamps.data()[slot] = timestampMs;
+    double *values = m_numeric.data() + slot;
+    for (int column = 0; column < m_numericColumns; ++column)
+        values[static_cast<qsizetype>(column) * m_capacity] = numeric[column];
+    QString *strings = m_text.data() + slot;
+    for (int column = 0; column < m_textColumns; ++column)
+        strings[static_cast<qsizetype>(column) * m_capacity] = text[column];
+
+    m_head = m_head + 1 == m_capacity ? 0 : m_head + 1;
+    if (m_size < m_capacity)
+        ++m_size;
+}
+
+void PreTriggerBuffer::swap(PreTriggerBuffer &other) noexcept
+{
+    std::swap(m_numericColumns, other.m_numericColumns);
+    std::swap(m_textColumns, other.m_textColumns);
+    std::swap(m_capacity, other.m_capacity);
+    std::swap(m_head, other.m_head);
+    std::swap(m_size, other.m_size);
+    m_timestamps.swap(other.m_timestamps);
+    m_numeric.swap(other.m_numeric);
+    m_text.swap(other.m_text);
+}
+
+qint64 PreTriggerBuffer::memoryBytes() const
+{
+    return m_timestamps.size() * static_cast<qint64>(sizeof(qint64))
+           + m_numeric.size() * static_cast<qint64>(sizeof(double))
+           + m_text.size() * static_cast<qint64>(sizeof(QString));
+}
+
+void PreTriggerBuffer::copyTo(LogSampleBatch &batch, qint64 timeOffsetMs) const
+{
+    QVector<double> numeric(m_numericColumns);
+    QVector<QString> text(m_textColumns);
+    const int first = (m_head - m_size + m_capacity) % qMax(1, m_capacity);
+
+    for (int row = 0; row < m_size; ++row) {
+        const int slot = (first + row) % m_capacity;
+        for (int column = 0; column < m_numericColumns; ++column)
+            numeric[column] = m_numeric.at(static_cast<qsizetype>(column) * m_capacity + slot);
+        for (int column = 0; column < m_textColumns; ++column)
+            text[column] = m_text.at(static_cast<qsizetype>(column) * m_capacity + slot);
+        batch.appendRow(m_timestamps.at(slot) + timeOffsetMs, numeric.constData(), text.constData());
+    }
+}
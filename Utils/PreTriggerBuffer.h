@@ -0,0 +1,69 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file PreTriggerBuffer.h
+ * @brief Fixed-size ring of the most recent logger samples, kept while no log is running.
+ *
+ * Storage is struct-of-arrays: one contiguous slab per column, indexed by
+ * ring slot, allocated once by reset(). Appending a sample writes one value
+ * per column and never allocates, so the ring can stay armed at the logger
+ * sample rate for the whole session at a fixed memory cost. When a log
+ * starts, the ring is swapped out in O(1) and its rows are transposed into
+ * the log on the writer thread (see copyTo()).
+ */
+
+#ifndef PRETRIGGERBUFFER_H
+#define PRETRIGGERBUFFER_H
+
+#include <QString>
+#include <QVector>
+
+class LogSampleBatch;
+
+class PreTriggerBuffer
+{
+public:
+    /// Allocate room for @p capacity rows of the given layout, dropping any buffered rows
+    void reset(int numericColumns, int textColumns, int capacity);
+
+    /// Free the storage
+    void release();
+
+    /// Forget the buffered rows, keeping the storage
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    /// Store one row, overwriting the oldest once the ring is full
+    void append(qint64 timestampMs, const double *numeric, const QString *text);
+
+    void swap(PreTriggerBuffer &other) noexcept;
+
+    int size() const { return m_size; }
+    int capacity() const { return m_capacity; }
+    /// Bytes held by the ring storage
+    qint64 memoryBytes() const;
+
+    /**
+     * @brief Append the buffered rows, oldest first, to @p batch.
+     * @param timeOffsetMs Added to every timestamp, e.g. to make them relative to the trigger
+     *
+     * @p batch must use the same layout. Safe to call from another thread
+     * while nothing appends to this buffer.
+     */
+    void copyTo(LogSampleBatch &batch, qint64 timeOffsetMs) const;
+
+private:
+    int m_numericColumns = 0;
+    int m_textColumns = 0;
+    int m_capacity = 0;
+    int m_head = 0;  ///< Slot the next row is written to
+    int m_size = 0;
+    QVector<qint64> m_timestamps;
+    QVector<double> m_numeric;  ///< Column-major: column * capacity + slot
+    QVector<QString> m_text;    ///< Column-major; assignment only shares the model's string
+};
+
+#endif  // PRETRIGGERBUFFER_H
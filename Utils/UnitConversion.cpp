@@ -0,0 +1,153 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file UnitConversion.cpp
+ * @brief Implementation of the unit conversion helpers.
+ */
+
+#include "UnitConversion.h"
+
+#include <iterator>
+
+namespace {
+enum class Quantity { None, Speed, Temperature, Pressure, Length };
+
+/// si = value * scale + offset
+struct UnitInfo
+{
+    Unit unit;
+    Quantity quantity;
+    double scale;
+    double offset;
+    const char *symbol;
+    UnitSystem system;
+};
+
+/// Indexed by Unit
+constexpr UnitInfo UNITS[] = {
+    {Unit::None, Quantity::None, 1.0, 0.0, "", UnitSystem::Metric},
+    {Unit::KilometersPerHour, Quantity::Speed, 1.0 / 3.6, 0.0, "km/h", UnitSystem::Metric},
+    {Unit::MilesPerHour, Quantity::Speed, 0.44704, 0.0, "mph", UnitSystem::Imperial},
+    {Unit::MetersPerSecond, Quantity::Speed, 1.0, 0.0, "m/s", UnitSystem::Metric},
+    {Unit::Celsius, Quantity::Temperature, 1.0, 273.15, "C", UnitSystem::Metric},
+    {Unit::Fahrenheit, Quantity::Temperature, 5.0 / 9.0, 273.15 - 32.0 * 5.0 / 9.0, "F", UnitSystem::Imperial},
+    {Unit::Pascal, Quantity::Pressure, 1.0, 0.0, "Pa", UnitSystem::Metric},
+    {Unit::Kilopascal, Quantity::Pressure, 1000.0, 0.0, "kPa", UnitSystem::Metric},
+    {Unit::Bar, Quantity::Pressure, 100000.0, 0.0, "bar", UnitSystem::Metric},
+    {Unit::Psi, Quantity::Pressure, 6894.757293168, 0.0, "psi", UnitSystem::Imperial},
+    {Unit::Meter, Quantity::Length, 1.0, 0.0, "m", UnitSystem::Metric},
+    {Unit::Foot, Quantity::Length, 0.3048, 0.0, "ft", UnitSystem::Imperial},
+    {Unit::Kilometer, Quantity::Length, 1000.0, 0.0, "km", UnitSystem::Metric},
+    {Unit::Mile, Quantity::Length, 1609.344, 0.0, "mi", UnitSystem::Imperial},
+};
+
+const UnitInfo &infoOf(Unit unit)
+{
+    return UNITS[static_cast<int>(unit)];
+}
+static_assert(std::size(UNITS) == static_cast<size_t>(Unit::Mile) + 1, "UNITS must list every Unit in order");
+
+struct Alias
+{
+    const char *symbol;
+    Unit unit;
+};
+
+/// Accepted spellings besides the canonical symbols, lower case
+constexpr Alias ALIASES[] = {
+    {"kph", Unit::KilometersPerHour},
+    {"kmh", Unit::KilometersPerHour},
+    {"°c", Unit::Celsius},
+    {"degc", Unit::Celsius},
+    {"°f", Unit::Fahrenheit},
+    {"degf", Unit::Fahrenheit},
+    {"miles", Unit::Mile},
+};
+}  // namespace
+
+UnitConversion UnitConversion::between(Unit from, Unit to)
+{
+    const UnitInfo &source = infoOf(from);
+    const UnitInfo &target = infoOf(to);
+    if (from == to || source.quantity == Quantity::None || source.quantity != target.quantity)
+        return UnitConversion();
+    // value -> SI -> target, folded into one pair
+    return UnitConversion{source.scale / target.scale, (source.offset - target.offset) / target.scale};
+}
+
+Unit parseUnit(const QString &symbol)
+{
+    const QString lower = symbol.trimmed().toLower();
+    if (lower.isEmpty())
+        return Unit::None;
+    for (const UnitInfo &info : UNITS) {
+        if (lower.compare(QLatin1String(info.symbol), Qt::CaseInsensitive) == 0)
+            return info.unit;
+    }
+    for (const Alias &alias : ALIASES) {
+        if (lower == QString::fromUtf8(alias.symbol))
+            return alias.unit;
+    }
+    return Unit::None;
+}
+
+QString unitSymbol(Unit unit)
+{
+    return QString::fromLatin1(infoOf(unit).symbol);
+}
+
+UnitSystem parseUnitSystem(const QString &setting)
+{
+    return setting.compare(QLatin1String("imperial"), Qt::CaseInsensitive) == 0 ? UnitSystem::Imperial
+                                                                                  : UnitSystem::Metric;
+}
+
+Unit displayUnit(Unit canonical, const UnitPreferences &preferences)
+{
+    const UnitInfo &info = infoOf(canonical);
+    UnitSystem wanted = UnitSystem::Metric;
+    switch (info.quantity) {
+    case Quantity::Speed:
+    case Quantity::Length:
+        wanted = preferences.speed;
+        break;
+    case Quantity::Temperature:
+        wanted = preferences.temperature;
+        break;
+    case Quantity::Pressure:
+        wanted = preferences.pressure;
+        break;
+    case Quantity::None:
+        return canonical;
+    }
+    if (info.system == wanted)
+        return canonical;
+
+    switch (canonical) {
+    case Unit::KilometersPerHour:
+    case Unit::MetersPerSecond:
+        return Unit::MilesPerHour;
+    case Unit::MilesPerHour:
+        return Unit::KilometersPerHour;
+    case Unit::Celsius:
+        return Unit::Fahrenheit;
+    case Unit::Fahrenheit:
+        return Unit::Celsius;
+    case Unit::Pascal:
+    case Unit::Kilopascal:
+    case Unit::Bar:
+        return Unit::Psi;
+    case Unit::Psi:
+        return Unit::Kilopascal;
+    case Unit::Meter:
+        return Unit::Foot;
+    case Unit::Foot:
+        return Unit::Meter;
+    case Unit::Kilometer:
+        return Unit::Mile;
+    case Unit::Mile:
+        return Unit::Kilometer;
+    default:
+        return canonical;
+    }
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2026 Kai Wyborny. All rights reserved.
+
+/**
+ * @file UnitConversion.h
+ * @brief Typed units and precompiled linear conversions between them.
+ *
+ * Every supported unit is a linear function of its quantity's SI unit, so a
+ * conversion between two units of the same quantity collapses to one
+ * (scale, offset) pair. Pairs are built when a setting changes and applied
+ * per sample as a single fused multiply-add; unit strings are only parsed
+ * at configuration time.
+ */
+
+#ifndef UNITCONVERSION_H
+#define UNITCONVERSION_H
+
+#include <QString>
+
+#include <cmath>
+
+enum class Unit {
+    None,  ///< Unitless or unknown; never converted
+    KilometersPerHour,
+    MilesPerHour,
+    MetersPerSecond,
+    Celsius,
+    Fahrenheit,
+    Pascal,
+    Kilopascal,
+    Bar,
+    Psi,
+    Meter,
+    Foot,
+    Kilometer,
+    Mile,
+};
+
+enum class UnitSystem { Metric, Imperial };
+
+/// The user's display choices, one per settings selector
+struct UnitPreferences
+{
+    UnitSystem speed = UnitSystem::Metric;  ///< Also used for distances
+    UnitSystem temperature = UnitSystem::Metric;
+    UnitSystem pressure = UnitSystem::Metric;
+};
+
+struct UnitConversion
+{
+    double scale = 1.0;
+    double offset = 0.0;
+
+    double apply(double value) const { return std::fma(value, scale, offset); }
+    bool isIdentity() const { return scale == 1.0 && offset == 0.0; }
+
+    /// Conversion from @p from to @p to; identity if either is None or they measure different quantities
+    static UnitConversion between(Unit from, Unit to);
+};
+
+/// Parse a unit symbol ("km/h", "MPH", "°C", "kPa", ...) case-insensitively; unknown symbols give Unit::None
+Unit parseUnit(const QString &symbol);
+QString unitSymbol(Unit unit);
+
+/// Parse a settings value ("metric" / "imperial")
+UnitSystem parseUnitSystem(const QString &setting);
+
+/**
+ * @brief Unit a @p canonical value is shown in under @p preferences.
+ *
+ * Values already in the preferred system keep their unit (kPa stays kPa
+ * under metric); others map to the other system's usual unit of the same
+ * quantity.
+ */
+Unit displayUnit(Unit canonical, const UnitPreferences &preferences);
+
+#endif  // UNITCONVERSION_H
@@ -1,6 +1,7 @@
 #include "Core/connect.h"
 #include "Utils/downloadmanager.h"
 
+#include <QCommandLineParser>
 #include <QDir>
 #include <QFontDatabase>
 #include <QGuiApplication>
@@ -9,6 +10,8 @@
 #include <QQuickStyle>
 #include <QtQml>
 
+#include <cstdio>
+
 // Modified by Kai Wyborny - 2026 (QGuiApplication migration, memory optimization)
 
 int main(int argc, char *argv[])
@@ -21,6 +24,69 @@ int main(int argc, char *argv[])
     app.setOrganizationDomain("power-tune.org");
     app.setApplicationName("PowerTune");
 
+    // * CAN replay: feed a recorded candump/.ptcan log through the pipeline instead of can0.
+    // * --benchmark runs headless (e.g. QT_QPA_PLATFORM=offscreen) and exits after the replay.
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption replayOption(QStringLiteral("can-replay"),
+                                          QStringLiteral("Replay a candump or .ptcan log instead of can0."),
+                                          QStringLiteral("file"));
+    const QCommandLineOption speedOption(QStringLiteral("replay-speed"),
+                                         QStringLiteral("Replay speed factor; 0 replays as fast as possible."),
+                                         QStringLiteral("factor"), QStringLiteral("1"));
+    const QCommandLineOption benchmarkOption(QStringLiteral("benchmark"),
+                                             QStringLiteral("Replay without the UI, print CAN throughput and exit."));
+    // * Log playback: drive the dashboard from a recorded data log in a loop, e.g. while profiling rendering.
+    const QCommandLineOption playbackOption(QStringLiteral("log-playback"),
+                                            QStringLiteral("Play a data log (CSV, .ptlog, .ptz) into the dashboard."),
+                                            QStringLiteral("file"));
+    const QCommandLineOption playbackSpeedOption(QStringLiteral("playback-speed"),
+                                                 QStringLiteral("Log playback speed factor."), QStringLiteral("factor"),
+                                                 QStringLiteral("1"));
+    // * Serial NMEA GPS; a ptgpssim pty path works too
+    const QCommandLineOption gpsOption(QStringLiteral("gps"), QStringLiteral("Read NMEA from a serial GPS device."),
+                                       QStringLiteral("device"));
+    const QCommandLineOption gpsBaudOption(QStringLiteral("gps-baud"), QStringLiteral("GPS line speed."),
+                                           QStringLiteral("baud"), QStringLiteral("115200"));
+    const QCommandLineOption gpsRateOption(QStringLiteral("gps-rate"),
+                                           QStringLiteral("Set a u-blox receiver to this fix rate (1-25 Hz)."),
+                                           QStringLiteral("hz"), QStringLiteral("0"));
+    // * UDP sensor feed (binary or legacy "ident,value" text); Tools/ptudpload generates load
+    const QCommandLineOption udpPortOption(QStringLiteral("udp-port"),
+                                           QStringLiteral("Receive UDP sensor datagrams on this port."),
+                                           QStringLiteral("port"), QStringLiteral("45454"));
+    const QCommandLineOption udpIdentsOption(QStringLiteral("udp-idents"),
+                                             QStringLiteral("Map UDP idents to sensors (\"ident key\" per line)."),
+                                             QStringLiteral("file"));
+    // * Live telemetry for pit-side viewers (unicast or multicast group); Tools/pttelemetry receives it
+    const QCommandLineOption telemetryOption(QStringLiteral("telemetry"),
+                                             QStringLiteral("Broadcast telemetry to this IPv4 address."),
+                                             QStringLiteral("host"));
+    const QCommandLineOption telemetryPortOption(QStringLiteral("telemetry-port"),
+                                                 QStringLiteral("Telemetry destination port."), QStringLiteral("port"),
+                                                 QStringLiteral("45460"));
+    const QCommandLineOption telemetryRateOption(QStringLiteral("telemetry-rate"),
+                                                 QStringLiteral("Telemetry snapshots per second (1-100)."),
+                                                 QStringLiteral("hz"), QStringLiteral("50"));
+    // * Sensor snapshot for co-processes on the device (Hardware/ptshm.h); Tools/ptshmread is an example reader
+    const QCommandLineOption shmOption(QStringLiteral("shm"),
+                                       QStringLiteral("Publish all sensors into POSIX shared memory."));
+    const QCommandLineOption shmNameOption(QStringLiteral("shm-name"), QStringLiteral("Shared-memory segment name."),
+                                           QStringLiteral("name"), QStringLiteral("/powertune-sensors"));
+    const QCommandLineOption shmRateOption(QStringLiteral("shm-rate"),
+                                           QStringLiteral("Shared-memory snapshots per second (1-200)."),
+                                           QStringLiteral("hz"), QStringLiteral("50"));
+    parser.addOptions({replayOption, speedOption, benchmarkOption, playbackOption, playbackSpeedOption, gpsOption,
+                       gpsBaudOption, gpsRateOption, udpPortOption, udpIdentsOption, telemetryOption,
+                       telemetryPortOption, telemetryRateOption, shmOption, shmNameOption, shmRateOption});
+    parser.process(app);
+    const QString replayFile = parser.value(replayOption);
+    const bool benchmark = parser.isSet(benchmarkOption);
+    if (benchmark && replayFile.isEmpty()) {
+        std::fprintf(stderr, "--benchmark requires --can-replay <file>\n");
+        return 1;
+    }
+
     const QDir fontDir(QStringLiteral(":/Resources/fonts"));
     const QStringList fontFiles = fontDir.entryList({QStringLiteral("*.ttf"), QStringLiteral("*.otf")});
     for (const QString &f : fontFiles)
@@ -34,7 +100,45 @@ int main(int argc, char *argv[])
     qmlRegisterType<DownloadManager>("DLM", 1, 0, "DLM");
     qmlRegisterType<Connect>("com.powertune", 1, 0, "ConnectObject");
     engine.rootContext()->setContextProperty("DLM", new DownloadManager(&engine));
-    engine.rootContext()->setContextProperty("Connect", new Connect(&engine));
+    Connect *connectObject = new Connect(&engine);
+    engine.rootContext()->setContextProperty("Connect", connectObject);
+    if (!replayFile.isEmpty())
+        connectObject->setCanReplay(replayFile, parser.value(speedOption).toDouble());
+    if (parser.isSet(playbackOption))
+        connectObject->setLogPlayback(parser.value(playbackOption), parser.value(playbackSpeedOption).toDouble());
+    if (parser.isSet(gpsOption)) {
+        connectObject->setGpsDevice(parser.value(gpsOption), parser.value(gpsBaudOption).toInt(),
+                                    parser.value(gpsRateOption).toInt());
+    }
+    if (parser.isSet(udpPortOption) || parser.isSet(udpIdentsOption))
+        connectObject->setUdpInput(parser.value(udpPortOption).toInt(), parser.value(udpIdentsOption));
+    if (parser.isSet(telemetryOption)) {
+        connectObject->setTelemetryBroadcast(parser.value(telemetryOption), parser.value(telemetryPortOption).toInt(),
+                                             parser.value(telemetryRateOption).toInt());
+    }
+    if (parser.isSet(shmOption) || parser.isSet(shmNameOption))
+        connectObject->setSharedMemoryExport(parser.value(shmNameOption), parser.value(shmRateOption).toInt());
+
+    if (benchmark) {
+        QObject::connect(connectObject, &Connect::canReplayFinished, &app, [&app](qint64 frames, qint64 elapsedUs) {
+            const double seconds = elapsedUs / 1e6;
+            std::printf("frames: %lld\nseconds: %.3f\nframes/s: %.0f\n", static_cast<long long>(frames), seconds,
+                        seconds > 0.0 ? frames / seconds : 0.0);
+            app.exit(0);
+        });
+        QObject::connect(
+            connectObject, &Connect::connectionOpenResult, &app,
+            [&app](bool success, const QString &message) {
+                if (!success) {
+                    std::fprintf(stderr, "%s\n", qPrintable(message));
+                    app.exit(1);
+                }
+            },
+            Qt::QueuedConnection);
+        connectObject->openSavedCanConnection();
+        return app.exec();
+    }
+
     // * Load main QML from PowerTune.Core module
     // ! Resource path includes both prefix and source path due to qt_add_qml_module behavior
     engine.load(QUrl(QStringLiteral("qrc:/qt/qml/PowerTune/Core/PowerTune/Core/Main.qml")));